@@ -2,32 +2,67 @@
 #include <QMediaDevices>
 #include <QAudioDevice>
 #include <QDebug>
+#include <QMetaMethod>
+#include <QThread>
+#include <algorithm>
 #include <cmath>
 
+/**
+ * Pull-mode source for the RX QAudioSink. The sink reads from it on the audio
+ * thread whenever its buffer needs refilling; it always delivers the full request
+ * (silence while prebuffering or on underrun) so the device keeps running.
+ */
+class AudioPlaybackDevice : public QIODevice {
+public:
+    explicit AudioPlaybackDevice(AudioEngine *engine) : m_engine(engine) {}
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return OUTPUT_CHUNK_BYTES + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override {
+        const int frameCount = static_cast<int>(maxlen / BYTES_PER_FRAME);
+        m_engine->renderPlayback(reinterpret_cast<float *>(data), frameCount);
+        return static_cast<qint64>(frameCount) * BYTES_PER_FRAME;
+    }
+
+    qint64 writeData(const char *data, qint64 len) override {
+        Q_UNUSED(data)
+        Q_UNUSED(len)
+        return -1;
+    }
+
+private:
+    static constexpr qint64 BYTES_PER_FRAME = 2 * sizeof(float); // Stereo Float32
+    static constexpr qint64 OUTPUT_CHUNK_BYTES = 240 * BYTES_PER_FRAME; // 20ms at 12kHz
+
+    AudioEngine *m_engine;
+};
+
 AudioEngine::AudioEngine(QObject *parent)
-    : QObject(parent), m_audioSink(nullptr), m_audioSinkDevice(nullptr), m_audioSource(nullptr),
-      m_audioSourceDevice(nullptr), m_micEnabled(false), m_micPollTimer(nullptr) {
+    : QObject(parent), m_audioThread(new QThread(this)), m_playbackDevice(new AudioPlaybackDevice(this)),
+      m_audioSource(nullptr), m_audioSourceDevice(nullptr), m_micEnabled(false), m_micPollTimer(nullptr) {
 
     // Output format: K4 uses 12kHz stereo Float32 PCM (L=Main RX, R=Sub RX)
     m_outputFormat.setSampleRate(12000);
     m_outputFormat.setChannelCount(2);
     m_outputFormat.setSampleFormat(QAudioFormat::Float);
 
-    // Input format: Use native 48kHz for microphone capture (most hardware supports this)
-    // We'll resample to 12kHz before encoding for K4 TX
-    m_inputFormat.setSampleRate(48000);
-    m_inputFormat.setChannelCount(1);
-    m_inputFormat.setSampleFormat(QAudioFormat::Float);
-
     // Create timer for polling microphone data (more reliable than readyRead signal)
-    m_micPollTimer = new QTimer(this);
+    m_micPollTimer = new QTimer();
     m_micPollTimer->setInterval(10); // Poll every 10ms for low latency
-    connect(m_micPollTimer, &QTimer::timeout, this, &AudioEngine::onMicDataReady);
+    connect(m_micPollTimer, &QTimer::timeout, m_micPollTimer, [this]() { captureMicrophone(); });
 
-    // Create feed timer for jitter-buffered RX audio playback
-    m_feedTimer = new QTimer(this);
-    m_feedTimer->setInterval(FEED_INTERVAL_MS);
-    connect(m_feedTimer, &QTimer::timeout, this, &AudioEngine::feedAudioDevice);
+    // RX playback and mic capture run on their own thread so GUI load can't starve them
+    m_audioThread->setObjectName("K4Audio");
+    m_playbackDevice->moveToThread(m_audioThread);
+    m_micPollTimer->moveToThread(m_audioThread);
+    connect(m_audioThread, &QThread::finished, m_playbackDevice, &QObject::deleteLater);
+    connect(m_audioThread, &QThread::finished, m_micPollTimer, &QObject::deleteLater);
+    m_audioThread->start(QThread::TimeCriticalPriority);
+
+    // Publish the default mix (SUB muted: main on both channels)
+    updateMixMatrix();
 
     // Setup audio input immediately so mic testing works without radio connection
     setupAudioInput();
@@ -35,17 +70,15 @@ AudioEngine::AudioEngine(QObject *parent)
 
 AudioEngine::~AudioEngine() {
     stop();
+    m_audioThread->quit();
+    m_audioThread->wait();
 }
 
 bool AudioEngine::start() {
-    bool outputOk = setupAudioOutput();
-
-    if (outputOk) {
-        m_feedTimer->start();
-    }
+    bool outputOk = m_outputStarted || setupAudioOutput();
 
     // Setup audio input if not already done (it's also called in constructor)
-    bool inputOk = (m_audioSource != nullptr) || setupAudioInput();
+    bool inputOk = m_inputReady || setupAudioInput();
 
     Q_UNUSED(inputOk);
 
@@ -53,33 +86,14 @@ bool AudioEngine::start() {
 }
 
 void AudioEngine::stop() {
-    // Stop feed timer and clear jitter buffer
-    if (m_feedTimer) {
-        m_feedTimer->stop();
-    }
-    m_audioQueue.clear();
-    m_prebuffering = true;
+    // Stop playback (also clears the jitter buffer)
+    teardownAudioOutput();
 
-    // Stop mic polling timer
-    if (m_micPollTimer) {
-        m_micPollTimer->stop();
+    // Stop mic capture (source and poll timer belong to the audio thread)
+    if (m_captureStarted) {
+        QMetaObject::invokeMethod(m_micPollTimer, [this]() { stopCapture(); }, Qt::BlockingQueuedConnection);
+        m_captureStarted = false;
     }
-
-    if (m_audioSink) {
-        m_audioSink->stop();
-        delete m_audioSink;
-        m_audioSink = nullptr;
-        m_audioSinkDevice = nullptr;
-    }
-
-    if (m_audioSource) {
-        m_audioSource->stop();
-        delete m_audioSource;
-        m_audioSource = nullptr;
-        m_audioSourceDevice = nullptr;
-    }
-
-    m_micBuffer.clear();
 }
 
 bool AudioEngine::setupAudioOutput() {
@@ -111,26 +125,57 @@ bool AudioEngine::setupAudioOutput() {
         return false;
     }
 
-    m_audioSink = new QAudioSink(outputDevice, m_outputFormat, this);
-    m_audioSink->setBufferSize(OUTPUT_BUFFER_SIZE);
+    // The sink must be created, driven and destroyed on the audio thread
+    bool ok = false;
+    QMetaObject::invokeMethod(
+        m_playbackDevice, [this, &outputDevice, &ok]() { ok = startPlayback(outputDevice); },
+        Qt::BlockingQueuedConnection);
+    m_outputStarted = ok;
+    return ok;
+}
 
-    m_audioSinkDevice = m_audioSink->start();
-    if (!m_audioSinkDevice) {
-        qWarning() << "AudioEngine: Failed to start audio output";
-        delete m_audioSink;
-        m_audioSink = nullptr;
-        return false;
-    }
+void AudioEngine::teardownAudioOutput() {
+    if (!m_outputStarted)
+        return;
+    QMetaObject::invokeMethod(m_playbackDevice, [this]() { stopPlayback(); }, Qt::BlockingQueuedConnection);
+    m_outputStarted = false;
+}
+
+bool AudioEngine::startPlayback(const QAudioDevice &device) {
+    m_jitterBuffer.clear();
+    m_playbackDevice->open(QIODevice::ReadOnly);
+
+    m_audioSink = new QAudioSink(device, m_outputFormat);
+    m_audioSink->setBufferSize(OUTPUT_BUFFER_SIZE);
 
     // Apply current volume setting to the newly created sink
     m_audioSink->setVolume(m_volume);
 
+    // Pull mode: the sink reads from m_playbackDevice as the hardware consumes audio
+    m_audioSink->start(m_playbackDevice);
+    if (m_audioSink->error() != QAudio::NoError) {
+        qWarning() << "AudioEngine: Failed to start audio output:" << m_audioSink->error();
+        stopPlayback();
+        return false;
+    }
+
     return true;
 }
 
+void AudioEngine::stopPlayback() {
+    if (m_audioSink) {
+        m_audioSink->stop();
+        delete m_audioSink;
+        m_audioSink = nullptr;
+    }
+    m_playbackDevice->close();
+    m_jitterBuffer.clear();
+}
+
 bool AudioEngine::setupAudioInput() {
     // Find the input device - use selected device or fall back to default
     QAudioDevice inputDevice;
+    m_inputReady = false;
 
     if (!m_selectedMicDeviceId.isEmpty()) {
         // Try to find the selected device
@@ -152,122 +197,135 @@ bool AudioEngine::setupAudioInput() {
         return false;
     }
 
-    if (!inputDevice.isFormatSupported(m_inputFormat)) {
-        qWarning() << "AudioEngine: 48kHz input format not supported by device";
+    m_inputFormat = chooseInputFormat(inputDevice);
+    if (!m_inputFormat.isValid()) {
+        qWarning() << "AudioEngine: No usable input format on" << inputDevice.description();
         return false;
     }
 
-    m_audioSource = new QAudioSource(inputDevice, m_inputFormat, this);
-    m_audioSource->setBufferSize(INPUT_BUFFER_SIZE);
+    // Capture and resampling buffers for this rate/format, allocated once here
+    const int frameBytes = m_inputFormat.bytesPerFrame();
+    m_micResampler = Resampler(m_inputFormat.sampleRate(), 12000);
+    m_micCapture.resize(MIC_CHUNK_FRAMES * frameBytes);
+    m_micMono.assign(MIC_CHUNK_FRAMES, 0.0f);
+    m_micResampled.assign(m_micResampler.maxOutput(MIC_CHUNK_FRAMES), 0.0f);
 
     // Don't start mic by default - user must enable
+    m_inputDevice = inputDevice;
+    m_inputReady = true;
     return true;
 }
 
-void AudioEngine::enqueueAudio(const QByteArray &pcmData) {
-    if (pcmData.isEmpty())
-        return;
+bool AudioEngine::startCapture() {
+    m_audioSource = new QAudioSource(m_inputDevice, m_inputFormat);
+    m_audioSource->setBufferSize(m_inputFormat.bytesForDuration(INPUT_BUFFER_US));
 
-    // Overflow protection: drop oldest if queue too deep
-    while (m_audioQueue.size() >= MAX_QUEUE_PACKETS) {
-        m_audioQueue.dequeue();
+    m_audioSourceDevice = m_audioSource->start();
+    if (!m_audioSourceDevice) {
+        qWarning() << "AudioEngine: Failed to start microphone device";
+        stopCapture();
+        return false;
     }
 
-    m_audioQueue.enqueue(pcmData);
-}
+    // Fresh resampler history and frame for every capture session
+    m_micResampler.reset();
+    m_micFrameFill = 0;
 
-void AudioEngine::flushQueue() {
-    m_audioQueue.clear();
-    m_prebuffering = true;
+    // Use timer-based polling instead of readyRead signal
+    // (readyRead doesn't fire reliably on all platforms)
+    m_micPollTimer->start();
+    return true;
 }
 
-void AudioEngine::feedAudioDevice() {
-    if (!m_audioSinkDevice || m_audioQueue.isEmpty())
-        return;
-
-    // Wait for prebuffer to fill before starting playback
-    if (m_prebuffering) {
-        if (m_audioQueue.size() < PREBUFFER_PACKETS)
-            return;
-        m_prebuffering = false;
+void AudioEngine::stopCapture() {
+    m_micPollTimer->stop();
+    if (m_audioSource) {
+        m_audioSource->stop();
+        delete m_audioSource;
+        m_audioSource = nullptr;
     }
+    m_audioSourceDevice = nullptr;
+}
 
-    // Write as many queued packets as the sink can accept
-    // Volume/routing/balance is applied here at playback time so slider
-    // changes take effect instantly regardless of queue depth
-    while (!m_audioQueue.isEmpty()) {
-        const QByteArray &front = m_audioQueue.head();
-        int bytesFree = m_audioSink->bytesFree();
-        if (bytesFree < front.size())
-            break;
-
-        QByteArray packet = m_audioQueue.dequeue();
-        applyMixAndVolume(packet);
-        m_audioSinkDevice->write(packet);
-    }
+QAudioFormat AudioEngine::chooseInputFormat(const QAudioDevice &device) {
+    // 48kHz mono Float32 is native on most hardware and needs no conversion
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(1);
+    format.setSampleFormat(QAudioFormat::Float);
+    if (device.isFormatSupported(format))
+        return format;
+
+    // Otherwise keep the device's own rate (44.1kHz USB headsets); the resampler handles
+    // any rate. Prefer mono Float32 there, then the device's preferred format as-is.
+    const QAudioFormat native = device.preferredFormat();
+    format.setSampleRate(native.sampleRate());
+    if (device.isFormatSupported(format))
+        return format;
+    if (device.isFormatSupported(native))
+        return native;
+    return QAudioFormat();
 }
 
-// Compute one output channel's mix from main/sub sources
-static inline float mixChannel(float mainSample, float subSample, AudioEngine::MixSource src, float mainVol,
-                               float subVol) {
-    switch (src) {
-    case AudioEngine::MixA:
-        return mainSample * mainVol;
-    case AudioEngine::MixB:
-        return subSample * subVol;
-    case AudioEngine::MixAB:
-        return mainSample * mainVol + subSample * subVol;
-    case AudioEngine::MixNegA:
-        return -mainSample * mainVol;
+const float *AudioEngine::captureToMono(int frameCount) {
+    if (m_inputFormat.channelCount() == 1 && m_inputFormat.sampleFormat() == QAudioFormat::Float)
+        return reinterpret_cast<const float *>(m_micCapture.constData());
+
+    // Normalize each sample to [-1, 1] and average the channels
+    const int channels = m_inputFormat.channelCount();
+    const int sampleBytes = m_inputFormat.bytesPerSample();
+    const char *frame = m_micCapture.constData();
+    for (int i = 0; i < frameCount; i++) {
+        float sum = 0.0f;
+        for (int ch = 0; ch < channels; ch++)
+            sum += m_inputFormat.normalizedSampleValue(frame + ch * sampleBytes);
+        m_micMono[i] = sum / channels;
+        frame += channels * sampleBytes;
     }
-    return 0.0f;
+    return m_micMono.data();
 }
 
-void AudioEngine::applyMixAndVolume(QByteArray &packet) {
-    float *samples = reinterpret_cast<float *>(packet.data());
-    int totalFloats = packet.size() / sizeof(float);
-    int sampleCount = totalFloats / 2;
+void AudioEngine::flushQueue() {
+    m_jitterBuffer.flush();
+}
 
-    // Pre-compute BL balance gains (BAL mode only, applied after MX routing)
-    float balLeftGain = 1.0f, balRightGain = 1.0f;
-    if (m_balanceMode == 1) {
-        balLeftGain = qBound(0.0f, (50.0f - m_balanceOffset) / 50.0f, 1.0f);
-        balRightGain = qBound(0.0f, (50.0f + m_balanceOffset) / 50.0f, 1.0f);
-    }
+void AudioEngine::renderPlayback(float *out, int frameCount) {
+    m_jitterBuffer.read(out, frameCount);
 
-    for (int i = 0; i < sampleCount; i++) {
-        float mainSample = samples[i * 2];    // Left channel (Main RX / VFO A)
-        float subSample = samples[i * 2 + 1]; // Right channel (Sub RX / VFO B)
-
-        // Step 1: SUB RX off — both channels get main audio only, sub slider has no effect
-        // BL balance still applies (L/R gain is independent of SUB RX state)
-        if (m_subMuted) {
-            float s = mainSample * m_mainVolume;
-            samples[i * 2] = qBound(-1.0f, s * balLeftGain, 1.0f);
-            samples[i * 2 + 1] = qBound(-1.0f, s * balRightGain, 1.0f);
-            continue;
-        }
+    // Volume/routing/balance is applied here at playback time so slider
+    // changes take effect instantly regardless of queue depth
+    applyMixAndVolume(out, frameCount);
+}
 
-        // Step 2: SUB RX on — apply MX routing
-        float left, right;
-        if (m_balanceMode == 0) {
-            // NOR mode: main slider controls main, sub slider controls sub
-            left = mixChannel(mainSample, subSample, m_mixLeft, m_mainVolume, m_subVolume);
-            right = mixChannel(mainSample, subSample, m_mixRight, m_mainVolume, m_subVolume);
-        } else {
-            // BAL mode: mainVolume controls both receivers (sub slider repurposed as balance)
-            left = mixChannel(mainSample, subSample, m_mixLeft, m_mainVolume, m_mainVolume);
-            right = mixChannel(mainSample, subSample, m_mixRight, m_mainVolume, m_mainVolume);
-
-            // Step 3: Apply BL balance (L/R gain adjustment after MX routing)
-            left *= balLeftGain;
-            right *= balRightGain;
-        }
+void AudioEngine::updateMixMatrix() {
+    const AudioMix::Matrix matrix = AudioMix::matrixFor(m_mixSettings);
+
+    // Odd sequence = write in progress; the reader retries rather than mixing a torn matrix
+    const quint32 sequence = m_mixSequence.load(std::memory_order_relaxed);
+    m_mixSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_mixMatrix[0].store(matrix.mainToLeft, std::memory_order_relaxed);
+    m_mixMatrix[1].store(matrix.subToLeft, std::memory_order_relaxed);
+    m_mixMatrix[2].store(matrix.mainToRight, std::memory_order_relaxed);
+    m_mixMatrix[3].store(matrix.subToRight, std::memory_order_relaxed);
+    m_mixSequence.store(sequence + 2, std::memory_order_release);
+}
 
-        // Step 4: Clamp
-        samples[i * 2] = qBound(-1.0f, left, 1.0f);
-        samples[i * 2 + 1] = qBound(-1.0f, right, 1.0f);
-    }
+void AudioEngine::applyMixAndVolume(float *samples, int frameCount) {
+    AudioMix::Matrix matrix;
+    quint32 before, after;
+    do {
+        before = m_mixSequence.load(std::memory_order_acquire);
+        matrix.mainToLeft = m_mixMatrix[0].load(std::memory_order_relaxed);
+        matrix.subToLeft = m_mixMatrix[1].load(std::memory_order_relaxed);
+        matrix.mainToRight = m_mixMatrix[2].load(std::memory_order_relaxed);
+        matrix.subToRight = m_mixMatrix[3].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = m_mixSequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    // Stream gain is fused into the matrix, so samples are touched exactly once
+    AudioMix::apply(samples, frameCount, matrix.scaled(m_streamGain.load(std::memory_order_relaxed)));
 }
 
 void AudioEngine::setMicEnabled(bool enabled) {
@@ -276,136 +334,131 @@ void AudioEngine::setMicEnabled(bool enabled) {
 
     m_micEnabled = enabled;
 
-    if (!m_audioSource) {
-        qWarning() << "AudioEngine: m_audioSource is NULL - mic not available";
+    if (!m_inputReady) {
+        qWarning() << "AudioEngine: No input device configured - mic not available";
         return;
     }
 
-    if (enabled) {
-        m_audioSourceDevice = m_audioSource->start();
-        if (m_audioSourceDevice) {
-            // Use timer-based polling instead of readyRead signal
-            // (readyRead doesn't fire reliably on all platforms)
-            m_micPollTimer->start();
-        } else {
-            qWarning() << "AudioEngine: Failed to start microphone device";
-        }
-    } else {
-        m_micPollTimer->stop();
-        m_audioSource->stop();
-        m_audioSourceDevice = nullptr;
-        m_micBuffer.clear(); // Clear any buffered data
+    // The source and its poll timer live on the audio thread
+    if (enabled && !m_captureStarted) {
+        bool ok = false;
+        QMetaObject::invokeMethod(
+            m_micPollTimer, [this, &ok]() { ok = startCapture(); }, Qt::BlockingQueuedConnection);
+        m_captureStarted = ok;
+    } else if (!enabled && m_captureStarted) {
+        QMetaObject::invokeMethod(m_micPollTimer, [this]() { stopCapture(); }, Qt::BlockingQueuedConnection);
+        m_captureStarted = false;
     }
 }
 
-QByteArray AudioEngine::resample48kTo12k(const QByteArray &input48k) {
-    // Simple 4:1 decimation with averaging filter
-    // 48kHz / 4 = 12kHz
-    const float *inputSamples = reinterpret_cast<const float *>(input48k.constData());
-    int inputCount = input48k.size() / sizeof(float);
-    int outputCount = inputCount / 4;
-
-    QByteArray output12k;
-    output12k.reserve(outputCount * sizeof(float));
-
-    for (int i = 0; i < outputCount; i++) {
-        // Average 4 samples for simple low-pass filtering
-        int srcIdx = i * 4;
-        float sum = 0.0f;
-        int count = 0;
-        for (int j = 0; j < 4 && (srcIdx + j) < inputCount; j++) {
-            sum += inputSamples[srcIdx + j];
-            count++;
-        }
-        float avg = (count > 0) ? (sum / count) : 0.0f;
-        output12k.append(reinterpret_cast<const char *>(&avg), sizeof(float));
-    }
-
-    return output12k;
-}
-
-void AudioEngine::onMicDataReady() {
-    if (!m_audioSourceDevice || !m_micEnabled)
-        return;
-
-    QByteArray data48k = m_audioSourceDevice->readAll();
-    if (data48k.isEmpty()) {
-        // No data available yet - this is normal, just wait for next poll
+void AudioEngine::captureMicrophone() {
+    if (!m_audioSourceDevice)
         return;
-    }
 
-    // Resample from 48kHz to 12kHz
-    QByteArray data12k = resample48kTo12k(data48k);
+    const float gain = m_micGain.load(std::memory_order_relaxed) * MIC_GAIN_SCALE;
+    bool framesQueued = false;
 
-    // Emit raw resampled data for any listeners that want it
-    emit microphoneData(data12k);
-
-    // Convert Float32 to S16LE, apply gain, and buffer for frame-based emission
-    const float *floatData = reinterpret_cast<const float *>(data12k.constData());
-    int floatSamples = data12k.size() / sizeof(float);
+    const bool rawListeners = isSignalConnected(QMetaMethod::fromSignal(&AudioEngine::microphoneData));
+    const int frameBytes = m_inputFormat.bytesPerFrame();
 
     // Calculate RMS level AFTER gain for meter display (shows what will be transmitted)
     float sumSquares = 0.0f;
+    int totalSamples = 0;
+
+    // Drain the device a chunk at a time through the preallocated buffers
+    qint64 bytesRead;
+    while ((bytesRead = m_audioSourceDevice->read(m_micCapture.data(), m_micCapture.size())) > 0) {
+        const int frameCount = static_cast<int>(bytesRead / frameBytes);
+        const float *mono = captureToMono(frameCount);
+
+        // Resample from the device rate to 12kHz
+        float *floatData = m_micResampled.data();
+        const int floatSamples = m_micResampler.process(mono, frameCount, floatData, int(m_micResampled.size()));
+
+        // Emit raw resampled data for any listeners that want it
+        if (rawListeners)
+            emit microphoneData(QByteArray(reinterpret_cast<const char *>(floatData), floatSamples * sizeof(float)));
+
+        // Convert Float32 to S16, apply gain, and pack into 20ms frames for TX
+        for (int i = 0; i < floatSamples; i++) {
+            // Apply mic gain and clamp (MIC_GAIN_SCALE makes 50% slider = unity gain)
+            float sample = qBound(-1.0f, floatData[i] * gain, 1.0f);
+
+            // Accumulate for RMS calculation (after gain)
+            sumSquares += sample * sample;
+
+            // Next free queue slot; none while the consumer is behind (sample dropped)
+            if (!m_micFrame && !(m_micFrame = m_micFrames.back()))
+                continue;
+            m_micFrame->samples[m_micFrameFill++] = static_cast<qint16>(sample * 32767.0f);
+            if (m_micFrameFill == FRAME_SAMPLES) {
+                m_micFrames.commit();
+                m_micFrame = nullptr;
+                m_micFrameFill = 0;
+                framesQueued = true;
+            }
+        }
+        totalSamples += floatSamples;
+    }
 
-    // Convert and append to buffer with gain applied
-    for (int i = 0; i < floatSamples; i++) {
-        // Apply mic gain and clamp (MIC_GAIN_SCALE makes 50% slider = unity gain)
-        float sample = qBound(-1.0f, floatData[i] * m_micGain * MIC_GAIN_SCALE, 1.0f);
-        qint16 s16Sample = static_cast<qint16>(sample * 32767.0f);
-
-        // Accumulate for RMS calculation (after gain)
-        sumSquares += sample * sample;
+    // One wake-up per batch: the consumer re-arms it with beginMicrophoneDrain()
+    if (framesQueued && !m_micFramesPending.exchange(true, std::memory_order_acq_rel))
+        emit microphoneFramesReady();
 
-        // Append as little-endian bytes
-        m_micBuffer.append(reinterpret_cast<const char *>(&s16Sample), sizeof(qint16));
+    if (totalSamples == 0) {
+        // No data available yet - this is normal, just wait for next poll
+        return;
     }
 
     // Emit RMS level for meter display
-    float rmsLevel = (floatSamples > 0) ? std::sqrt(sumSquares / floatSamples) : 0.0f;
+    float rmsLevel = std::sqrt(sumSquares / totalSamples);
     emit micLevelChanged(rmsLevel);
-
-    // Emit complete frames (240 samples = 480 bytes S16LE each)
-    while (m_micBuffer.size() >= FRAME_BYTES_S16LE) {
-        QByteArray frame = m_micBuffer.left(FRAME_BYTES_S16LE);
-        m_micBuffer.remove(0, FRAME_BYTES_S16LE);
-        emit microphoneFrame(frame);
-    }
 }
 
 void AudioEngine::setVolume(float volume) {
     m_volume = qBound(0.0f, volume, 1.0f);
-    if (m_audioSink) {
-        m_audioSink->setVolume(m_volume);
+    if (m_outputStarted) {
+        // The sink belongs to the audio thread
+        QMetaObject::invokeMethod(m_playbackDevice, [this, volume = m_volume]() {
+            if (m_audioSink)
+                m_audioSink->setVolume(volume);
+        });
     }
 }
 
 void AudioEngine::setMainVolume(float volume) {
-    m_mainVolume = qBound(0.0f, volume, 1.0f);
+    m_mixSettings.mainVolume = qBound(0.0f, volume, 1.0f);
+    updateMixMatrix();
 }
 
 void AudioEngine::setSubVolume(float volume) {
-    m_subVolume = qBound(0.0f, volume, 1.0f);
+    m_mixSettings.subVolume = qBound(0.0f, volume, 1.0f);
+    updateMixMatrix();
 }
 
 void AudioEngine::setSubMuted(bool muted) {
-    m_subMuted = muted;
+    m_mixSettings.subMuted = muted;
+    updateMixMatrix();
 }
 
 void AudioEngine::setAudioMix(int left, int right) {
-    m_mixLeft = static_cast<MixSource>(qBound(0, left, 3));
-    m_mixRight = static_cast<MixSource>(qBound(0, right, 3));
+    m_mixSettings.mixLeft = static_cast<AudioMix::Source>(qBound(0, left, 3));
+    m_mixSettings.mixRight = static_cast<AudioMix::Source>(qBound(0, right, 3));
+    updateMixMatrix();
 }
 
 void AudioEngine::setBalanceMode(int mode) {
-    m_balanceMode = qBound(0, mode, 1);
+    m_mixSettings.balanceMode = qBound(0, mode, 1);
+    updateMixMatrix();
 }
 
 void AudioEngine::setBalanceOffset(int offset) {
-    m_balanceOffset = qBound(-50, offset, 50);
+    m_mixSettings.balanceOffset = qBound(-50, offset, 50);
+    updateMixMatrix();
 }
 
 void AudioEngine::setMicGain(float gain) {
-    m_micGain = qBound(0.0f, gain, 1.0f);
+    m_micGain.store(qBound(0.0f, gain, 1.0f), std::memory_order_relaxed);
 }
 
 void AudioEngine::setMicDevice(const QString &deviceId) {
@@ -418,11 +471,7 @@ void AudioEngine::setMicDevice(const QString &deviceId) {
             setMicEnabled(false);
         }
 
-        // Recreate the audio source with the new device
-        if (m_audioSource) {
-            delete m_audioSource;
-            m_audioSource = nullptr;
-        }
+        // Resolve the new device (capture is stopped, so its buffers can be rebuilt)
         setupAudioInput();
 
         if (wasEnabled) {
@@ -454,12 +503,8 @@ void AudioEngine::setOutputDevice(const QString &deviceId) {
         m_selectedOutputDeviceId = deviceId;
 
         // Restart audio output with the new device if currently running
-        if (m_audioSink) {
-            m_audioSink->stop();
-            delete m_audioSink;
-            m_audioSink = nullptr;
-            m_audioSinkDevice = nullptr;
-
+        if (m_outputStarted) {
+            teardownAudioOutput();
             setupAudioOutput();
         }
     }
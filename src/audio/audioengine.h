@@ -5,35 +5,85 @@
 #include <QAudioSink>
 #include <QAudioSource>
 #include <QAudioFormat>
+#include <QAudioDevice>
 #include <QIODevice>
 #include <QTimer>
-#include <QQueue>
-
+#include <array>
+#include <atomic>
+#include <vector>
+#include "audiomix.h"
+#include "jitterbuffer.h"
+#include "resampler.h"
+#include "../network/spscqueue.h"
+
+class QThread;
+
+/**
+ * @brief RX playback and microphone capture
+ *
+ * RX audio is played by a QAudioSink in pull mode on a dedicated time-critical
+ * audio thread: the device asks for samples when its buffer needs refilling, so
+ * playback is clocked by the hardware instead of a GUI-thread timer. Decoded
+ * frames reach it through an adaptive JitterBuffer (lock-free ring of
+ * preallocated float frames, network thread -> audio thread); nothing is
+ * allocated per packet.
+ *
+ * Mix, volume and balance setters run on the GUI thread and publish a
+ * precomputed AudioMix::Matrix; the audio thread picks it up on its next pull.
+ *
+ * Microphone capture also runs on the audio thread. The device is opened at 48kHz
+ * mono Float32 when it can be, otherwise at its own rate and format (e.g. 44.1kHz
+ * USB headsets), and a polyphase Resampler brings it to the K4's 12kHz. Gained S16
+ * samples are packed straight into preallocated 20ms MicrophoneFrame slots of a
+ * lock-free queue; the TX stage (TxAudioPipeline on the network thread) drains it.
+ */
 class AudioEngine : public QObject {
     Q_OBJECT
 
 public:
-    enum MixSource { MixA = 0, MixB = 1, MixAB = 2, MixNegA = 3 };
+    enum MixSource {
+        MixA = AudioMix::SourceA,
+        MixB = AudioMix::SourceB,
+        MixAB = AudioMix::SourceAB,
+        MixNegA = AudioMix::SourceNegA
+    };
+
+    // Microphone frame: 20ms of mono S16 at 12kHz, gain applied
+    static constexpr int FRAME_SAMPLES = 240;
+    struct MicrophoneFrame {
+        std::array<qint16, FRAME_SAMPLES> samples;
+    };
 
     explicit AudioEngine(QObject *parent = nullptr);
     ~AudioEngine();
 
     bool start();
     void stop();
-    void enqueueAudio(const QByteArray &pcmData);
+    // RX playout buffer. Producer side is used by the network thread with decoded
+    // audio (see JitterBuffer); stats() is safe from any thread.
+    JitterBuffer *jitterBuffer() { return &m_jitterBuffer; }
+    JitterBuffer::Stats jitterStats() const { return m_jitterBuffer.stats(); }
+
+    // Drop queued RX audio; the audio thread discards the backlog on its next pull
     void flushQueue();
 
     void setMicEnabled(bool enabled);
     bool isMicEnabled() const { return m_micEnabled; }
 
+    // Microphone frame queue, consumer side (one thread, see NetworkWorker): after
+    // microphoneFramesReady(), call beginMicrophoneDrain() and then take frames in place
+    void beginMicrophoneDrain() { m_micFramesPending.store(false, std::memory_order_release); }
+    const MicrophoneFrame *frontMicrophoneFrame() { return m_micFrames.front(); }
+    void discardMicrophoneFrame() { m_micFrames.discard(); }
+
     void setVolume(float volume); // 0.0 to 1.0
     float volume() const { return m_volume; }
 
     // Channel volume controls (applied at playback time for instant response)
     void setMainVolume(float volume);
     void setSubVolume(float volume);
-    float mainVolume() const { return m_mainVolume; }
-    float subVolume() const { return m_subVolume; }
+    float mainVolume() const { return m_mixSettings.mainVolume; }
+    float subVolume() const { return m_mixSettings.subVolume; }
 
     // SUB RX mute control (when sub receiver is off, sub channel is silent)
     void setSubMuted(bool muted);
@@ -45,9 +95,13 @@ public:
     void setBalanceMode(int mode);
     void setBalanceOffset(int offset); // -50 to +50
 
+    // Thread-safe: scale applied to decoded RX samples before mixing (K4 Opus/S32 streams
+    // are very quiet, see OpusDecoder::streamGain). Folded into the mix matrix.
+    void setStreamGain(float gain) { m_streamGain.store(gain, std::memory_order_relaxed); }
+
     // Microphone settings
     void setMicGain(float gain); // 0.0 to 1.0
-    float micGain() const { return m_micGain; }
+    float micGain() const { return m_micGain.load(std::memory_order_relaxed); }
 
     void setMicDevice(const QString &deviceId);
     QString micDeviceId() const;
@@ -63,87 +117,113 @@ public:
     static QList<QPair<QString, QString>> availableOutputDevices(); // (id, description)
 
 signals:
-    void microphoneData(const QByteArray &pcmData);    // Raw Float32 mic data (variable size)
-    void microphoneFrame(const QByteArray &s16leData); // Complete frame (240 samples, S16LE @ 12kHz)
-    void micLevelChanged(float level);                 // RMS level 0.0-1.0 for meter display
-
-private slots:
-    void onMicDataReady();
-    void feedAudioDevice();
+    // Emitted from the audio thread
+    void microphoneData(const QByteArray &pcmData); // Raw Float32 mic data at 12kHz (variable size)
+    void microphoneFramesReady();                   // Not re-emitted until beginMicrophoneDrain()
+    void micLevelChanged(float level);              // RMS level 0.0-1.0 for meter display
 
 private:
+    friend class AudioPlaybackDevice;
+
     bool setupAudioOutput();
+    void teardownAudioOutput();
     bool setupAudioInput();
 
-    // Resample 48kHz Float32 samples to 12kHz (4:1 decimation with averaging)
-    QByteArray resample48kTo12k(const QByteArray &input48k);
+    // Audio thread: open/close the mic device and its poll timer
+    bool startCapture();
+    void stopCapture();
+
+    // Audio thread: drain the mic device, resample to 12kHz and queue complete frames
+    void captureMicrophone();
+
+    // Audio thread: create/destroy the pull-mode sink
+    bool startPlayback(const QAudioDevice &device);
+    void stopPlayback();
 
-    // Apply MX routing + volume + balance to a raw [main, sub] interleaved packet
-    void applyMixAndVolume(QByteArray &packet);
+    // Audio thread (consumer): fill frameCount stereo frames from the jitter buffer
+    void renderPlayback(float *out, int frameCount);
+
+    // Microphone format: 48kHz mono Float32 if the device supports it, else its native rate
+    static QAudioFormat chooseInputFormat(const QAudioDevice &device);
+
+    // Convert frameCount captured frames in m_micCapture to mono Float32
+    const float *captureToMono(int frameCount);
+
+    // GUI thread: rebuild the mix matrix from m_mixSettings and publish it
+    void updateMixMatrix();
+
+    // Audio thread: apply MX routing + volume + balance + stream gain to raw [main, sub] frames
+    void applyMixAndVolume(float *samples, int frameCount);
 
     // Audio output format: 12kHz stereo Float32 (K4 RX audio, L=Main R=Sub)
     QAudioFormat m_outputFormat;
 
-    // Audio input format: 48kHz mono Float32 (native macOS rate, resampled to 12kHz)
+    // Audio input format negotiated with the mic device (see chooseInputFormat)
     QAudioFormat m_inputFormat;
 
-    // Audio output (speaker)
-    QAudioSink *m_audioSink;
-    QIODevice *m_audioSinkDevice;
+    // Audio output (speaker): sink and pull device live on m_audioThread
+    QThread *m_audioThread;
+    QIODevice *m_playbackDevice;
+    QAudioSink *m_audioSink = nullptr; // Only touched on the audio thread
+    bool m_outputStarted = false;      // GUI thread view of whether the sink is running
 
-    // Audio input (microphone)
+    // Audio input (microphone): device and format resolved on the GUI thread, source
+    // created, polled and destroyed on m_audioThread
+    QAudioDevice m_inputDevice;
+    bool m_inputReady = false;
     QAudioSource *m_audioSource;
     QIODevice *m_audioSourceDevice;
     bool m_micEnabled;
+    bool m_captureStarted = false; // GUI thread view of whether the source is running
     QString m_selectedMicDeviceId;    // Empty = use system default
     QString m_selectedOutputDeviceId; // Empty = use system default
 
     // Volume control (QAudioSink system volume)
     float m_volume = 1.0f;
 
-    // Channel volume controls (0.0 to 1.0)
-    float m_mainVolume = 1.0f;
-    float m_subVolume = 1.0f;
+    // Playback mix settings (GUI thread): volumes, SUB mute (starts muted, SUB RX is off
+    // at startup), MX routing (default A.B: main left, sub right) and BL balance
+    AudioMix::Settings m_mixSettings;
 
-    // SUB RX mute state (true = sub muted, sub channel is silent)
-    bool m_subMuted = true; // Starts muted (SUB RX is off at startup)
+    // Published mix matrix (mainToLeft, subToLeft, mainToRight, subToRight) behind a
+    // sequence lock: one writer (GUI thread), one reader (audio thread), no blocking
+    std::array<std::atomic<float>, 4> m_mixMatrix;
+    std::atomic<quint32> m_mixSequence{0};
+    std::atomic<float> m_streamGain{1.0f};
 
-    // Audio mix routing (MX command) - default A.B (main left, sub right)
-    MixSource m_mixLeft = MixA;
-    MixSource m_mixRight = MixB;
-
-    // Balance mode (0=NOR: independent volume, 1=BAL: L/R balance)
-    int m_balanceMode = 0;
-    int m_balanceOffset = 0; // -50 to +50
-
-    // Microphone gain control
-    float m_micGain = 0.25f; // Default 25% (macOS mic input is typically hot)
+    // Microphone gain control (set on the GUI thread, applied on the audio thread)
+    std::atomic<float> m_micGain{0.25f}; // Default 25% (macOS mic input is typically hot)
 
     // Audio buffer sizes for ~100ms latency
     // Output: 12kHz * 2 channels * 4 bytes/sample * 0.1 sec = 9600 bytes
-    // Input: 48kHz * 4 bytes/sample * 0.1 sec = 19200 bytes
+    // Input: 100ms at whatever rate/format the mic was opened with
     static constexpr int OUTPUT_BUFFER_SIZE = 9600;
-    static constexpr int INPUT_BUFFER_SIZE = 19200;
+    static constexpr qint32 INPUT_BUFFER_US = 100000;
+
+    // Microphone capture -> 12kHz, sized once in setupAudioInput (no per-poll allocation)
+    static constexpr int MIC_CHUNK_FRAMES = 1024; // Device frames read per pass
+    Resampler m_micResampler{48000, 12000};
+    QByteArray m_micCapture;           // Raw device frames
+    std::vector<float> m_micMono;      // Downmix/conversion scratch (non mono-Float formats)
+    std::vector<float> m_micResampled; // 12kHz output of one chunk
 
     // Microphone gain scaling factor (gain slider 0-1 maps to 0-2x, so 0.5 = unity)
     static constexpr float MIC_GAIN_SCALE = 2.0f;
 
-    // Microphone frame buffering for Opus encoding
-    // Buffer accumulates S16LE samples at 12kHz until we have a complete frame
-    static constexpr int FRAME_SAMPLES = 240;                                // 20ms at 12kHz
-    static constexpr int FRAME_BYTES_S16LE = FRAME_SAMPLES * sizeof(qint16); // 480 bytes
-    QByteArray m_micBuffer;
+    // Microphone frames for TX, audio thread -> network thread. Samples are written
+    // directly into the queue's next free slot and published when it holds a full frame.
+    static constexpr int MIC_QUEUE_FRAMES = 16; // 320ms
+    SpscQueue<MicrophoneFrame> m_micFrames{MIC_QUEUE_FRAMES};
+    MicrophoneFrame *m_micFrame = nullptr; // Slot being filled (audio thread)
+    int m_micFrameFill = 0;
+    std::atomic<bool> m_micFramesPending{false};
 
-    // Timer for polling microphone data (more reliable than readyRead signal)
+    // Timer for polling microphone data (more reliable than readyRead signal); lives on m_audioThread
     QTimer *m_micPollTimer;
 
     // Jitter buffer for RX audio playback
-    QQueue<QByteArray> m_audioQueue;
-    QTimer *m_feedTimer;
-    bool m_prebuffering = true;
-    static constexpr int PREBUFFER_PACKETS = 2;  // ~40ms prebuffer (2 × 20ms Opus packets)
-    static constexpr int MAX_QUEUE_PACKETS = 50; // ~1s overflow cap
-    static constexpr int FEED_INTERVAL_MS = 10;
+    // Single producer (network thread) / single consumer (audio thread), lock-free
+    JitterBuffer m_jitterBuffer{12000};
 };
 
 #endif // AUDIOENGINE_H
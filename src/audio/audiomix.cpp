@@ -0,0 +1,108 @@
+#include "audiomix.h"
+#include "audiosimd.h"
+#include <algorithm>
+
+namespace AudioMix {
+
+// One output channel's [main, sub] weights for an MX source
+static void sourceWeights(Source source, float mainVolume, float subVolume, float &mainWeight, float &subWeight) {
+    mainWeight = 0.0f;
+    subWeight = 0.0f;
+    switch (source) {
+    case SourceA:
+        mainWeight = mainVolume;
+        break;
+    case SourceB:
+        subWeight = subVolume;
+        break;
+    case SourceAB:
+        mainWeight = mainVolume;
+        subWeight = subVolume;
+        break;
+    case SourceNegA:
+        mainWeight = -mainVolume;
+        break;
+    }
+}
+
+Matrix matrixFor(const Settings &settings) {
+    // BL balance gains (BAL mode only, applied after MX routing)
+    float balLeftGain = 1.0f, balRightGain = 1.0f;
+    if (settings.balanceMode == 1) {
+        balLeftGain = std::clamp((50.0f - settings.balanceOffset) / 50.0f, 0.0f, 1.0f);
+        balRightGain = std::clamp((50.0f + settings.balanceOffset) / 50.0f, 0.0f, 1.0f);
+    }
+
+    Matrix m;
+
+    // SUB RX off — both channels get main audio only, sub slider has no effect
+    // BL balance still applies (L/R gain is independent of SUB RX state)
+    if (settings.subMuted) {
+        m.mainToLeft = settings.mainVolume * balLeftGain;
+        m.subToLeft = 0.0f;
+        m.mainToRight = settings.mainVolume * balRightGain;
+        m.subToRight = 0.0f;
+        return m;
+    }
+
+    // SUB RX on — MX routing. NOR: main slider controls main, sub slider controls sub.
+    // BAL: mainVolume controls both receivers (sub slider repurposed as balance).
+    const float subVolume = (settings.balanceMode == 0) ? settings.subVolume : settings.mainVolume;
+    sourceWeights(settings.mixLeft, settings.mainVolume, subVolume, m.mainToLeft, m.subToLeft);
+    sourceWeights(settings.mixRight, settings.mainVolume, subVolume, m.mainToRight, m.subToRight);
+
+    m.mainToLeft *= balLeftGain;
+    m.subToLeft *= balLeftGain;
+    m.mainToRight *= balRightGain;
+    m.subToRight *= balRightGain;
+    return m;
+}
+
+void apply(float *samples, int frameCount, const Matrix &matrix) {
+    int i = 0;
+
+#if defined(AUDIO_SIMD_SSE2)
+    // Two frames per vector: [m0 s0 m1 s1] -> [m0 m0 m1 m1] * [ml mr ml mr] + [s0 s0 s1 s1] * [sl sr sl sr]
+    const __m128 mainWeights = _mm_setr_ps(matrix.mainToLeft, matrix.mainToRight, matrix.mainToLeft,
+                                           matrix.mainToRight);
+    const __m128 subWeights = _mm_setr_ps(matrix.subToLeft, matrix.subToRight, matrix.subToLeft, matrix.subToRight);
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    for (; i + 2 <= frameCount; i += 2) {
+        const __m128 v = _mm_loadu_ps(samples + i * 2);
+        const __m128 mains = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 subs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 out = _mm_add_ps(_mm_mul_ps(mains, mainWeights), _mm_mul_ps(subs, subWeights));
+        out = _mm_min_ps(_mm_max_ps(out, lo), hi);
+        _mm_storeu_ps(samples + i * 2, out);
+    }
+#elif defined(AUDIO_SIMD_NEON)
+    const float mainLanes[4] = {matrix.mainToLeft, matrix.mainToRight, matrix.mainToLeft, matrix.mainToRight};
+    const float subLanes[4] = {matrix.subToLeft, matrix.subToRight, matrix.subToLeft, matrix.subToRight};
+    const float32x4_t mainWeights = vld1q_f32(mainLanes);
+    const float32x4_t subWeights = vld1q_f32(subLanes);
+    const float32x4_t lo = vdupq_n_f32(-1.0f);
+    const float32x4_t hi = vdupq_n_f32(1.0f);
+    for (; i + 2 <= frameCount; i += 2) {
+        const float32x4_t v = vld1q_f32(samples + i * 2);
+        // vtrnq(v, v): val[0] = [m0 m0 m1 m1], val[1] = [s0 s0 s1 s1] (ARMv7 and AArch64)
+        const float32x4x2_t split = vtrnq_f32(v, v);
+        float32x4_t out = vmulq_f32(split.val[0], mainWeights);
+        out = vmlaq_f32(out, split.val[1], subWeights);
+        out = vminq_f32(vmaxq_f32(out, lo), hi);
+        vst1q_f32(samples + i * 2, out);
+    }
+#endif
+
+    // Scalar tail (and the whole buffer without SIMD)
+    for (; i < frameCount; i++) {
+        const float mainSample = samples[i * 2];
+        const float subSample = samples[i * 2 + 1];
+        const float left = matrix.mainToLeft * mainSample + matrix.subToLeft * subSample;
+        const float right = matrix.mainToRight * mainSample + matrix.subToRight * subSample;
+        samples[i * 2] = std::clamp(left, -1.0f, 1.0f);
+        samples[i * 2 + 1] = std::clamp(right, -1.0f, 1.0f);
+    }
+}
+
+} // namespace AudioMix
@@ -0,0 +1,49 @@
+#ifndef AUDIOMIX_H
+#define AUDIOMIX_H
+
+/**
+ * @brief RX playback mix: MX routing, volume and BL balance as one 2x2 matrix
+ *
+ * Every combination of SUB mute, NOR/BAL mode, MX sources, slider volumes and
+ * balance offset is linear in the [main, sub] input, so it collapses to
+ *
+ *     left  = mainToLeft  * main + subToLeft  * sub
+ *     right = mainToRight * main + subToRight * sub
+ *
+ * The matrix is rebuilt only when a setting changes; apply() is a branch-free
+ * SSE/NEON kernel (scalar elsewhere) over interleaved stereo Float32.
+ */
+namespace AudioMix {
+
+// MX command sources (same values as RadioState::audioMixLeft/Right)
+enum Source { SourceA = 0, SourceB = 1, SourceAB = 2, SourceNegA = 3 };
+
+struct Settings {
+    float mainVolume = 1.0f; // 0.0 to 1.0
+    float subVolume = 1.0f;  // 0.0 to 1.0
+    bool subMuted = true;    // SUB RX off: both outputs carry main only
+    Source mixLeft = SourceA;
+    Source mixRight = SourceB;
+    int balanceMode = 0;   // 0=NOR (independent volumes), 1=BAL (L/R balance)
+    int balanceOffset = 0; // -50 to +50
+};
+
+struct Matrix {
+    float mainToLeft = 1.0f;
+    float subToLeft = 0.0f;
+    float mainToRight = 0.0f;
+    float subToRight = 1.0f;
+
+    Matrix scaled(float gain) const {
+        return {mainToLeft * gain, subToLeft * gain, mainToRight * gain, subToRight * gain};
+    }
+};
+
+Matrix matrixFor(const Settings &settings);
+
+// Mix frameCount interleaved [main, sub] frames in place, clamping to [-1, 1]
+void apply(float *samples, int frameCount, const Matrix &matrix);
+
+} // namespace AudioMix
+
+#endif // AUDIOMIX_H
@@ -0,0 +1,15 @@
+#ifndef AUDIOSIMD_H
+#define AUDIOSIMD_H
+
+// SIMD selection for the audio kernels. Only instruction sets that are part of the
+// target's baseline are used (SSE2 on x86-64, NEON on AArch64 or ARMv7 builds with
+// -mfpu=neon), so no extra compiler flags are needed; other targets fall back to scalar.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AUDIO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#endif // AUDIOSIMD_H
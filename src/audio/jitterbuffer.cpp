@@ -0,0 +1,227 @@
+#include "jitterbuffer.h"
+#include <algorithm>
+
+JitterBuffer::JitterBuffer(int sampleRate) : m_sampleRate(sampleRate) {}
+
+// =============================================================================
+// Producer (network thread)
+// =============================================================================
+
+int JitterBuffer::packetArrived(quint8 sequence, int frameSamples, qint64 arrivalUs) {
+    if (frameSamples > 0)
+        m_frameSamples.store(frameSamples, std::memory_order_relaxed);
+    m_packetsReceived.fetch_add(1, std::memory_order_relaxed);
+
+    if (!m_haveSequence) {
+        m_haveSequence = true;
+        m_lastSequence = sequence;
+        m_lastArrivalUs = arrivalUs;
+        return 0;
+    }
+
+    // 8-bit sequence: anything "behind" the last packet is a duplicate or arrived too late
+    const quint8 delta = static_cast<quint8>(sequence - m_lastSequence);
+    if (delta == 0 || delta >= 128) {
+        m_packetsLate.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    // RFC 3550 interarrival jitter, using the sequence number as the media clock
+    const double packetFrames = m_frameSamples.load(std::memory_order_relaxed);
+    const double elapsedFrames = double(arrivalUs - m_lastArrivalUs) * m_sampleRate / 1e6;
+    const double transitDelta = elapsedFrames - delta * packetFrames;
+    m_jitterFrames += (qAbs(transitDelta) - m_jitterFrames) / 16.0;
+    m_jitterMs.store(float(m_jitterFrames * 1000.0 / m_sampleRate), std::memory_order_relaxed);
+
+    m_lastSequence = sequence;
+    m_lastArrivalUs = arrivalUs;
+
+    const int lost = delta - 1;
+    if (lost > 0)
+        m_packetsLost.fetch_add(lost, std::memory_order_relaxed);
+    return qMin(lost, MAX_CONCEALED_FRAMES);
+}
+
+void JitterBuffer::resetSequence() {
+    m_haveSequence = false;
+    m_jitterFrames = 0.0;
+    m_jitterMs.store(0.0f, std::memory_order_relaxed);
+}
+
+void JitterBuffer::write(const float *samples, int count, bool concealed) {
+    // Keep [main, sub] pairs together; oversized packets span several ring frames
+    count -= count % 2;
+    if (concealed && count > 0)
+        m_concealedFrames.fetch_add(1, std::memory_order_relaxed);
+
+    while (count > 0) {
+        // The producer cannot drop the oldest frame; if the ring is full the consumer
+        // is far behind and trims the backlog on its next read
+        AudioFrame *frame = m_ring.back();
+        if (!frame) {
+            m_overflowDrops.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const int n = qMin(count, AudioFrame::CAPACITY);
+        std::copy_n(samples, n, frame->samples.data());
+        frame->count = n;
+        // Count before publishing: once committed the consumer may pop the frame and subtract it,
+        // and the depth must never read below what is really queued
+        m_queuedFrames.fetch_add(n / 2, std::memory_order_relaxed);
+        m_ring.commit();
+
+        samples += n;
+        count -= n;
+    }
+}
+
+// =============================================================================
+// Consumer (audio thread)
+// =============================================================================
+
+void JitterBuffer::read(float *out, int frameCount) {
+    if (m_flushRequested.exchange(false, std::memory_order_acq_rel))
+        clear();
+
+    const double target = targetFrames();
+    m_targetMs.store(float(target * 1000.0 / m_sampleRate), std::memory_order_relaxed);
+
+    // Overflow protection: a runaway backlog is cut back to the target in one step
+    if (bufferedFrames() > MAX_LATENCY_MS * m_sampleRate / 1000.0) {
+        while (bufferedFrames() > target && m_ring.front()) {
+            discardFront();
+            m_overflowDrops.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Hold playback until the target depth has built up
+    if (m_prebuffering) {
+        if (bufferedFrames() < target) {
+            std::fill_n(out, frameCount * 2, 0.0f);
+            return;
+        }
+        m_prebuffering = false;
+        m_depthAverage = bufferedFrames();
+    }
+
+    if (!m_primed) {
+        if (!popPair(m_prev) || !popPair(m_next)) {
+            underrun(out, frameCount);
+            return;
+        }
+        m_phase = 0.0;
+        m_primed = true;
+    }
+
+    // Time-stretch: outside the dead band, play proportionally faster (too deep) or
+    // slower (too shallow), never more than MAX_STRETCH away from nominal
+    m_depthAverage += (bufferedFrames() - m_depthAverage) * DEPTH_SMOOTHING;
+    const double error = m_depthAverage - target;
+    double rate = 1.0;
+    if (qAbs(error) > DEAD_BAND_MS * m_sampleRate / 1000.0)
+        rate += MAX_STRETCH * qBound(-1.0, error / target, 1.0);
+    m_playoutRate.store(float(rate), std::memory_order_relaxed);
+
+    // Linear interpolation between the two most recent input frames
+    for (int i = 0; i < frameCount; i++) {
+        const float t = float(m_phase);
+        out[i * 2] = m_prev[0] + (m_next[0] - m_prev[0]) * t;
+        out[i * 2 + 1] = m_prev[1] + (m_next[1] - m_prev[1]) * t;
+
+        m_phase += rate;
+        while (m_phase >= 1.0) {
+            m_phase -= 1.0;
+            m_prev[0] = m_next[0];
+            m_prev[1] = m_next[1];
+            if (!popPair(m_next)) {
+                underrun(out + (i + 1) * 2, frameCount - i - 1);
+                return;
+            }
+        }
+    }
+
+    // The underrun boost wears off while playout runs clean
+    m_underrunBoost = qMax(0.0, m_underrunBoost - BOOST_DECAY_PER_SECOND_MS * frameCount / 1000.0);
+}
+
+void JitterBuffer::clear() {
+    while (m_ring.front())
+        discardFront();
+    m_readPos = 0;
+    m_prebuffering = true;
+    m_primed = false;
+    m_phase = 0.0;
+    m_depthAverage = 0.0;
+    m_playoutRate.store(1.0f, std::memory_order_relaxed);
+}
+
+void JitterBuffer::underrun(float *out, int frameCount) {
+    // Fade the last played frame out instead of cutting to silence (no click)
+    for (int i = 0; i < frameCount; i++) {
+        const float gain = i < FADE_FRAMES ? 1.0f - float(i + 1) / FADE_FRAMES : 0.0f;
+        out[i * 2] = m_prev[0] * gain;
+        out[i * 2 + 1] = m_prev[1] * gain;
+    }
+    m_prev[0] = m_prev[1] = 0.0f;
+
+    m_underruns.fetch_add(1, std::memory_order_relaxed);
+    m_underrunBoost = qMin(m_underrunBoost + UNDERRUN_BOOST_MS * m_sampleRate / 1000.0,
+                           MAX_BOOST_MS * m_sampleRate / 1000.0);
+    m_prebuffering = true;
+    m_primed = false;
+    m_playoutRate.store(1.0f, std::memory_order_relaxed);
+}
+
+bool JitterBuffer::popPair(float *pair) {
+    while (const AudioFrame *frame = m_ring.front()) {
+        if (m_readPos + 1 < frame->count) {
+            pair[0] = frame->samples[m_readPos];
+            pair[1] = frame->samples[m_readPos + 1];
+            m_readPos += 2;
+            return true;
+        }
+        discardFront();
+    }
+    return false;
+}
+
+void JitterBuffer::discardFront() {
+    if (const AudioFrame *frame = m_ring.front()) {
+        m_queuedFrames.fetch_sub(frame->count / 2, std::memory_order_relaxed);
+        m_ring.discard();
+    }
+    m_readPos = 0;
+}
+
+int JitterBuffer::bufferedFrames() const {
+    return m_queuedFrames.load(std::memory_order_relaxed) - m_readPos / 2;
+}
+
+double JitterBuffer::targetFrames() const {
+    // One packet plus three times the jitter covers nearly all arrival spread
+    const double jitterFrames = m_jitterMs.load(std::memory_order_relaxed) * m_sampleRate / 1000.0;
+    const double base = m_frameSamples.load(std::memory_order_relaxed) + 3.0 * jitterFrames;
+    return qBound(MIN_TARGET_MS * m_sampleRate / 1000.0, base, MAX_TARGET_MS * m_sampleRate / 1000.0) +
+           m_underrunBoost;
+}
+
+// =============================================================================
+// Statistics (any thread)
+// =============================================================================
+
+JitterBuffer::Stats JitterBuffer::stats() const {
+    Stats s;
+    // m_readPos belongs to the consumer; the committed-frame count is close enough here
+    s.latencyMs = m_queuedFrames.load(std::memory_order_relaxed) * 1000.0 / m_sampleRate;
+    s.targetMs = m_targetMs.load(std::memory_order_relaxed);
+    s.jitterMs = m_jitterMs.load(std::memory_order_relaxed);
+    s.playoutRate = m_playoutRate.load(std::memory_order_relaxed);
+    s.packetsReceived = m_packetsReceived.load(std::memory_order_relaxed);
+    s.packetsLost = m_packetsLost.load(std::memory_order_relaxed);
+    s.packetsLate = m_packetsLate.load(std::memory_order_relaxed);
+    s.concealedFrames = m_concealedFrames.load(std::memory_order_relaxed);
+    s.underruns = m_underruns.load(std::memory_order_relaxed);
+    s.overflowDrops = m_overflowDrops.load(std::memory_order_relaxed);
+    return s;
+}
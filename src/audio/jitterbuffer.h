@@ -0,0 +1,128 @@
+#ifndef JITTERBUFFER_H
+#define JITTERBUFFER_H
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include "../network/spscqueue.h"
+
+/**
+ * @brief Adaptive playout buffer for K4 RX audio (interleaved stereo Float32)
+ *
+ * Producer side (network thread): packetArrived() tracks the K4 sequence byte and
+ * interarrival jitter (RFC 3550 estimator) and reports gaps so the caller can
+ * synthesize the missing frames (Opus PLC/FEC) before writing the packet itself.
+ *
+ * Consumer side (audio thread): read() plays out at a target depth derived from
+ * the measured jitter plus a boost after each underrun. When the smoothed depth
+ * drifts outside a dead band around the target, playout is resampled up to
+ * MAX_STRETCH faster or slower, so latency converges without audible gaps.
+ * Underruns fade out to silence and rebuild the target depth before resuming.
+ *
+ * Frames are preallocated ring slots; neither side allocates after construction.
+ * stats() may be called from any thread.
+ */
+class JitterBuffer {
+public:
+    struct Stats {
+        double latencyMs = 0.0;    // Audio currently buffered ahead of the sink
+        double targetMs = 0.0;     // Adaptive playout target
+        double jitterMs = 0.0;     // Interarrival jitter estimate
+        double playoutRate = 1.0;  // Current time-stretch ratio (>1 = shrinking latency)
+        quint64 packetsReceived = 0;
+        quint64 packetsLost = 0;     // Sequence gaps
+        quint64 packetsLate = 0;     // Duplicate or out-of-order, dropped
+        quint64 concealedFrames = 0; // Frames synthesized by PLC/FEC
+        quint64 underruns = 0;
+        quint64 overflowDrops = 0; // Frames dropped because the backlog exceeded MAX_LATENCY_MS
+    };
+
+    explicit JitterBuffer(int sampleRate = 12000);
+
+    JitterBuffer(const JitterBuffer &) = delete;
+    JitterBuffer &operator=(const JitterBuffer &) = delete;
+
+    // Producer: register an arriving packet before decoding it. Returns how many
+    // packets are missing just before it (to be concealed, at most MAX_CONCEALED_FRAMES),
+    // or -1 if it is a duplicate / stale packet that should be dropped.
+    int packetArrived(quint8 sequence, int frameSamples, qint64 arrivalUs);
+
+    // Producer: forget sequence history (new connection)
+    void resetSequence();
+
+    // Producer: queue count interleaved [main, sub] samples; concealed marks PLC/FEC output
+    void write(const float *samples, int count, bool concealed = false);
+
+    // Consumer: produce frameCount stereo frames (always fully written)
+    void read(float *out, int frameCount);
+
+    // Consumer: drop everything and start prebuffering again
+    void clear();
+
+    // Any thread: the consumer drops the backlog on its next read()
+    void flush() { m_flushRequested.store(true, std::memory_order_release); }
+
+    Stats stats() const;
+
+    static constexpr int MAX_CONCEALED_FRAMES = 5;   // Longer gaps are resynced, not concealed
+    static constexpr double MIN_TARGET_MS = 40.0;    // ~2 × 20ms K4 packets
+    static constexpr double MAX_TARGET_MS = 300.0;
+    static constexpr double MAX_LATENCY_MS = 1000.0; // Overflow: trim back to target
+    static constexpr double MAX_STRETCH = 0.01;      // ±1% playout rate (~6Hz on a 600Hz CW note)
+
+private:
+    struct AudioFrame {
+        static constexpr int CAPACITY = 960; // 40ms stereo at 12kHz; K4 packets are 20ms
+        std::array<float, CAPACITY> samples;
+        int count = 0;
+    };
+
+    bool popPair(float *pair);
+    void discardFront();
+    int bufferedFrames() const;
+    double targetFrames() const;
+    void underrun(float *out, int frameCount);
+
+    const int m_sampleRate;
+    SpscQueue<AudioFrame> m_ring{RING_FRAMES};
+    std::atomic<int> m_queuedFrames{0}; // Stereo frames written to the ring and not yet discarded
+    std::atomic<bool> m_flushRequested{false};
+
+    // Producer-only
+    bool m_haveSequence = false;
+    quint8 m_lastSequence = 0;
+    qint64 m_lastArrivalUs = 0;
+    double m_jitterFrames = 0.0;
+
+    // Consumer-only
+    int m_readPos = 0; // Samples already taken from the front ring frame
+    bool m_prebuffering = true;
+    bool m_primed = false;
+    float m_prev[2] = {0.0f, 0.0f};
+    float m_next[2] = {0.0f, 0.0f};
+    double m_phase = 0.0;
+    double m_depthAverage = 0.0;
+    double m_underrunBoost = 0.0; // Frames added to the target after underruns, decays during playout
+
+    // Shared statistics (relaxed atomics; approximate by design)
+    std::atomic<int> m_frameSamples{240};
+    std::atomic<float> m_jitterMs{0.0f};
+    std::atomic<float> m_targetMs{float(MIN_TARGET_MS)};
+    std::atomic<float> m_playoutRate{1.0f};
+    std::atomic<quint64> m_packetsReceived{0};
+    std::atomic<quint64> m_packetsLost{0};
+    std::atomic<quint64> m_packetsLate{0};
+    std::atomic<quint64> m_concealedFrames{0};
+    std::atomic<quint64> m_underruns{0};
+    std::atomic<quint64> m_overflowDrops{0};
+
+    static constexpr int RING_FRAMES = 64;         // > 1s of 20ms packets
+    static constexpr double DEAD_BAND_MS = 15.0;   // No stretching while this close to target
+    static constexpr double DEPTH_SMOOTHING = 0.05; // EMA weight per read() for the depth estimate
+    static constexpr double UNDERRUN_BOOST_MS = 20.0;
+    static constexpr double MAX_BOOST_MS = 200.0;
+    static constexpr double BOOST_DECAY_PER_SECOND_MS = 2.0;
+    static constexpr int FADE_FRAMES = 60; // 5ms fade-out on underrun at 12kHz
+};
+
+#endif // JITTERBUFFER_H
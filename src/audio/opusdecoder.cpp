@@ -1,5 +1,7 @@
 #include "opusdecoder.h"
 #include <QDebug>
+#include <QtEndian>
+#include <algorithm>
 
 OpusDecoder::OpusDecoder(QObject *parent) : QObject(parent), m_decoder(nullptr), m_sampleRate(12000), m_channels(2) {}
 
@@ -12,6 +14,7 @@ OpusDecoder::~OpusDecoder() {
 bool OpusDecoder::initialize(int sampleRate, int channels) {
     m_sampleRate = sampleRate;
     m_channels = channels;
+    m_pcm16.assign(MAX_FRAME_SIZE * channels, 0);
 
     int error;
     m_decoder = opus_decoder_create(sampleRate, channels, &error);
@@ -25,6 +28,18 @@ bool OpusDecoder::initialize(int sampleRate, int channels) {
 }
 
 QByteArray OpusDecoder::decodeK4Packet(const QByteArray &packet) {
+    QByteArray out(MAX_DECODED_SAMPLES * sizeof(float), Qt::Uninitialized);
+    float *samples = reinterpret_cast<float *>(out.data());
+    int count = decodeK4Packet(packet, samples, MAX_DECODED_SAMPLES);
+    const float gain = streamGain(count > 0 ? static_cast<quint8>(packet[3]) : 0x01);
+    for (int i = 0; i < count; i++) {
+        samples[i] *= gain;
+    }
+    out.truncate(count * sizeof(float));
+    return out;
+}
+
+int OpusDecoder::decodeK4Packet(const QByteArray &packet, float *out, int maxSamples) {
     // K4 Audio Packet Structure:
     // Byte 0: TYPE = 1 (Audio)
     // Byte 1: VER = Version number
@@ -37,12 +52,12 @@ QByteArray OpusDecoder::decodeK4Packet(const QByteArray &packet) {
     // Note: EM0 is documented as "RAW 32-bit float" but K4 actually sends S32LE integers
 
     if (packet.size() < 8) {
-        return QByteArray();
+        return 0;
     }
 
     // Verify packet type
     if (static_cast<unsigned char>(packet[0]) != 0x01) {
-        return QByteArray();
+        return 0;
     }
 
     unsigned char encodeMode = static_cast<unsigned char>(packet[3]);
@@ -51,90 +66,109 @@ QByteArray OpusDecoder::decodeK4Packet(const QByteArray &packet) {
     quint16 frameSize = static_cast<unsigned char>(packet[4]) | (static_cast<unsigned char>(packet[5]) << 8);
     Q_UNUSED(frameSize)
 
-    // Extract audio data starting at byte 7
-    QByteArray audioData = packet.mid(7);
-
-    if (audioData.isEmpty()) {
-        return QByteArray();
-    }
+    // Audio data starts at byte 7; read in place (RAW samples may be unaligned)
+    const uchar *audioData = reinterpret_cast<const uchar *>(packet.constData()) + 7;
+    const int audioBytes = packet.size() - 7;
 
     // Decode based on encode mode — output raw normalized stereo [main, sub, main, sub, ...]
-    // Volume/routing/balance is applied later at playback time in AudioEngine::feedAudioDevice()
+    // Volume/routing/balance is applied later at playback time in AudioEngine::renderPlayback()
     switch (encodeMode) {
     case 0x00: // EM0 - RAW 32-bit signed integer stereo PCM (S32LE)
     {
-        const qint32 *stereoSamples = reinterpret_cast<const qint32 *>(audioData.constData());
-        int totalSamples = audioData.size() / sizeof(qint32);
-
-        QByteArray out(totalSamples * sizeof(float), Qt::Uninitialized);
-        float *dst = reinterpret_cast<float *>(out.data());
+        int totalSamples = qMin(audioBytes / int(sizeof(qint32)), maxSamples);
         for (int i = 0; i < totalSamples; i++) {
-            dst[i] = static_cast<float>(stereoSamples[i]) * NORMALIZE_32BIT * K4_GAIN_BOOST;
+            qint32 sample = qFromLittleEndian<qint32>(audioData + i * sizeof(qint32));
+            out[i] = static_cast<float>(sample) * NORMALIZE_32BIT;
         }
-        return out;
+        return totalSamples;
     }
 
     case 0x01: // EM1 - RAW 16-bit S16LE stereo PCM (full scale, no boost needed)
     {
-        const qint16 *stereoSamples = reinterpret_cast<const qint16 *>(audioData.constData());
-        int totalSamples = audioData.size() / sizeof(qint16);
-
-        QByteArray out(totalSamples * sizeof(float), Qt::Uninitialized);
-        float *dst = reinterpret_cast<float *>(out.data());
+        int totalSamples = qMin(audioBytes / int(sizeof(qint16)), maxSamples);
         for (int i = 0; i < totalSamples; i++) {
-            dst[i] = static_cast<float>(stereoSamples[i]) * NORMALIZE_16BIT; // No boost for RAW
+            qint16 sample = qFromLittleEndian<qint16>(audioData + i * sizeof(qint16));
+            out[i] = static_cast<float>(sample) * NORMALIZE_16BIT;
         }
-        return out;
+        return totalSamples;
     }
 
     case 0x02: // EM2 - Opus encoded, decode with opus_decode() (returns S16LE)
     {
-        QByteArray stereoPcm = decode(audioData);
-        if (stereoPcm.isEmpty()) {
-            return QByteArray();
+        if (!m_decoder)
+            return 0;
+        int samples = opus_decode(m_decoder, audioData, audioBytes, m_pcm16.data(), MAX_FRAME_SIZE, 0);
+        if (samples < 0) {
+            qWarning() << "OpusDecoder: Decode failed:" << opus_strerror(samples);
+            return 0;
         }
 
-        const qint16 *stereoSamples = reinterpret_cast<const qint16 *>(stereoPcm.constData());
-        int totalSamples = stereoPcm.size() / sizeof(qint16);
-
-        QByteArray out(totalSamples * sizeof(float), Qt::Uninitialized);
-        float *dst = reinterpret_cast<float *>(out.data());
+        int totalSamples = qMin(samples * m_channels, maxSamples);
         for (int i = 0; i < totalSamples; i++) {
-            dst[i] = static_cast<float>(stereoSamples[i]) * NORMALIZE_16BIT * K4_GAIN_BOOST;
+            out[i] = static_cast<float>(m_pcm16[i]) * NORMALIZE_16BIT;
         }
-        return out;
+        return totalSamples;
     }
 
     case 0x03: // EM3 - Opus encoded, decode with opus_decode_float() (returns float)
     {
-        QByteArray stereoPcm = decodeFloat(audioData);
-        if (stereoPcm.isEmpty()) {
-            return QByteArray();
-        }
-
-        const float *stereoFloats = reinterpret_cast<const float *>(stereoPcm.constData());
-        int totalSamples = stereoPcm.size() / sizeof(float);
-
-        QByteArray out(totalSamples * sizeof(float), Qt::Uninitialized);
-        float *dst = reinterpret_cast<float *>(out.data());
-        for (int i = 0; i < totalSamples; i++) {
-            dst[i] = stereoFloats[i] * K4_GAIN_BOOST;
+        if (!m_decoder)
+            return 0;
+        // Decode straight into the output; the frame size limit keeps it within maxSamples
+        int frameLimit = qMin(MAX_FRAME_SIZE, maxSamples / m_channels);
+        int samples = opus_decode_float(m_decoder, audioData, audioBytes, out, frameLimit, 0);
+        if (samples < 0) {
+            qWarning() << "OpusDecoder: Float decode failed:" << opus_strerror(samples);
+            return 0;
         }
-        return out;
+        return samples * m_channels;
     }
 
     default:
         qWarning() << "OpusDecoder: Unknown encode mode:" << encodeMode;
-        return QByteArray();
+        return 0;
+    }
+}
+
+int OpusDecoder::concealK4Frame(const QByteArray &nextPacket, float *out, int maxSamples, bool useFec) {
+    if (nextPacket.size() < 8 || static_cast<unsigned char>(nextPacket[0]) != 0x01) {
+        return 0;
+    }
+
+    unsigned char encodeMode = static_cast<unsigned char>(nextPacket[3]);
+
+    // The lost frame is assumed to be as long as the one that follows it
+    int frameSize = static_cast<unsigned char>(nextPacket[4]) | (static_cast<unsigned char>(nextPacket[5]) << 8);
+    frameSize = qMin(frameSize, qMin(MAX_FRAME_SIZE, maxSamples / m_channels));
+    if (frameSize <= 0) {
+        return 0;
+    }
+
+    if (encodeMode != 0x02 && encodeMode != 0x03) {
+        std::fill_n(out, frameSize * m_channels, 0.0f);
+        return frameSize * m_channels;
+    }
+    if (!m_decoder) {
+        return 0;
+    }
+
+    // FEC decodes the redundant copy of the previous frame carried in nextPacket (plain PLC
+    // if the encoder sent none); PLC extrapolates from decoder state alone (NULL data)
+    const uchar *data = useFec ? reinterpret_cast<const uchar *>(nextPacket.constData()) + 7 : nullptr;
+    const int dataBytes = useFec ? nextPacket.size() - 7 : 0;
+    int samples = opus_decode_float(m_decoder, data, dataBytes, out, frameSize, useFec ? 1 : 0);
+    if (samples < 0) {
+        qWarning() << "OpusDecoder: Concealment failed:" << opus_strerror(samples);
+        return 0;
     }
+    return samples * m_channels;
 }
 
 QByteArray OpusDecoder::decode(const QByteArray &opusData) {
     if (!m_decoder)
         return QByteArray();
 
-    // Max frame size for 12kHz = 120ms * 12000 = 1440 samples per channel
-    const int maxFrameSize = 1440;
+    const int maxFrameSize = MAX_FRAME_SIZE;
     QVector<opus_int16> pcm(maxFrameSize * m_channels);
 
     int samples = opus_decode(m_decoder, reinterpret_cast<const unsigned char *>(opusData.constData()), opusData.size(),
@@ -152,8 +186,7 @@ QByteArray OpusDecoder::decodeFloat(const QByteArray &opusData) {
     if (!m_decoder)
         return QByteArray();
 
-    // Max frame size for 12kHz = 120ms * 12000 = 1440 samples per channel
-    const int maxFrameSize = 1440;
+    const int maxFrameSize = MAX_FRAME_SIZE;
     QVector<float> pcm(maxFrameSize * m_channels);
 
     int samples = opus_decode_float(m_decoder, reinterpret_cast<const unsigned char *>(opusData.constData()),
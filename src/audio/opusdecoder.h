@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <opus/opus.h>
+#include <vector>
 
 class OpusDecoder : public QObject {
     Q_OBJECT
@@ -19,17 +20,37 @@ public:
     // Volume/routing/balance is NOT applied here — that happens at playback time
     QByteArray decodeK4Packet(const QByteArray &packet);
 
+    // Same, but decodes into a caller-provided buffer of maxSamples floats without allocating,
+    // and WITHOUT the gain boost: the playback mix applies streamGain() in the same pass.
+    // Returns the number of floats written (0 on error). MAX_DECODED_SAMPLES always fits.
+    int decodeK4Packet(const QByteArray &packet, float *out, int maxSamples);
+
+    // Gain that brings an encode mode's normalized output to full scale
+    static float streamGain(quint8 encodeMode) { return encodeMode == 0x01 ? 1.0f : K4_GAIN_BOOST; }
+
+    // Synthesize one frame lost just before nextPacket (same layout as decodeK4Packet output).
+    // Opus modes use the packet's in-band FEC when useFec is set, otherwise packet loss
+    // concealment; RAW modes have neither and produce silence. Call before decoding nextPacket.
+    int concealK4Frame(const QByteArray &nextPacket, float *out, int maxSamples, bool useFec);
+
     // Raw decode for testing (returns S16LE stereo PCM)
     QByteArray decode(const QByteArray &opusData);
 
     // Decode to float (returns float32 stereo PCM)
     QByteArray decodeFloat(const QByteArray &opusData);
 
+    // Max frame size for 12kHz = 120ms * 12000 = 1440 samples per channel
+    static constexpr int MAX_FRAME_SIZE = 1440;
+    static constexpr int MAX_DECODED_SAMPLES = MAX_FRAME_SIZE * 2; // Stereo
+
 private:
     ::OpusDecoder *m_decoder;
     int m_sampleRate;
     int m_channels;
 
+    // Scratch for EM2 (opus_decode() returns S16), sized once in initialize()
+    std::vector<opus_int16> m_pcm16;
+
     // Normalization constants
     static constexpr float NORMALIZE_16BIT = 1.0f / 32768.0f;
     static constexpr float NORMALIZE_32BIT = 1.0f / 2147483648.0f;
@@ -36,16 +36,24 @@ QByteArray OpusEncoder::encode(const QByteArray &pcmData) {
     }
 
     QByteArray encoded(MAX_PACKET_SIZE, Qt::Uninitialized);
-
-    const opus_int16 *pcm = reinterpret_cast<const opus_int16 *>(pcmData.constData());
-    int bytes =
-        opus_encode(m_encoder, pcm, FRAME_SAMPLES, reinterpret_cast<unsigned char *>(encoded.data()), MAX_PACKET_SIZE);
-
+    int bytes = encode(reinterpret_cast<const opus_int16 *>(pcmData.constData()), encoded.data(), MAX_PACKET_SIZE);
     if (bytes < 0) {
-        qWarning() << "OpusEncoder: Encode failed:" << opus_strerror(bytes);
         return QByteArray();
     }
 
     encoded.resize(bytes);
     return encoded;
 }
+
+int OpusEncoder::encode(const opus_int16 *pcm, char *out, int maxBytes) {
+    if (!m_encoder) {
+        return -1;
+    }
+
+    int bytes = opus_encode(m_encoder, pcm, FRAME_SAMPLES, reinterpret_cast<unsigned char *>(out), maxBytes);
+    if (bytes < 0) {
+        qWarning() << "OpusEncoder: Encode failed:" << opus_strerror(bytes);
+        return -1;
+    }
+    return bytes;
+}
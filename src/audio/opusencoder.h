@@ -19,6 +19,10 @@ public:
     bool initialize(int sampleRate = 12000, int channels = 1, int bitrate = 24000);
     QByteArray encode(const QByteArray &pcmData);
 
+    // Encode one FRAME_SAMPLES frame straight into out (e.g. a packet body). Returns the
+    // number of bytes written, or -1 on error. Allocation-free.
+    int encode(const opus_int16 *pcm, char *out, int maxBytes);
+
     int frameSamples() const { return FRAME_SAMPLES; }
     int frameBytes() const { return FRAME_BYTES; }
 
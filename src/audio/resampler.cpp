@@ -0,0 +1,153 @@
+#include "resampler.h"
+#include "audiosimd.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+static constexpr double PI = 3.14159265358979323846;
+
+// Zeroth-order modified Bessel function of the first kind (Kaiser window)
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+    for (int k = 1; k < 64; k++) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+    return sum;
+}
+
+// count is a multiple of 4
+static float dot(const float *a, const float *b, int count) {
+#if defined(AUDIO_SIMD_SSE2)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    if (i < count)
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    __m128 sum = _mm_add_ps(acc0, acc1);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(sum);
+#elif defined(AUDIO_SIMD_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    if (i < count)
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    // Pairwise horizontal sum (vaddvq_f32 is AArch64-only)
+    const float32x4_t sum = vaddq_f32(acc0, acc1);
+    const float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    return vget_lane_f32(vpadd_f32(half, half), 0);
+#else
+    float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+    for (int i = 0; i < count; i += 4) {
+        acc0 += a[i] * b[i];
+        acc1 += a[i + 1] * b[i + 1];
+        acc2 += a[i + 2] * b[i + 2];
+        acc3 += a[i + 3] * b[i + 3];
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+#endif
+}
+
+Resampler::Resampler(int inputRate, int outputRate) : m_inputRate(inputRate), m_outputRate(outputRate) {
+    const int divisor = std::gcd(inputRate, outputRate);
+    m_interpolation = outputRate / divisor;
+    m_decimation = inputRate / divisor;
+
+    // Kaiser estimate for the transition band, measured at the input rate
+    const double lowerRate = std::min(inputRate, outputRate);
+    const double transition = (STOPBAND_EDGE - PASSBAND_EDGE) * lowerRate / inputRate;
+    const double length = (STOPBAND_DB - 8.0) / (2.285 * 2.0 * PI * transition);
+    m_taps = std::max(4, (static_cast<int>(std::ceil(length)) + 3) & ~3);
+
+    designFilter();
+    m_window.assign(m_taps - 1 + MAX_BLOCK, 0.0f);
+}
+
+void Resampler::designFilter() {
+    // Prototype lowpass at the upsampled rate (input * L), cut off midway through the
+    // transition band of the lower rate
+    const int length = m_taps * m_interpolation;
+    const double upsampledRate = double(m_inputRate) * m_interpolation;
+    const double cutoff = (PASSBAND_EDGE + STOPBAND_EDGE) / 2.0 * std::min(m_inputRate, m_outputRate) / upsampledRate;
+    const double beta = 0.1102 * (STOPBAND_DB - 8.7);
+    const double center = (length - 1) / 2.0;
+    const double windowNorm = besselI0(beta);
+
+    std::vector<double> prototype(length);
+    double sum = 0.0;
+    for (int n = 0; n < length; n++) {
+        const double t = n - center;
+        const double sinc = (t == 0.0) ? 2.0 * cutoff : std::sin(2.0 * PI * cutoff * t) / (PI * t);
+        const double r = t / (center + 0.5);
+        const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / windowNorm;
+        prototype[n] = sinc * window;
+        sum += prototype[n];
+    }
+
+    // Unity gain: each of the L phases sums to ~1
+    const double gain = m_interpolation / sum;
+
+    m_coefficients.resize(length);
+    for (int phase = 0; phase < m_interpolation; phase++) {
+        float *coefficients = m_coefficients.data() + phase * m_taps;
+        for (int k = 0; k < m_taps; k++)
+            coefficients[m_taps - 1 - k] = static_cast<float>(prototype[phase + k * m_interpolation] * gain);
+    }
+}
+
+int Resampler::maxOutput(int inputCount) const {
+    return static_cast<int>((static_cast<long long>(inputCount) * m_interpolation) / m_decimation) + 2;
+}
+
+void Resampler::reset() {
+    std::fill(m_window.begin(), m_window.end(), 0.0f);
+    m_phase = 0;
+    m_position = 0;
+}
+
+int Resampler::process(const float *in, int count, float *out, int maxOut) {
+    const int history = m_taps - 1;
+    const int step = m_decimation / m_interpolation;
+    const int phaseStep = m_decimation % m_interpolation;
+    int written = 0;
+
+    while (count > 0) {
+        const int block = std::min(count, MAX_BLOCK);
+        std::copy_n(in, block, m_window.data() + history);
+
+        // Output at input position b uses window[b .. b + taps) = x[b - taps + 1 .. b].
+        // Outputs that don't fit in maxOut are dropped, keeping the phase consistent.
+        while (m_position < block) {
+            if (written < maxOut)
+                out[written++] = dot(m_coefficients.data() + m_phase * m_taps, m_window.data() + m_position, m_taps);
+            m_position += step;
+            m_phase += phaseStep;
+            if (m_phase >= m_interpolation) {
+                m_phase -= m_interpolation;
+                m_position++;
+            }
+        }
+
+        // Slide the newest samples down as history for the next block
+        std::copy(m_window.begin() + block, m_window.begin() + block + history, m_window.begin());
+        m_position -= block;
+        in += block;
+        count -= block;
+    }
+
+    return written;
+}
@@ -0,0 +1,65 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <vector>
+
+/**
+ * @brief Streaming polyphase FIR sample-rate converter (mono Float32)
+ *
+ * Converts between any two integer rates by the rational factor L/M (reduced by
+ * their GCD, e.g. 48000->12000 is 1/4 and 44100->12000 is 40/147). The anti-alias
+ * filter is a Kaiser-windowed sinc designed once at construction: flat to 40% of
+ * the lower rate, at least STOPBAND_DB down from its Nyquist frequency. It is split
+ * into L phases of equal length; each output sample is one SIMD dot product of a
+ * phase against the most recent input, so no zero-stuffed samples are computed.
+ *
+ * All buffers are allocated in the constructor; process() never allocates and can
+ * be fed blocks of any size. Not thread-safe: one instance per stream.
+ */
+class Resampler {
+public:
+    Resampler(int inputRate, int outputRate);
+
+    // Resample count input samples into out, returning the number written. Output
+    // beyond maxOut is discarded; size out with maxOutput(count) to avoid that.
+    int process(const float *in, int count, float *out, int maxOut);
+
+    // Upper bound on the samples process() can produce from inputCount samples
+    int maxOutput(int inputCount) const;
+
+    // Forget the filter history (e.g. when capture restarts)
+    void reset();
+
+    int inputRate() const { return m_inputRate; }
+    int outputRate() const { return m_outputRate; }
+    int interpolation() const { return m_interpolation; }
+    int decimation() const { return m_decimation; }
+    int tapsPerPhase() const { return m_taps; }
+
+    static constexpr double STOPBAND_DB = 80.0;
+
+private:
+    static constexpr double PASSBAND_EDGE = 0.40; // Fraction of the lower rate
+    static constexpr double STOPBAND_EDGE = 0.50;
+    static constexpr int MAX_BLOCK = 1024; // Input samples filtered per pass
+
+    void designFilter();
+
+    int m_inputRate;
+    int m_outputRate;
+    int m_interpolation; // L
+    int m_decimation;    // M
+    int m_taps;          // Per phase, multiple of 4 for the SIMD loop
+
+    // Phase p coefficients at [p * m_taps], time-reversed so each output is a
+    // forward dot product with the input window
+    std::vector<float> m_coefficients;
+
+    // m_taps - 1 samples of history followed by up to MAX_BLOCK new samples
+    std::vector<float> m_window;
+
+    int m_phase = 0;    // Current filter phase, 0..L-1
+    int m_position = 0; // Input index (relative to the current block) of the next output
+};
+
+#endif // RESAMPLER_H
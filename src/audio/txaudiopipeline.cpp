@@ -0,0 +1,51 @@
+#include "txaudiopipeline.h"
+#include <QtEndian>
+#include <cstring>
+
+TxAudioPipeline::TxAudioPipeline() {
+    // 12kHz mono, matching the microphone frames from AudioEngine
+    m_encoder.initialize(12000, 1);
+}
+
+int TxAudioPipeline::encodeFrame(const qint16 *samples, quint8 encodeMode) {
+    // The body follows a 15-byte header, so RAW samples are stored bytewise (unaligned)
+    char *body = m_packet.data() + Protocol::AUDIO_BODY_OFFSET;
+    int bodyBytes = 0;
+
+    switch (encodeMode) {
+    case 0: // EM0 - RAW 32-bit float stereo
+    {
+        // Mono S16LE to stereo float32 (K4 expects stereo: L=Main, R=Sub)
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            const float normalized = static_cast<float>(samples[i]) / 32768.0f;
+            const float stereo[2] = {normalized, normalized}; // Left, Right (duplicate)
+            std::memcpy(body + i * sizeof(stereo), stereo, sizeof(stereo));
+        }
+        bodyBytes = FRAME_SAMPLES * 2 * sizeof(float);
+        break;
+    }
+
+    case 1: // EM1 - RAW 16-bit S16LE stereo
+    {
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            qToLittleEndian<qint16>(samples[i], body + i * 4);     // Left channel
+            qToLittleEndian<qint16>(samples[i], body + i * 4 + 2); // Right channel (duplicate)
+        }
+        bodyBytes = FRAME_SAMPLES * 2 * sizeof(qint16);
+        break;
+    }
+
+    case 2: // EM2 - Opus Int
+    case 3: // EM3 - Opus Float
+    default:
+        bodyBytes = m_encoder.encode(samples, body, MAX_BODY_BYTES);
+        break;
+    }
+
+    if (bodyBytes <= 0) {
+        return 0;
+    }
+
+    Protocol::writeAudioHeader(m_packet.data(), m_sequence++, encodeMode);
+    return Protocol::finishPacket(m_packet.data(), K4Protocol::AudioPacket::HEADER_SIZE + bodyBytes);
+}
@@ -0,0 +1,41 @@
+#ifndef TXAUDIOPIPELINE_H
+#define TXAUDIOPIPELINE_H
+
+#include <QtGlobal>
+#include <array>
+#include "opusencoder.h"
+#include "../network/protocol.h"
+
+/**
+ * @brief TX audio stage: one 20ms microphone frame in, one framed K4 audio packet out
+ *
+ * Runs on the network thread (owned by NetworkWorker), fed with frames that
+ * AudioEngine captures on its audio thread. The packet buffer is preallocated with
+ * the framing and audio header reserved at the front, so Opus (EM2/EM3) encodes and
+ * RAW (EM0/EM1) converts straight into the packet body, and the socket writes the
+ * finished packet from the same buffer. Nothing is allocated per frame.
+ */
+class TxAudioPipeline {
+public:
+    static constexpr int FRAME_SAMPLES = OpusEncoder::FRAME_SAMPLES; // 20ms mono S16 at 12kHz
+
+    TxAudioPipeline();
+
+    // New transmission (PTT press): the packet sequence restarts at 0
+    void reset() { m_sequence = 0; }
+
+    // Build the packet for one frame. Returns its size in bytes (0 if encoding failed);
+    // the packet stays in packetData() until the next call.
+    int encodeFrame(const qint16 *samples, quint8 encodeMode);
+    const char *packetData() const { return m_packet.data(); }
+
+private:
+    // Largest body is EM0: stereo Float32 (K4 expects L=Main, R=Sub)
+    static constexpr int MAX_BODY_BYTES = FRAME_SAMPLES * 2 * sizeof(float);
+
+    OpusEncoder m_encoder;
+    std::array<char, Protocol::AUDIO_BODY_OFFSET + MAX_BODY_BYTES + 4> m_packet;
+    quint8 m_sequence = 0;
+};
+
+#endif // TXAUDIOPIPELINE_H
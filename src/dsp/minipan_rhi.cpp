@@ -1,5 +1,6 @@
 #include "minipan_rhi.h"
-#include "rhi_utils.h"
+#include "renderscheduler.h"
+#include "rhiresourcecache.h"
 #include "ui/k4styles.h"
 #include <QFile>
 #include <QMouseEvent>
@@ -17,9 +18,6 @@ MiniPanRhiWidget::MiniPanRhiWidget(QWidget *parent) : QRhiWidget(parent) {
     setApi(QRhiWidget::Api::Metal);
 #endif
 
-    // Initialize color LUT
-    initColorLUT();
-
     // Allocate waterfall data buffer
     m_waterfallData.resize(TEXTURE_WIDTH * WATERFALL_HISTORY);
     m_waterfallData.fill(0);
@@ -32,9 +30,9 @@ MiniPanRhiWidget::~MiniPanRhiWidget() {
     // QRhi resources are automatically cleaned up
 }
 
-void MiniPanRhiWidget::initColorLUT() {
+static QVector<quint8> waterfallColorLut() {
     // Create 256-entry RGBA color LUT for waterfall
-    m_colorLUT.resize(256 * 4);
+    QVector<quint8> lut(256 * 4);
 
     for (int i = 0; i < 256; ++i) {
         float t = i / 255.0f;
@@ -72,11 +70,12 @@ void MiniPanRhiWidget::initColorLUT() {
             b = static_cast<int>(255 * s);
         }
 
-        m_colorLUT[i * 4 + 0] = static_cast<quint8>(qBound(0, r, 255));
-        m_colorLUT[i * 4 + 1] = static_cast<quint8>(qBound(0, g, 255));
-        m_colorLUT[i * 4 + 2] = static_cast<quint8>(qBound(0, b, 255));
-        m_colorLUT[i * 4 + 3] = 255;
+        lut[i * 4 + 0] = static_cast<quint8>(qBound(0, r, 255));
+        lut[i * 4 + 1] = static_cast<quint8>(qBound(0, g, 255));
+        lut[i * 4 + 2] = static_cast<quint8>(qBound(0, b, 255));
+        lut[i * 4 + 3] = 255;
     }
+    return lut;
 }
 
 void MiniPanRhiWidget::initialize(QRhiCommandBuffer *cb) {
@@ -89,37 +88,22 @@ void MiniPanRhiWidget::initialize(QRhiCommandBuffer *cb) {
         return;
     }
 
-    // Load shaders from compiled .qsb resources (shared with main panadapter)
-    m_spectrumVert = RhiUtils::loadShader(":/shaders/src/dsp/shaders/spectrum.vert.qsb");
-    m_spectrumFrag = RhiUtils::loadShader(":/shaders/src/dsp/shaders/spectrum.frag.qsb");
-    m_waterfallVert = RhiUtils::loadShader(":/shaders/src/dsp/shaders/waterfall.vert.qsb");
-    m_waterfallFrag = RhiUtils::loadShader(":/shaders/src/dsp/shaders/waterfall.frag.qsb");
-    m_overlayVert = RhiUtils::loadShader(":/shaders/src/dsp/shaders/overlay.vert.qsb");
-    m_overlayFrag = RhiUtils::loadShader(":/shaders/src/dsp/shaders/overlay.frag.qsb");
+    RhiResourceCache *cache = RhiResourceCache::instance();
+    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
 
     // Create waterfall texture (single channel for dB values)
     m_waterfallTexture.reset(m_rhi->newTexture(QRhiTexture::R8, QSize(TEXTURE_WIDTH, WATERFALL_HISTORY), 1,
                                                QRhiTexture::UsedAsTransferSource));
     m_waterfallTexture->create();
 
-    // Create color LUT texture (256x1 RGBA)
-    m_colorLutTexture.reset(m_rhi->newTexture(QRhiTexture::RGBA8, QSize(256, 1)));
-    m_colorLutTexture->create();
-
-    // Upload color LUT data
-    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
-    QRhiTextureSubresourceUploadDescription lutUpload(m_colorLUT.constData(), m_colorLUT.size());
-    rub->uploadTexture(m_colorLutTexture.get(), QRhiTextureUploadEntry(0, 0, lutUpload));
+    // Color LUT (256x1 RGBA) and sampler, shared with the other mini-pan on this QRhi
+    m_colorLutTexture = cache->lut(m_rhi, QStringLiteral("minipan.waterfall"), waterfallColorLut, rub);
+    m_sampler = cache->linearSampler(m_rhi);
 
     // Upload initial zeroed waterfall data (prevents uninitialized texture garbage)
     QRhiTextureSubresourceUploadDescription waterfallUpload(m_waterfallData.constData(), m_waterfallData.size());
     rub->uploadTexture(m_waterfallTexture.get(), QRhiTextureUploadEntry(0, 0, waterfallUpload));
 
-    // Create sampler
-    m_sampler.reset(m_rhi->newSampler(QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
-                                      QRhiSampler::ClampToEdge, QRhiSampler::Repeat));
-    m_sampler->create();
-
     // Create vertex buffers (dynamic)
     m_spectrumVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 2048 * 6 * sizeof(float)));
     m_spectrumVbo->create();
@@ -139,25 +123,6 @@ void MiniPanRhiWidget::initialize(QRhiCommandBuffer *cb) {
     m_waterfallVbo->create();
     rub->uploadStaticBuffer(m_waterfallVbo.get(), waterfallQuad);
 
-    m_overlayVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 1024 * 2 * sizeof(float)));
-    m_overlayVbo->create();
-
-    // Dedicated passband buffers (QRhi requires separate buffers to avoid GPU conflicts)
-    m_passbandVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 256 * sizeof(float)));
-    m_passbandVbo->create();
-
-    // Dedicated passband edge buffers (12 vertices = 24 floats for 2 rectangles)
-    m_passbandEdgeVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 64 * sizeof(float)));
-    m_passbandEdgeVbo->create();
-
-    // Dedicated center line buffers
-    m_centerLineVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 64 * sizeof(float)));
-    m_centerLineVbo->create();
-
-    // Dedicated notch filter buffers
-    m_notchVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 64 * sizeof(float)));
-    m_notchVbo->create();
-
     // Create uniform buffers
     m_spectrumUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 16));
     m_spectrumUniformBuffer->create();
@@ -165,25 +130,6 @@ void MiniPanRhiWidget::initialize(QRhiCommandBuffer *cb) {
     m_waterfallUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 16));
     m_waterfallUniformBuffer->create();
 
-    m_overlayUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_overlayUniformBuffer->create();
-
-    // Dedicated passband uniform buffer
-    m_passbandUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_passbandUniformBuffer->create();
-
-    // Dedicated passband edge uniform buffer
-    m_passbandEdgeUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_passbandEdgeUniformBuffer->create();
-
-    // Dedicated center line uniform buffer
-    m_centerLineUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_centerLineUniformBuffer->create();
-
-    // Dedicated notch filter uniform buffer
-    m_notchUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_notchUniformBuffer->create();
-
     cb->resourceUpdate(rub);
 
     m_rhiInitialized = true;
@@ -193,148 +139,81 @@ void MiniPanRhiWidget::createPipelines() {
     if (m_pipelinesCreated)
         return;
 
-    if (!m_spectrumVert.isValid() || !m_spectrumFrag.isValid())
+    RhiResourceCache *cache = RhiResourceCache::instance();
+    const QShader spectrumVert = cache->shader(QStringLiteral("spectrum.vert"));
+    const QShader spectrumFrag = cache->shader(QStringLiteral("spectrum.frag"));
+    const QShader waterfallVert = cache->shader(QStringLiteral("waterfall.vert"));
+    const QShader waterfallFrag = cache->shader(QStringLiteral("waterfall.frag"));
+    if (!spectrumVert.isValid() || !spectrumFrag.isValid())
         return;
 
     m_rpDesc = renderTarget()->renderPassDescriptor();
 
     // Spectrum pipeline (triangle strip with per-vertex color)
-    {
-        m_spectrumSrb.reset(m_rhi->newShaderResourceBindings());
-        m_spectrumSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::VertexStage,
-                                                                             m_spectrumUniformBuffer.get())});
-        m_spectrumSrb->create();
-
-        m_spectrumPipeline.reset(m_rhi->newGraphicsPipeline());
-        m_spectrumPipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_spectrumVert}, {QRhiShaderStage::Fragment, m_spectrumFrag}});
-
-        QRhiVertexInputLayout inputLayout;
-        inputLayout.setBindings({{6 * sizeof(float)}});                         // position(2) + color(4)
-        inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
-                                   {0, 1, QRhiVertexInputAttribute::Float4, 2 * sizeof(float)}}); // color
-        m_spectrumPipeline->setVertexInputLayout(inputLayout);
-        m_spectrumPipeline->setTopology(QRhiGraphicsPipeline::TriangleStrip);
-        m_spectrumPipeline->setShaderResourceBindings(m_spectrumSrb.get());
-        m_spectrumPipeline->setRenderPassDescriptor(m_rpDesc);
-
-        QRhiGraphicsPipeline::TargetBlend blend;
-        blend.enable = true;
-        blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
-        blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
-        m_spectrumPipeline->setTargetBlends({blend});
-
-        m_spectrumPipeline->create();
-    }
+    m_spectrumSrb.reset(m_rhi->newShaderResourceBindings());
+    m_spectrumSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::VertexStage,
+                                                                         m_spectrumUniformBuffer.get())});
+    m_spectrumSrb->create();
+
+    m_spectrumPipeline =
+        cache->pipeline(m_rhi, QStringLiteral("minipan.spectrum"), m_rpDesc, [&](QRhiGraphicsPipeline *pipeline) {
+            pipeline->setShaderStages(
+                {{QRhiShaderStage::Vertex, spectrumVert}, {QRhiShaderStage::Fragment, spectrumFrag}});
+
+            QRhiVertexInputLayout inputLayout;
+            inputLayout.setBindings({{6 * sizeof(float)}});                         // position(2) + color(4)
+            inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
+                                       {0, 1, QRhiVertexInputAttribute::Float4, 2 * sizeof(float)}}); // color
+            pipeline->setVertexInputLayout(inputLayout);
+            pipeline->setTopology(QRhiGraphicsPipeline::TriangleStrip);
+            pipeline->setShaderResourceBindings(m_spectrumSrb.get());
+
+            QRhiGraphicsPipeline::TargetBlend blend;
+            blend.enable = true;
+            blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
+            blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
+            pipeline->setTargetBlends({blend});
+        });
 
     // Waterfall pipeline
-    {
-        m_waterfallSrb.reset(m_rhi->newShaderResourceBindings());
-        m_waterfallSrb->setBindings(
-            {QRhiShaderResourceBinding::uniformBuffer(
-                 0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-                 m_waterfallUniformBuffer.get()),
-             QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
-                                                       m_waterfallTexture.get(), m_sampler.get()),
-             QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
-                                                       m_colorLutTexture.get(), m_sampler.get())});
-        m_waterfallSrb->create();
-
-        m_waterfallPipeline.reset(m_rhi->newGraphicsPipeline());
-        m_waterfallPipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_waterfallVert}, {QRhiShaderStage::Fragment, m_waterfallFrag}});
-
-        QRhiVertexInputLayout inputLayout;
-        inputLayout.setBindings({{4 * sizeof(float)}});                         // position(2) + texcoord(2)
-        inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
-                                   {0, 1, QRhiVertexInputAttribute::Float2, 2 * sizeof(float)}}); // texcoord
-        m_waterfallPipeline->setVertexInputLayout(inputLayout);
-        m_waterfallPipeline->setTopology(QRhiGraphicsPipeline::Triangles);
-        m_waterfallPipeline->setShaderResourceBindings(m_waterfallSrb.get());
-        m_waterfallPipeline->setRenderPassDescriptor(m_rpDesc);
-        m_waterfallPipeline->create();
-    }
-
-    // Overlay pipeline (lines)
-    {
-        m_overlaySrb.reset(m_rhi->newShaderResourceBindings());
-        m_overlaySrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_overlayUniformBuffer.get())});
-        m_overlaySrb->create();
-
-        m_overlayLinePipeline.reset(m_rhi->newGraphicsPipeline());
-        m_overlayLinePipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_overlayVert}, {QRhiShaderStage::Fragment, m_overlayFrag}});
-
-        QRhiVertexInputLayout inputLayout;
-        inputLayout.setBindings({{2 * sizeof(float)}});
-        inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}});
-        m_overlayLinePipeline->setVertexInputLayout(inputLayout);
-        m_overlayLinePipeline->setTopology(QRhiGraphicsPipeline::Lines);
-        m_overlayLinePipeline->setShaderResourceBindings(m_overlaySrb.get());
-        m_overlayLinePipeline->setRenderPassDescriptor(m_rpDesc);
-
-        QRhiGraphicsPipeline::TargetBlend blend;
-        blend.enable = true;
-        blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
-        blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
-        m_overlayLinePipeline->setTargetBlends({blend});
-
-        m_overlayLinePipeline->create();
-
-        // Triangle version for filled shapes
-        m_overlayTrianglePipeline.reset(m_rhi->newGraphicsPipeline());
-        m_overlayTrianglePipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_overlayVert}, {QRhiShaderStage::Fragment, m_overlayFrag}});
-        m_overlayTrianglePipeline->setVertexInputLayout(inputLayout);
-        m_overlayTrianglePipeline->setTopology(QRhiGraphicsPipeline::Triangles);
-        m_overlayTrianglePipeline->setShaderResourceBindings(m_overlaySrb.get());
-        m_overlayTrianglePipeline->setRenderPassDescriptor(m_rpDesc);
-        m_overlayTrianglePipeline->setTargetBlends({blend});
-        m_overlayTrianglePipeline->create();
-    }
-
-    // Dedicated passband SRB (to avoid GPU buffer conflicts)
-    {
-        m_passbandSrb.reset(m_rhi->newShaderResourceBindings());
-        m_passbandSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_passbandUniformBuffer.get())});
-        m_passbandSrb->create();
-    }
-
-    // Dedicated passband edge SRB
-    {
-        m_passbandEdgeSrb.reset(m_rhi->newShaderResourceBindings());
-        m_passbandEdgeSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_passbandEdgeUniformBuffer.get())});
-        m_passbandEdgeSrb->create();
-    }
-
-    // Dedicated center line SRB
-    {
-        m_centerLineSrb.reset(m_rhi->newShaderResourceBindings());
-        m_centerLineSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_centerLineUniformBuffer.get())});
-        m_centerLineSrb->create();
-    }
-
-    // Dedicated notch filter SRB
-    {
-        m_notchSrb.reset(m_rhi->newShaderResourceBindings());
-        m_notchSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_notchUniformBuffer.get())});
-        m_notchSrb->create();
-    }
+    m_waterfallSrb.reset(m_rhi->newShaderResourceBindings());
+    m_waterfallSrb->setBindings(
+        {QRhiShaderResourceBinding::uniformBuffer(
+             0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
+             m_waterfallUniformBuffer.get()),
+         QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_waterfallTexture.get(), m_sampler),
+         QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage, m_colorLutTexture,
+                                                   m_sampler)});
+    m_waterfallSrb->create();
+
+    m_waterfallPipeline =
+        cache->pipeline(m_rhi, QStringLiteral("minipan.waterfall"), m_rpDesc, [&](QRhiGraphicsPipeline *pipeline) {
+            pipeline->setShaderStages(
+                {{QRhiShaderStage::Vertex, waterfallVert}, {QRhiShaderStage::Fragment, waterfallFrag}});
+
+            QRhiVertexInputLayout inputLayout;
+            inputLayout.setBindings({{4 * sizeof(float)}});                         // position(2) + texcoord(2)
+            inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
+                                       {0, 1, QRhiVertexInputAttribute::Float2, 2 * sizeof(float)}}); // texcoord
+            pipeline->setVertexInputLayout(inputLayout);
+            pipeline->setTopology(QRhiGraphicsPipeline::Triangles);
+            pipeline->setShaderResourceBindings(m_waterfallSrb.get());
+        });
+
+    // Overlay batch (passband, markers, separator, border)
+    m_overlayBatch.create(m_rhi, m_rpDesc);
 
     m_pipelinesCreated = true;
 }
 
+void MiniPanRhiWidget::scheduleFrame() {
+    RenderScheduler::instance()->requestFrame(this);
+}
+
 void MiniPanRhiWidget::render(QRhiCommandBuffer *cb) {
+    RenderScheduler::instance()->frameRendered(this);
+
     // Always clear to black even if not initialized (prevents white/garbage showing)
     if (!m_rhiInitialized) {
         cb->beginPass(renderTarget(), Qt::black, {1.0f, 0}, nullptr);
@@ -494,6 +373,11 @@ void MiniPanRhiWidget::render(QRhiCommandBuffer *cb) {
         }
     }
 
+    // Passband, markers, separator and border: one vertex upload for the frame
+    m_overlayBatch.begin(w, h);
+    buildOverlayGeometry(w, h, spectrumHeight);
+    m_overlayBatch.upload(rub);
+
     cb->resourceUpdate(rub);
 
     // Begin render pass
@@ -502,7 +386,7 @@ void MiniPanRhiWidget::render(QRhiCommandBuffer *cb) {
     // Draw waterfall (bottom portion)
     if (m_waterfallPipeline) {
         cb->setViewport({0, 0, w, waterfallHeight});
-        cb->setGraphicsPipeline(m_waterfallPipeline.get());
+        cb->setGraphicsPipeline(m_waterfallPipeline);
         cb->setShaderResources(m_waterfallSrb.get());
         const QRhiCommandBuffer::VertexInput waterfallVbufBinding(m_waterfallVbo.get(), 0);
         cb->setVertexInput(0, 1, &waterfallVbufBinding);
@@ -512,293 +396,114 @@ void MiniPanRhiWidget::render(QRhiCommandBuffer *cb) {
     // Draw spectrum fill (top portion)
     if (m_spectrumPipeline && !m_smoothedSpectrum.isEmpty()) {
         cb->setViewport({0, waterfallHeight, w, spectrumHeight});
-        cb->setGraphicsPipeline(m_spectrumPipeline.get());
+        cb->setGraphicsPipeline(m_spectrumPipeline);
         cb->setShaderResources(m_spectrumSrb.get());
         const QRhiCommandBuffer::VertexInput spectrumVbufBinding(m_spectrumVbo.get(), 0);
         cb->setVertexInput(0, 1, &spectrumVbufBinding);
         cb->draw(static_cast<int>(w) * 2);
     }
 
-    // Draw overlays (full viewport)
+    // Draw overlays (full viewport): filled shapes, then separator and border lines
     cb->setViewport({0, 0, w, h});
+    m_overlayBatch.drawTriangles(cb);
+    m_overlayBatch.drawLines(cb);
 
-    // Draw separator line, passband, center marker, notch, and border using overlay pipeline
-    if (m_overlayLinePipeline && m_overlayTrianglePipeline) {
-        // Helper lambda to draw filled quad
-        auto drawFilledQuad = [&](float x1, float y1, float x2, float y2, const QColor &color) {
-            QVector<float> quadVerts = {x1, y1, x2, y1, x2, y2, x1, y1, x2, y2, x1, y2};
-
-            QRhiResourceUpdateBatch *rub2 = m_rhi->nextResourceUpdateBatch();
-            rub2->updateDynamicBuffer(m_overlayVbo.get(), 0, quadVerts.size() * sizeof(float), quadVerts.constData());
-
-            struct {
-                float viewportWidth;
-                float viewportHeight;
-                float pad0, pad1; // std140: padding BEFORE color
-                float r, g, b, a;
-            } overlayUniforms = {w,
-                                 h,
-                                 0,
-                                 0,
-                                 static_cast<float>(color.redF()),
-                                 static_cast<float>(color.greenF()),
-                                 static_cast<float>(color.blueF()),
-                                 static_cast<float>(color.alphaF())};
-            rub2->updateDynamicBuffer(m_overlayUniformBuffer.get(), 0, sizeof(overlayUniforms), &overlayUniforms);
-
-            cb->resourceUpdate(rub2);
-            cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-            cb->setShaderResources(m_overlaySrb.get());
-            const QRhiCommandBuffer::VertexInput overlayVbufBinding(m_overlayVbo.get(), 0);
-            cb->setVertexInput(0, 1, &overlayVbufBinding);
-            cb->draw(6);
-        };
-
-        // Helper lambda to draw lines
-        auto drawLines = [&](const QVector<float> &lineVerts, const QColor &color) {
-            QRhiResourceUpdateBatch *rub2 = m_rhi->nextResourceUpdateBatch();
-            rub2->updateDynamicBuffer(m_overlayVbo.get(), 0, lineVerts.size() * sizeof(float), lineVerts.constData());
-
-            struct {
-                float viewportWidth;
-                float viewportHeight;
-                float pad0, pad1; // std140: padding BEFORE color
-                float r, g, b, a;
-            } overlayUniforms = {w,
-                                 h,
-                                 0,
-                                 0,
-                                 static_cast<float>(color.redF()),
-                                 static_cast<float>(color.greenF()),
-                                 static_cast<float>(color.blueF()),
-                                 static_cast<float>(color.alphaF())};
-            rub2->updateDynamicBuffer(m_overlayUniformBuffer.get(), 0, sizeof(overlayUniforms), &overlayUniforms);
-
-            cb->resourceUpdate(rub2);
-            cb->setGraphicsPipeline(m_overlayLinePipeline.get());
-            cb->setShaderResources(m_overlaySrb.get());
-            const QRhiCommandBuffer::VertexInput overlayVbufBinding(m_overlayVbo.get(), 0);
-            cb->setVertexInput(0, 1, &overlayVbufBinding);
-            cb->draw(lineVerts.size() / 2);
-        };
-
-        // Draw filter passband using DEDICATED buffers (full height)
-        float centerX = w / 2;
-        if (m_filterBw > 0 && m_passbandSrb) {
-            float bwPixels = (static_cast<float>(m_filterBw) * w) / m_bandwidthHz;
-
-            // K4 IF shift: value in 10 Hz units (m_ifShift=140 → 1400 Hz → displayed as 1.40 kHz)
-            float shiftHz = m_ifShift * 10.0f;
-            float shiftPixels = (shiftHz * w) / m_bandwidthHz;
-
-            float passbandX;
-            if (m_mode == "CW" || m_mode == "CW-R") {
-                // CW: passband position relative to CW pitch
-                // When shift == pitch, passband is centered on center line
-                // When shift differs from pitch, passband moves accordingly
-                float offsetHz = shiftHz - m_cwPitch;
-                float offsetPixels = (offsetHz * w) / m_bandwidthHz;
-
-                if (m_mode == "CW") {
-                    // CW: positive offset moves passband right (higher freq)
-                    passbandX = centerX + offsetPixels - bwPixels / 2;
-                } else {
-                    // CW-R: positive offset moves passband left (lower freq)
-                    passbandX = centerX - offsetPixels - bwPixels / 2;
-                }
-            } else if (m_mode == "LSB") {
-                // LSB: passband center is shiftHz below carrier
-                // Passband left edge = center - shiftPixels - bwPixels/2
-                // Passband right edge = center - shiftPixels + bwPixels/2
-                // With shift=BW/2, right edge touches center line
-                passbandX = centerX - shiftPixels - bwPixels / 2;
-            } else {
-                // USB/DATA: passband center is shiftHz above carrier
-                // Passband left edge = center + shiftPixels - bwPixels/2
-                // With shift=BW/2, left edge touches center line
-                passbandX = centerX + shiftPixels - bwPixels / 2;
-            }
+    cb->endPass();
+}
 
-            // Draw passband quad using DEDICATED passband buffers
-            QColor fillColor = m_passbandColor;
-            fillColor.setAlpha(100);
-
-            // Build passband quad vertices (two triangles) - full height
-            QVector<float> pbQuadVerts = {
-                passbandX, 0, passbandX + bwPixels, 0, passbandX + bwPixels, h, passbandX, 0, passbandX + bwPixels, h,
-                passbandX, h};
-
-            QRhiResourceUpdateBatch *pbRub = m_rhi->nextResourceUpdateBatch();
-            pbRub->updateDynamicBuffer(m_passbandVbo.get(), 0, pbQuadVerts.size() * sizeof(float),
-                                       pbQuadVerts.constData());
-
-            struct {
-                float viewportWidth;
-                float viewportHeight;
-                float pad0, pad1; // std140: padding BEFORE color
-                float r, g, b, a;
-            } pbUniforms = {w,
-                            h,
-                            0,
-                            0,
-                            static_cast<float>(fillColor.redF()),
-                            static_cast<float>(fillColor.greenF()),
-                            static_cast<float>(fillColor.blueF()),
-                            static_cast<float>(fillColor.alphaF())};
-            pbRub->updateDynamicBuffer(m_passbandUniformBuffer.get(), 0, sizeof(pbUniforms), &pbUniforms);
-
-            cb->resourceUpdate(pbRub);
-            cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-            cb->setShaderResources(m_passbandSrb.get());
-            const QRhiCommandBuffer::VertexInput pbVbufBinding(m_passbandVbo.get(), 0);
-            cb->setVertexInput(0, 1, &pbVbufBinding);
-            cb->draw(6);
-
-            // Draw passband edge rectangles using DEDICATED buffers (2px wide for robust Metal rendering)
-            if (m_passbandEdgeSrb) {
-                QColor edgeColor = m_passbandColor;
-                edgeColor.setAlpha(180);
-                float edgeWidth = 2.0f;
-                // Left edge rectangle + right edge rectangle = 4 triangles = 12 vertices
-                QVector<float> passbandEdges = {// Left edge (2 triangles)
-                                                passbandX, 0, passbandX + edgeWidth, 0, passbandX + edgeWidth, h,
-                                                passbandX, 0, passbandX + edgeWidth, h, passbandX, h,
-                                                // Right edge (2 triangles)
-                                                passbandX + bwPixels, 0, passbandX + bwPixels + edgeWidth, 0,
-                                                passbandX + bwPixels + edgeWidth, h, passbandX + bwPixels, 0,
-                                                passbandX + bwPixels + edgeWidth, h, passbandX + bwPixels, h};
-
-                QRhiResourceUpdateBatch *edgeRub = m_rhi->nextResourceUpdateBatch();
-                edgeRub->updateDynamicBuffer(m_passbandEdgeVbo.get(), 0, passbandEdges.size() * sizeof(float),
-                                             passbandEdges.constData());
-
-                struct {
-                    float viewportWidth;
-                    float viewportHeight;
-                    float pad0, pad1;
-                    float r, g, b, a;
-                } edgeUniforms = {w,
-                                  h,
-                                  0,
-                                  0,
-                                  static_cast<float>(edgeColor.redF()),
-                                  static_cast<float>(edgeColor.greenF()),
-                                  static_cast<float>(edgeColor.blueF()),
-                                  static_cast<float>(edgeColor.alphaF())};
-                edgeRub->updateDynamicBuffer(m_passbandEdgeUniformBuffer.get(), 0, sizeof(edgeUniforms), &edgeUniforms);
-
-                cb->resourceUpdate(edgeRub);
-                cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-                cb->setShaderResources(m_passbandEdgeSrb.get());
-                const QRhiCommandBuffer::VertexInput edgeVbufBinding(m_passbandEdgeVbo.get(), 0);
-                cb->setVertexInput(0, 1, &edgeVbufBinding);
-                cb->draw(12);
+void MiniPanRhiWidget::buildOverlayGeometry(float w, float h, float spectrumHeight) {
+    // Filter passband (full height)
+    float centerX = w / 2;
+    if (m_filterBw > 0) {
+        float bwPixels = (static_cast<float>(m_filterBw) * w) / m_bandwidthHz;
+
+        // K4 IF shift: value in 10 Hz units (m_ifShift=140 → 1400 Hz → displayed as 1.40 kHz)
+        float shiftHz = m_ifShift * 10.0f;
+        float shiftPixels = (shiftHz * w) / m_bandwidthHz;
+
+        float passbandX;
+        if (m_mode == "CW" || m_mode == "CW-R") {
+            // CW: passband position relative to CW pitch
+            // When shift == pitch, passband is centered on center line
+            // When shift differs from pitch, passband moves accordingly
+            float offsetHz = shiftHz - m_cwPitch;
+            float offsetPixels = (offsetHz * w) / m_bandwidthHz;
+
+            if (m_mode == "CW") {
+                // CW: positive offset moves passband right (higher freq)
+                passbandX = centerX + offsetPixels - bwPixels / 2;
+            } else {
+                // CW-R: positive offset moves passband left (lower freq)
+                passbandX = centerX - offsetPixels - bwPixels / 2;
             }
+        } else if (m_mode == "LSB") {
+            // LSB: passband center is shiftHz below carrier
+            // Passband left edge = center - shiftPixels - bwPixels/2
+            // Passband right edge = center - shiftPixels + bwPixels/2
+            // With shift=BW/2, right edge touches center line
+            passbandX = centerX - shiftPixels - bwPixels / 2;
+        } else {
+            // USB/DATA: passband center is shiftHz above carrier
+            // Passband left edge = center + shiftPixels - bwPixels/2
+            // With shift=BW/2, left edge touches center line
+            passbandX = centerX + shiftPixels - bwPixels / 2;
         }
 
-        // Draw frequency marker (center line) using DEDICATED buffers
-        if (m_centerLineSrb) {
-            // Draw as filled rectangle (2px wide) instead of line for robust Metal rendering
-            QColor markerColor(0, 200, 255); // Bright cyan
-            float markerWidth = 2.0f;
-            QVector<float> centerLineVerts = {
-                centerX, 0, centerX + markerWidth, 0, centerX + markerWidth, h, centerX, 0, centerX + markerWidth, h,
-                centerX, h};
-
-            QRhiResourceUpdateBatch *clRub = m_rhi->nextResourceUpdateBatch();
-            clRub->updateDynamicBuffer(m_centerLineVbo.get(), 0, centerLineVerts.size() * sizeof(float),
-                                       centerLineVerts.constData());
-
-            struct {
-                float viewportWidth;
-                float viewportHeight;
-                float pad0, pad1; // std140: padding BEFORE color
-                float r, g, b, a;
-            } clUniforms = {w,
-                            h,
-                            0,
-                            0,
-                            static_cast<float>(markerColor.redF()),
-                            static_cast<float>(markerColor.greenF()),
-                            static_cast<float>(markerColor.blueF()),
-                            static_cast<float>(markerColor.alphaF())};
-            clRub->updateDynamicBuffer(m_centerLineUniformBuffer.get(), 0, sizeof(clUniforms), &clUniforms);
-
-            cb->resourceUpdate(clRub);
-            cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-            cb->setShaderResources(m_centerLineSrb.get());
-            const QRhiCommandBuffer::VertexInput clVbufBinding(m_centerLineVbo.get(), 0);
-            cb->setVertexInput(0, 1, &clVbufBinding);
-            cb->draw(6);
-        }
+        QColor fillColor = m_passbandColor;
+        fillColor.setAlpha(100);
+        m_overlayBatch.addRect(passbandX, 0.0f, passbandX + bwPixels, h, fillColor);
 
-        // Draw notch filter marker using DEDICATED buffers
-        // Notch position relative to passband center (consistent with main panadapter)
-        if (m_notchEnabled && m_notchPitchHz > 0 && m_notchSrb && m_bandwidthHz > 0) {
-            int offsetHz;
-            if (m_mode == "LSB") {
-                // LSB: notch is below carrier (left of center)
-                offsetHz = -m_notchPitchHz;
-            } else if (m_mode == "CW") {
-                // CW: notch offset from passband center (which is at cwPitch)
-                offsetHz = m_notchPitchHz - m_cwPitch;
-            } else if (m_mode == "CW-R") {
-                // CW-R: inverted CW
-                offsetHz = -(m_notchPitchHz - m_cwPitch);
-            } else {
-                // USB, DATA, DATA-R, AM, FM: notch is above carrier
-                offsetHz = m_notchPitchHz;
-            }
+        // Passband edges as 2px rectangles (robust on Metal, unlike lines)
+        QColor edgeColor = m_passbandColor;
+        edgeColor.setAlpha(180);
+        float edgeWidth = 2.0f;
+        m_overlayBatch.addRect(passbandX, 0.0f, passbandX + edgeWidth, h, edgeColor);
+        m_overlayBatch.addRect(passbandX + bwPixels, 0.0f, passbandX + bwPixels + edgeWidth, h, edgeColor);
+    }
 
-            float notchX = centerX + (static_cast<float>(offsetHz) * w) / m_bandwidthHz;
-            bool inBounds = (notchX >= 0 && notchX < w);
-
-            if (inBounds) {
-                // Draw as filled rectangle (2px wide) instead of line for robust rendering
-                QColor notchColor(255, 0, 0); // Red
-                float notchWidth = 2.0f;
-                QVector<float> notchVerts = {
-                    notchX, 0, notchX + notchWidth, 0, notchX + notchWidth, h, notchX, 0, notchX + notchWidth, h,
-                    notchX, h};
-
-                QRhiResourceUpdateBatch *notchRub = m_rhi->nextResourceUpdateBatch();
-                notchRub->updateDynamicBuffer(m_notchVbo.get(), 0, notchVerts.size() * sizeof(float),
-                                              notchVerts.constData());
-
-                struct {
-                    float viewportWidth;
-                    float viewportHeight;
-                    float pad0, pad1; // std140: padding BEFORE color
-                    float r, g, b, a;
-                } notchUniforms = {w,
-                                   h,
-                                   0,
-                                   0,
-                                   static_cast<float>(notchColor.redF()),
-                                   static_cast<float>(notchColor.greenF()),
-                                   static_cast<float>(notchColor.blueF()),
-                                   static_cast<float>(notchColor.alphaF())};
-                notchRub->updateDynamicBuffer(m_notchUniformBuffer.get(), 0, sizeof(notchUniforms), &notchUniforms);
-
-                cb->resourceUpdate(notchRub);
-                cb->setGraphicsPipeline(m_overlayTrianglePipeline.get()); // Use triangles not lines
-                cb->setShaderResources(m_notchSrb.get());
-                const QRhiCommandBuffer::VertexInput notchVbufBinding(m_notchVbo.get(), 0);
-                cb->setVertexInput(0, 1, &notchVbufBinding);
-                cb->draw(6); // 2 triangles = 6 vertices
-            }
+    // Frequency marker (center line), as a filled rectangle (2px wide) for robust Metal rendering
+    QColor markerColor(0, 200, 255); // Bright cyan
+    float markerWidth = 2.0f;
+    m_overlayBatch.addRect(centerX, 0.0f, centerX + markerWidth, h, markerColor);
+
+    // Notch filter marker
+    // Notch position relative to passband center (consistent with main panadapter)
+    if (m_notchEnabled && m_notchPitchHz > 0 && m_bandwidthHz > 0) {
+        int offsetHz;
+        if (m_mode == "LSB") {
+            // LSB: notch is below carrier (left of center)
+            offsetHz = -m_notchPitchHz;
+        } else if (m_mode == "CW") {
+            // CW: notch offset from passband center (which is at cwPitch)
+            offsetHz = m_notchPitchHz - m_cwPitch;
+        } else if (m_mode == "CW-R") {
+            // CW-R: inverted CW
+            offsetHz = -(m_notchPitchHz - m_cwPitch);
+        } else {
+            // USB, DATA, DATA-R, AM, FM: notch is above carrier
+            offsetHz = m_notchPitchHz;
         }
 
-        // Draw separator line
-        QVector<float> separatorLine = {0, spectrumHeight, w, spectrumHeight};
-        drawLines(separatorLine, QColor(51, 51, 51)); // #333333
+        float notchX = centerX + (static_cast<float>(offsetHz) * w) / m_bandwidthHz;
+        bool inBounds = (notchX >= 0 && notchX < w);
 
-        // Draw border
-        QVector<float> border = {0, 0, w - 1, 0, w - 1, 0, w - 1, h - 1, w - 1, h - 1, 0, h - 1, 0, h - 1, 0, 0};
-        drawLines(border, QColor(68, 68, 68)); // #444444
+        if (inBounds) {
+            // Draw as filled rectangle (2px wide) instead of line for robust rendering
+            QColor notchColor(255, 0, 0); // Red
+            float notchWidth = 2.0f;
+            m_overlayBatch.addRect(notchX, 0.0f, notchX + notchWidth, h, notchColor);
+        }
     }
 
-    cb->endPass();
+    // Separator line
+    m_overlayBatch.addLine(0, spectrumHeight, w, spectrumHeight, QColor(51, 51, 51)); // #333333
+
+    // Border
+    const QColor borderColor(68, 68, 68); // #444444
+    m_overlayBatch.addLine(0, 0, w - 1, 0, borderColor);
+    m_overlayBatch.addLine(w - 1, 0, w - 1, h - 1, borderColor);
+    m_overlayBatch.addLine(w - 1, h - 1, 0, h - 1, borderColor);
+    m_overlayBatch.addLine(0, h - 1, 0, 0, borderColor);
 }
 
 void MiniPanRhiWidget::updateSpectrum(const QByteArray &bins) {
@@ -824,11 +529,18 @@ void MiniPanRhiWidget::updateSpectrum(const QByteArray &bins) {
         m_spectrum = trimmed;
     }
 
-    // Use raw spectrum directly (no smoothing)
-    m_smoothedSpectrum = m_spectrum;
+    // Use raw spectrum directly (no smoothing). If the previous packet hasn't been drawn
+    // yet (both arrived within one scheduler tick), keep the per-bin maximum of the two so
+    // a short signal still reaches the waterfall row.
+    if (m_waterfallNeedsUpdate && m_smoothedSpectrum.size() == m_spectrum.size()) {
+        for (int i = 0; i < m_spectrum.size(); ++i)
+            m_smoothedSpectrum[i] = qMax(m_smoothedSpectrum[i], m_spectrum[i]);
+    } else {
+        m_smoothedSpectrum = m_spectrum;
+    }
 
     m_waterfallNeedsUpdate = true;
-    update();
+    scheduleFrame();
 }
 
 void MiniPanRhiWidget::clear() {
@@ -854,7 +566,7 @@ void MiniPanRhiWidget::clear() {
     if (m_rightFreqLabel)
         m_rightFreqLabel->setText("");
 
-    update();
+    scheduleFrame();
 }
 
 float MiniPanRhiWidget::normalizeDb(float db) {
@@ -871,14 +583,14 @@ int MiniPanRhiWidget::bandwidthForMode(const QString &mode) const {
 void MiniPanRhiWidget::setSpectrumColor(const QColor &color) {
     if (m_spectrumColor != color) {
         m_spectrumColor = color;
-        update();
+        scheduleFrame();
     }
 }
 
 void MiniPanRhiWidget::setPassbandColor(const QColor &color) {
     if (m_passbandColor != color) {
         m_passbandColor = color;
-        update();
+        scheduleFrame();
     }
 }
 
@@ -886,7 +598,7 @@ void MiniPanRhiWidget::setNotchFilter(bool enabled, int pitchHz) {
     if (m_notchEnabled != enabled || m_notchPitchHz != pitchHz) {
         m_notchEnabled = enabled;
         m_notchPitchHz = pitchHz;
-        update();
+        scheduleFrame();
     }
 }
 
@@ -895,28 +607,28 @@ void MiniPanRhiWidget::setMode(const QString &mode) {
         m_mode = mode;
         m_bandwidthHz = bandwidthForMode(mode);
         updateFrequencyLabels(); // Update corner labels for new bandwidth
-        update();
+        scheduleFrame();
     }
 }
 
 void MiniPanRhiWidget::setFilterBandwidth(int bwHz) {
     if (m_filterBw != bwHz) {
         m_filterBw = bwHz;
-        update();
+        scheduleFrame();
     }
 }
 
 void MiniPanRhiWidget::setIfShift(int shift) {
     if (m_ifShift != shift) {
         m_ifShift = shift;
-        update();
+        scheduleFrame();
     }
 }
 
 void MiniPanRhiWidget::setCwPitch(int pitchHz) {
     if (m_cwPitch != pitchHz) {
         m_cwPitch = pitchHz;
-        update();
+        scheduleFrame();
     }
 }
 
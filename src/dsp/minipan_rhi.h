@@ -8,6 +8,7 @@
 #include <QTimer>
 #include <QVector>
 #include <memory>
+#include "overlaybatch.h"
 
 // Compact Mini-Pan widget for VFO area using Qt RHI
 // GPU-accelerated via Metal (macOS), DirectX (Windows), Vulkan (Linux)
@@ -53,11 +54,14 @@ protected:
 
 private:
     // Initialization
-    void initColorLUT();
     void createPipelines();
     void createFrequencyLabels();
     void updateFrequencyLabels();
     void positionFrequencyLabels();
+    void buildOverlayGeometry(float w, float h, float spectrumHeight);
+
+    // Repaint on the next RenderScheduler tick (instead of update())
+    void scheduleFrame();
 
     // Data processing
     float normalizeDb(float db);
@@ -69,52 +73,19 @@ private:
     std::unique_ptr<QRhiBuffer> m_spectrumUniformBuffer;
     std::unique_ptr<QRhiBuffer> m_waterfallVbo;
     std::unique_ptr<QRhiBuffer> m_waterfallUniformBuffer;
-    std::unique_ptr<QRhiBuffer> m_overlayVbo;
-    std::unique_ptr<QRhiBuffer> m_overlayUniformBuffer;
     std::unique_ptr<QRhiTexture> m_waterfallTexture;
-    std::unique_ptr<QRhiTexture> m_colorLutTexture;
-    std::unique_ptr<QRhiSampler> m_sampler;
-    std::unique_ptr<QRhiGraphicsPipeline> m_spectrumPipeline;
-    std::unique_ptr<QRhiGraphicsPipeline> m_waterfallPipeline;
-    std::unique_ptr<QRhiGraphicsPipeline> m_overlayLinePipeline;
-    std::unique_ptr<QRhiGraphicsPipeline> m_overlayTrianglePipeline;
+    QRhiTexture *m_colorLutTexture = nullptr; // Shared, owned by RhiResourceCache
+    QRhiSampler *m_sampler = nullptr;
+    QRhiGraphicsPipeline *m_spectrumPipeline = nullptr;
+    QRhiGraphicsPipeline *m_waterfallPipeline = nullptr;
     std::unique_ptr<QRhiShaderResourceBindings> m_spectrumSrb;
     std::unique_ptr<QRhiShaderResourceBindings> m_waterfallSrb;
-    std::unique_ptr<QRhiShaderResourceBindings> m_overlaySrb;
-
-    // Dedicated passband buffers (QRhi requires separate buffers to avoid conflicts)
-    std::unique_ptr<QRhiBuffer> m_passbandVbo;
-    std::unique_ptr<QRhiBuffer> m_passbandUniformBuffer;
-    std::unique_ptr<QRhiShaderResourceBindings> m_passbandSrb;
-
-    // Dedicated passband edge buffers (separate from fill to avoid conflicts)
-    std::unique_ptr<QRhiBuffer> m_passbandEdgeVbo;
-    std::unique_ptr<QRhiBuffer> m_passbandEdgeUniformBuffer;
-    std::unique_ptr<QRhiShaderResourceBindings> m_passbandEdgeSrb;
-
-    // Dedicated center line buffers
-    std::unique_ptr<QRhiBuffer> m_centerLineVbo;
-    std::unique_ptr<QRhiBuffer> m_centerLineUniformBuffer;
-    std::unique_ptr<QRhiShaderResourceBindings> m_centerLineSrb;
-
-    // Dedicated notch filter buffers (QRhi requires separate buffers to avoid conflicts)
-    std::unique_ptr<QRhiBuffer> m_notchVbo;
-    std::unique_ptr<QRhiBuffer> m_notchUniformBuffer;
-    std::unique_ptr<QRhiShaderResourceBindings> m_notchSrb;
-
     QRhiRenderPassDescriptor *m_rpDesc = nullptr;
+    OverlayBatch m_overlayBatch;
 
     bool m_rhiInitialized = false;
     bool m_pipelinesCreated = false;
 
-    // Shader stages (loaded from .qsb files - shared with panadapter)
-    QShader m_spectrumVert;
-    QShader m_spectrumFrag;
-    QShader m_waterfallVert;
-    QShader m_waterfallFrag;
-    QShader m_overlayVert;
-    QShader m_overlayFrag;
-
     // Spectrum data
     QVector<float> m_spectrum;
     QVector<float> m_smoothedSpectrum;
@@ -127,9 +98,6 @@ private:
     bool m_waterfallNeedsUpdate = false;
     bool m_waterfallNeedsFullClear = false;
 
-    // Color LUT (256 RGBA entries)
-    QVector<quint8> m_colorLUT;
-
     // Display settings
     float m_minDb = -1.0f;
     float m_maxDb = 4.0f;
@@ -0,0 +1,45 @@
+#include "noisefloor.h"
+
+quint8 NoiseFloorEstimator::percentile(const quint8 *bins, int count, double fraction) {
+    if (count <= 0)
+        return 0;
+
+    // Four interleaved histograms: runs of equal bytes (a flat noise floor) don't serialize on
+    // one counter, so the loop keeps several increments in flight
+    quint32 counts[4][256] = {};
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        counts[0][bins[i]]++;
+        counts[1][bins[i + 1]]++;
+        counts[2][bins[i + 2]]++;
+        counts[3][bins[i + 3]]++;
+    }
+    for (; i < count; ++i)
+        counts[0][bins[i]]++;
+
+    // Walk up to the rank std::nth_element would use
+    const qint64 rank = qBound<qint64>(0, static_cast<qint64>(fraction * (count - 1)), count - 1);
+    qint64 seen = 0;
+    for (int value = 0; value < 256; ++value) {
+        seen += counts[0][value] + counts[1][value] + counts[2][value] + counts[3][value];
+        if (seen > rank)
+            return static_cast<quint8>(value);
+    }
+    return 255;
+}
+
+float NoiseFloorEstimator::update(const quint8 *bins, int count, float dbScale, float dbOffset) {
+    if (count <= 0)
+        return m_floorDb;
+
+    if (dbScale != m_dbScale || dbOffset != m_dbOffset) {
+        m_dbScale = dbScale;
+        m_dbOffset = dbOffset;
+        m_valid = false;
+    }
+
+    const float db = percentile(bins, count, m_percentile) * dbScale + dbOffset;
+    m_floorDb = m_valid ? m_floorDb + (db - m_floorDb) * m_smoothing : db;
+    m_valid = true;
+    return m_floorDb;
+}
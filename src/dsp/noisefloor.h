@@ -0,0 +1,42 @@
+#ifndef NOISEFLOOR_H
+#define NOISEFLOOR_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Robust noise floor of spectrum packets: a low percentile of the raw bins, smoothed over packets
+ *
+ * K4 bins are 8-bit, so the percentile comes from a 256-entry histogram built in one pass over the
+ * packet (O(bins), no sort or copy) and gives the same value as std::nth_element at that rank. Unlike
+ * the minimum, a few deep nulls or dropped bins can't drag it down, and carriers can't lift it unless
+ * they cover more than (1 - percentile) of the span. Runs once per packet on the GUI thread.
+ */
+class NoiseFloorEstimator {
+public:
+    static constexpr double DEFAULT_PERCENTILE = 0.1;
+    static constexpr float DEFAULT_SMOOTHING = 0.05f; // Weight of each new packet
+
+    explicit NoiseFloorEstimator(double percentile = DEFAULT_PERCENTILE, float smoothing = DEFAULT_SMOOTHING)
+        : m_percentile(percentile), m_smoothing(smoothing) {}
+
+    // Raw value at the given fraction of the sorted bins (0 = minimum, 0.5 = median, 1 = maximum)
+    static quint8 percentile(const quint8 *bins, int count, double fraction);
+
+    // Fold one packet in and return the smoothed floor in dB (raw * dbScale + dbOffset). The first
+    // packet after reset() (or a change of scale) sets the floor directly.
+    float update(const quint8 *bins, int count, float dbScale, float dbOffset);
+
+    float floorDb() const { return m_floorDb; }
+    bool isValid() const { return m_valid; }
+    void reset() { m_valid = false; }
+
+private:
+    double m_percentile;
+    float m_smoothing;
+    float m_floorDb = 0.0f;
+    float m_dbScale = 0.0f;
+    float m_dbOffset = 0.0f;
+    bool m_valid = false;
+};
+
+#endif // NOISEFLOOR_H
@@ -0,0 +1,118 @@
+#include "overlaybatch.h"
+#include "rhiresourcecache.h"
+
+bool OverlayBatch::create(QRhi *rhi, QRhiRenderPassDescriptor *rpDesc) {
+    // spectrum.vert/.frag: pixel position + per-vertex color, viewport size uniform
+    RhiResourceCache *cache = RhiResourceCache::instance();
+    const QShader vert = cache->shader(QStringLiteral("spectrum.vert"));
+    const QShader frag = cache->shader(QStringLiteral("spectrum.frag"));
+    if (!rhi || !vert.isValid() || !frag.isValid())
+        return false;
+
+    m_rhi = rhi;
+
+    m_vbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer,
+                                 INITIAL_VERTEX_CAPACITY * FLOATS_PER_VERTEX * sizeof(float)));
+    m_vbo->create();
+
+    m_uniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 16));
+    m_uniformBuffer->create();
+
+    m_srb.reset(m_rhi->newShaderResourceBindings());
+    m_srb->setBindings({QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::VertexStage,
+                                                                 m_uniformBuffer.get())});
+    m_srb->create();
+
+    QRhiVertexInputLayout inputLayout;
+    inputLayout.setBindings({{FLOATS_PER_VERTEX * sizeof(float)}});
+    inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0},                  // position
+                               {0, 1, QRhiVertexInputAttribute::Float4, 2 * sizeof(float)}}); // color
+
+    QRhiGraphicsPipeline::TargetBlend blend;
+    blend.enable = true;
+    blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
+    blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
+
+    // Every widget's overlay draws with the same two pipelines (per compatible render pass)
+    auto sharedPipeline = [&](const QString &name, QRhiGraphicsPipeline::Topology topology) {
+        return cache->pipeline(m_rhi, name, rpDesc, [&](QRhiGraphicsPipeline *pipeline) {
+            pipeline->setShaderStages({{QRhiShaderStage::Vertex, vert}, {QRhiShaderStage::Fragment, frag}});
+            pipeline->setVertexInputLayout(inputLayout);
+            pipeline->setTopology(topology);
+            pipeline->setShaderResourceBindings(m_srb.get());
+            pipeline->setTargetBlends({blend});
+        });
+    };
+    m_trianglePipeline = sharedPipeline(QStringLiteral("overlay.triangles"), QRhiGraphicsPipeline::Triangles);
+    m_linePipeline = sharedPipeline(QStringLiteral("overlay.lines"), QRhiGraphicsPipeline::Lines);
+
+    return m_trianglePipeline && m_linePipeline;
+}
+
+void OverlayBatch::begin(float viewportWidth, float viewportHeight) {
+    m_viewportWidth = viewportWidth;
+    m_viewportHeight = viewportHeight;
+    m_triangleVerts.clear();
+    m_lineVerts.clear();
+}
+
+void OverlayBatch::appendVertex(QVector<float> &out, float x, float y, const QColor &color) {
+    out << x << y << static_cast<float>(color.redF()) << static_cast<float>(color.greenF())
+        << static_cast<float>(color.blueF()) << static_cast<float>(color.alphaF());
+}
+
+void OverlayBatch::addLine(float x1, float y1, float x2, float y2, const QColor &color) {
+    appendVertex(m_lineVerts, x1, y1, color);
+    appendVertex(m_lineVerts, x2, y2, color);
+}
+
+void OverlayBatch::addRect(float x1, float y1, float x2, float y2, const QColor &color) {
+    appendVertex(m_triangleVerts, x1, y1, color);
+    appendVertex(m_triangleVerts, x2, y1, color);
+    appendVertex(m_triangleVerts, x2, y2, color);
+    appendVertex(m_triangleVerts, x1, y1, color);
+    appendVertex(m_triangleVerts, x2, y2, color);
+    appendVertex(m_triangleVerts, x1, y2, color);
+}
+
+void OverlayBatch::upload(QRhiResourceUpdateBatch *rub) {
+    if (!m_rhi)
+        return;
+
+    const quint32 triangleBytes = m_triangleVerts.size() * sizeof(float);
+    const quint32 lineBytes = m_lineVerts.size() * sizeof(float);
+
+    // Grow (never shrink) the buffer; Dynamic buffers are rewritten in place each frame
+    if (triangleBytes + lineBytes > m_vbo->size()) {
+        m_vbo->setSize(qMax(triangleBytes + lineBytes, m_vbo->size() * 2));
+        m_vbo->create();
+    }
+
+    if (triangleBytes > 0)
+        rub->updateDynamicBuffer(m_vbo.get(), 0, triangleBytes, m_triangleVerts.constData());
+    if (lineBytes > 0)
+        rub->updateDynamicBuffer(m_vbo.get(), triangleBytes, lineBytes, m_lineVerts.constData());
+
+    const float viewport[4] = {m_viewportWidth, m_viewportHeight, 0.0f, 0.0f};
+    rub->updateDynamicBuffer(m_uniformBuffer.get(), 0, sizeof(viewport), viewport);
+}
+
+void OverlayBatch::drawTriangles(QRhiCommandBuffer *cb) {
+    if (!m_trianglePipeline || m_triangleVerts.isEmpty())
+        return;
+    cb->setGraphicsPipeline(m_trianglePipeline);
+    cb->setShaderResources(m_srb.get());
+    const QRhiCommandBuffer::VertexInput vbufBinding(m_vbo.get(), 0);
+    cb->setVertexInput(0, 1, &vbufBinding);
+    cb->draw(m_triangleVerts.size() / FLOATS_PER_VERTEX);
+}
+
+void OverlayBatch::drawLines(QRhiCommandBuffer *cb) {
+    if (!m_linePipeline || m_lineVerts.isEmpty())
+        return;
+    cb->setGraphicsPipeline(m_linePipeline);
+    cb->setShaderResources(m_srb.get());
+    const QRhiCommandBuffer::VertexInput vbufBinding(m_vbo.get(), m_triangleVerts.size() * sizeof(float));
+    cb->setVertexInput(0, 1, &vbufBinding);
+    cb->draw(m_lineVerts.size() / FLOATS_PER_VERTEX);
+}
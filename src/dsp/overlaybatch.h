@@ -0,0 +1,53 @@
+#ifndef OVERLAYBATCH_H
+#define OVERLAYBATCH_H
+
+#include <rhi/qrhi.h>
+#include <QColor>
+#include <QVector>
+#include <memory>
+
+// Per-frame overlay geometry (grid, passbands, markers, borders) for the RHI spectrum widgets.
+// Lines and filled rectangles are collected with per-vertex color in pixel coordinates
+// (origin top-left), uploaded into one dynamic vertex buffer in a single update batch, and
+// drawn with one call per pipeline.
+//
+// Per frame: begin() -> addLine()/addRect() -> upload() -> drawTriangles()/drawLines()
+class OverlayBatch {
+public:
+    // Build the pipelines for the widget's render pass (from createPipelines())
+    bool create(QRhi *rhi, QRhiRenderPassDescriptor *rpDesc);
+    bool isCreated() const { return m_trianglePipeline && m_linePipeline; }
+
+    // Start a new frame; coordinates are pixels within a viewport of this size
+    void begin(float viewportWidth, float viewportHeight);
+    void addLine(float x1, float y1, float x2, float y2, const QColor &color);
+    void addRect(float x1, float y1, float x2, float y2, const QColor &color); // Two triangles
+
+    // Queue the frame's vertices and viewport uniform (before beginPass)
+    void upload(QRhiResourceUpdateBatch *rub);
+
+    // Inside the pass, with a viewport matching begin()
+    void drawTriangles(QRhiCommandBuffer *cb);
+    void drawLines(QRhiCommandBuffer *cb);
+
+private:
+    static constexpr int FLOATS_PER_VERTEX = 6; // position(2) + color(4), as spectrum.vert
+    static constexpr int INITIAL_VERTEX_CAPACITY = 256;
+
+    static void appendVertex(QVector<float> &out, float x, float y, const QColor &color);
+
+    QRhi *m_rhi = nullptr;
+    std::unique_ptr<QRhiBuffer> m_vbo; // Triangles first, then lines
+    std::unique_ptr<QRhiBuffer> m_uniformBuffer;
+    std::unique_ptr<QRhiShaderResourceBindings> m_srb;
+    QRhiGraphicsPipeline *m_trianglePipeline = nullptr; // Shared, owned by RhiResourceCache
+    QRhiGraphicsPipeline *m_linePipeline = nullptr;
+
+    // CPU staging, reused every frame (clear() keeps the capacity)
+    QVector<float> m_triangleVerts;
+    QVector<float> m_lineVerts;
+    float m_viewportWidth = 0.0f;
+    float m_viewportHeight = 0.0f;
+};
+
+#endif // OVERLAYBATCH_H
@@ -1,13 +1,15 @@
 #include "panadapter_rhi.h"
-#include "rhi_utils.h"
+#include "renderscheduler.h"
+#include "rhiresourcecache.h"
 #include "ui/k4styles.h"
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QtMath>
 #include <cmath>
-#include <cstring>
 
 // Transparent overlay widget for dBm/S-unit scale labels
 class DbmScaleOverlay : public QWidget {
@@ -243,33 +245,15 @@ PanadapterRhiWidget::PanadapterRhiWidget(QWidget *parent) : QRhiWidget(parent) {
     setApi(QRhiWidget::Api::Metal);
 #endif
 
-    // Initialize color LUTs
-    initColorLUT();    // Waterfall LUT
-    initSpectrumLUT(); // Spectrum LUT (for BlueAmplitude style)
-
-    // Note: Waterfall data buffer is allocated in initialize() after devicePixelRatio is known
-
-    // Peak hold decay timer
-    m_peakDecayTimer = new QTimer(this);
-    connect(m_peakDecayTimer, &QTimer::timeout, this, [this]() {
-        if (!m_peakHold.isEmpty()) {
-            for (int i = 0; i < m_peakHold.size(); ++i) {
-                m_peakHold[i] -= PEAK_DECAY_RATE;
-                if (m_peakHold[i] < m_currentSpectrum.value(i, m_minDb)) {
-                    m_peakHold[i] = m_currentSpectrum.value(i, m_minDb);
-                }
-            }
-            update();
-        }
-    });
-    m_peakDecayTimer->start(50);
+    // Note: GPU resources, including the shared color LUTs, are created on the first frame (initialize())
+    // Peak hold decays on the GPU with each packet (see processSpectrum)
 
     // Waterfall marker timer
     m_waterfallMarkerTimer = new QTimer(this);
     m_waterfallMarkerTimer->setSingleShot(true);
     connect(m_waterfallMarkerTimer, &QTimer::timeout, this, [this]() {
         m_showWaterfallMarker = false;
-        update();
+        scheduleFrame();
     });
 
     // Create dBm scale overlay (child widget)
@@ -281,6 +265,14 @@ PanadapterRhiWidget::PanadapterRhiWidget(QWidget *parent) : QRhiWidget(parent) {
     m_freqScaleOverlay = new FrequencyScaleOverlay(this);
     m_freqScaleOverlay->setFrequencyRange(m_centerFreq, m_spanHz, m_cwPitch, m_mode);
     m_freqScaleOverlay->show();
+
+    // Scrollback indicator (top-left of the waterfall, hidden while live)
+    m_historyLabel = new QLabel(this);
+    m_historyLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+    m_historyLabel->setStyleSheet(QString("QLabel { color: #CCCCCC; background-color: rgba(0, 0, 0, 160);"
+                                          " padding: 1px 4px; font-size: %1px; border-radius: 2px; }")
+                                      .arg(K4Styles::Dimensions::FontSizeNormal));
+    m_historyLabel->hide();
 }
 
 PanadapterRhiWidget::~PanadapterRhiWidget() {
@@ -291,6 +283,7 @@ void PanadapterRhiWidget::resizeEvent(QResizeEvent *event) {
     QRhiWidget::resizeEvent(event);
     updateDbmScaleOverlay();
     updateFreqScaleOverlay();
+    updateHistoryLabel();
 }
 
 void PanadapterRhiWidget::updateDbmScaleOverlay() {
@@ -325,10 +318,10 @@ void PanadapterRhiWidget::updateFreqScaleOverlay() {
     m_freqScaleOverlay->raise(); // Ensure it renders on top
 }
 
-void PanadapterRhiWidget::initColorLUT() {
+static QVector<quint8> waterfallColorLut() {
     // Create 256-entry RGBA color LUT for WATERFALL (unchanged)
     // 8-stage color progression: Black -> Dark Blue -> Royal Blue -> Cyan -> Green -> Yellow -> Red
-    m_colorLUT.resize(256 * 4);
+    QVector<quint8> lut(256 * 4);
 
     for (int i = 0; i < 256; ++i) {
         float value = i / 255.0f;
@@ -370,18 +363,19 @@ void PanadapterRhiWidget::initColorLUT() {
             b = 0;
         }
 
-        m_colorLUT[i * 4 + 0] = static_cast<quint8>(qBound(0, r, 255));
-        m_colorLUT[i * 4 + 1] = static_cast<quint8>(qBound(0, g, 255));
-        m_colorLUT[i * 4 + 2] = static_cast<quint8>(qBound(0, b, 255));
-        m_colorLUT[i * 4 + 3] = 255;
+        lut[i * 4 + 0] = static_cast<quint8>(qBound(0, r, 255));
+        lut[i * 4 + 1] = static_cast<quint8>(qBound(0, g, 255));
+        lut[i * 4 + 2] = static_cast<quint8>(qBound(0, b, 255));
+        lut[i * 4 + 3] = 255;
     }
+    return lut;
 }
 
-void PanadapterRhiWidget::initSpectrumLUT() {
+static QVector<quint8> spectrumColorLut() {
     // Create 256-entry RGBA color LUT for SPECTRUM (BlueAmplitude style)
     // 8-stage: Royal Blue -> Cyan -> Green -> Yellow -> Orange -> Red -> White
     // Noise floor starts at royal blue (more visible color earlier)
-    m_spectrumLUT.resize(256 * 4);
+    QVector<quint8> lut(256 * 4);
 
     for (int i = 0; i < 256; ++i) {
         float value = i / 255.0f;
@@ -425,11 +419,12 @@ void PanadapterRhiWidget::initSpectrumLUT() {
             b = static_cast<int>(t * 255);
         }
 
-        m_spectrumLUT[i * 4 + 0] = static_cast<quint8>(qBound(0, r, 255));
-        m_spectrumLUT[i * 4 + 1] = static_cast<quint8>(qBound(0, g, 255));
-        m_spectrumLUT[i * 4 + 2] = static_cast<quint8>(qBound(0, b, 255));
-        m_spectrumLUT[i * 4 + 3] = 255;
+        lut[i * 4 + 0] = static_cast<quint8>(qBound(0, r, 255));
+        lut[i * 4 + 1] = static_cast<quint8>(qBound(0, g, 255));
+        lut[i * 4 + 2] = static_cast<quint8>(qBound(0, b, 255));
+        lut[i * 4 + 3] = 255;
     }
+    return lut;
 }
 
 void PanadapterRhiWidget::initialize(QRhiCommandBuffer *cb) {
@@ -441,379 +436,268 @@ void PanadapterRhiWidget::initialize(QRhiCommandBuffer *cb) {
         qWarning() << "QRhi is NULL - GPU backend failed to initialize";
         return;
     }
+    initializeResources(cb);
+}
 
-    // Use fixed texture sizes - GPU bilinear filtering handles scaling to display size
-    m_textureWidth = BASE_TEXTURE_WIDTH;
-    m_waterfallHistory = BASE_WATERFALL_HISTORY;
-
-    // Allocate waterfall data buffer
-    m_waterfallData.resize(m_textureWidth * m_waterfallHistory);
-    m_waterfallData.fill(0);
-
-    // Load shaders from compiled .qsb resources
-    m_spectrumBlueVert = RhiUtils::loadShader(":/shaders/src/dsp/shaders/spectrum_blue.vert.qsb");
-    m_spectrumBlueAmpFrag = RhiUtils::loadShader(":/shaders/src/dsp/shaders/spectrum_blue_amp.frag.qsb");
-    m_waterfallVert = RhiUtils::loadShader(":/shaders/src/dsp/shaders/waterfall.vert.qsb");
-    m_waterfallFrag = RhiUtils::loadShader(":/shaders/src/dsp/shaders/waterfall.frag.qsb");
-    m_overlayVert = RhiUtils::loadShader(":/shaders/src/dsp/shaders/overlay.vert.qsb");
-    m_overlayFrag = RhiUtils::loadShader(":/shaders/src/dsp/shaders/overlay.frag.qsb");
-
-    // Create waterfall texture (single channel for dB values)
-    m_waterfallTexture.reset(m_rhi->newTexture(QRhiTexture::R8, QSize(m_textureWidth, m_waterfallHistory), 1,
-                                               QRhiTexture::UsedAsTransferSource));
-    m_waterfallTexture->create();
+void PanadapterRhiWidget::initializeOffscreen(QRhi *offscreenRhi, QRhiCommandBuffer *cb) {
+    if (m_rhiInitialized)
+        return;
 
-    // Create color LUT texture (256x1 RGBA)
-    m_colorLutTexture.reset(m_rhi->newTexture(QRhiTexture::RGBA8, QSize(256, 1)));
-    m_colorLutTexture->create();
+    m_rhi = offscreenRhi;
+    initializeResources(cb);
+}
 
-    // Create spectrum data texture (1D texture for fragment shader spectrum)
-    m_spectrumDataTexture.reset(m_rhi->newTexture(QRhiTexture::R32F, QSize(m_textureWidth, 1)));
-    m_spectrumDataTexture->create();
+void PanadapterRhiWidget::initializeResources(QRhiCommandBuffer *cb) {
+    RhiResourceCache *cache = RhiResourceCache::instance();
+    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
 
-    // Create spectrum color LUT texture (256x1 RGBA) - for BlueAmplitude style
-    m_spectrumColorLutTexture.reset(m_rhi->newTexture(QRhiTexture::RGBA8, QSize(256, 1)));
-    m_spectrumColorLutTexture->create();
+    // Waterfall texture, row info and scrollback window start small; the first frame sizes them to the
+    // waterfall's height and the first packet to its bins. Without RGBA32F for the row info the waterfall
+    // falls back to drawing rows where they were written.
+    m_waterfallReproject = m_rhi->isTextureFormatSupported(QRhiTexture::RGBA32F);
+    createWaterfallStorage(MIN_TEXTURE_WIDTH, MIN_WATERFALL_HISTORY);
+    m_waterfallNeedsFullClear = true; // Contents are undefined until the first frame clears them
+
+    // Color LUTs (256x1 RGBA), separate for waterfall and spectrum; the sampler and the fullscreen
+    // quad are the same for every widget on this QRhi
+    m_colorLutTexture = cache->lut(m_rhi, QStringLiteral("panadapter.waterfall"), waterfallColorLut, rub);
+    m_spectrumColorLutTexture = cache->lut(m_rhi, QStringLiteral("panadapter.spectrum"), spectrumColorLut, rub);
+    m_sampler = cache->linearSampler(m_rhi);
+    m_fullscreenQuadVbo = cache->fullscreenQuad(m_rhi, rub);
+
+    // Spectrum processing textures start at one bin; resizeSpectrumState() sizes them to the packet
+    m_binTexture.reset(m_rhi->newTexture(QRhiTexture::R8, QSize(1, 1)));
+    m_binTexture->create();
+
+    const QRhiTexture::Format stateFormat =
+        m_rhi->isTextureFormatSupported(QRhiTexture::RGBA32F) ? QRhiTexture::RGBA32F : QRhiTexture::RGBA16F;
+    for (int i = 0; i < 2; ++i) {
+        m_spectrumState[i].reset(m_rhi->newTexture(stateFormat, QSize(2, 1), 1, QRhiTexture::RenderTarget));
+        m_spectrumState[i]->create();
+        m_spectrumStateRt[i].reset(m_rhi->newTextureRenderTarget({m_spectrumState[i].get()}));
+    }
+    m_spectrumStateRpDesc.reset(m_spectrumStateRt[0]->newCompatibleRenderPassDescriptor());
+    for (auto &rt : m_spectrumStateRt) {
+        rt->setRenderPassDescriptor(m_spectrumStateRpDesc.get());
+        rt->create();
+    }
 
-    // Upload color LUT data (separate LUTs for waterfall and spectrum)
-    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
-    // Upload waterfall color LUT
-    QRhiTextureSubresourceUploadDescription waterfallLutUpload(m_colorLUT.constData(), m_colorLUT.size());
-    rub->uploadTexture(m_colorLutTexture.get(), QRhiTextureUploadEntry(0, 0, waterfallLutUpload));
-    // Upload spectrum color LUT (for BlueAmplitude style)
-    QRhiTextureSubresourceUploadDescription spectrumLutUpload(m_spectrumLUT.constData(), m_spectrumLUT.size());
-    rub->uploadTexture(m_spectrumColorLutTexture.get(), QRhiTextureUploadEntry(0, 0, spectrumLutUpload));
-
-    // Upload initial zeroed waterfall data (prevents uninitialized texture garbage)
-    QRhiTextureSubresourceUploadDescription waterfallUpload(m_waterfallData.constData(), m_waterfallData.size());
-    rub->uploadTexture(m_waterfallTexture.get(), QRhiTextureUploadEntry(0, 0, waterfallUpload));
-
-    // Create sampler
-    m_sampler.reset(m_rhi->newSampler(QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
-                                      QRhiSampler::ClampToEdge, QRhiSampler::Repeat));
-    m_sampler->create();
-
-    // Waterfall quad (static)
-    float tMax = static_cast<float>(m_waterfallHistory - 1) / m_waterfallHistory;
-    float waterfallQuad[] = {
-        // position (x, y), texcoord (s, t)
-        -1.0f, -1.0f, 0.0f, 0.0f, // bottom-left
-        1.0f,  -1.0f, 1.0f, 0.0f, // bottom-right
-        1.0f,  1.0f,  1.0f, tMax, // top-right
-        -1.0f, -1.0f, 0.0f, 0.0f, // bottom-left
-        1.0f,  1.0f,  1.0f, tMax, // top-right
-        -1.0f, 1.0f,  0.0f, tMax  // top-left
-    };
-    m_waterfallVbo.reset(m_rhi->newBuffer(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(waterfallQuad)));
+    // Waterfall quad (static until the row count changes)
+    m_waterfallVbo.reset(m_rhi->newBuffer(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, 24 * sizeof(float)));
     m_waterfallVbo->create();
-    rub->uploadStaticBuffer(m_waterfallVbo.get(), waterfallQuad);
-
-    m_overlayVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 4096 * 2 * sizeof(float)));
-    m_overlayVbo->create();
+    uploadWaterfallQuad(rub);
 
     // Create uniform buffers
-    m_waterfallUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 16));
+    m_waterfallUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
     m_waterfallUniformBuffer->create();
 
-    m_overlayUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_overlayUniformBuffer->create();
-
-    // Fullscreen quad (shared by all fragment-shader spectrum styles)
-    // Position (x, y) + texCoord (s, t) - covers normalized -1 to 1 range
-    float fullscreenQuad[] = {
-        // position (x, y), texcoord (s, t)
-        -1.0f, -1.0f, 0.0f, 1.0f, // bottom-left (texCoord y=1 = bottom)
-        1.0f,  -1.0f, 1.0f, 1.0f, // bottom-right
-        1.0f,  1.0f,  1.0f, 0.0f, // top-right (texCoord y=0 = top)
-        -1.0f, -1.0f, 0.0f, 1.0f, // bottom-left
-        1.0f,  1.0f,  1.0f, 0.0f, // top-right
-        -1.0f, 1.0f,  0.0f, 0.0f  // top-left
-    };
-    m_fullscreenQuadVbo.reset(
-        m_rhi->newBuffer(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(fullscreenQuad)));
-    m_fullscreenQuadVbo->create();
-    rub->uploadStaticBuffer(m_fullscreenQuadVbo.get(), fullscreenQuad);
-
-    // Spectrum amplitude style uniform buffer: 80 bytes (std140 layout)
-    // fillBaseColor(16) + fillPeakColor(16) + glowColor(16) + params(16) + viewport(16)
-    m_spectrumBlueAmpUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 80));
+    // Spectrum amplitude style uniform buffer: 96 bytes (std140 layout)
+    // fillBaseColor(16) + fillPeakColor(16) + glowColor(16) + params(16) + viewport(16) + traceMask(16)
+    m_spectrumBlueAmpUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 96));
     m_spectrumBlueAmpUniformBuffer->create();
 
-    // Separate buffers for passband to avoid GPU buffer conflicts
-    m_passbandVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 256 * sizeof(float)));
-    m_passbandVbo->create();
-
-    m_passbandUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_passbandUniformBuffer->create();
-
-    // Separate buffers for marker to avoid conflicts with passband
-    m_markerVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 64 * sizeof(float)));
-    m_markerVbo->create();
-
-    m_markerUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_markerUniformBuffer->create();
-
-    // Separate buffers for notch to avoid conflicts with grid (which shares overlay buffers)
-    m_notchVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 64 * sizeof(float)));
-    m_notchVbo->create();
-
-    m_notchUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_notchUniformBuffer->create();
-
-    // Secondary VFO passband buffers (for showing other receiver's passband)
-    m_secondaryPassbandVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 256 * sizeof(float)));
-    m_secondaryPassbandVbo->create();
-
-    m_secondaryPassbandUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_secondaryPassbandUniformBuffer->create();
+    // Spectrum processing uniforms: 48 bytes (see spectrum_process.frag) per packet of a frame, bound
+    // at a dynamic offset (a dynamic buffer holds one value per frame); waterfall row: 16 bytes
+    m_spectrumProcessUniformStride = m_rhi->ubufAligned(48);
+    m_spectrumProcessUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer,
+                                                          m_spectrumProcessUniformStride * MAX_PACKETS_PER_FRAME));
+    m_spectrumProcessUniformBuffer->create();
+
+    m_waterfallRowUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 16));
+    m_waterfallRowUniformBuffer->create();
+
+    // Bindings that read the spectrum state, one per ping-pong texture (recreated on resize)
+    for (int i = 0; i < 2; ++i) {
+        m_spectrumProcessSrb[i].reset(m_rhi->newShaderResourceBindings());
+        m_spectrumProcessSrb[i]->setBindings(
+            {QRhiShaderResourceBinding::uniformBufferWithDynamicOffset(
+                 0, QRhiShaderResourceBinding::FragmentStage, m_spectrumProcessUniformBuffer.get(), 48),
+             QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
+                                                       m_binTexture.get(), m_sampler),
+             QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
+                                                       m_spectrumState[1 - i].get(), m_sampler)});
+        m_spectrumProcessSrb[i]->create();
 
-    m_secondaryMarkerVbo.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer, 64 * sizeof(float)));
-    m_secondaryMarkerVbo->create();
+        m_waterfallRowSrb[i].reset(m_rhi->newShaderResourceBindings());
+        m_waterfallRowSrb[i]->setBindings(
+            {QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::FragmentStage,
+                                                      m_waterfallRowUniformBuffer.get()),
+             QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
+                                                       m_spectrumState[i].get(), m_sampler)});
+        m_waterfallRowSrb[i]->create();
 
-    m_secondaryMarkerUniformBuffer.reset(m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 32));
-    m_secondaryMarkerUniformBuffer->create();
+        m_spectrumBlueAmpSrb[i].reset(m_rhi->newShaderResourceBindings());
+        m_spectrumBlueAmpSrb[i]->setBindings(
+            {QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::FragmentStage,
+                                                      m_spectrumBlueAmpUniformBuffer.get()),
+             QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
+                                                       m_spectrumState[i].get(), m_sampler),
+             QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
+                                                       m_spectrumColorLutTexture, m_sampler)});
+        m_spectrumBlueAmpSrb[i]->create();
+    }
 
     cb->resourceUpdate(rub);
 
     m_rhiInitialized = true;
 }
 
-void PanadapterRhiWidget::createPipelines() {
+void PanadapterRhiWidget::createPipelines(QRhiRenderPassDescriptor *rpDesc) {
     if (m_pipelinesCreated)
         return;
 
-    if (!m_spectrumBlueVert.isValid() || !m_spectrumBlueAmpFrag.isValid())
+    RhiResourceCache *cache = RhiResourceCache::instance();
+    const QShader quadVert = cache->shader(QStringLiteral("spectrum_blue.vert"));
+    const QShader spectrumAmpFrag = cache->shader(QStringLiteral("spectrum_blue_amp.frag"));
+    const QShader processFrag = cache->shader(QStringLiteral("spectrum_process.frag"));
+    const QShader rowFrag = cache->shader(QStringLiteral("waterfall_row.frag"));
+    const QShader waterfallVert = cache->shader(QStringLiteral("waterfall.vert"));
+    const QShader waterfallFrag = cache->shader(QStringLiteral("waterfall_aligned.frag"));
+    if (!quadVert.isValid() || !spectrumAmpFrag.isValid() || !processFrag.isValid() || !rowFrag.isValid())
         return;
 
-    m_rpDesc = renderTarget()->renderPassDescriptor();
+    m_rpDesc = rpDesc;
+
+    // Fullscreen quad layout shared by the spectrum passes (and the waterfall quad)
+    QRhiVertexInputLayout quadLayout;
+    quadLayout.setBindings({{4 * sizeof(float)}});                         // position(2) + texcoord(2)
+    quadLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
+                              {0, 1, QRhiVertexInputAttribute::Float2, 2 * sizeof(float)}}); // texcoord
+
+    QRhiGraphicsPipeline::TargetBlend blend;
+    blend.enable = true;
+    blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
+    blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
+
+    // Pipelines come from the cache: the other panadapter on this window reuses them
+    auto quadPipeline = [&](const QString &name, const QShader &vert, const QShader &frag,
+                            QRhiShaderResourceBindings *layout, QRhiRenderPassDescriptor *pass, bool blended) {
+        return cache->pipeline(m_rhi, name, pass, [&](QRhiGraphicsPipeline *pipeline) {
+            pipeline->setShaderStages({{QRhiShaderStage::Vertex, vert}, {QRhiShaderStage::Fragment, frag}});
+            pipeline->setVertexInputLayout(quadLayout);
+            pipeline->setTopology(QRhiGraphicsPipeline::Triangles);
+            pipeline->setShaderResourceBindings(layout);
+            if (blended)
+                pipeline->setTargetBlends({blend});
+        });
+    };
 
-    // Spectrum amplitude pipeline (LUT-based colors with amplitude brightness)
-    {
-        m_spectrumBlueAmpSrb.reset(m_rhi->newShaderResourceBindings());
-        m_spectrumBlueAmpSrb->setBindings(
-            {QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::FragmentStage,
-                                                      m_spectrumBlueAmpUniformBuffer.get()),
-             QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
-                                                       m_spectrumDataTexture.get(), m_sampler.get()),
-             QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
-                                                       m_spectrumColorLutTexture.get(), m_sampler.get())});
-        m_spectrumBlueAmpSrb->create();
-
-        m_spectrumBlueAmpPipeline.reset(m_rhi->newGraphicsPipeline());
-        m_spectrumBlueAmpPipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_spectrumBlueVert}, {QRhiShaderStage::Fragment, m_spectrumBlueAmpFrag}});
-
-        QRhiVertexInputLayout inputLayout;
-        inputLayout.setBindings({{4 * sizeof(float)}});                         // position(2) + texcoord(2)
-        inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
-                                   {0, 1, QRhiVertexInputAttribute::Float2, 2 * sizeof(float)}}); // texcoord
-        m_spectrumBlueAmpPipeline->setVertexInputLayout(inputLayout);
-        m_spectrumBlueAmpPipeline->setTopology(QRhiGraphicsPipeline::Triangles);
-        m_spectrumBlueAmpPipeline->setShaderResourceBindings(m_spectrumBlueAmpSrb.get());
-        m_spectrumBlueAmpPipeline->setRenderPassDescriptor(m_rpDesc);
-
-        QRhiGraphicsPipeline::TargetBlend blend;
-        blend.enable = true;
-        blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
-        blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
-        m_spectrumBlueAmpPipeline->setTargetBlends({blend});
-
-        m_spectrumBlueAmpPipeline->create();
-    }
+    // Spectrum processing (offscreen, writes the next spectrum state)
+    m_spectrumProcessPipeline = quadPipeline(QStringLiteral("panadapter.spectrumProcess"), quadVert, processFrag,
+                                             m_spectrumProcessSrb[0].get(), m_spectrumStateRpDesc.get(), false);
 
-    // Waterfall pipeline
-    {
-        m_waterfallSrb.reset(m_rhi->newShaderResourceBindings());
-        m_waterfallSrb->setBindings(
-            {QRhiShaderResourceBinding::uniformBuffer(
-                 0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-                 m_waterfallUniformBuffer.get()),
-             QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
-                                                       m_waterfallTexture.get(), m_sampler.get()),
-             QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
-                                                       m_colorLutTexture.get(), m_sampler.get())});
-        m_waterfallSrb->create();
-
-        m_waterfallPipeline.reset(m_rhi->newGraphicsPipeline());
-        m_waterfallPipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_waterfallVert}, {QRhiShaderStage::Fragment, m_waterfallFrag}});
-
-        QRhiVertexInputLayout inputLayout;
-        inputLayout.setBindings({{4 * sizeof(float)}});                         // position(2) + texcoord(2)
-        inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}, // position
-                                   {0, 1, QRhiVertexInputAttribute::Float2, 2 * sizeof(float)}}); // texcoord
-        m_waterfallPipeline->setVertexInputLayout(inputLayout);
-        m_waterfallPipeline->setTopology(QRhiGraphicsPipeline::Triangles);
-        m_waterfallPipeline->setShaderResourceBindings(m_waterfallSrb.get());
-        m_waterfallPipeline->setRenderPassDescriptor(m_rpDesc);
-        m_waterfallPipeline->create();
-    }
+    // Waterfall row (offscreen, writes one row of the waterfall texture)
+    m_waterfallRowPipeline = quadPipeline(QStringLiteral("panadapter.waterfallRow"), quadVert, rowFrag,
+                                          m_waterfallRowSrb[0].get(), m_waterfallRowRpDesc.get(), false);
 
-    // Overlay pipeline (lines)
-    {
-        m_overlaySrb.reset(m_rhi->newShaderResourceBindings());
-        m_overlaySrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_overlayUniformBuffer.get())});
-        m_overlaySrb->create();
-
-        // Separate SRB for passband to avoid buffer conflicts
-        m_passbandSrb.reset(m_rhi->newShaderResourceBindings());
-        m_passbandSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_passbandUniformBuffer.get())});
-        m_passbandSrb->create();
-
-        // Separate SRB for marker to avoid buffer conflicts with passband
-        m_markerSrb.reset(m_rhi->newShaderResourceBindings());
-        m_markerSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_markerUniformBuffer.get())});
-        m_markerSrb->create();
-
-        m_notchSrb.reset(m_rhi->newShaderResourceBindings());
-        m_notchSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_notchUniformBuffer.get())});
-        m_notchSrb->create();
-
-        // Secondary VFO passband SRBs
-        m_secondaryPassbandSrb.reset(m_rhi->newShaderResourceBindings());
-        m_secondaryPassbandSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_secondaryPassbandUniformBuffer.get())});
-        m_secondaryPassbandSrb->create();
-
-        m_secondaryMarkerSrb.reset(m_rhi->newShaderResourceBindings());
-        m_secondaryMarkerSrb->setBindings({QRhiShaderResourceBinding::uniformBuffer(
-            0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
-            m_secondaryMarkerUniformBuffer.get())});
-        m_secondaryMarkerSrb->create();
-
-        m_overlayLinePipeline.reset(m_rhi->newGraphicsPipeline());
-        m_overlayLinePipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_overlayVert}, {QRhiShaderStage::Fragment, m_overlayFrag}});
-
-        QRhiVertexInputLayout inputLayout;
-        inputLayout.setBindings({{2 * sizeof(float)}});
-        inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0}});
-        m_overlayLinePipeline->setVertexInputLayout(inputLayout);
-        m_overlayLinePipeline->setTopology(QRhiGraphicsPipeline::Lines);
-        m_overlayLinePipeline->setShaderResourceBindings(m_overlaySrb.get());
-        m_overlayLinePipeline->setRenderPassDescriptor(m_rpDesc);
-
-        QRhiGraphicsPipeline::TargetBlend blend;
-        blend.enable = true;
-        blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
-        blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
-        m_overlayLinePipeline->setTargetBlends({blend});
-
-        m_overlayLinePipeline->create();
-
-        // Triangle version for filled shapes
-        m_overlayTrianglePipeline.reset(m_rhi->newGraphicsPipeline());
-        m_overlayTrianglePipeline->setShaderStages(
-            {{QRhiShaderStage::Vertex, m_overlayVert}, {QRhiShaderStage::Fragment, m_overlayFrag}});
-        m_overlayTrianglePipeline->setVertexInputLayout(inputLayout);
-        m_overlayTrianglePipeline->setTopology(QRhiGraphicsPipeline::Triangles);
-        m_overlayTrianglePipeline->setShaderResourceBindings(m_overlaySrb.get());
-        m_overlayTrianglePipeline->setRenderPassDescriptor(m_rpDesc);
-        m_overlayTrianglePipeline->setTargetBlends({blend});
-        m_overlayTrianglePipeline->create();
-    }
+    // Spectrum amplitude (LUT-based colors with amplitude brightness)
+    m_spectrumBlueAmpPipeline = quadPipeline(QStringLiteral("panadapter.spectrumBlueAmp"), quadVert, spectrumAmpFrag,
+                                             m_spectrumBlueAmpSrb[0].get(), m_rpDesc, true);
+
+    // Waterfall
+    m_waterfallSrb.reset(m_rhi->newShaderResourceBindings());
+    m_historySrb.reset(m_rhi->newShaderResourceBindings());
+    updateWaterfallBindings();
+    m_waterfallPipeline = quadPipeline(QStringLiteral("panadapter.waterfall"), waterfallVert, waterfallFrag,
+                                       m_waterfallSrb.get(), m_rpDesc, false);
+
+    if (!m_spectrumProcessPipeline || !m_waterfallRowPipeline)
+        return;
+
+    // Overlay batch (grid, passbands, markers)
+    m_overlayBatch.create(m_rhi, m_rpDesc);
 
     m_pipelinesCreated = true;
 }
 
+void PanadapterRhiWidget::scheduleFrame() {
+    RenderScheduler::instance()->requestFrame(this);
+}
+
 void PanadapterRhiWidget::render(QRhiCommandBuffer *cb) {
+    RenderScheduler::instance()->frameRendered(this);
+    renderFrame(cb, renderTarget());
+}
+
+void PanadapterRhiWidget::renderOffscreen(QRhiCommandBuffer *cb, QRhiRenderTarget *target) {
+    renderFrame(cb, target);
+}
+
+void PanadapterRhiWidget::renderFrame(QRhiCommandBuffer *cb, QRhiRenderTarget *target) {
     // Always clear to black even if not initialized (prevents red/garbage showing)
     if (!m_rhiInitialized) {
-        cb->beginPass(renderTarget(), Qt::black, {1.0f, 0}, nullptr);
+        cb->beginPass(target, Qt::black, {1.0f, 0}, nullptr);
         cb->endPass();
         return;
     }
 
     // Create pipelines on first render (need render pass descriptor)
     if (!m_pipelinesCreated) {
-        createPipelines();
+        createPipelines(target->renderPassDescriptor());
         if (!m_pipelinesCreated) {
-            cb->beginPass(renderTarget(), Qt::black, {1.0f, 0}, nullptr);
+            cb->beginPass(target, Qt::black, {1.0f, 0}, nullptr);
             cb->endPass();
             return;
         }
     }
 
-    const QSize outputSize = renderTarget()->pixelSize();
+    QElapsedTimer frameClock;
+    frameClock.start();
+
+    const QSize outputSize = target->pixelSize();
     const float w = outputSize.width();
     const float h = outputSize.height();
     const float spectrumHeight = h * m_spectrumRatio;
     const float waterfallHeight = h - spectrumHeight;
 
-    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
+    // Resize or clear the waterfall first (GPU passes of their own) so the new row lands in the result
+    updateWaterfallStorage(cb, waterfallHeight);
 
-    // Full waterfall clear (on disconnect)
-    if (m_waterfallNeedsFullClear) {
-        QRhiTextureSubresourceUploadDescription fullUpload(m_waterfallData.constData(), m_waterfallData.size());
-        rub->uploadTexture(m_waterfallTexture.get(), QRhiTextureUploadEntry(0, 0, fullUpload));
-        m_waterfallNeedsFullClear = false;
-    }
+    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
 
-    // Update waterfall texture if needed
-    if (m_waterfallNeedsUpdate && !m_currentSpectrum.isEmpty()) {
-        updateWaterfallData();
-        QRhiTextureSubresourceUploadDescription rowUpload(
-            m_waterfallData.constData() + m_waterfallWriteRow * m_textureWidth, m_textureWidth);
-        rowUpload.setDestinationTopLeft(QPoint(0, m_waterfallWriteRow));
-        rowUpload.setSourceSize(QSize(m_textureWidth, 1));
-        rub->uploadTexture(m_waterfallTexture.get(), QRhiTextureUploadEntry(0, 0, rowUpload));
-        m_waterfallWriteRow = (m_waterfallWriteRow + 1) % m_waterfallHistory;
-        m_waterfallNeedsUpdate = false;
+    // New packets: smooth each into the spectrum state and add its waterfall row (GPU passes)
+    if (!m_pendingPackets.isEmpty()) {
+        processSpectrum(cb, rub);
+        rub = m_rhi->nextResourceUpdateBatch();
     }
 
     // Update waterfall uniform buffer with bin parameters
     float scrollOffset = static_cast<float>(m_waterfallWriteRow) / m_waterfallHistory;
-    float binCount = static_cast<float>(m_currentSpectrum.isEmpty() ? m_textureWidth : m_currentSpectrum.size());
+    float binCount = static_cast<float>(m_binCount > 0 ? m_binCount : m_textureWidth);
     struct {
         float scrollOffset;
         float binCount;
         float textureWidth;
+        float historyRows;
+        float viewCenter; // Newest row's window, relative to m_waterfallRefFreq
+        float viewSpan;
+        float reproject;
         float padding;
-    } waterfallUniforms = {scrollOffset, binCount, static_cast<float>(m_textureWidth), 0.0f};
+    } waterfallUniforms = {scrollOffset,
+                           binCount,
+                           static_cast<float>(m_textureWidth),
+                           static_cast<float>(m_waterfallHistory),
+                           static_cast<float>(m_waterfallViewCenter - m_waterfallRefFreq),
+                           static_cast<float>(m_waterfallViewSpan),
+                           m_waterfallReproject && m_waterfallRefValid ? 1.0f : 0.0f,
+                           0.0f};
+
+    // Scrollback: the paged window fills the history texture from line 0 (oldest) up, every
+    // column in view and already reprojected. The live texture keeps receiving rows underneath.
+    const bool viewingHistory = m_historyOffset > 0 && m_history.isOpen();
+    if (viewingHistory) {
+        pageHistory(rub);
+        const float historyWidth = static_cast<float>(HISTORY_TEXTURE_WIDTH);
+        waterfallUniforms.scrollOffset = 0.0f;
+        waterfallUniforms.binCount = historyWidth;
+        waterfallUniforms.textureWidth = historyWidth;
+        waterfallUniforms.reproject = 0.0f;
+    }
     rub->updateDynamicBuffer(m_waterfallUniformBuffer.get(), 0, sizeof(waterfallUniforms), &waterfallUniforms);
 
-    // Calculate smoothed baseline for spectrum normalization
-    if (!m_currentSpectrum.isEmpty()) {
-        float frameMinNormalized = 1.0f;
-        for (int i = 0; i < m_currentSpectrum.size(); ++i) {
-            float normalized = normalizeDb(m_currentSpectrum[i]);
-            if (normalized < frameMinNormalized)
-                frameMinNormalized = normalized;
-        }
-        const float baselineAlpha = 0.05f;
-        if (m_smoothedBaseline < 0.001f)
-            m_smoothedBaseline = frameMinNormalized;
-        else
-            m_smoothedBaseline = baselineAlpha * frameMinNormalized + (1.0f - baselineAlpha) * m_smoothedBaseline;
-
-        // Upload raw spectrum bins to 1D texture - GPU shader does bilinear interpolation
-        int specSize = m_currentSpectrum.size();
-        int offset = (m_textureWidth - specSize) / 2;
-
-        QVector<float> normalizedSpectrum(m_textureWidth, 0.0f); // Initialize to zero
-        for (int i = 0; i < specSize; ++i) {
-            float normalized = normalizeDb(m_currentSpectrum[i]);
-            float adjusted = qMax(0.0f, normalized - m_smoothedBaseline);
-            normalizedSpectrum[offset + i] = adjusted * 0.95f;
-        }
-
-        QRhiTextureSubresourceUploadDescription specDataUpload(normalizedSpectrum.constData(),
-                                                               normalizedSpectrum.size() * sizeof(float));
-        specDataUpload.setSourceSize(QSize(m_textureWidth, 1));
-        rub->uploadTexture(m_spectrumDataTexture.get(), QRhiTextureUploadEntry(0, 0, specDataUpload));
-
-        // Update blue spectrum uniform buffer (80 bytes, std140 layout)
-        float specBinCount =
-            static_cast<float>(m_currentSpectrum.isEmpty() ? m_textureWidth : m_currentSpectrum.size());
+    // Spectrum fill reads the processed state; normalization and noise floor happen in the shader
+    if (m_binCount > 0) {
+        // Update blue spectrum uniform buffer (96 bytes, std140 layout)
         struct {
             float fillBaseColor[4]; // offset 0: dark navy
             float fillPeakColor[4]; // offset 16: electric blue
@@ -823,491 +707,248 @@ void PanadapterRhiWidget::render(QRhiCommandBuffer *cb) {
             float spectrumHeightPx; // offset 56
             float binCount;         // offset 60: actual bin count
             float viewportSize[2];  // offset 64
-            float textureWidth;     // offset 72: for bin centering
-            float padding;          // offset 76
+            float minDb;            // offset 72: display range for normalization
+            float maxDb;            // offset 76
+            float traceMask[4];     // offset 80: state channel to draw
         } specBlueUniforms = {
-            {0.0f, 0.08f, 0.16f, 0.85f},        // fillBaseColor: dark navy
-            {0.0f, 0.63f, 1.0f, 0.85f},         // fillPeakColor: electric blue
-            {0.0f, 0.83f, 1.0f, 1.0f},          // glowColor: cyan
-            0.8f,                               // glowIntensity
-            0.04f,                              // glowWidth
-            spectrumHeight,                     // spectrumHeight in pixels
-            specBinCount,                       // binCount for shader
-            {w, h},                             // viewportSize
-            static_cast<float>(m_textureWidth), // textureWidth for bin centering
-            0.0f                                // padding
-        };
+            {0.0f, 0.08f, 0.16f, 0.85f}, // fillBaseColor: dark navy
+            {0.0f, 0.63f, 1.0f, 0.85f},  // fillPeakColor: electric blue
+            {0.0f, 0.83f, 1.0f, 1.0f},   // glowColor: cyan
+            0.8f,                        // glowIntensity
+            0.04f,                       // glowWidth
+            spectrumHeight,              // spectrumHeight in pixels
+            binCount,                    // binCount for shader
+            {w, h},                      // viewportSize
+            m_minDb,                     // minDb
+            m_maxDb,                     // maxDb
+            {m_spectrumTrace == SpectrumTrace::Average ? 1.0f : 0.0f,
+             m_spectrumTrace == SpectrumTrace::PeakHold ? 1.0f : 0.0f,
+             m_spectrumTrace == SpectrumTrace::MinHold ? 1.0f : 0.0f, 0.0f}};
         rub->updateDynamicBuffer(m_spectrumBlueAmpUniformBuffer.get(), 0, sizeof(specBlueUniforms), &specBlueUniforms);
     }
 
+    const qint64 uploadedNs = frameClock.nsecsElapsed();
+
+    // Grid, passbands and markers: one vertex upload for the frame
+    m_overlayBatch.begin(w, h);
+    buildOverlayGeometry(w, spectrumHeight);
+    m_overlayBatch.upload(rub);
+
+    const qint64 overlaidNs = frameClock.nsecsElapsed();
+
     cb->resourceUpdate(rub);
 
     // Begin render pass
-    cb->beginPass(renderTarget(), QColor::fromRgbF(0.08f, 0.08f, 0.08f, 1.0f), {1.0f, 0}, nullptr);
+    cb->beginPass(target, QColor::fromRgbF(0.08f, 0.08f, 0.08f, 1.0f), {1.0f, 0}, nullptr);
 
     // Draw waterfall (bottom portion)
     if (m_waterfallPipeline) {
         cb->setViewport({0, 0, w, waterfallHeight});
-        cb->setGraphicsPipeline(m_waterfallPipeline.get());
-        cb->setShaderResources(m_waterfallSrb.get());
+        cb->setGraphicsPipeline(m_waterfallPipeline);
+        cb->setShaderResources(viewingHistory ? m_historySrb.get() : m_waterfallSrb.get());
         const QRhiCommandBuffer::VertexInput waterfallVbufBinding(m_waterfallVbo.get(), 0);
         cb->setVertexInput(0, 1, &waterfallVbufBinding);
         cb->draw(6);
     }
 
-    // Draw grid BEHIND spectrum (in spectrum area)
-    if (m_gridEnabled && m_overlayLinePipeline) {
+    // Draw grid BEHIND spectrum (the batch's lines are only the grid)
+    cb->setViewport({0, 0, w, h});
+    m_overlayBatch.drawLines(cb);
+
+    // Draw spectrum fill ON TOP of grid (shader-based fullscreen quad)
+    if (m_binCount > 0 && m_spectrumBlueAmpPipeline) {
         cb->setViewport({0, waterfallHeight, w, spectrumHeight});
+        cb->setGraphicsPipeline(m_spectrumBlueAmpPipeline);
+        cb->setShaderResources(m_spectrumBlueAmpSrb[m_spectrumStateIndex].get());
 
-        QVector<float> gridVerts;
+        const QRhiCommandBuffer::VertexInput quadVbufBinding(m_fullscreenQuadVbo, 0);
+        cb->setVertexInput(0, 1, &quadVbufBinding);
+        cb->draw(6); // Fullscreen quad (2 triangles)
+    }
 
-        // Horizontal lines (dB scale) - 8 divisions in spectrum area
+    // Draw passbands and markers on top (full viewport)
+    cb->setViewport({0, 0, w, h});
+    m_overlayBatch.drawTriangles(cb);
+
+    cb->endPass();
+
+    m_frameTiming = {uploadedNs, overlaidNs - uploadedNs, frameClock.nsecsElapsed() - overlaidNs};
+}
+
+void PanadapterRhiWidget::buildOverlayGeometry(float w, float spectrumHeight) {
+    // Grid lines (in spectrum area): 8 dB divisions, 10 frequency divisions
+    if (m_gridEnabled) {
         for (int i = 1; i < 8; ++i) {
             float y = spectrumHeight * i / 8.0f;
-            gridVerts << 0.0f << y << w << y;
+            m_overlayBatch.addLine(0.0f, y, w, y, m_gridColor);
         }
-
-        // Vertical lines (frequency) - 10 divisions in spectrum area
         for (int i = 1; i < 10; ++i) {
             float x = w * i / 10.0f;
-            gridVerts << x << 0.0f << x << spectrumHeight;
+            m_overlayBatch.addLine(x, 0.0f, x, spectrumHeight, m_gridColor);
         }
-
-        QRhiResourceUpdateBatch *gridRub = m_rhi->nextResourceUpdateBatch();
-        gridRub->updateDynamicBuffer(m_overlayVbo.get(), 0, gridVerts.size() * sizeof(float), gridVerts.constData());
-
-        struct {
-            float viewportWidth;
-            float viewportHeight;
-            float pad0, pad1;
-            float r, g, b, a;
-        } gridUniforms = {w,
-                          spectrumHeight,
-                          0,
-                          0,
-                          static_cast<float>(m_gridColor.redF()),
-                          static_cast<float>(m_gridColor.greenF()),
-                          static_cast<float>(m_gridColor.blueF()),
-                          static_cast<float>(m_gridColor.alphaF())};
-        gridRub->updateDynamicBuffer(m_overlayUniformBuffer.get(), 0, sizeof(gridUniforms), &gridUniforms);
-
-        cb->resourceUpdate(gridRub);
-        cb->setGraphicsPipeline(m_overlayLinePipeline.get());
-        cb->setShaderResources(m_overlaySrb.get());
-        const QRhiCommandBuffer::VertexInput gridVbufBinding(m_overlayVbo.get(), 0);
-        cb->setVertexInput(0, 1, &gridVbufBinding);
-        cb->draw(gridVerts.size() / 2);
     }
 
-    // Draw spectrum fill ON TOP of grid (shader-based fullscreen quad)
-    if (!m_currentSpectrum.isEmpty() && m_spectrumBlueAmpPipeline) {
-        cb->setViewport({0, waterfallHeight, w, spectrumHeight});
-        cb->setGraphicsPipeline(m_spectrumBlueAmpPipeline.get());
-        cb->setShaderResources(m_spectrumBlueAmpSrb.get());
+    // Secondary VFO passband first (so it renders behind primary when overlapping)
+    if (m_secondaryVisible && m_secondaryFilterBw > 0 && m_secondaryTunedFreq > 0) {
+        qint64 secLowFreq, secHighFreq;
+        int secShiftOffsetHz = m_secondaryIfShift * 10;
+
+        if (m_secondaryMode == "LSB") {
+            qint64 center = m_secondaryTunedFreq - secShiftOffsetHz;
+            secLowFreq = center - m_secondaryFilterBw / 2;
+            secHighFreq = center + m_secondaryFilterBw / 2;
+        } else if (m_secondaryMode == "USB" || m_secondaryMode == "DATA" || m_secondaryMode == "DATA-R") {
+            qint64 center = m_secondaryTunedFreq + secShiftOffsetHz;
+            secLowFreq = center - m_secondaryFilterBw / 2;
+            secHighFreq = center + m_secondaryFilterBw / 2;
+        } else if (m_secondaryMode == "CW" || m_secondaryMode == "CW-R") {
+            int pitchOffset = (m_secondaryMode == "CW") ? m_secondaryCwPitch : -m_secondaryCwPitch;
+            qint64 center = m_secondaryTunedFreq + pitchOffset;
+            secLowFreq = center - m_secondaryFilterBw / 2;
+            secHighFreq = center + m_secondaryFilterBw / 2;
+        } else {
+            // AM/FM - symmetric around carrier (both sidebands, no IF shift)
+            secLowFreq = m_secondaryTunedFreq - m_secondaryFilterBw / 2;
+            secHighFreq = m_secondaryTunedFreq + m_secondaryFilterBw / 2;
+        }
 
-        const QRhiCommandBuffer::VertexInput quadVbufBinding(m_fullscreenQuadVbo.get(), 0);
-        cb->setVertexInput(0, 1, &quadVbufBinding);
-        cb->draw(6); // Fullscreen quad (2 triangles)
-    }
+        float secX1 = freqToNormalized(secLowFreq) * w;
+        float secX2 = freqToNormalized(secHighFreq) * w;
+        secX1 = qBound(0.0f, secX1, w);
+        secX2 = qBound(0.0f, secX2, w);
 
-    // Draw overlays (full viewport for grid, markers, passband)
-    cb->setViewport({0, 0, w, h});
+        if (secX2 > secX1) {
+            m_overlayBatch.addRect(secX1, 0.0f, secX2, spectrumHeight, m_secondaryPassbandColor);
+        }
 
-    if (m_overlayLinePipeline && m_overlayTrianglePipeline) {
-        // Helper lambda to draw filled quad
-        auto drawFilledQuad = [&](float x1, float y1, float x2, float y2, const QColor &color) {
-            QVector<float> quadVerts = {x1, y1, x2, y1, x2, y2, x1, y1, x2, y2, x1, y2};
-
-            QRhiResourceUpdateBatch *rub2 = m_rhi->nextResourceUpdateBatch();
-            rub2->updateDynamicBuffer(m_overlayVbo.get(), 0, quadVerts.size() * sizeof(float), quadVerts.constData());
-
-            struct {
-                float viewportWidth;
-                float viewportHeight;
-                float pad0, pad1; // Matches shader's vec2 padding (std140 layout)
-                float r, g, b, a; // Matches shader's vec4 color at offset 16
-            } overlayUniforms = {w,
-                                 h,
-                                 0,
-                                 0,
-                                 static_cast<float>(color.redF()),
-                                 static_cast<float>(color.greenF()),
-                                 static_cast<float>(color.blueF()),
-                                 static_cast<float>(color.alphaF())};
-            rub2->updateDynamicBuffer(m_overlayUniformBuffer.get(), 0, sizeof(overlayUniforms), &overlayUniforms);
-
-            cb->resourceUpdate(rub2);
-            cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-            cb->setShaderResources(m_overlaySrb.get());
-            const QRhiCommandBuffer::VertexInput overlayVbufBinding(m_overlayVbo.get(), 0);
-            cb->setVertexInput(0, 1, &overlayVbufBinding);
-            cb->draw(6);
-        };
+        // Secondary VFO marker
+        qint64 secMarkerFreq = m_secondaryTunedFreq;
+        if (m_secondaryMode == "CW") {
+            secMarkerFreq = m_secondaryTunedFreq + m_secondaryCwPitch;
+        } else if (m_secondaryMode == "CW-R") {
+            secMarkerFreq = m_secondaryTunedFreq - m_secondaryCwPitch;
+        }
+        float secMarkerX = freqToNormalized(secMarkerFreq) * w;
+        if (secMarkerX >= 0 && secMarkerX <= w) {
+            float markerWidth = 2.0f;
+            m_overlayBatch.addRect(secMarkerX, 0.0f, secMarkerX + markerWidth, spectrumHeight, m_secondaryMarkerColor);
+        }
+    }
 
-        // Helper lambda to draw lines
-        auto drawLines = [&](const QVector<float> &lineVerts, const QColor &color) {
-            if (lineVerts.isEmpty())
-                return;
-            QRhiResourceUpdateBatch *rub2 = m_rhi->nextResourceUpdateBatch();
-            rub2->updateDynamicBuffer(m_overlayVbo.get(), 0, lineVerts.size() * sizeof(float), lineVerts.constData());
-
-            struct {
-                float viewportWidth;
-                float viewportHeight;
-                float pad0, pad1; // Matches shader's vec2 padding (std140 layout)
-                float r, g, b, a; // Matches shader's vec4 color at offset 16
-            } overlayUniforms = {w,
-                                 h,
-                                 0,
-                                 0,
-                                 static_cast<float>(color.redF()),
-                                 static_cast<float>(color.greenF()),
-                                 static_cast<float>(color.blueF()),
-                                 static_cast<float>(color.alphaF())};
-            rub2->updateDynamicBuffer(m_overlayUniformBuffer.get(), 0, sizeof(overlayUniforms), &overlayUniforms);
-
-            cb->resourceUpdate(rub2);
-            cb->setGraphicsPipeline(m_overlayLinePipeline.get());
-            cb->setShaderResources(m_overlaySrb.get());
-            const QRhiCommandBuffer::VertexInput overlayVbufBinding(m_overlayVbo.get(), 0);
-            cb->setVertexInput(0, 1, &overlayVbufBinding);
-            cb->draw(lineVerts.size() / 2);
-        };
+    // Passband overlay
+    if (m_cursorVisible && m_filterBw > 0 && m_tunedFreq > 0) {
+        // Calculate passband edges based on mode
+        qint64 lowFreq, highFreq;
+
+        // K4 IF shift is reported in decahertz (10 Hz units)
+        // This is the passband center offset from the dial frequency
+        // USB with shift=150 means passband centered 1500 Hz above dial
+        // CW with shift=50 means passband centered at 500 Hz pitch
+        int shiftOffsetHz = m_ifShift * 10;
+
+        if (m_mode == "LSB") {
+            // LSB: passband is below dial, shift indicates center offset (negative)
+            qint64 center = m_tunedFreq - shiftOffsetHz;
+            lowFreq = center - m_filterBw / 2;
+            highFreq = center + m_filterBw / 2;
+        } else if (m_mode == "USB" || m_mode == "DATA" || m_mode == "DATA-R") {
+            // USB: passband is above dial, shift indicates center offset
+            qint64 center = m_tunedFreq + shiftOffsetHz;
+            lowFreq = center - m_filterBw / 2;
+            highFreq = center + m_filterBw / 2;
+        } else if (m_mode == "CW" || m_mode == "CW-R") {
+            // CW: shift already includes pitch offset from K4
+            int pitchOffset = (m_mode == "CW") ? m_cwPitch : -m_cwPitch;
+            qint64 center = m_tunedFreq + pitchOffset;
+            lowFreq = center - m_filterBw / 2;
+            highFreq = center + m_filterBw / 2;
+        } else {
+            // AM/FM - symmetric around carrier (both sidebands, no IF shift)
+            lowFreq = m_tunedFreq - m_filterBw / 2;
+            highFreq = m_tunedFreq + m_filterBw / 2;
+        }
 
-        // Grid is now drawn BEFORE spectrum fill (see above)
-
-        // Draw secondary VFO passband first (so it renders behind primary when overlapping)
-        if (m_secondaryVisible && m_secondaryFilterBw > 0 && m_secondaryTunedFreq > 0) {
-            qint64 secLowFreq, secHighFreq;
-            int secShiftOffsetHz = m_secondaryIfShift * 10;
-
-            if (m_secondaryMode == "LSB") {
-                qint64 center = m_secondaryTunedFreq - secShiftOffsetHz;
-                secLowFreq = center - m_secondaryFilterBw / 2;
-                secHighFreq = center + m_secondaryFilterBw / 2;
-            } else if (m_secondaryMode == "USB" || m_secondaryMode == "DATA" || m_secondaryMode == "DATA-R") {
-                qint64 center = m_secondaryTunedFreq + secShiftOffsetHz;
-                secLowFreq = center - m_secondaryFilterBw / 2;
-                secHighFreq = center + m_secondaryFilterBw / 2;
-            } else if (m_secondaryMode == "CW" || m_secondaryMode == "CW-R") {
-                int pitchOffset = (m_secondaryMode == "CW") ? m_secondaryCwPitch : -m_secondaryCwPitch;
-                qint64 center = m_secondaryTunedFreq + pitchOffset;
-                secLowFreq = center - m_secondaryFilterBw / 2;
-                secHighFreq = center + m_secondaryFilterBw / 2;
-            } else {
-                // AM/FM - symmetric around carrier (both sidebands, no IF shift)
-                secLowFreq = m_secondaryTunedFreq - m_secondaryFilterBw / 2;
-                secHighFreq = m_secondaryTunedFreq + m_secondaryFilterBw / 2;
-            }
+        // Convert to pixel coordinates
+        float x1 = freqToNormalized(lowFreq) * w;
+        float x2 = freqToNormalized(highFreq) * w;
 
-            float secX1 = freqToNormalized(secLowFreq) * w;
-            float secX2 = freqToNormalized(secHighFreq) * w;
-            secX1 = qBound(0.0f, secX1, w);
-            secX2 = qBound(0.0f, secX2, w);
-
-            if (secX2 > secX1) {
-                QVector<float> secQuadVerts = {
-                    secX1, 0, secX2, 0, secX2, spectrumHeight, secX1, 0, secX2, spectrumHeight, secX1, spectrumHeight};
-
-                QRhiResourceUpdateBatch *secPbRub = m_rhi->nextResourceUpdateBatch();
-                secPbRub->updateDynamicBuffer(m_secondaryPassbandVbo.get(), 0, secQuadVerts.size() * sizeof(float),
-                                              secQuadVerts.constData());
-
-                struct {
-                    float viewportWidth;
-                    float viewportHeight;
-                    float pad0, pad1;
-                    float r, g, b, a;
-                } secPbUniforms = {w,
-                                   h,
-                                   0,
-                                   0,
-                                   static_cast<float>(m_secondaryPassbandColor.redF()),
-                                   static_cast<float>(m_secondaryPassbandColor.greenF()),
-                                   static_cast<float>(m_secondaryPassbandColor.blueF()),
-                                   static_cast<float>(m_secondaryPassbandColor.alphaF())};
-                secPbRub->updateDynamicBuffer(m_secondaryPassbandUniformBuffer.get(), 0, sizeof(secPbUniforms),
-                                              &secPbUniforms);
-
-                cb->resourceUpdate(secPbRub);
-                cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-                cb->setShaderResources(m_secondaryPassbandSrb.get());
-                const QRhiCommandBuffer::VertexInput secPbVbufBinding(m_secondaryPassbandVbo.get(), 0);
-                cb->setVertexInput(0, 1, &secPbVbufBinding);
-                cb->draw(6);
-            }
+        // Clamp to visible area
+        x1 = qBound(0.0f, x1, w);
+        x2 = qBound(0.0f, x2, w);
 
-            // Secondary VFO marker
-            qint64 secMarkerFreq = m_secondaryTunedFreq;
-            if (m_secondaryMode == "CW") {
-                secMarkerFreq = m_secondaryTunedFreq + m_secondaryCwPitch;
-            } else if (m_secondaryMode == "CW-R") {
-                secMarkerFreq = m_secondaryTunedFreq - m_secondaryCwPitch;
-            }
-            float secMarkerX = freqToNormalized(secMarkerFreq) * w;
-            if (secMarkerX >= 0 && secMarkerX <= w) {
-                float markerWidth = 2.0f;
-                QVector<float> secMarkerVerts = {secMarkerX,
-                                                 0.0f,
-                                                 secMarkerX + markerWidth,
-                                                 0.0f,
-                                                 secMarkerX + markerWidth,
-                                                 spectrumHeight,
-                                                 secMarkerX,
-                                                 0.0f,
-                                                 secMarkerX + markerWidth,
-                                                 spectrumHeight,
-                                                 secMarkerX,
-                                                 spectrumHeight};
-
-                QRhiResourceUpdateBatch *secMkRub = m_rhi->nextResourceUpdateBatch();
-                secMkRub->updateDynamicBuffer(m_secondaryMarkerVbo.get(), 0, secMarkerVerts.size() * sizeof(float),
-                                              secMarkerVerts.constData());
-
-                struct {
-                    float viewportWidth;
-                    float viewportHeight;
-                    float pad0, pad1;
-                    float r, g, b, a;
-                } secMkUniforms = {w,
-                                   h,
-                                   0,
-                                   0,
-                                   static_cast<float>(m_secondaryMarkerColor.redF()),
-                                   static_cast<float>(m_secondaryMarkerColor.greenF()),
-                                   static_cast<float>(m_secondaryMarkerColor.blueF()),
-                                   static_cast<float>(m_secondaryMarkerColor.alphaF())};
-                secMkRub->updateDynamicBuffer(m_secondaryMarkerUniformBuffer.get(), 0, sizeof(secMkUniforms),
-                                              &secMkUniforms);
-
-                cb->resourceUpdate(secMkRub);
-                cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-                cb->setShaderResources(m_secondaryMarkerSrb.get());
-                const QRhiCommandBuffer::VertexInput secMkVbufBinding(m_secondaryMarkerVbo.get(), 0);
-                cb->setVertexInput(0, 1, &secMkVbufBinding);
-                cb->draw(6);
-            }
+        if (x2 > x1) {
+            // Use spectrumHeight not h - passband should only appear in spectrum area, not waterfall
+            m_overlayBatch.addRect(x1, 0.0f, x2, spectrumHeight, m_passbandColor);
         }
 
-        // Draw passband overlay (uses separate buffers to avoid GPU conflicts)
-        if (m_cursorVisible && m_filterBw > 0 && m_tunedFreq > 0) {
-            // Calculate passband edges based on mode
-            qint64 lowFreq, highFreq;
-
-            // K4 IF shift is reported in decahertz (10 Hz units)
-            // This is the passband center offset from the dial frequency
-            // USB with shift=150 means passband centered 1500 Hz above dial
-            // CW with shift=50 means passband centered at 500 Hz pitch
-            int shiftOffsetHz = m_ifShift * 10;
+        // Frequency marker
+        // Use spectrumHeight not h - marker should only appear in spectrum area, not waterfall
+        // For CW modes: marker at passband center (dial + pitch offset)
+        // For SSB/other: marker at dial frequency (passband shifts around it)
+        qint64 markerFreq = m_tunedFreq;
+        if (m_mode == "CW") {
+            // CW marker at passband center (pitch offset from dial)
+            markerFreq = m_tunedFreq + m_cwPitch;
+        } else if (m_mode == "CW-R") {
+            // CW-R marker at passband center (pitch offset below dial)
+            markerFreq = m_tunedFreq - m_cwPitch;
+        }
+        // For USB/LSB/AM/FM: marker stays at dial frequency
+        float markerX = freqToNormalized(markerFreq) * w;
+        if (markerX >= 0 && markerX <= w) {
+            // Draw as filled rectangle (2px wide) instead of line for robust Metal rendering
+            float markerWidth = 2.0f;
+            m_overlayBatch.addRect(markerX, 0.0f, markerX + markerWidth, spectrumHeight, m_frequencyMarkerColor);
+        }
 
-            if (m_mode == "LSB") {
-                // LSB: passband is below dial, shift indicates center offset (negative)
-                qint64 center = m_tunedFreq - shiftOffsetHz;
-                lowFreq = center - m_filterBw / 2;
-                highFreq = center + m_filterBw / 2;
+        // Notch filter marker (red line)
+        // Calculate notch position relative to the passband center
+        // This ensures correct alignment regardless of tunedFreq/centerFreq mismatch
+        if (m_notchEnabled && m_notchPitchHz > 0 && m_spanHz > 0) {
+            // First, find where the passband center is on screen
+            // For CW: passbandCenter = tunedFreq + cwPitch
+            // For USB/DATA: passbandCenter = tunedFreq + shiftOffset
+            // For LSB: passbandCenter = tunedFreq - shiftOffset
+            // For AM/FM: passbandCenter = tunedFreq
+            qint64 passbandCenterFreq;
+            if (m_mode == "CW") {
+                passbandCenterFreq = m_tunedFreq + m_cwPitch;
+            } else if (m_mode == "CW-R") {
+                passbandCenterFreq = m_tunedFreq - m_cwPitch;
+            } else if (m_mode == "LSB") {
+                int shiftOffsetHz = m_ifShift * 10;
+                passbandCenterFreq = m_tunedFreq - shiftOffsetHz;
             } else if (m_mode == "USB" || m_mode == "DATA" || m_mode == "DATA-R") {
-                // USB: passband is above dial, shift indicates center offset
-                qint64 center = m_tunedFreq + shiftOffsetHz;
-                lowFreq = center - m_filterBw / 2;
-                highFreq = center + m_filterBw / 2;
-            } else if (m_mode == "CW" || m_mode == "CW-R") {
-                // CW: shift already includes pitch offset from K4
-                int pitchOffset = (m_mode == "CW") ? m_cwPitch : -m_cwPitch;
-                qint64 center = m_tunedFreq + pitchOffset;
-                lowFreq = center - m_filterBw / 2;
-                highFreq = center + m_filterBw / 2;
+                int shiftOffsetHz = m_ifShift * 10;
+                passbandCenterFreq = m_tunedFreq + shiftOffsetHz;
             } else {
-                // AM/FM - symmetric around carrier (both sidebands, no IF shift)
-                lowFreq = m_tunedFreq - m_filterBw / 2;
-                highFreq = m_tunedFreq + m_filterBw / 2;
+                // AM/FM: centered on carrier
+                passbandCenterFreq = m_tunedFreq;
             }
 
-            // Convert to pixel coordinates
-            float x1 = freqToNormalized(lowFreq) * w;
-            float x2 = freqToNormalized(highFreq) * w;
-
-            // Clamp to visible area
-            x1 = qBound(0.0f, x1, w);
-            x2 = qBound(0.0f, x2, w);
-
-            if (x2 > x1) {
-                // Draw passband quad - use dedicated VBO, uniform buffer, and SRB
-                // Use spectrumHeight not h - passband should only appear in spectrum area, not waterfall
-                QVector<float> quadVerts = {
-                    x1, 0, x2, 0, x2, spectrumHeight, x1, 0, x2, spectrumHeight, x1, spectrumHeight};
-
-                QRhiResourceUpdateBatch *pbRub = m_rhi->nextResourceUpdateBatch();
-                pbRub->updateDynamicBuffer(m_passbandVbo.get(), 0, quadVerts.size() * sizeof(float),
-                                           quadVerts.constData());
-
-                struct {
-                    float viewportWidth;
-                    float viewportHeight;
-                    float pad0, pad1;
-                    float r, g, b, a;
-                } pbUniforms = {w,
-                                h,
-                                0,
-                                0,
-                                static_cast<float>(m_passbandColor.redF()),
-                                static_cast<float>(m_passbandColor.greenF()),
-                                static_cast<float>(m_passbandColor.blueF()),
-                                static_cast<float>(m_passbandColor.alphaF())};
-                pbRub->updateDynamicBuffer(m_passbandUniformBuffer.get(), 0, sizeof(pbUniforms), &pbUniforms);
-
-                cb->resourceUpdate(pbRub);
-                cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-                cb->setShaderResources(m_passbandSrb.get());
-                const QRhiCommandBuffer::VertexInput pbVbufBinding(m_passbandVbo.get(), 0);
-                cb->setVertexInput(0, 1, &pbVbufBinding);
-                cb->draw(6);
+            // Calculate notch RF frequency - notch pitch is audio offset from carrier
+            qint64 notchFreq;
+            if (m_mode == "LSB") {
+                notchFreq = m_tunedFreq - m_notchPitchHz;
+            } else {
+                notchFreq = m_tunedFreq + m_notchPitchHz;
             }
 
-            // Draw frequency marker - use dedicated VBO, uniform buffer, and SRB
-            // Use spectrumHeight not h - marker should only appear in spectrum area, not waterfall
-            // For CW modes: marker at passband center (dial + pitch offset)
-            // For SSB/other: marker at dial frequency (passband shifts around it)
-            qint64 markerFreq = m_tunedFreq;
-            if (m_mode == "CW") {
-                // CW marker at passband center (pitch offset from dial)
-                markerFreq = m_tunedFreq + m_cwPitch;
-            } else if (m_mode == "CW-R") {
-                // CW-R marker at passband center (pitch offset below dial)
-                markerFreq = m_tunedFreq - m_cwPitch;
-            }
-            // For USB/LSB/AM/FM: marker stays at dial frequency
-            float markerX = freqToNormalized(markerFreq) * w;
-            if (markerX >= 0 && markerX <= w) {
-                // Draw as filled rectangle (2px wide) instead of line for robust Metal rendering
-                float markerWidth = 2.0f;
-                QVector<float> markerVerts = {markerX,
-                                              0.0f,
-                                              markerX + markerWidth,
-                                              0.0f,
-                                              markerX + markerWidth,
-                                              spectrumHeight,
-                                              markerX,
-                                              0.0f,
-                                              markerX + markerWidth,
-                                              spectrumHeight,
-                                              markerX,
-                                              spectrumHeight};
-
-                QRhiResourceUpdateBatch *mkRub = m_rhi->nextResourceUpdateBatch();
-                mkRub->updateDynamicBuffer(m_markerVbo.get(), 0, markerVerts.size() * sizeof(float),
-                                           markerVerts.constData());
-
-                struct {
-                    float viewportWidth;
-                    float viewportHeight;
-                    float pad0, pad1;
-                    float r, g, b, a;
-                } mkUniforms = {w,
-                                h,
-                                0,
-                                0,
-                                static_cast<float>(m_frequencyMarkerColor.redF()),
-                                static_cast<float>(m_frequencyMarkerColor.greenF()),
-                                static_cast<float>(m_frequencyMarkerColor.blueF()),
-                                static_cast<float>(m_frequencyMarkerColor.alphaF())};
-                mkRub->updateDynamicBuffer(m_markerUniformBuffer.get(), 0, sizeof(mkUniforms), &mkUniforms);
-
-                cb->resourceUpdate(mkRub);
-                cb->setGraphicsPipeline(m_overlayTrianglePipeline.get());
-                cb->setShaderResources(m_markerSrb.get());
-                const QRhiCommandBuffer::VertexInput mkVbufBinding(m_markerVbo.get(), 0);
-                cb->setVertexInput(0, 1, &mkVbufBinding);
-                cb->draw(6);
-            }
+            // Calculate notch offset from passband center in Hz
+            qint64 notchOffsetHz = notchFreq - passbandCenterFreq;
+
+            // Get passband center screen position and add the offset
+            float passbandCenterX = freqToNormalized(passbandCenterFreq) * w;
+            float notchX = passbandCenterX + (static_cast<float>(notchOffsetHz) * w) / m_spanHz;
+            bool inBounds = (notchX >= 0 && notchX <= w);
 
-            // Draw notch filter marker (red line) - uses dedicated notch buffers
-            // Calculate notch position relative to the passband center
-            // This ensures correct alignment regardless of tunedFreq/centerFreq mismatch
-            if (m_notchEnabled && m_notchPitchHz > 0 && m_spanHz > 0) {
-                // First, find where the passband center is on screen
-                // For CW: passbandCenter = tunedFreq + cwPitch
-                // For USB/DATA: passbandCenter = tunedFreq + shiftOffset
-                // For LSB: passbandCenter = tunedFreq - shiftOffset
-                // For AM/FM: passbandCenter = tunedFreq
-                qint64 passbandCenterFreq;
-                if (m_mode == "CW") {
-                    passbandCenterFreq = m_tunedFreq + m_cwPitch;
-                } else if (m_mode == "CW-R") {
-                    passbandCenterFreq = m_tunedFreq - m_cwPitch;
-                } else if (m_mode == "LSB") {
-                    int shiftOffsetHz = m_ifShift * 10;
-                    passbandCenterFreq = m_tunedFreq - shiftOffsetHz;
-                } else if (m_mode == "USB" || m_mode == "DATA" || m_mode == "DATA-R") {
-                    int shiftOffsetHz = m_ifShift * 10;
-                    passbandCenterFreq = m_tunedFreq + shiftOffsetHz;
-                } else {
-                    // AM/FM: centered on carrier
-                    passbandCenterFreq = m_tunedFreq;
-                }
-
-                // Calculate notch RF frequency - notch pitch is audio offset from carrier
-                qint64 notchFreq;
-                if (m_mode == "LSB") {
-                    notchFreq = m_tunedFreq - m_notchPitchHz;
-                } else {
-                    notchFreq = m_tunedFreq + m_notchPitchHz;
-                }
-
-                // Calculate notch offset from passband center in Hz
-                qint64 notchOffsetHz = notchFreq - passbandCenterFreq;
-
-                // Get passband center screen position and add the offset
-                float passbandCenterX = freqToNormalized(passbandCenterFreq) * w;
-                float notchX = passbandCenterX + (static_cast<float>(notchOffsetHz) * w) / m_spanHz;
-                bool inBounds = (notchX >= 0 && notchX <= w);
-
-                if (inBounds) {
-                    // Draw as filled rectangle (2px wide) instead of line for robust rendering
-                    float notchWidth = 2.0f;
-                    QVector<float> notchVerts = {notchX,
-                                                 0.0f,
-                                                 notchX + notchWidth,
-                                                 0.0f,
-                                                 notchX + notchWidth,
-                                                 spectrumHeight,
-                                                 notchX,
-                                                 0.0f,
-                                                 notchX + notchWidth,
-                                                 spectrumHeight,
-                                                 notchX,
-                                                 spectrumHeight};
-
-                    QRhiResourceUpdateBatch *notchRub = m_rhi->nextResourceUpdateBatch();
-                    notchRub->updateDynamicBuffer(m_notchVbo.get(), 0, notchVerts.size() * sizeof(float),
-                                                  notchVerts.constData());
-
-                    struct {
-                        float viewportWidth;
-                        float viewportHeight;
-                        float pad0, pad1;
-                        float r, g, b, a;
-                    } notchUniforms = {w,
-                                       h,
-                                       0,
-                                       0,
-                                       static_cast<float>(m_notchColor.redF()),
-                                       static_cast<float>(m_notchColor.greenF()),
-                                       static_cast<float>(m_notchColor.blueF()),
-                                       static_cast<float>(m_notchColor.alphaF())};
-                    notchRub->updateDynamicBuffer(m_notchUniformBuffer.get(), 0, sizeof(notchUniforms), &notchUniforms);
-
-                    cb->resourceUpdate(notchRub);
-                    cb->setGraphicsPipeline(m_overlayTrianglePipeline.get()); // Use triangles not lines
-                    cb->setShaderResources(m_notchSrb.get());
-                    const QRhiCommandBuffer::VertexInput notchVbufBinding(m_notchVbo.get(), 0);
-                    cb->setVertexInput(0, 1, &notchVbufBinding);
-                    cb->draw(6); // 2 triangles = 6 vertices
-                }
+            if (inBounds) {
+                // Draw as filled rectangle (2px wide) instead of line for robust rendering
+                float notchWidth = 2.0f;
+                m_overlayBatch.addRect(notchX, 0.0f, notchX + notchWidth, spectrumHeight, m_notchColor);
             }
         }
     }
-
-    cb->endPass();
 }
 
 void PanadapterRhiWidget::updateSpectrum(const QByteArray &bins, qint64 centerFreq, qint32 sampleRate,
@@ -1321,103 +962,493 @@ void PanadapterRhiWidget::updateSpectrum(const QByteArray &bins, qint64 centerFr
     int totalBins = bins.size();
 
     // Extract center bins if tier span > commanded span
-    QByteArray binsToUse;
+    int firstBin = 0;
+    int binCount = totalBins;
     if (tierSpanHz > m_spanHz && totalBins > 100 && m_spanHz > 0) {
         int requestedBins = (static_cast<qint64>(m_spanHz) * totalBins) / tierSpanHz;
-        requestedBins = qBound(50, requestedBins, totalBins);
-        int centerStart = (totalBins - requestedBins) / 2; // Center extraction
-        binsToUse = bins.mid(centerStart, requestedBins);
-    } else {
-        binsToUse = bins;
+        binCount = qBound(50, requestedBins, totalBins);
+        firstBin = (totalBins - binCount) / 2; // Center extraction
     }
 
-    // Decompress bins to dB values
-    decompressBins(binsToUse, m_rawSpectrum);
+    // K4 spectrum bins: dBm = raw_byte - K4_DBM_OFFSET
+    // The extracted bins cover their share of the tier span
+    const qint32 binsSpanHz =
+        totalBins > 0 ? static_cast<qint32>(static_cast<qint64>(binCount) * tierSpanHz / totalBins) : m_spanHz;
+    // The signal index shares the display's noise floor: one histogram pass per packet
+    const float noiseFloorDb =
+        queueBins(bins, firstBin, binCount, 1.0f, -K4_DBM_OFFSET, PAN_DECAY_ALPHA, centerFreq, binsSpanHz);
+    m_signalIndex.update(reinterpret_cast<const quint8 *>(bins.constData()) + firstBin, binCount, centerFreq,
+                         binsSpanHz, 1.0f, -K4_DBM_OFFSET, noiseFloorDb);
+
+    // Record the displayed bins; a scrolled-back view stays on the same rows as new ones arrive
+    if (m_history.isOpen() && totalBins > 0) {
+        const bool newRow =
+            m_history.append(QDateTime::currentMSecsSinceEpoch(), centerFreq, binsSpanHz,
+                             reinterpret_cast<const quint8 *>(bins.constData()) + firstBin, binCount);
+        if (newRow && m_historyOffset > 0 && m_historyOffset < m_history.rowCount() - 1) {
+            if (m_historyPaged.offset == m_historyOffset)
+                m_historyPaged.offset++; // Same rows, nothing to re-page
+            m_historyOffset++;
+        }
+    }
 
-    // Apply exponential smoothing for gradual decay (attack fast, decay slow)
-    constexpr float attackAlpha = 0.85f; // Fast attack (new peaks appear quickly)
-    constexpr float decayAlpha = 0.45f;  // Moderate decay for crisp waterfall
+    updateFreqScaleOverlay(); // Update frequency labels when center freq changes
+    scheduleFrame();
+}
 
-    if (m_currentSpectrum.size() != m_rawSpectrum.size()) {
-        m_currentSpectrum = m_rawSpectrum;
-    } else {
-        for (int i = 0; i < m_rawSpectrum.size(); ++i) {
-            float alpha = (m_rawSpectrum[i] > m_currentSpectrum[i]) ? attackAlpha : decayAlpha;
-            m_currentSpectrum[i] = alpha * m_rawSpectrum[i] + (1.0f - alpha) * m_currentSpectrum[i];
-        }
+void PanadapterRhiWidget::updateMiniSpectrum(const QByteArray &bins) {
+    // MiniPAN bins: dBm = raw_byte * 10 - 160
+    queueBins(bins, 0, bins.size(), 10.0f, -160.0f, MINI_DECAY_ALPHA, m_centerFreq, m_spanHz);
+    scheduleFrame();
+}
+
+float PanadapterRhiWidget::queueBins(const QByteArray &bins, int first, int count, float dbScale, float dbOffset,
+                                    float decayAlpha, qint64 centerFreq, qint32 spanHz) {
+    if (count <= 0)
+        return m_noiseFloorEstimator.floorDb();
+
+    // Packets within one RenderScheduler tick queue up for the same frame, which processes them
+    // in order. A packet that changes the layout replaces the queue: the spectrum state is resized
+    // before the first pass.
+    if (first != m_pendingFirstBin || count != m_pendingBinCount || dbScale != m_pendingDbScale ||
+        dbOffset != m_pendingDbOffset || centerFreq != m_pendingCenterFreq || spanHz != m_pendingSpanHz)
+        m_pendingPackets.clear();
+    else if (m_pendingPackets.size() == MAX_PACKETS_PER_FRAME)
+        m_pendingPackets.removeFirst(); // Far behind; the newest packets matter most
+
+    // Noise floor of the packet's raw bytes (normalizes the fill) and the peak hold's fall since
+    // the previous packet, both per packet on the CPU
+    if (count != m_pendingBinCount)
+        m_noiseFloorEstimator.reset(); // The state restarts with the new bin count
+    PendingPacket packet;
+    packet.bins = bins; // Kept until the frame uploads it (no copy)
+    packet.noiseFloorDb = m_noiseFloorEstimator.update(reinterpret_cast<const quint8 *>(bins.constData()) + first,
+                                                       count, dbScale, dbOffset);
+    packet.peakDecay = 0.0f;
+    if (m_peakDecayClock.isValid())
+        packet.peakDecay = PEAK_DECAY_RATE * m_peakDecayClock.restart() / PEAK_DECAY_INTERVAL_MS;
+    else
+        m_peakDecayClock.start();
+    m_pendingPackets.append(packet);
+
+    m_pendingFirstBin = first;
+    m_pendingBinCount = count;
+    m_pendingDbScale = dbScale;
+    m_pendingDbOffset = dbOffset;
+    m_pendingDecayAlpha = decayAlpha;
+    m_pendingCenterFreq = centerFreq;
+    m_pendingSpanHz = spanHz;
+    return packet.noiseFloorDb;
+}
+
+void PanadapterRhiWidget::resizeSpectrumState(int binCount) {
+    m_binTexture->setPixelSize(QSize(binCount, 1));
+    m_binTexture->create();
+    for (int i = 0; i < 2; ++i) {
+        m_spectrumState[i]->setPixelSize(QSize(binCount + 1, 1));
+        m_spectrumState[i]->create();
+        m_spectrumStateRt[i]->create();
     }
 
-    // Update peak hold
-    if (m_peakHoldEnabled) {
-        if (m_peakHold.size() != m_currentSpectrum.size()) {
-            m_peakHold = m_currentSpectrum;
-        } else {
-            for (int i = 0; i < m_currentSpectrum.size(); ++i) {
-                if (m_currentSpectrum[i] > m_peakHold[i]) {
-                    m_peakHold[i] = m_currentSpectrum[i];
-                }
-            }
+    // Rebuild the bindings so they pick up the recreated textures
+    for (int i = 0; i < 2; ++i) {
+        m_spectrumProcessSrb[i]->create();
+        m_waterfallRowSrb[i]->create();
+        m_spectrumBlueAmpSrb[i]->create();
+    }
+
+    m_binCount = binCount;
+    m_spectrumStateReset = true;
+}
+
+void PanadapterRhiWidget::processSpectrum(QRhiCommandBuffer *cb, QRhiResourceUpdateBatch *rub) {
+    if (m_pendingBinCount != m_binCount)
+        resizeSpectrumState(m_pendingBinCount);
+
+    // Bins are centered in the waterfall texture (waterfall_aligned.frag uses the same offset)
+    struct {
+        float minDb;
+        float maxDb;
+        float binCount;
+        float binOffset;
+    } rowUniforms = {m_minDb, m_maxDb, static_cast<float>(m_binCount),
+                     static_cast<float>((m_textureWidth - m_binCount) / 2)};
+    rub->updateDynamicBuffer(m_waterfallRowUniformBuffer.get(), 0, sizeof(rowUniforms), &rowUniforms);
+
+    if (!m_waterfallRefValid) {
+        m_waterfallRefFreq = m_pendingCenterFreq;
+        m_waterfallRefValid = true;
+    }
+    m_waterfallViewCenter = m_pendingCenterFreq;
+    m_waterfallViewSpan = m_pendingSpanHz;
+
+    const QRhiCommandBuffer::VertexInput quadVbufBinding(m_fullscreenQuadVbo, 0);
+    for (int p = 0; p < m_pendingPackets.size(); ++p) {
+        const PendingPacket &packet = m_pendingPackets[p];
+        if (p > 0)
+            rub = m_rhi->nextResourceUpdateBatch();
+
+        // The packet's bytes go up as-is; decompression happens in the shader. Uploads are
+        // ordered with the passes, so each pass reads its own packet.
+        QRhiTextureSubresourceUploadDescription binUpload(packet.bins.constData() + m_pendingFirstBin, m_binCount);
+        binUpload.setSourceSize(QSize(m_binCount, 1));
+        rub->uploadTexture(m_binTexture.get(), QRhiTextureUploadEntry(0, 0, binUpload));
+
+        struct {
+            float dbScale;
+            float dbOffset;
+            float attackAlpha;
+            float decayAlpha;
+            float peakDecay;
+            float noiseFloorDb;
+            float binCount;
+            float resetHistory;
+            float peakHoldEnabled;
+            float averageMode;
+            float averageAlpha;
+            float minHoldEnabled;
+        } processUniforms = {m_pendingDbScale,
+                             m_pendingDbOffset,
+                             ATTACK_ALPHA,
+                             m_pendingDecayAlpha,
+                             packet.peakDecay,
+                             packet.noiseFloorDb,
+                             static_cast<float>(m_binCount),
+                             m_spectrumStateReset ? 1.0f : 0.0f,
+                             m_spectrumTrace == SpectrumTrace::PeakHold ? 1.0f : 0.0f,
+                             m_averagingFrames > 0 ? (m_averagingMode == AveragingMode::Linear ? 2.0f : 1.0f) : 0.0f,
+                             m_averagingFrames > 0 ? 1.0f / m_averagingFrames : 1.0f,
+                             m_spectrumTrace == SpectrumTrace::MinHold ? 1.0f : 0.0f};
+        const quint32 uniformOffset = m_spectrumProcessUniformStride * p;
+        rub->updateDynamicBuffer(m_spectrumProcessUniformBuffer.get(), uniformOffset, sizeof(processUniforms),
+                                 &processUniforms);
+
+        // The row's frequency window, one texel beside it (the row itself is never rewritten)
+        if (m_waterfallReproject) {
+            const float rowInfo[4] = {static_cast<float>(m_pendingCenterFreq - m_waterfallRefFreq),
+                                      static_cast<float>(m_pendingSpanHz), static_cast<float>(m_binCount), 1.0f};
+            QRhiTextureSubresourceUploadDescription rowInfoUpload(rowInfo, sizeof(rowInfo));
+            rowInfoUpload.setDestinationTopLeft(QPoint(m_waterfallWriteRow, 0));
+            rowInfoUpload.setSourceSize(QSize(1, 1));
+            rub->uploadTexture(m_waterfallRowInfo.get(), QRhiTextureUploadEntry(0, 0, rowInfoUpload));
         }
+
+        const int next = 1 - m_spectrumStateIndex;
+
+        // Smooth the packet into the other state texture (reads the current one)
+        const QRhiCommandBuffer::DynamicOffset processOffset(0, uniformOffset);
+        cb->beginPass(m_spectrumStateRt[next].get(), Qt::black, {1.0f, 0}, rub);
+        cb->setGraphicsPipeline(m_spectrumProcessPipeline);
+        cb->setViewport({0, 0, static_cast<float>(m_binCount + 1), 1});
+        cb->setShaderResources(m_spectrumProcessSrb[next].get(), 1, &processOffset);
+        cb->setVertexInput(0, 1, &quadVbufBinding);
+        cb->draw(6);
+        cb->endPass();
+
+        // Render the new row into the waterfall history. Viewports are bottom-up; on APIs whose
+        // framebuffers run top-down, flip so the row lands where waterfall.vert expects it.
+        const int viewportRow =
+            m_rhi->isYUpInFramebuffer() ? m_waterfallWriteRow : m_waterfallHistory - 1 - m_waterfallWriteRow;
+        cb->beginPass(m_waterfallRowRt.get(), Qt::black, {1.0f, 0});
+        cb->setGraphicsPipeline(m_waterfallRowPipeline);
+        cb->setViewport({0, static_cast<float>(viewportRow), static_cast<float>(m_textureWidth), 1});
+        cb->setShaderResources(m_waterfallRowSrb[next].get());
+        cb->setVertexInput(0, 1, &quadVbufBinding);
+        cb->draw(6);
+        cb->endPass();
+
+        m_spectrumStateIndex = next;
+        m_spectrumStateReset = false;
+        m_waterfallWriteRow = (m_waterfallWriteRow + 1) % m_waterfallHistory;
+        m_waterfallNarrowRows =
+            waterfallWidthFor(m_binCount) <= m_textureWidth / 2 ? m_waterfallNarrowRows + 1 : 0;
     }
+    m_waterfallEmpty = false;
+    m_pendingPackets.clear();
+}
 
-    m_waterfallNeedsUpdate = true;
-    updateFreqScaleOverlay(); // Update frequency labels when center freq changes
-    update();
+// =============================================================================
+// Waterfall storage
+// =============================================================================
+
+int PanadapterRhiWidget::waterfallWidthFor(int binCount) {
+    // Powers of two: any two widths differ by an even number of texels, so centered rows stay centered
+    int width = MIN_TEXTURE_WIDTH;
+    while (width < binCount && width < BASE_TEXTURE_WIDTH)
+        width *= 2;
+    return width;
 }
 
-void PanadapterRhiWidget::updateMiniSpectrum(const QByteArray &bins) {
-    m_rawSpectrum.resize(bins.size());
-    for (int i = 0; i < bins.size(); ++i) {
-        m_rawSpectrum[i] = static_cast<quint8>(bins[i]) * 10.0f - 160.0f;
+int PanadapterRhiWidget::waterfallRowsFor(float heightPx) {
+    const int steps = (static_cast<int>(std::ceil(heightPx)) + WATERFALL_HISTORY_STEP - 1) / WATERFALL_HISTORY_STEP;
+    return qBound(MIN_WATERFALL_HISTORY, steps * WATERFALL_HISTORY_STEP, BASE_WATERFALL_HISTORY);
+}
+
+void PanadapterRhiWidget::createWaterfallStorage(int width, int rows) {
+    m_textureWidth = width;
+    m_waterfallHistory = rows;
+
+    // Single channel for normalized dB; rows are rendered into it and copied out on resize
+    m_waterfallTexture.reset(m_rhi->newTexture(QRhiTexture::R8, QSize(width, rows), 1,
+                                               QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+    m_waterfallTexture->create();
+
+    // Row info (center, span, bin count, valid) per waterfall row; Hz needs full float precision
+    if (m_waterfallReproject)
+        m_waterfallRowInfo.reset(m_rhi->newTexture(QRhiTexture::RGBA32F, QSize(rows, 1), 1,
+                                                   QRhiTexture::UsedAsTransferSource));
+    else
+        m_waterfallRowInfo.reset(m_rhi->newTexture(QRhiTexture::RGBA8, QSize(1, 1)));
+    m_waterfallRowInfo->create();
+
+    // Rows are rendered in place, so the rest of the history must survive the pass; the clear
+    // target is the same texture loaded as black
+    m_waterfallRowRt.reset(m_rhi->newTextureRenderTarget({m_waterfallTexture.get()},
+                                                         QRhiTextureRenderTarget::PreserveColorContents));
+    if (!m_waterfallRowRpDesc)
+        m_waterfallRowRpDesc.reset(m_waterfallRowRt->newCompatibleRenderPassDescriptor());
+    m_waterfallRowRt->setRenderPassDescriptor(m_waterfallRowRpDesc.get());
+    m_waterfallRowRt->create();
+
+    m_waterfallClearRt.reset(m_rhi->newTextureRenderTarget({m_waterfallTexture.get()}));
+    if (!m_waterfallClearRpDesc)
+        m_waterfallClearRpDesc.reset(m_waterfallClearRt->newCompatibleRenderPassDescriptor());
+    m_waterfallClearRt->setRenderPassDescriptor(m_waterfallClearRpDesc.get());
+    m_waterfallClearRt->create();
+
+    // Scrollback window: one line per waterfall row, one texel per stored history bin
+    if (!m_historyTexture)
+        m_historyTexture.reset(m_rhi->newTexture(QRhiTexture::R8, QSize(HISTORY_TEXTURE_WIDTH, rows)));
+    else
+        m_historyTexture->setPixelSize(QSize(HISTORY_TEXTURE_WIDTH, rows));
+    m_historyTexture->create();
+    m_historyPage.resize(HISTORY_TEXTURE_WIDTH * rows);
+    m_historyPaged = HistoryView();
+
+    // The waterfall bindings exist once the pipelines do
+    if (m_waterfallSrb)
+        updateWaterfallBindings();
+}
+
+void PanadapterRhiWidget::updateWaterfallBindings() {
+    m_waterfallSrb->setBindings(
+        {QRhiShaderResourceBinding::uniformBuffer(
+             0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
+             m_waterfallUniformBuffer.get()),
+         QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_waterfallTexture.get(), m_sampler),
+         QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_colorLutTexture, m_sampler),
+         QRhiShaderResourceBinding::sampledTexture(3, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_waterfallRowInfo.get(), m_sampler)});
+    m_waterfallSrb->create();
+
+    // Same layout, sampling the scrollback window instead of the live history
+    m_historySrb->setBindings(
+        {QRhiShaderResourceBinding::uniformBuffer(
+             0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
+             m_waterfallUniformBuffer.get()),
+         QRhiShaderResourceBinding::sampledTexture(1, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_historyTexture.get(), m_sampler),
+         QRhiShaderResourceBinding::sampledTexture(2, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_colorLutTexture, m_sampler),
+         QRhiShaderResourceBinding::sampledTexture(3, QRhiShaderResourceBinding::FragmentStage,
+                                                   m_waterfallRowInfo.get(), m_sampler)});
+    m_historySrb->create();
+}
+
+void PanadapterRhiWidget::uploadWaterfallQuad(QRhiResourceUpdateBatch *rub) {
+    const float tMax = static_cast<float>(m_waterfallHistory - 1) / m_waterfallHistory;
+    const float waterfallQuad[] = {
+        // position (x, y), texcoord (s, t)
+        -1.0f, -1.0f, 0.0f, 0.0f, // bottom-left
+        1.0f,  -1.0f, 1.0f, 0.0f, // bottom-right
+        1.0f,  1.0f,  1.0f, tMax, // top-right
+        -1.0f, -1.0f, 0.0f, 0.0f, // bottom-left
+        1.0f,  1.0f,  1.0f, tMax, // top-right
+        -1.0f, 1.0f,  0.0f, tMax  // top-left
+    };
+    rub->uploadStaticBuffer(m_waterfallVbo.get(), waterfallQuad);
+}
+
+void PanadapterRhiWidget::updateWaterfallStorage(QRhiCommandBuffer *cb, float waterfallHeight) {
+    // A full clear (disconnect, first frame) forgets every row, so nothing is worth copying
+    if (m_waterfallNeedsFullClear) {
+        m_waterfallWriteRow = 0;
+        m_waterfallNarrowRows = 0;
+        m_waterfallEmpty = true;
+        m_waterfallRefValid = false;
+    }
+
+    // Grow as soon as a packet needs it; shrink only once every stored row fits half the width
+    int width = m_textureWidth;
+    if (!m_pendingPackets.isEmpty()) {
+        const int needed = waterfallWidthFor(m_pendingBinCount);
+        if (needed > width || m_waterfallEmpty)
+            width = needed;
+        else if (m_waterfallNarrowRows >= m_waterfallHistory)
+            width = qMax(needed, width / 2);
     }
+    const int rows = waterfallRowsFor(waterfallHeight);
 
-    // Apply exponential smoothing for gradual decay (attack fast, decay slow)
-    constexpr float attackAlpha = 0.85f; // Fast attack
-    constexpr float decayAlpha = 0.38f;  // Slower decay (visible glow effect)
+    if (width != m_textureWidth || rows != m_waterfallHistory)
+        resizeWaterfall(cb, width, rows);
+    else if (m_waterfallNeedsFullClear)
+        clearWaterfall(cb);
+    m_waterfallNeedsFullClear = false;
+}
+
+void PanadapterRhiWidget::resizeWaterfall(QRhiCommandBuffer *cb, int width, int rows) {
+    // The old textures stay alive until the copies below are recorded (QRhi defers their release)
+    std::unique_ptr<QRhiTexture> oldTexture = std::move(m_waterfallTexture);
+    std::unique_ptr<QRhiTexture> oldRowInfo = std::move(m_waterfallRowInfo);
+    const int oldWidth = m_textureWidth;
+    const int oldRows = m_waterfallHistory;
 
-    if (m_currentSpectrum.size() != m_rawSpectrum.size()) {
-        m_currentSpectrum = m_rawSpectrum;
-    } else {
-        for (int i = 0; i < m_rawSpectrum.size(); ++i) {
-            float alpha = (m_rawSpectrum[i] > m_currentSpectrum[i]) ? attackAlpha : decayAlpha;
-            m_currentSpectrum[i] = alpha * m_rawSpectrum[i] + (1.0f - alpha) * m_currentSpectrum[i];
+    createWaterfallStorage(width, rows);
+    clearWaterfall(cb);
+
+    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
+    uploadWaterfallQuad(rub);
+
+    // Copy the newest rows, oldest first, so the next row goes right after them. Bins stay centered:
+    // widths are powers of two, and a narrower texture is only chosen once every row fits it.
+    const int keep = m_waterfallEmpty ? 0 : qMin(oldRows, rows);
+    const int copyWidth = qMin(oldWidth, width);
+    int source = (m_waterfallWriteRow - keep + oldRows) % oldRows;
+    for (int dest = 0; dest < keep;) {
+        const int count = qMin(keep - dest, oldRows - source);
+        QRhiTextureCopyDescription rowsCopy;
+        rowsCopy.setPixelSize(QSize(copyWidth, count));
+        rowsCopy.setSourceTopLeft(QPoint((oldWidth - copyWidth) / 2, source));
+        rowsCopy.setDestinationTopLeft(QPoint((width - copyWidth) / 2, dest));
+        rub->copyTexture(m_waterfallTexture.get(), oldTexture.get(), rowsCopy);
+
+        if (m_waterfallReproject) {
+            QRhiTextureCopyDescription rowInfoCopy;
+            rowInfoCopy.setPixelSize(QSize(count, 1));
+            rowInfoCopy.setSourceTopLeft(QPoint(source, 0));
+            rowInfoCopy.setDestinationTopLeft(QPoint(dest, 0));
+            rub->copyTexture(m_waterfallRowInfo.get(), oldRowInfo.get(), rowInfoCopy);
         }
+        dest += count;
+        source = 0;
     }
+    cb->resourceUpdate(rub);
 
-    m_waterfallNeedsUpdate = true;
-    update();
+    m_waterfallWriteRow = keep % rows;
+    m_waterfallNarrowRows = 0;
 }
 
-void PanadapterRhiWidget::decompressBins(const QByteArray &bins, QVector<float> &out) {
-    // K4 spectrum bins: dBm = raw_byte - K4_DBM_OFFSET
-    out.resize(bins.size());
-    for (int i = 0; i < bins.size(); ++i) {
-        out[i] = static_cast<quint8>(bins[i]) - K4_DBM_OFFSET;
+void PanadapterRhiWidget::clearWaterfall(QRhiCommandBuffer *cb) {
+    // valid = 0 everywhere: rows are blank until written again (16 bytes per row; the rows
+    // themselves are cleared by the pass)
+    QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
+    if (m_waterfallReproject) {
+        const QVector<float> noRows(4 * m_waterfallHistory, 0.0f);
+        QRhiTextureSubresourceUploadDescription rowInfoUpload(noRows.constData(), noRows.size() * sizeof(float));
+        rub->uploadTexture(m_waterfallRowInfo.get(), QRhiTextureUploadEntry(0, 0, rowInfoUpload));
     }
+    cb->beginPass(m_waterfallClearRt.get(), Qt::black, {1.0f, 0}, rub);
+    cb->endPass();
 }
 
-void PanadapterRhiWidget::updateWaterfallData() {
-    if (m_currentSpectrum.isEmpty())
+// =============================================================================
+// Waterfall history
+// =============================================================================
+
+void PanadapterRhiWidget::setHistoryStorage(const QString &directory, const QString &name) {
+    m_historyDirectory = directory;
+    m_historyName = name;
+    openHistoryFile();
+}
+
+void PanadapterRhiWidget::setHistoryBand(int band) {
+    if (m_historyBandSet && band == m_historyBand)
         return;
+    m_historyBand = band;
+    m_historyBandSet = true;
+    openHistoryFile();
+}
 
-    // Upload raw bins centered in texture for shader sampling
-    int row = m_waterfallWriteRow;
-    int specSize = m_currentSpectrum.size();
-    int offset = (m_textureWidth - specSize) / 2;
+void PanadapterRhiWidget::openHistoryFile() {
+    // A different band is a different file: drop back to the live waterfall
+    m_history.close();
+    m_historyPaged = HistoryView();
+    setHistoryOffset(0);
+    if (m_historyDirectory.isEmpty() || m_historyName.isEmpty() || !m_historyBandSet)
+        return;
 
-    // Clear row (zeros outside bin region = no signal)
-    std::memset(&m_waterfallData[row * m_textureWidth], 0, m_textureWidth);
+    const QString band = m_historyBand >= 0 ? QString("band%1").arg(m_historyBand) : QString("gen");
+    m_history.open(QDir(m_historyDirectory).filePath(QString("%1-%2.wfh").arg(m_historyName, band)));
+}
 
-    // Copy raw bins (no interpolation - GPU handles it)
-    for (int i = 0; i < specSize; ++i) {
-        float normalized = normalizeDb(m_currentSpectrum[i]);
-        m_waterfallData[row * m_textureWidth + offset + i] =
-            static_cast<quint8>(qBound(0, static_cast<int>(normalized * 255), 255));
+void PanadapterRhiWidget::setHistoryOffset(int rowsBack) {
+    rowsBack = qBound(0, rowsBack, qMax(0, m_history.rowCount() - 1));
+    if (rowsBack == m_historyOffset)
+        return;
+    m_historyOffset = rowsBack;
+    updateHistoryLabel();
+    scheduleFrame();
+}
+
+void PanadapterRhiWidget::setHistoryZoom(int rowsPerLine) {
+    rowsPerLine = qBound(1, rowsPerLine, MAX_HISTORY_ZOOM);
+    if (rowsPerLine == m_historyZoom)
+        return;
+    m_historyZoom = rowsPerLine;
+    updateHistoryLabel();
+    scheduleFrame();
+}
+
+void PanadapterRhiWidget::pageHistory(QRhiResourceUpdateBatch *rub) {
+    const HistoryView view{m_historyOffset, m_historyZoom, m_centerFreq, m_spanHz, m_minDb, m_maxDb};
+    if (view == m_historyPaged)
+        return;
+
+    // Only the visible window is read from the mapped file, reprojected onto the current span
+    m_history.readWindow(m_historyPage.data(), HISTORY_TEXTURE_WIDTH, m_waterfallHistory, m_historyOffset,
+                         m_historyZoom, m_centerFreq, m_spanHz);
+
+    // Raw K4 bytes -> display range, as waterfall_row.frag does for live rows (0 = no data)
+    quint8 lut[256];
+    lut[0] = 0;
+    for (int raw = 1; raw < 256; ++raw) {
+        const float db = raw - K4_DBM_OFFSET;
+        lut[raw] = static_cast<quint8>(qBound(0.0f, (db - m_minDb) / (m_maxDb - m_minDb), 1.0f) * 255.0f + 0.5f);
     }
+    for (quint8 &value : m_historyPage)
+        value = lut[value];
+
+    QRhiTextureSubresourceUploadDescription upload(m_historyPage.constData(), m_historyPage.size());
+    rub->uploadTexture(m_historyTexture.get(), QRhiTextureUploadEntry(0, 0, upload));
+    m_historyPaged = view;
 }
 
-float PanadapterRhiWidget::normalizeDb(float db) {
-    return qBound(0.0f, (db - m_minDb) / (m_maxDb - m_minDb), 1.0f);
+void PanadapterRhiWidget::updateHistoryLabel() {
+    if (!m_historyLabel)
+        return;
+
+    const WaterfallHistory::RowHeader *row = m_historyOffset > 0 ? m_history.row(m_historyOffset) : nullptr;
+    if (!row) {
+        m_historyLabel->hide();
+        return;
+    }
+
+    // Time of the newest visible line, and how far back that is
+    const QDateTime time = QDateTime::fromMSecsSinceEpoch(row->timestampMs);
+    const qint64 agoSeconds = qMax<qint64>(0, time.secsTo(QDateTime::currentDateTime()));
+    QString text = QString("%1  -%2:%3")
+                       .arg(time.toString("HH:mm:ss"))
+                       .arg(agoSeconds / 60)
+                       .arg(agoSeconds % 60, 2, 10, QChar('0'));
+    if (m_historyZoom > 1)
+        text += QString("  x%1").arg(m_historyZoom);
+    m_historyLabel->setText(text);
+    m_historyLabel->adjustSize();
+    m_historyLabel->move(4, static_cast<int>(height() * m_spectrumRatio) + 4);
+    m_historyLabel->show();
+    m_historyLabel->raise();
 }
 
 float PanadapterRhiWidget::freqToNormalized(qint64 freq) {
@@ -1453,6 +1484,21 @@ qint64 PanadapterRhiWidget::xToFreq(int x, int w) {
     return startFreq + static_cast<qint64>(normalized * m_spanHz);
 }
 
+qint64 PanadapterRhiWidget::snapToSignal(qint64 freq) const {
+    if (!m_signalSnapEnabled || width() <= 0)
+        return freq;
+    const qint32 toleranceHz = static_cast<qint32>(static_cast<qint64>(SIGNAL_SNAP_PX) * m_spanHz / width());
+    const SignalIndex::Entry *signal = m_signalIndex.nearest(freq, toleranceHz);
+    return signal ? signal->frequency : freq;
+}
+
+qint64 PanadapterRhiWidget::nextSignal(qint64 freq, int direction) const {
+    // Step from the signal freq is sitting on (anywhere in a wide one), so it isn't found again
+    const SignalIndex::Entry *current = m_signalIndex.nearest(freq, 0);
+    const SignalIndex::Entry *next = m_signalIndex.next(current ? current->frequency : freq, direction);
+    return next ? next->frequency : 0;
+}
+
 QColor PanadapterRhiWidget::interpolateColor(const QColor &a, const QColor &b, float t) {
     t = qBound(0.0f, t, 1.0f);
     return QColor::fromRgbF(a.redF() + (b.redF() - a.redF()) * t, a.greenF() + (b.greenF() - a.greenF()) * t,
@@ -1493,14 +1539,15 @@ void PanadapterRhiWidget::setDbRange(float minDb, float maxDb) {
     m_minDb = minDb;
     m_maxDb = maxDb;
     updateDbmScaleOverlay(); // Update overlay labels when range changes
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setSpectrumRatio(float ratio) {
     m_spectrumRatio = qBound(0.1f, ratio, 0.9f);
     updateDbmScaleOverlay();  // Resize dBm scale to match new spectrum area
     updateFreqScaleOverlay(); // Reposition frequency labels at boundary
-    update();
+    updateHistoryLabel();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setWaterfallHeight(int percent) {
@@ -1510,7 +1557,8 @@ void PanadapterRhiWidget::setWaterfallHeight(int percent) {
     m_spectrumRatio = qBound(0.1f, ratio, 0.9f);
     updateDbmScaleOverlay();  // Resize dBm scale to match new spectrum area
     updateFreqScaleOverlay(); // Reposition frequency labels at boundary
-    update();
+    updateHistoryLabel();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setTunedFrequency(qint64 freq) {
@@ -1518,25 +1566,25 @@ void PanadapterRhiWidget::setTunedFrequency(qint64 freq) {
         m_tunedFreq = freq;
         m_showWaterfallMarker = true;
         m_waterfallMarkerTimer->start(500);
-        update();
+        scheduleFrame();
     }
 }
 
 void PanadapterRhiWidget::setFilterBandwidth(int bwHz) {
     m_filterBw = bwHz;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setMode(const QString &mode) {
     m_mode = mode;
     updateFreqScaleOverlay();
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setIfShift(int shift) {
     if (m_ifShift != shift) {
         m_ifShift = shift;
-        update();
+        scheduleFrame();
     }
 }
 
@@ -1544,17 +1592,20 @@ void PanadapterRhiWidget::setCwPitch(int pitchHz) {
     if (m_cwPitch != pitchHz) {
         m_cwPitch = pitchHz;
         updateFreqScaleOverlay();
-        update();
+        scheduleFrame();
     }
 }
 
 void PanadapterRhiWidget::clear() {
-    m_currentSpectrum.clear();
-    m_rawSpectrum.clear();
-    m_peakHold.clear();
-    m_waterfallWriteRow = 0;
-    m_waterfallData.fill(0);
+    // Drop the spectrum; the next packet restarts averaging, the holds and the noise floor
+    m_pendingPackets.clear();
+    m_binCount = 0;
+    m_spectrumStateReset = true;
+    m_peakDecayClock.invalidate();
+    m_noiseFloorEstimator.reset();
+    m_signalIndex.clear();
     m_waterfallNeedsFullClear = true;
+    setHistoryOffset(0); // History stays on disk for the next session
 
     // Reset frequency/mode/overlay state so reconnect starts clean
     m_centerFreq = 0;
@@ -1577,26 +1628,31 @@ void PanadapterRhiWidget::clear() {
     if (m_freqScaleOverlay)
         m_freqScaleOverlay->setFrequencyRange(0, 0, 0, "");
 
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setGridEnabled(bool enabled) {
     m_gridEnabled = enabled;
-    update();
+    scheduleFrame();
+}
+
+void PanadapterRhiWidget::setAveraging(int frames, AveragingMode mode) {
+    // Takes effect with the next packet; the averaged state carries over
+    m_averagingFrames = qMax(0, frames);
+    m_averagingMode = mode;
 }
 
-void PanadapterRhiWidget::setPeakHoldEnabled(bool enabled) {
-    m_peakHoldEnabled = enabled;
-    if (!enabled)
-        m_peakHold.clear();
-    update();
+void PanadapterRhiWidget::setSpectrumTrace(SpectrumTrace trace) {
+    // Holds that aren't displayed track the averaged spectrum, so they restart from there
+    m_spectrumTrace = trace;
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setRefLevel(int level) {
     if (m_refLevel != level) {
         m_refLevel = level;
         updateDbRangeFromRefAndScale();
-        update();
+        scheduleFrame();
     }
 }
 
@@ -1607,7 +1663,7 @@ void PanadapterRhiWidget::setScale(int scale) {
     if (m_scale != scale && scale >= 10 && scale <= 150) {
         m_scale = scale;
         updateDbRangeFromRefAndScale();
-        update();
+        scheduleFrame();
     }
 }
 
@@ -1624,7 +1680,7 @@ void PanadapterRhiWidget::setSpan(int spanHz) {
     if (m_spanHz != spanHz && spanHz > 0) {
         m_spanHz = spanHz;
         updateFreqScaleOverlay();
-        update();
+        scheduleFrame();
     }
 }
 
@@ -1632,14 +1688,14 @@ void PanadapterRhiWidget::setNotchFilter(bool enabled, int pitchHz) {
     if (m_notchEnabled != enabled || m_notchPitchHz != pitchHz) {
         m_notchEnabled = enabled;
         m_notchPitchHz = pitchHz;
-        update();
+        scheduleFrame();
     }
 }
 
 void PanadapterRhiWidget::setCursorVisible(bool visible) {
     if (m_cursorVisible != visible) {
         m_cursorVisible = visible;
-        update();
+        scheduleFrame();
     }
 }
 
@@ -1656,71 +1712,71 @@ void PanadapterRhiWidget::setSecondaryVfo(qint64 freq, int bwHz, const QString &
     m_secondaryMode = mode;
     m_secondaryIfShift = ifShift;
     m_secondaryCwPitch = cwPitch;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setSecondaryVisible(bool visible) {
     if (m_secondaryVisible != visible) {
         m_secondaryVisible = visible;
-        update();
+        scheduleFrame();
     }
 }
 
 void PanadapterRhiWidget::setSecondaryPassbandColor(const QColor &color) {
     m_secondaryPassbandColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setSecondaryMarkerColor(const QColor &color) {
     m_secondaryMarkerColor = color;
-    update();
+    scheduleFrame();
 }
 
 // Color setters
 void PanadapterRhiWidget::setSpectrumBaseColor(const QColor &color) {
     m_spectrumBaseColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setSpectrumPeakColor(const QColor &color) {
     m_spectrumPeakColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setSpectrumLineColor(const QColor &color) {
     m_spectrumLineColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setGridColor(const QColor &color) {
     m_gridColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setPeakHoldColor(const QColor &color) {
     m_peakHoldColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setPassbandColor(const QColor &color) {
     m_passbandColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setFrequencyMarkerColor(const QColor &color) {
     m_frequencyMarkerColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setNotchColor(const QColor &color) {
     m_notchColor = color;
-    update();
+    scheduleFrame();
 }
 
 void PanadapterRhiWidget::setBackgroundGradient(const QColor &center, const QColor &edge) {
     m_bgCenterColor = center;
     m_bgEdgeColor = edge;
-    update();
+    scheduleFrame();
 }
 
 // Mouse events
@@ -1728,13 +1784,13 @@ void PanadapterRhiWidget::mousePressEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
         m_isDragging = true;
         m_isRightDragging = false;
-        qint64 freq = xToFreq(event->pos().x(), width());
+        qint64 freq = snapToSignal(xToFreq(event->pos().x(), width()));
         emit frequencyClicked(freq);
         event->accept();
     } else if (event->button() == Qt::RightButton) {
         m_isRightDragging = true;
         m_isDragging = false;
-        qint64 freq = xToFreq(event->pos().x(), width());
+        qint64 freq = snapToSignal(xToFreq(event->pos().x(), width()));
         emit frequencyRightClicked(freq);
         event->accept();
     }
@@ -1800,6 +1856,19 @@ void PanadapterRhiWidget::mouseReleaseEvent(QMouseEvent *event) {
 }
 
 void PanadapterRhiWidget::wheelEvent(QWheelEvent *event) {
+    // Alt+Wheel scrolls back through the waterfall history, Alt+Ctrl+Wheel zooms it (rows per line)
+    if ((event->modifiers() & Qt::AltModifier) && m_history.isOpen()) {
+        const int steps = m_wheelAccumulator.accumulate(event, 3);
+        if (steps != 0) {
+            if (event->modifiers() & Qt::ControlModifier)
+                setHistoryZoom(steps > 0 ? m_historyZoom * 2 : m_historyZoom / 2);
+            else
+                setHistoryOffset(m_historyOffset + steps * HISTORY_SCROLL_LINES * m_historyZoom);
+        }
+        event->accept();
+        return;
+    }
+
     int key = 0; // frequency (no modifier)
     if (event->modifiers() & Qt::ShiftModifier)
         key = 1; // scale
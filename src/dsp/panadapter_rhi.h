@@ -4,10 +4,15 @@
 #include <QRhiWidget>
 #include <rhi/qrhi.h>
 #include <QColor>
+#include <QLabel>
 #include <QElapsedTimer>
 #include <QTimer>
 #include <QVector>
 #include <memory>
+#include "noisefloor.h"
+#include "overlaybatch.h"
+#include "signalindex.h"
+#include "waterfallhistory.h"
 #include "../ui/wheelaccumulator.h"
 
 // Forward declarations for overlay widgets
@@ -41,7 +46,13 @@ public:
 
     // Display settings
     void setGridEnabled(bool enabled);
-    void setPeakHoldEnabled(bool enabled);
+
+    // Spectrum post-processing, once per packet on the GPU (driven by the radio's #AVG and #PKM).
+    // Averaging over N frames is exponential with weight 1/N; 0 frames = fast-attack/slow-decay smoothing.
+    enum class AveragingMode { Log, Linear }; // Average dB, or average power
+    enum class SpectrumTrace { Average, PeakHold, MinHold };
+    void setAveraging(int frames, AveragingMode mode = AveragingMode::Log);
+    void setSpectrumTrace(SpectrumTrace trace);
     void setRefLevel(int level);
     void setScale(int scale); // 25-150, affects display gain/range
     void setSpan(int spanHz);
@@ -68,6 +79,36 @@ public:
     void setNotchColor(const QColor &color);
     void setBackgroundGradient(const QColor &center, const QColor &edge);
 
+    // Waterfall history: every packet is recorded to <directory>/<name>-band<N>.wfh (see
+    // WaterfallHistory). Recording starts once both the storage and a band are set.
+    void setHistoryStorage(const QString &directory, const QString &name);
+    void setHistoryBand(int band); // K4 band number, -1 = general coverage
+
+    // Scrollback: rows back from the newest (0 = live waterfall) and rows merged per waterfall line
+    void setHistoryOffset(int rowsBack);
+    void setHistoryZoom(int rowsPerLine);
+    int historyOffset() const { return m_historyOffset; }
+    int historyZoom() const { return m_historyZoom; }
+
+    // Signals detected in the PAN packets (see SignalIndex). Clicks within SIGNAL_SNAP_PX of one tune
+    // to its peak; nextSignal() is the signal after freq going up (direction > 0) or down, 0 if none.
+    void setSignalSnapEnabled(bool enabled) { m_signalSnapEnabled = enabled; }
+    QVector<SignalIndex::Entry> detectedSignals() const { return m_signalIndex.signalList(); }
+    qint64 nextSignal(qint64 freq, int direction) const;
+
+    // Offscreen rendering (benchmarks, golden images): draws exactly what render() draws, into a
+    // render target of any QRhi (Null backend, software OpenGL, ...). Use instead of showing the widget.
+    void initializeOffscreen(QRhi *offscreenRhi, QRhiCommandBuffer *cb);
+    void renderOffscreen(QRhiCommandBuffer *cb, QRhiRenderTarget *target);
+
+    // CPU time spent recording the last frame, in nanoseconds
+    struct FrameTiming {
+        qint64 uploadNs = 0;  // Waterfall storage, packet upload and processing passes, uniforms
+        qint64 overlayNs = 0; // Grid, passband and marker geometry
+        qint64 recordNs = 0;  // Main pass command recording
+    };
+    FrameTiming lastFrameTiming() const { return m_frameTiming; }
+
 signals:
     void frequencyClicked(qint64 freq);
     void frequencyDragged(qint64 freq);
@@ -99,18 +140,42 @@ private:
     // Update dB range based on current ref level and scale
     void updateDbRangeFromRefAndScale();
     // Initialization
-    void initColorLUT();
-    void initSpectrumLUT();
-    void createPipelines();
-
-    // Data processing
-    void decompressBins(const QByteArray &bins, QVector<float> &out);
-    void updateWaterfallData();
+    void initializeResources(QRhiCommandBuffer *cb); // m_rhi must be set
+    void createPipelines(QRhiRenderPassDescriptor *rpDesc);
+    void renderFrame(QRhiCommandBuffer *cb, QRhiRenderTarget *target);
+
+    // GPU spectrum processing
+    // Queue a packet for the next frame; returns its smoothed noise floor in dB
+    float queueBins(const QByteArray &bins, int first, int count, float dbScale, float dbOffset, float decayAlpha,
+                    qint64 centerFreq, qint32 spanHz);
+    void resizeSpectrumState(int binCount);
+    void processSpectrum(QRhiCommandBuffer *cb, QRhiResourceUpdateBatch *rub);
+
+    // Waterfall storage (see m_textureWidth)
+    static int waterfallWidthFor(int binCount);
+    static int waterfallRowsFor(float heightPx);
+    void createWaterfallStorage(int width, int rows);
+    void updateWaterfallBindings();
+    void uploadWaterfallQuad(QRhiResourceUpdateBatch *rub);
+    void updateWaterfallStorage(QRhiCommandBuffer *cb, float waterfallHeight);
+    void resizeWaterfall(QRhiCommandBuffer *cb, int width, int rows);
+    void clearWaterfall(QRhiCommandBuffer *cb); // GPU clear of the rows, zeroes their row info
+
+    // Queue this frame's grid, passband and marker geometry into m_overlayBatch
+    void buildOverlayGeometry(float w, float spectrumHeight);
+
+    // Repaint on the next RenderScheduler tick (instead of update())
+    void scheduleFrame();
+
+    // Waterfall history
+    void openHistoryFile();
+    void pageHistory(QRhiResourceUpdateBatch *rub);
+    void updateHistoryLabel();
 
     // Coordinate helpers
-    float normalizeDb(float db);
     float freqToNormalized(qint64 freq);
     qint64 xToFreq(int x, int w);
+    qint64 snapToSignal(qint64 freq) const;
     QColor interpolateColor(const QColor &a, const QColor &b, float t);
     QColor spectrumGradientColor(float t); // 5-stop teal-to-white gradient
 
@@ -118,77 +183,103 @@ private:
     QRhi *m_rhi = nullptr;
     std::unique_ptr<QRhiBuffer> m_waterfallVbo;
     std::unique_ptr<QRhiBuffer> m_waterfallUniformBuffer;
-    std::unique_ptr<QRhiBuffer> m_overlayVbo;
-    std::unique_ptr<QRhiBuffer> m_overlayUniformBuffer;
-    std::unique_ptr<QRhiBuffer> m_passbandVbo;
-    std::unique_ptr<QRhiBuffer> m_passbandUniformBuffer;
-    std::unique_ptr<QRhiBuffer> m_markerVbo;
-    std::unique_ptr<QRhiBuffer> m_markerUniformBuffer;
-    std::unique_ptr<QRhiBuffer> m_notchVbo;
-    std::unique_ptr<QRhiBuffer> m_notchUniformBuffer;
     std::unique_ptr<QRhiTexture> m_waterfallTexture;
-    std::unique_ptr<QRhiTexture> m_colorLutTexture;
-    std::unique_ptr<QRhiTexture> m_spectrumDataTexture; // 1D texture for spectrum values
-    std::unique_ptr<QRhiSampler> m_sampler;
-    std::unique_ptr<QRhiGraphicsPipeline> m_waterfallPipeline;
-    std::unique_ptr<QRhiGraphicsPipeline> m_overlayLinePipeline;
-    std::unique_ptr<QRhiGraphicsPipeline> m_overlayTrianglePipeline;
-    std::unique_ptr<QRhiBuffer> m_fullscreenQuadVbo; // Shared fullscreen quad for fragment-shader styles
+    std::unique_ptr<QRhiTexture> m_waterfallRowInfo; // Per row: center, span, bin count, valid (see waterfall.frag)
+    // Shared with the other spectrum widgets, owned by RhiResourceCache
+    QRhiTexture *m_colorLutTexture = nullptr;
+    QRhiTexture *m_spectrumColorLutTexture = nullptr; // 256-entry color LUT for the amplitude style
+    QRhiSampler *m_sampler = nullptr;
+    QRhiBuffer *m_fullscreenQuadVbo = nullptr; // Fullscreen quad for fragment-shader styles
+    QRhiGraphicsPipeline *m_waterfallPipeline = nullptr;
+    QRhiGraphicsPipeline *m_spectrumBlueAmpPipeline = nullptr;
+    QRhiGraphicsPipeline *m_spectrumProcessPipeline = nullptr;
+    QRhiGraphicsPipeline *m_waterfallRowPipeline = nullptr;
     // Spectrum amplitude style resources (LUT-based colors)
-    std::unique_ptr<QRhiGraphicsPipeline> m_spectrumBlueAmpPipeline;
-    std::unique_ptr<QRhiShaderResourceBindings> m_spectrumBlueAmpSrb;
+    std::unique_ptr<QRhiShaderResourceBindings> m_spectrumBlueAmpSrb[2]; // [i] samples m_spectrumState[i]
     std::unique_ptr<QRhiBuffer> m_spectrumBlueAmpUniformBuffer;
-    std::unique_ptr<QRhiTexture> m_spectrumColorLutTexture; // 256-entry color LUT
     std::unique_ptr<QRhiShaderResourceBindings> m_waterfallSrb;
-    std::unique_ptr<QRhiShaderResourceBindings> m_overlaySrb;
-    std::unique_ptr<QRhiShaderResourceBindings> m_passbandSrb;
-    std::unique_ptr<QRhiShaderResourceBindings> m_markerSrb;
-    std::unique_ptr<QRhiShaderResourceBindings> m_notchSrb;
-    // Secondary passband buffers (for other VFO's overlay)
-    std::unique_ptr<QRhiBuffer> m_secondaryPassbandVbo;
-    std::unique_ptr<QRhiBuffer> m_secondaryPassbandUniformBuffer;
-    std::unique_ptr<QRhiShaderResourceBindings> m_secondaryPassbandSrb;
-    std::unique_ptr<QRhiBuffer> m_secondaryMarkerVbo;
-    std::unique_ptr<QRhiBuffer> m_secondaryMarkerUniformBuffer;
-    std::unique_ptr<QRhiShaderResourceBindings> m_secondaryMarkerSrb;
+    std::unique_ptr<QRhiTexture> m_historyTexture; // Scrollback window paged from m_history
+    std::unique_ptr<QRhiShaderResourceBindings> m_historySrb;
     QRhiRenderPassDescriptor *m_rpDesc = nullptr;
+    OverlayBatch m_overlayBatch;
+
+    // GPU spectrum processing: each packet's raw bytes are uploaded once, then one pass
+    // smooths them into the spectrum state (ping-pong between two textures) and a second
+    // renders the new waterfall row straight into the waterfall texture
+    std::unique_ptr<QRhiTexture> m_binTexture;       // Raw K4 bytes (R8, binCount x 1)
+    std::unique_ptr<QRhiTexture> m_spectrumState[2]; // (binCount + 1) x 1, see spectrum_process.frag
+    std::unique_ptr<QRhiTextureRenderTarget> m_spectrumStateRt[2];
+    std::unique_ptr<QRhiRenderPassDescriptor> m_spectrumStateRpDesc;
+    std::unique_ptr<QRhiShaderResourceBindings> m_spectrumProcessSrb[2]; // [i] reads state 1-i, writes state i
+    std::unique_ptr<QRhiBuffer> m_spectrumProcessUniformBuffer; // MAX_PACKETS_PER_FRAME slots, dynamic offset
+    quint32 m_spectrumProcessUniformStride = 0;
+    std::unique_ptr<QRhiTextureRenderTarget> m_waterfallRowRt;
+    std::unique_ptr<QRhiRenderPassDescriptor> m_waterfallRowRpDesc;
+    std::unique_ptr<QRhiTextureRenderTarget> m_waterfallClearRt; // Same texture, cleared to black on begin
+    std::unique_ptr<QRhiRenderPassDescriptor> m_waterfallClearRpDesc;
+    std::unique_ptr<QRhiShaderResourceBindings> m_waterfallRowSrb[2]; // [i] reads state i
+    std::unique_ptr<QRhiBuffer> m_waterfallRowUniformBuffer;
 
     bool m_rhiInitialized = false;
     bool m_pipelinesCreated = false;
     bool m_firstFrameRendered = false;
-
-    // Shader stages (loaded from .qsb files)
-    QShader m_spectrumBlueVert;
-    QShader m_spectrumBlueAmpFrag;
-    QShader m_waterfallVert;
-    QShader m_waterfallFrag;
-    QShader m_overlayVert;
-    QShader m_overlayFrag;
-
-    // Spectrum data
-    QVector<float> m_currentSpectrum;
-    QVector<float> m_rawSpectrum;
-    QVector<float> m_peakHold;
+    FrameTiming m_frameTiming;
+
+    // Spectrum data: packets waiting for the next frame, oldest first, all with the layout below.
+    // Each gets its own processing pass and waterfall row, so averaging and the holds see every packet.
+    struct PendingPacket {
+        QByteArray bins;    // Implicitly shared, not copied
+        float noiseFloorDb; // Smoothed floor after this packet
+        float peakDecay;    // dB the peak hold falls since the previous packet
+    };
+    static constexpr int MAX_PACKETS_PER_FRAME = 8; // Beyond this the oldest are dropped
+    QVector<PendingPacket> m_pendingPackets;
+    int m_pendingFirstBin = 0;
+    int m_pendingBinCount = 0;
+    float m_pendingDbScale = 1.0f; // dB = raw_byte * scale + offset
+    float m_pendingDbOffset = 0.0f;
+    float m_pendingDecayAlpha = 0.45f;
+    qint64 m_pendingCenterFreq = 0; // Frequency window the pending bins cover
+    qint32 m_pendingSpanHz = 0;
+    int m_binCount = 0;               // Bins held in the spectrum state (0 = nothing to draw)
+    int m_spectrumStateIndex = 0;     // Which m_spectrumState holds the latest packet
+    bool m_spectrumStateReset = true; // Next pass starts fresh (no valid history)
+    QElapsedTimer m_peakDecayClock;   // Time since the previous packet, for peak hold decay
+    NoiseFloorEstimator m_noiseFloorEstimator;
+
+    // Carrier index over every PAN packet, for click snapping and next/previous
+    static constexpr int SIGNAL_SNAP_PX = 8;
+    SignalIndex m_signalIndex;
+    bool m_signalSnapEnabled = true;
 
     // K4 spectrum calibration: dBm = raw_byte - K4_DBM_OFFSET
     // Calibrated by comparing peak signals with K4 display
     static constexpr float K4_DBM_OFFSET = 146.0f;
 
-    // Waterfall data - sized for 4K/HiDPI displays
-    // Memory: 4096 × 1024 × 1 byte = 4 MB (trivial for modern GPUs)
-    static constexpr int BASE_WATERFALL_HISTORY = 1024;
-    static constexpr int BASE_TEXTURE_WIDTH = 4096;
-    int m_textureWidth = BASE_TEXTURE_WIDTH;         // Scaled by devicePixelRatio
-    int m_waterfallHistory = BASE_WATERFALL_HISTORY; // Scaled by devicePixelRatio
+    // Waterfall storage follows what is displayed: the texture is the power of two that holds the
+    // packet's bins, with one row per waterfall pixel (in WATERFALL_HISTORY_STEP steps). Both are
+    // rebuilt lazily on the GPU, keeping the rows already drawn; full clears are a render pass.
+    // Memory: 256 x 128 bytes (32 KB) up to 4096 x 1024 bytes (4 MB) for very wide packets on 4K.
+    static constexpr int BASE_WATERFALL_HISTORY = 1024; // Most rows kept (taller waterfalls magnify)
+    static constexpr int MIN_WATERFALL_HISTORY = 128;
+    static constexpr int WATERFALL_HISTORY_STEP = 64; // Dragging the window doesn't rebuild every pixel
+    static constexpr int BASE_TEXTURE_WIDTH = 4096;   // Widest texture (wider packets are cropped)
+    static constexpr int MIN_TEXTURE_WIDTH = 256;
+    int m_textureWidth = MIN_TEXTURE_WIDTH;
+    int m_waterfallHistory = MIN_WATERFALL_HISTORY;
     int m_waterfallWriteRow = 0;
-    QVector<quint8> m_waterfallData;
-    bool m_waterfallNeedsUpdate = false;
+    int m_waterfallNarrowRows = 0;  // Consecutive rows that fit half of m_textureWidth
+    bool m_waterfallEmpty = true;   // No row written since the last clear
     bool m_waterfallNeedsFullClear = false;
 
-    // Color LUT (256 RGBA entries) - for waterfall
-    QVector<quint8> m_colorLUT;
-    // Spectrum color LUT (256 RGBA entries) - for BlueAmplitude style
-    QVector<quint8> m_spectrumLUT;
+    // Waterfall reprojection: every row keeps the center and span it was drawn at, and
+    // waterfall.frag maps each row into the newest row's window. Centers are stored relative
+    // to m_waterfallRefFreq so they fit float precision.
+    bool m_waterfallReproject = false; // Needs RGBA32F for the row info
+    bool m_waterfallRefValid = false;
+    qint64 m_waterfallRefFreq = 0;
+    qint64 m_waterfallViewCenter = 0; // Newest row's window
+    qint32 m_waterfallViewSpan = 0;
 
     // Frequency info
     qint64 m_centerFreq = 0;
@@ -204,9 +295,10 @@ private:
     float m_minDb = -138.0f;
     float m_maxDb = -58.0f;
     float m_spectrumRatio = 0.30f;
-    float m_smoothedBaseline = 0.0f;
     bool m_gridEnabled = true;
-    bool m_peakHoldEnabled = true;
+    int m_averagingFrames = 0;
+    AveragingMode m_averagingMode = AveragingMode::Log;
+    SpectrumTrace m_spectrumTrace = SpectrumTrace::Average;
     int m_refLevel = -110;
     int m_scale = 75; // 10-150, default 75 (neutral)
     int m_spanHz = 10000;
@@ -242,9 +334,38 @@ private:
     QColor m_bgCenterColor{56, 56, 56};             // Lighter gray at center
     QColor m_bgEdgeColor{20, 20, 20};               // Darker at edges
 
-    // Peak hold decay
-    QTimer *m_peakDecayTimer = nullptr;
-    static constexpr float PEAK_DECAY_RATE = 0.5f;
+    // Spectrum smoothing without #AVG (attack fast, decay slow) and peak hold decay
+    static constexpr float ATTACK_ALPHA = 0.85f;
+    static constexpr float PAN_DECAY_ALPHA = 0.45f;  // Moderate decay for crisp waterfall
+    static constexpr float MINI_DECAY_ALPHA = 0.38f; // Slower decay (visible glow effect)
+    static constexpr float PEAK_DECAY_RATE = 0.5f; // dB per PEAK_DECAY_INTERVAL_MS
+    static constexpr float PEAK_DECAY_INTERVAL_MS = 50.0f;
+
+    // Waterfall history (scrollback reads only the visible window from the mapped file)
+    static constexpr int HISTORY_TEXTURE_WIDTH = WaterfallHistory::ROW_BINS;
+    static constexpr int HISTORY_SCROLL_LINES = 32; // Waterfall lines per wheel step
+    static constexpr int MAX_HISTORY_ZOOM = 16;
+    WaterfallHistory m_history;
+    QString m_historyDirectory;
+    QString m_historyName;
+    int m_historyBand = -1;
+    bool m_historyBandSet = false;
+    int m_historyOffset = 0; // Rows back from the newest; 0 = live
+    int m_historyZoom = 1;   // History rows per waterfall line
+    QVector<quint8> m_historyPage;
+    struct HistoryView {
+        int offset = -1;
+        int zoom = 0;
+        qint64 centerFreq = 0;
+        int spanHz = 0;
+        float minDb = 0.0f;
+        float maxDb = 0.0f;
+        bool operator==(const HistoryView &o) const {
+            return offset == o.offset && zoom == o.zoom && centerFreq == o.centerFreq && spanHz == o.spanHz &&
+                   minDb == o.minDb && maxDb == o.maxDb;
+        }
+    } m_historyPaged; // What m_historyTexture currently holds
+    QLabel *m_historyLabel = nullptr;
 
     // Waterfall marker
     QTimer *m_waterfallMarkerTimer = nullptr;
@@ -0,0 +1,116 @@
+#include "renderscheduler.h"
+#include <QCoreApplication>
+#include <QTimer>
+#include <QWidget>
+
+RenderScheduler *RenderScheduler::instance() {
+    // Parented to the application so the timer goes away with the event loop
+    static RenderScheduler *scheduler = new RenderScheduler(QCoreApplication::instance());
+    return scheduler;
+}
+
+RenderScheduler::RenderScheduler(QObject *parent) : QObject(parent) {
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_tickTimer, &QTimer::timeout, this, &RenderScheduler::tick);
+}
+
+void RenderScheduler::setFrameRate(int fps) {
+    fps = qBound(1, fps, 120);
+    if (fps == m_frameRate)
+        return;
+    m_frameRate = fps;
+    if (m_tickTimer->isActive())
+        m_tickTimer->setInterval(frameIntervalMs());
+}
+
+RenderScheduler::Client *RenderScheduler::findClient(QWidget *widget) {
+    for (Client &client : m_clients) {
+        if (client.widget == widget)
+            return &client;
+    }
+    return nullptr;
+}
+
+void RenderScheduler::removeClient(QObject *object) {
+    m_clients.removeIf([object](const Client &client) { return client.widget == object; });
+}
+
+void RenderScheduler::requestFrame(QWidget *widget) {
+    Client *client = findClient(widget);
+    if (!client) {
+        connect(widget, &QObject::destroyed, this, &RenderScheduler::removeClient);
+        m_clients.append(Client{widget});
+        client = &m_clients.last();
+    }
+
+    if (client->dirty)
+        m_stats.requestsCoalesced++;
+    client->dirty = true;
+
+    if (!m_tickTimer->isActive()) {
+        // Waking from idle: tick as soon as a full interval has passed since the last one
+        const int interval = frameIntervalMs();
+        const qint64 sinceLast = m_lastTick.isValid() ? m_lastTick.elapsed() : interval;
+        m_tickTimer->start(static_cast<int>(qMax<qint64>(0, interval - sinceLast)));
+    }
+}
+
+void RenderScheduler::frameRendered(QWidget *widget) {
+    if (Client *client = findClient(widget)) {
+        client->inFlight = false;
+        m_stats.framesRendered++;
+    }
+}
+
+void RenderScheduler::tick() {
+    m_lastTick.start();
+    m_stats.ticks++;
+
+    bool pending = false;
+    for (Client &client : m_clients) {
+        // A hidden or minimized widget never renders the frame it was asked for; don't wait on it.
+        // Nor, for long, on a visible one whose update() didn't reach render().
+        const bool canRender = client.widget->isVisible() && !client.widget->window()->isMinimized();
+        if (client.inFlight && (!canRender || ++client.inFlightTicks > MAX_IN_FLIGHT_TICKS)) {
+            if (canRender)
+                m_stats.framesAbandoned++;
+            client.inFlight = false;
+        }
+
+        if (!client.dirty) {
+            m_stats.framesSkipped++;
+            continue;
+        }
+        if (client.inFlight) {
+            m_stats.framesDropped++;
+            pending = true;
+            continue;
+        }
+
+        // Hidden widgets repaint with their latest state when shown again
+        client.dirty = false;
+        if (canRender) {
+            client.inFlight = true;
+            client.inFlightTicks = 0;
+            m_stats.framesRequested++;
+            client.widget->update();
+        }
+    }
+
+    // Keep ticking only while there is work; the next request restarts the clock
+    if (pending)
+        m_tickTimer->start(frameIntervalMs());
+    else
+        m_tickTimer->stop();
+}
+
+RenderScheduler::Stats RenderScheduler::stats() const {
+    Stats stats = m_stats;
+    stats.frameRate = m_frameRate;
+    return stats;
+}
+
+void RenderScheduler::resetStats() {
+    m_stats = Stats();
+}
@@ -0,0 +1,86 @@
+#ifndef RENDERSCHEDULER_H
+#define RENDERSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QVector>
+
+class QTimer;
+class QWidget;
+
+/**
+ * @brief One frame clock for every RHI spectrum widget (panadapters and mini-pans)
+ *
+ * Widgets call requestFrame() instead of QWidget::update() whenever a packet arrives
+ * or their display state changes. On each tick, capped at the radio's #FPS rate, the
+ * scheduler repaints only the widgets that asked since the last tick, all in the same
+ * event loop turn, so they land in one backing store flush and present on the same
+ * vsync. Requests between ticks collapse into one frame. While nothing is dirty the
+ * clock stops, so an idle display costs no wakeups.
+ *
+ * A widget whose previous frame hasn't rendered yet (frameRendered() not called) is not
+ * asked again; its frame is counted as dropped and retried on the next tick. A frame still
+ * unrendered after MAX_IN_FLIGHT_TICKS ticks (a zero-size or occluded widget whose update()
+ * never reaches render()) is abandoned, so the widget is asked again and the clock can stop.
+ *
+ * GUI thread only.
+ */
+class RenderScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        int frameRate = 0;
+        quint64 ticks = 0;
+        quint64 framesRequested = 0; // update() calls issued to widgets
+        quint64 framesRendered = 0;
+        quint64 framesSkipped = 0;     // Widget/tick pairs with nothing dirty (no repaint)
+        quint64 framesDropped = 0;     // Dirty widget still waiting on its last frame, deferred a tick
+        quint64 requestsCoalesced = 0; // requestFrame() calls merged into an already pending frame
+        quint64 framesAbandoned = 0;   // Frames given up on after MAX_IN_FLIGHT_TICKS
+    };
+
+    static RenderScheduler *instance();
+
+    // Tick rate in frames per second (#FPS, 12-30 on the K4)
+    void setFrameRate(int fps);
+    int frameRate() const { return m_frameRate; }
+
+    // Repaint widget on the next tick. The widget is registered on first use and
+    // forgotten when it is destroyed.
+    void requestFrame(QWidget *widget);
+
+    // Called by the widget at the start of its render()
+    void frameRendered(QWidget *widget);
+
+    Stats stats() const;
+    void resetStats();
+
+    static constexpr int DEFAULT_FRAME_RATE = 30;
+    static constexpr int MAX_IN_FLIGHT_TICKS = 6;
+
+private slots:
+    void tick();
+
+private:
+    explicit RenderScheduler(QObject *parent = nullptr);
+
+    struct Client {
+        QWidget *widget = nullptr;
+        bool dirty = false;    // Something changed since its last requested frame
+        bool inFlight = false; // update() issued, render() not seen yet
+        int inFlightTicks = 0; // Ticks since that update()
+    };
+
+    Client *findClient(QWidget *widget);
+    void removeClient(QObject *object);
+    int frameIntervalMs() const { return 1000 / m_frameRate; }
+
+    QTimer *m_tickTimer = nullptr;
+    QElapsedTimer m_lastTick;
+    QVector<Client> m_clients;
+    int m_frameRate = DEFAULT_FRAME_RATE;
+    Stats m_stats;
+};
+
+#endif // RENDERSCHEDULER_H
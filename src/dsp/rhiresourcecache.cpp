@@ -0,0 +1,162 @@
+#include "rhiresourcecache.h"
+#include "rhi_utils.h"
+#include <QVarLengthArray>
+
+namespace {
+// The binding with its resources left out: enough to lay out a pipeline, never bound for a draw
+QRhiShaderResourceBinding layoutOnly(const QRhiShaderResourceBinding &binding) {
+    const QRhiShaderResourceBinding::Data *d = binding.data();
+    switch (d->type) {
+    case QRhiShaderResourceBinding::UniformBuffer:
+        if (d->u.ubuf.hasDynamicOffset)
+            return QRhiShaderResourceBinding::uniformBufferWithDynamicOffset(d->binding, d->stage, nullptr,
+                                                                             d->u.ubuf.maybeSize);
+        return QRhiShaderResourceBinding::uniformBuffer(d->binding, d->stage, nullptr);
+    case QRhiShaderResourceBinding::SampledTexture:
+        return QRhiShaderResourceBinding::sampledTexture(d->binding, d->stage, nullptr, nullptr);
+    case QRhiShaderResourceBinding::Texture:
+        return QRhiShaderResourceBinding::texture(d->binding, d->stage, nullptr);
+    case QRhiShaderResourceBinding::Sampler:
+        return QRhiShaderResourceBinding::sampler(d->binding, d->stage, nullptr);
+    default:
+        return binding; // Storage bindings aren't used by the spectrum pipelines
+    }
+}
+} // namespace
+
+RhiResourceCache *RhiResourceCache::instance() {
+    static RhiResourceCache cache;
+    return &cache;
+}
+
+QShader RhiResourceCache::shader(const QString &name) {
+    auto it = m_shaders.constFind(name);
+    if (it != m_shaders.constEnd())
+        return *it;
+
+    // Failures are cached too: a missing resource won't appear later
+    const QShader loaded = RhiUtils::loadShader(QStringLiteral(":/shaders/src/dsp/shaders/%1.qsb").arg(name));
+    m_shaders.insert(name, loaded);
+    m_stats.shadersLoaded++;
+    return loaded;
+}
+
+RhiResourceCache::PerRhi &RhiResourceCache::resources(QRhi *rhi) {
+    auto it = m_resources.find(rhi);
+    if (it == m_resources.end()) {
+        // First request on this QRhi: release everything with it
+        rhi->addCleanupCallback([this](QRhi *dying) { release(dying); });
+        it = m_resources.insert(rhi, PerRhi());
+    }
+    return *it;
+}
+
+void RhiResourceCache::release(QRhi *rhi) {
+    auto it = m_resources.find(rhi);
+    if (it == m_resources.end())
+        return;
+    for (const CachedPipeline &cached : std::as_const(it->pipelines))
+        destroy(cached);
+    qDeleteAll(it->luts);
+    delete it->sampler;
+    delete it->fullscreenQuad;
+    m_resources.erase(it);
+}
+
+void RhiResourceCache::destroy(const CachedPipeline &cached) {
+    delete cached.pipeline;
+    delete cached.layout;
+    delete cached.rpDesc;
+}
+
+QRhiTexture *RhiResourceCache::lut(QRhi *rhi, const QString &name, LutBuilder build, QRhiResourceUpdateBatch *rub) {
+    PerRhi &res = resources(rhi);
+    if (QRhiTexture *texture = res.luts.value(name)) {
+        m_stats.resourcesShared++;
+        return texture;
+    }
+
+    const QVector<quint8> colors = build();
+    QRhiTexture *texture = rhi->newTexture(QRhiTexture::RGBA8, QSize(256, 1));
+    texture->create();
+    QRhiTextureSubresourceUploadDescription upload(colors.constData(), colors.size());
+    rub->uploadTexture(texture, QRhiTextureUploadEntry(0, 0, upload)); // Copies the data
+    res.luts.insert(name, texture);
+    m_stats.resourcesCreated++;
+    return texture;
+}
+
+QRhiSampler *RhiResourceCache::linearSampler(QRhi *rhi) {
+    PerRhi &res = resources(rhi);
+    if (res.sampler) {
+        m_stats.resourcesShared++;
+        return res.sampler;
+    }
+
+    res.sampler = rhi->newSampler(QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
+                                  QRhiSampler::ClampToEdge, QRhiSampler::Repeat);
+    res.sampler->create();
+    m_stats.resourcesCreated++;
+    return res.sampler;
+}
+
+QRhiBuffer *RhiResourceCache::fullscreenQuad(QRhi *rhi, QRhiResourceUpdateBatch *rub) {
+    PerRhi &res = resources(rhi);
+    if (res.fullscreenQuad) {
+        m_stats.resourcesShared++;
+        return res.fullscreenQuad;
+    }
+
+    static const float quad[] = {
+        // position (x, y), texcoord (s, t)
+        -1.0f, -1.0f, 0.0f, 1.0f, // bottom-left (texCoord y=1 = bottom)
+        1.0f,  -1.0f, 1.0f, 1.0f, // bottom-right
+        1.0f,  1.0f,  1.0f, 0.0f, // top-right (texCoord y=0 = top)
+        -1.0f, -1.0f, 0.0f, 1.0f, // bottom-left
+        1.0f,  1.0f,  1.0f, 0.0f, // top-right
+        -1.0f, 1.0f,  0.0f, 0.0f  // top-left
+    };
+    res.fullscreenQuad = rhi->newBuffer(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(quad));
+    res.fullscreenQuad->create();
+    rub->uploadStaticBuffer(res.fullscreenQuad, quad);
+    m_stats.resourcesCreated++;
+    return res.fullscreenQuad;
+}
+
+QRhiGraphicsPipeline *RhiResourceCache::pipeline(QRhi *rhi, const QString &name, QRhiRenderPassDescriptor *rpDesc,
+                                                 const std::function<void(QRhiGraphicsPipeline *)> &setup) {
+    PerRhi &res = resources(rhi);
+    const QPair<QString, QVector<quint32>> key(name, rpDesc->serializedFormat());
+    auto it = res.pipelines.constFind(key);
+    if (it != res.pipelines.constEnd()) {
+        m_stats.resourcesShared++;
+        return it->pipeline;
+    }
+
+    // The bindings set by setup() belong to the asking widget and its render target may be rebuilt, so
+    // the pipeline is created against copies: the bindings' layout without resources (every draw binds
+    // the widget's own) and a compatible render pass descriptor
+    CachedPipeline cached;
+    cached.pipeline = rhi->newGraphicsPipeline();
+    setup(cached.pipeline);
+
+    QVarLengthArray<QRhiShaderResourceBinding, 8> bindings;
+    if (const QRhiShaderResourceBindings *srb = cached.pipeline->shaderResourceBindings()) {
+        for (auto b = srb->cbeginBindings(); b != srb->cendBindings(); ++b)
+            bindings.append(layoutOnly(*b));
+    }
+    cached.layout = rhi->newShaderResourceBindings();
+    cached.layout->setBindings(bindings.cbegin(), bindings.cend());
+    cached.rpDesc = rpDesc->newCompatibleRenderPassDescriptor();
+
+    cached.pipeline->setShaderResourceBindings(cached.layout);
+    cached.pipeline->setRenderPassDescriptor(cached.rpDesc);
+    if (!cached.layout->create() || !cached.pipeline->create()) {
+        qWarning() << "RhiResourceCache: cannot create pipeline" << name;
+        destroy(cached);
+        return nullptr;
+    }
+    res.pipelines.insert(key, cached);
+    m_stats.resourcesCreated++;
+    return cached.pipeline;
+}
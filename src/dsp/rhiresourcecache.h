@@ -0,0 +1,80 @@
+#ifndef RHIRESOURCECACHE_H
+#define RHIRESOURCECACHE_H
+
+#include <rhi/qrhi.h>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief Process-wide cache of what the RHI spectrum widgets have in common
+ *
+ * Shaders are read from their .qsb resources once per process. Color LUTs, the sampler, the
+ * fullscreen quad and pipelines belong to a QRhi (every QRhiWidget in a top-level window shares the
+ * window's) and are created the first time a widget asks for them, which happens from its
+ * initialize()/first frame: widgets that are never shown create nothing. Pipelines are shared by
+ * name between render passes of the same serialized format. Everything per QRhi is released by the
+ * QRhi's cleanup callback, so widgets hold plain pointers and never delete them. GUI thread only.
+ */
+class RhiResourceCache {
+public:
+    static RhiResourceCache *instance();
+
+    // Shader from :/shaders/src/dsp/shaders/<name>.qsb, e.g. "waterfall.vert" (invalid if missing)
+    QShader shader(const QString &name);
+
+    // 256x1 RGBA8 color LUT; build() (256 RGBA entries) runs and is uploaded through rub only when
+    // name is new to this QRhi
+    using LutBuilder = QVector<quint8> (*)();
+    QRhiTexture *lut(QRhi *rhi, const QString &name, LutBuilder build, QRhiResourceUpdateBatch *rub);
+
+    // Linear filtering, clamped horizontally and repeating vertically (the scrolling waterfalls)
+    QRhiSampler *linearSampler(QRhi *rhi);
+
+    // Two triangles covering clip space: position(2) + texcoord(2), texcoord y = 0 at the top
+    QRhiBuffer *fullscreenQuad(QRhi *rhi, QRhiResourceUpdateBatch *rub);
+
+    // Pipeline called name for render passes compatible with rpDesc. On a miss setup() configures a
+    // new pipeline (stages, vertex input, topology, blending and the bindings it is laid out for) and
+    // it is created against the cache's own copies of that layout and of rpDesc, so it outlives the
+    // widget that asked first; every caller of one name must bind resources of that layout.
+    // Returns nullptr if creation fails.
+    QRhiGraphicsPipeline *pipeline(QRhi *rhi, const QString &name, QRhiRenderPassDescriptor *rpDesc,
+                                   const std::function<void(QRhiGraphicsPipeline *)> &setup);
+
+    struct Stats {
+        int shadersLoaded = 0;
+        int resourcesCreated = 0; // LUTs, samplers, quads and pipelines
+        int resourcesShared = 0;  // Requests answered from the cache
+    };
+    Stats stats() const { return m_stats; }
+
+private:
+    RhiResourceCache() = default;
+
+    // A shared pipeline and what it was created against, owned by the cache
+    struct CachedPipeline {
+        QRhiGraphicsPipeline *pipeline = nullptr;
+        QRhiShaderResourceBindings *layout = nullptr;
+        QRhiRenderPassDescriptor *rpDesc = nullptr;
+    };
+
+    struct PerRhi {
+        QHash<QString, QRhiTexture *> luts;
+        QRhiSampler *sampler = nullptr;
+        QRhiBuffer *fullscreenQuad = nullptr;
+        QHash<QPair<QString, QVector<quint32>>, CachedPipeline> pipelines; // (name, pass format)
+    };
+
+    PerRhi &resources(QRhi *rhi);
+    void release(QRhi *rhi);
+    static void destroy(const CachedPipeline &cached);
+
+    QHash<QString, QShader> m_shaders;
+    QHash<QRhi *, PerRhi> m_resources;
+    Stats m_stats;
+};
+
+#endif // RHIRESOURCECACHE_H
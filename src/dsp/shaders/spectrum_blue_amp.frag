@@ -3,10 +3,10 @@
 layout(location = 0) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
 
-layout(binding = 1) uniform sampler2D spectrumData;
+layout(binding = 1) uniform sampler2D spectrumState; // r/g/b = averaged/peak/min dB per bin, noise floor last
 layout(binding = 2) uniform sampler2D colorLut;  // Spectrum color LUT
 
-// Uniform buffer: 80 bytes, std140 layout
+// Uniform buffer: 96 bytes, std140 layout
 layout(std140, binding = 0) uniform buf {
     vec4 fillBaseColor;     // offset 0:  (unused)
     vec4 fillPeakColor;     // offset 16: (unused)
@@ -16,22 +16,27 @@ layout(std140, binding = 0) uniform buf {
     float spectrumHeight;   // offset 56: spectrum area height in pixels
     float binCount;         // offset 60: actual spectrum bin count
     vec2 viewportSize;      // offset 64: viewport dimensions
-    float textureWidth;     // offset 72: texture width for bin centering
-    float padding;          // offset 76: padding for 16-byte alignment
-};  // Total: 80 bytes
+    float minDb;            // offset 72: bottom of the display range
+    float maxDb;            // offset 76: top of the display range
+    vec4 traceMask;         // offset 80: selects the displayed trace from the state (averaged, peak, min)
+};  // Total: 96 bytes
+
+float normalizeDb(float db) {
+    return clamp((db - minDb) / (maxDb - minDb), 0.0, 1.0);
+}
 
 // Simple bilinear sampling - let GPU handle interpolation
 float sampleBilinear(float u) {
-    // Bins are centered in texture - use floor() to match C++ integer division
-    float binOffset = floor((textureWidth - binCount) / 2.0);
-    // Map display X [0,1] to texture coordinate where bins are stored
-    float texU = (binOffset + u * binCount + 0.5) / textureWidth;
-    return texture(spectrumData, vec2(texU, 0.5)).r;
+    // State texture is binCount + 1 wide; clamp so the baseline texel never bleeds in
+    float texel = clamp(u * binCount + 0.5, 0.5, binCount - 0.5);
+    return dot(texture(spectrumState, vec2(texel / (binCount + 1.0), 0.5)), traceMask);
 }
 
 void main() {
-    // Sample spectrum value using GPU bilinear interpolation
-    float spectrumValue = sampleBilinear(fragTexCoord.x);
+    // Sample the trace using GPU bilinear interpolation, then lift the noise floor
+    // to the bottom of the display
+    float baselineDb = texelFetch(spectrumState, ivec2(int(binCount), 0), 0).r;
+    float spectrumValue = max(0.0, normalizeDb(sampleBilinear(fragTexCoord.x)) - normalizeDb(baselineDb)) * 0.95;
 
     // spectrumValue is 0.0 (no signal) to ~1.0 (max signal)
     // Convert to Y threshold: peakY where 0.0 = top, 1.0 = bottom (in texCoord space)
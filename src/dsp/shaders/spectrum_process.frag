@@ -0,0 +1,67 @@
+#version 440
+
+// One packet of spectrum processing, rendered into a (binCount + 1) x 1 state texture.
+// Texel i < binCount: r = averaged dB, g = peak hold dB, b = min hold dB. Texel binCount:
+// the noise floor (estimated on the CPU, see NoiseFloorEstimator) that normalizes the fill.
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outState;
+
+layout(binding = 1) uniform sampler2D rawBins;   // Raw K4 bytes of the packet (R8)
+layout(binding = 2) uniform sampler2D prevState; // State after the previous packet
+
+layout(std140, binding = 0) uniform buf {
+    float dbScale;         // dB per raw byte step
+    float dbOffset;        // dB of raw byte 0
+    float attackAlpha;     // Smoothing weight of a rising bin (averageMode 0)
+    float decayAlpha;      // Smoothing weight of a falling bin (averageMode 0)
+    float peakDecay;       // dB the peak hold falls since the previous packet
+    float noiseFloorDb;
+    float binCount;        // Bins in this packet
+    float resetHistory;    // 1.0 = prevState is not valid (first packet, bin count changed)
+    float peakHoldEnabled; // 0.0 = peak hold follows the averaged spectrum
+    float averageMode;     // 0 = attack/decay, 1 = log (dB) average, 2 = linear (power) average
+    float averageAlpha;    // Weight of the new packet for averageMode 1 and 2 (1 / frames)
+    float minHoldEnabled;  // 0.0 = min hold follows the averaged spectrum
+};
+
+float averagedDb(int bin) {
+    float raw = texelFetch(rawBins, ivec2(bin, 0), 0).r * 255.0 * dbScale + dbOffset;
+    if (resetHistory > 0.5)
+        return raw;
+    float previous = texelFetch(prevState, ivec2(bin, 0), 0).r;
+
+    if (averageMode > 1.5) {
+        // Average power, then back to dB: noise dips don't pull a steady carrier down
+        float power = mix(exp2(previous * 0.33219281), exp2(raw * 0.33219281), averageAlpha);
+        return log2(power) * 3.0103;
+    }
+    if (averageMode > 0.5)
+        return mix(previous, raw, averageAlpha);
+
+    // Attack fast (new peaks appear quickly), decay slower
+    float alpha = raw > previous ? attackAlpha : decayAlpha;
+    return mix(previous, raw, alpha);
+}
+
+void main() {
+    int bins = int(binCount);
+    int x = int(gl_FragCoord.x);
+
+    if (x >= bins) {
+        outState = vec4(noiseFloorDb, noiseFloorDb, noiseFloorDb, 1.0);
+        return;
+    }
+
+    float averaged = averagedDb(x);
+    float peak = averaged;
+    float minimum = averaged;
+    if (resetHistory < 0.5) {
+        vec4 previous = texelFetch(prevState, ivec2(x, 0), 0);
+        if (peakHoldEnabled > 0.5)
+            peak = max(averaged, previous.g - peakDecay);
+        if (minHoldEnabled > 0.5)
+            minimum = min(averaged, previous.b);
+    }
+    outState = vec4(averaged, peak, minimum, 1.0);
+}
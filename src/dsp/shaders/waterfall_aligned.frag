@@ -0,0 +1,59 @@
+#version 440
+
+// Panadapter waterfall: every history row is drawn in the newest row's frequency window.
+// Rows keep the bins they were rendered with; rowInfoTex records where each row was tuned,
+// so after a QSY or span change older rows slide/scale into place and anything outside
+// their coverage is blank. With reproject = 0 rows are drawn as stored (scrollback texture,
+// or no RGBA32F for the row info).
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+layout(binding = 1) uniform sampler2D waterfallTex;
+layout(binding = 2) uniform sampler2D colorLutTex;
+layout(binding = 3) uniform sampler2D rowInfoTex; // Per row: center (Hz, relative), span (Hz), bin count, valid
+
+// First four floats match waterfall.vert
+layout(std140, binding = 0) uniform buf {
+    float scrollOffset;
+    float binCount;     // Bins in the newest row (used when not reprojecting)
+    float textureWidth;
+    float historyRows;  // Waterfall texture height
+    float viewCenter;   // Newest row's center, same reference as rowInfoTex
+    float viewSpan;
+    float reproject;
+    float padding;
+};
+
+float rowValue(int row, float x) {
+    float count = binCount;
+    float bin = floor(x * binCount);
+    if (reproject > 0.5) {
+        vec4 info = texelFetch(rowInfoTex, ivec2(row, 0), 0);
+        if (info.a < 0.5)
+            return 0.0; // Never written
+        float freq = viewCenter + (x - 0.5) * viewSpan;
+        float position = (freq - info.r) / info.g + 0.5;
+        if (position < 0.0 || position >= 1.0)
+            return 0.0; // Outside what this row covered
+        count = info.b;
+        bin = floor(position * count);
+    }
+
+    // Bins are centered in the texture, as waterfall_row.frag wrote them
+    float binOffset = floor((textureWidth - count) / 2.0);
+    return texelFetch(waterfallTex, ivec2(int(binOffset + bin), row), 0).r;
+}
+
+void main() {
+    // Blend the two nearest rows vertically (what linear filtering did), each in its own alignment
+    int rows = int(historyRows);
+    float y = fragTexCoord.y * historyRows - 0.5;
+    int row0 = int(floor(y));
+    float blend = y - float(row0);
+    row0 = ((row0 % rows) + rows) % rows;
+    int row1 = (row0 + 1) % rows;
+
+    float value = mix(rowValue(row0, fragTexCoord.x), rowValue(row1, fragTexCoord.x), blend);
+    outColor = texture(colorLutTex, vec2(value, 0.5));
+}
@@ -0,0 +1,27 @@
+#version 440
+
+// Writes the newest waterfall row (rendered into one row of the waterfall texture):
+// smoothed bins centered in the texture width, normalized to the display dB range.
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 0) out vec4 outColor;
+
+layout(binding = 1) uniform sampler2D spectrumState; // r = smoothed dB per bin
+
+layout(std140, binding = 0) uniform buf {
+    float minDb;
+    float maxDb;
+    float binCount;
+    float binOffset; // First texel of the bin region, (textureWidth - binCount) / 2
+};
+
+void main() {
+    // Zeros outside bin region = no signal
+    int bin = int(gl_FragCoord.x) - int(binOffset);
+    float value = 0.0;
+    if (bin >= 0 && bin < int(binCount)) {
+        float db = texelFetch(spectrumState, ivec2(bin, 0), 0).r;
+        value = clamp((db - minDb) / (maxDb - minDb), 0.0, 1.0);
+    }
+    outColor = vec4(value, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,142 @@
+#include "signalindex.h"
+#include <algorithm>
+#include <cmath>
+
+// Keep the MAX_ENTRIES strongest, in ascending frequency
+static void keepStrongest(QVector<SignalIndex::Entry> &entries) {
+    if (entries.size() > SignalIndex::MAX_ENTRIES) {
+        std::nth_element(entries.begin(), entries.begin() + SignalIndex::MAX_ENTRIES, entries.end(),
+                         [](const SignalIndex::Entry &a, const SignalIndex::Entry &b) { return a.snrDb > b.snrDb; });
+        entries.resize(SignalIndex::MAX_ENTRIES);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const SignalIndex::Entry &a, const SignalIndex::Entry &b) { return a.frequency < b.frequency; });
+}
+
+void SignalIndex::update(const quint8 *bins, int count, qint64 centerFreq, qint32 spanHz, float dbScale,
+                         float dbOffset, float noiseFloorDb) {
+    if (count <= 0 || spanHz <= 0 || dbScale <= 0.0f)
+        return;
+
+    // Thresholds in raw units, so the scan compares bytes
+    m_noiseFloorDb = noiseFloorDb;
+    const float floorRaw = (noiseFloorDb - dbOffset) / dbScale;
+    const int high = static_cast<int>(std::ceil(floorRaw + m_thresholdDb / dbScale));
+    const int low = static_cast<int>(std::ceil(floorRaw + m_thresholdDb / 2.0f / dbScale));
+    const double binHz = static_cast<double>(spanHz) / count;
+    const double startHz = static_cast<double>(centerFreq) - spanHz / 2.0;
+
+    m_detected.clear();
+    int i = 0;
+    while (i < count) {
+        if (bins[i] < low) {
+            ++i;
+            continue;
+        }
+        const int begin = i;
+        int peak = i;
+        for (; i < count && bins[i] >= low; ++i) {
+            if (bins[i] > bins[peak])
+                peak = i;
+        }
+        if (bins[peak] < high)
+            continue;
+
+        // Vertex of the parabola through the peak and its neighbours, within half a bin
+        double offset = 0.0;
+        if (peak > 0 && peak < count - 1) {
+            const double left = bins[peak - 1];
+            const double right = bins[peak + 1];
+            const double curvature = left - 2.0 * bins[peak] + right;
+            if (curvature < 0.0)
+                offset = 0.5 * (left - right) / curvature;
+        }
+
+        Entry entry;
+        entry.frequency = std::llround(startHz + (peak + 0.5 + offset) * binHz);
+        entry.snrDb = (bins[peak] - floorRaw) * dbScale;
+        entry.widthHz = std::max(1, static_cast<int>(std::lround((i - begin) * binHz)));
+        entry.hits = 1;
+        entry.misses = 0;
+        m_detected.append(entry);
+    }
+    if (m_detected.size() > MAX_ENTRIES)
+        keepStrongest(m_detected);
+
+    // Merge with the index (both ascending): a detection within two bins, or half the wider
+    // signal's width, of an entry is that entry again
+    auto carryOver = [this](Entry entry) {
+        if (++entry.misses <= MAX_MISSES)
+            m_merged.append(entry);
+    };
+    m_merged.clear();
+    int a = 0;
+    int b = 0;
+    while (a < m_entries.size() && b < m_detected.size()) {
+        const Entry &known = m_entries[a];
+        const Entry &found = m_detected[b];
+        const double tolerance = std::max(2.0 * binHz, std::max(known.widthHz, found.widthHz) / 2.0);
+        if (found.frequency + tolerance < known.frequency) {
+            m_merged.append(found);
+            ++b;
+        } else if (known.frequency + tolerance < found.frequency) {
+            carryOver(known);
+            ++a;
+        } else {
+            Entry entry = found;
+            entry.hits = known.hits + 1;
+            m_merged.append(entry);
+            ++a;
+            ++b;
+        }
+    }
+    for (; a < m_entries.size(); ++a)
+        carryOver(m_entries[a]);
+    for (; b < m_detected.size(); ++b)
+        m_merged.append(m_detected[b]);
+    keepStrongest(m_merged);
+    std::swap(m_entries, m_merged);
+}
+
+void SignalIndex::clear() {
+    m_entries.clear();
+}
+
+QVector<SignalIndex::Entry> SignalIndex::signalList() const {
+    QVector<Entry> confirmed;
+    for (const Entry &entry : m_entries) {
+        if (entry.hits >= MIN_HITS)
+            confirmed.append(entry);
+    }
+    return confirmed;
+}
+
+const SignalIndex::Entry *SignalIndex::nearest(qint64 freq, qint32 toleranceHz) const {
+    const Entry *best = nullptr;
+    qint64 bestDistance = 0;
+    for (const Entry &entry : m_entries) {
+        const qint64 distance = qAbs(entry.frequency - freq);
+        if (entry.hits < MIN_HITS || distance > std::max<qint64>(toleranceHz, entry.widthHz / 2))
+            continue;
+        if (!best || distance < bestDistance) {
+            best = &entry;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+const SignalIndex::Entry *SignalIndex::next(qint64 freq, int direction) const {
+    if (direction > 0) {
+        for (const Entry &entry : m_entries) {
+            if (entry.hits >= MIN_HITS && entry.frequency > freq)
+                return &entry;
+        }
+    } else if (direction < 0) {
+        for (auto it = m_entries.crbegin(); it != m_entries.crend(); ++it) {
+            if (it->hits >= MIN_HITS && it->frequency < freq)
+                return &*it;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,62 @@
+#ifndef SIGNALINDEX_H
+#define SIGNALINDEX_H
+
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief Index of the carriers on a panadapter, updated incrementally from each spectrum packet
+ *
+ * A packet is scanned once on its raw bytes: a signal is a run of bins above the noise floor plus
+ * half the threshold whose peak reaches the full threshold (the gap is the hysteresis that keeps a
+ * noisy skirt from splitting one signal into several). Its frequency is the peak refined by a
+ * parabola through the neighbouring bins, its width the run's extent. Detections are matched to the
+ * index by frequency, so an entry follows a drifting carrier; an entry counts as confirmed after
+ * MIN_HITS packets and is dropped after MAX_MISSES packets without it, which keeps single noise
+ * spikes out and a fading signal in. O(bins) per packet plus a sort of the few detections; the
+ * noise floor comes from the caller, which already estimates it for the display. GUI thread only.
+ */
+class SignalIndex {
+public:
+    struct Entry {
+        qint64 frequency; // Hz, interpolated peak
+        float snrDb;      // Peak above the noise floor
+        qint32 widthHz;   // Extent above floor + threshold / 2
+        int hits;         // Packets the signal was detected in
+        int misses;       // Consecutive packets without it
+    };
+
+    static constexpr float DEFAULT_THRESHOLD_DB = 10.0f;
+    static constexpr int MAX_ENTRIES = 64; // Strongest kept when a busy band has more
+    static constexpr int MIN_HITS = 3;
+    static constexpr int MAX_MISSES = 4;
+
+    explicit SignalIndex(float thresholdDb = DEFAULT_THRESHOLD_DB) : m_thresholdDb(thresholdDb) {}
+
+    // Scan one packet of raw bins covering [centerFreq - spanHz / 2, centerFreq + spanHz / 2);
+    // dB = raw * dbScale + dbOffset, noiseFloorDb is the packet's floor (see NoiseFloorEstimator)
+    void update(const quint8 *bins, int count, qint64 centerFreq, qint32 spanHz, float dbScale, float dbOffset,
+                float noiseFloorDb);
+    void clear();
+
+    // Confirmed entries, ascending frequency
+    QVector<Entry> signalList() const;
+
+    // Confirmed signal closest to freq whose center (or extent, for wide signals) is within
+    // toleranceHz of it; nullptr if none
+    const Entry *nearest(qint64 freq, qint32 toleranceHz) const;
+
+    // First confirmed signal strictly above (direction > 0) or below (direction < 0) freq; nullptr if none
+    const Entry *next(qint64 freq, int direction) const;
+
+    float noiseFloorDb() const { return m_noiseFloorDb; }
+
+private:
+    float m_thresholdDb;
+    float m_noiseFloorDb = 0.0f; // Of the last packet
+    QVector<Entry> m_entries;    // Ascending frequency, confirmed or not
+    QVector<Entry> m_detected;   // Scratch for one packet
+    QVector<Entry> m_merged;     // Scratch for the merge
+};
+
+#endif // SIGNALINDEX_H
@@ -0,0 +1,192 @@
+#include "waterfallhistory.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+bool WaterfallHistory::open(const QString &path, int capacityRows) {
+    close();
+    if (capacityRows <= 0)
+        return false;
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "WaterfallHistory: cannot open" << path << m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = qint64(sizeof(FileHeader)) + qint64(capacityRows) * ROW_BYTES;
+    bool fresh = m_file.size() != size;
+    if (!fresh) {
+        FileHeader existing;
+        fresh = m_file.read(reinterpret_cast<char *>(&existing), sizeof(existing)) != sizeof(existing) ||
+                std::memcmp(existing.magic, MAGIC, sizeof(MAGIC)) != 0 || existing.version != VERSION ||
+                existing.rowBytes != ROW_BYTES || existing.rowBins != ROW_BINS ||
+                existing.capacity != quint32(capacityRows) || existing.writeIndex >= existing.capacity ||
+                existing.count > existing.capacity;
+    }
+
+    // Unknown layout: start over. Row slots are only read once count covers them, so
+    // the (sparse) file doesn't need to be zeroed.
+    if (fresh && (!m_file.resize(0) || !m_file.resize(size))) {
+        qWarning() << "WaterfallHistory: cannot size" << path << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    m_map = m_file.map(0, size);
+    if (!m_map) {
+        qWarning() << "WaterfallHistory: cannot map" << path << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    if (fresh) {
+        FileHeader *h = header();
+        std::memset(h, 0, sizeof(FileHeader));
+        std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+        h->version = VERSION;
+        h->rowBytes = ROW_BYTES;
+        h->rowBins = ROW_BINS;
+        h->capacity = quint32(capacityRows);
+    }
+    return true;
+}
+
+void WaterfallHistory::close() {
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+int WaterfallHistory::rowCount() const {
+    return m_map ? int(header()->count) : 0;
+}
+
+int WaterfallHistory::capacity() const {
+    return m_map ? int(header()->capacity) : 0;
+}
+
+int WaterfallHistory::slotForAge(int age) const {
+    const FileHeader *h = header();
+    return int((h->writeIndex + h->capacity - 1 - quint32(age)) % h->capacity);
+}
+
+const WaterfallHistory::RowHeader *WaterfallHistory::row(int age) const {
+    if (age < 0 || age >= rowCount())
+        return nullptr;
+    return reinterpret_cast<const RowHeader *>(slot(slotForAge(age)));
+}
+
+const quint8 *WaterfallHistory::rowBins(int age) const {
+    if (age < 0 || age >= rowCount())
+        return nullptr;
+    return slot(slotForAge(age)) + sizeof(RowHeader);
+}
+
+bool WaterfallHistory::append(qint64 timestampMs, qint64 centerFreq, qint32 spanHz, const quint8 *bins, int count) {
+    if (!m_map || count <= 0 || spanHz <= 0)
+        return false;
+
+    // Wider packets are max-pooled so peaks survive the narrower row
+    const int binCount = std::min(count, ROW_BINS);
+    auto pooled = [&](int i) {
+        if (count == binCount)
+            return bins[i];
+        const int begin = int(qint64(i) * count / binCount);
+        const int end = std::max(begin + 1, int(qint64(i + 1) * count / binCount));
+        return *std::max_element(bins + begin, bins + end);
+    };
+
+    // Same view within the row interval: fold into the newest row
+    if (RowHeader *newest = const_cast<RowHeader *>(row(0))) {
+        if (newest->centerFreq == centerFreq && newest->spanHz == spanHz && newest->binCount == binCount &&
+            timestampMs >= newest->timestampMs && timestampMs - newest->timestampMs < ROW_INTERVAL_MS) {
+            quint8 *dest = reinterpret_cast<quint8 *>(newest + 1);
+            for (int i = 0; i < binCount; ++i)
+                dest[i] = std::max(dest[i], pooled(i));
+            return false;
+        }
+    }
+
+    // Write the row, then publish it through the header
+    FileHeader *h = header();
+    uchar *dest = slot(int(h->writeIndex));
+    RowHeader *rowHeader = reinterpret_cast<RowHeader *>(dest);
+    rowHeader->timestampMs = timestampMs;
+    rowHeader->centerFreq = centerFreq;
+    rowHeader->spanHz = spanHz;
+    rowHeader->binCount = quint16(binCount);
+    rowHeader->reserved = 0;
+    quint8 *destBins = dest + sizeof(RowHeader);
+    for (int i = 0; i < binCount; ++i)
+        destBins[i] = pooled(i);
+
+    h->writeIndex = (h->writeIndex + 1) % h->capacity;
+    h->count = std::min(h->count + 1, h->capacity);
+    return true;
+}
+
+int WaterfallHistory::ageAt(qint64 timestampMs) const {
+    // Rows are in time order: binary search on age (timestamps fall as age rises)
+    int low = 0;
+    int high = rowCount() - 1;
+    if (high < 0)
+        return 0;
+    while (low < high) {
+        const int mid = (low + high) / 2;
+        if (row(mid)->timestampMs <= timestampMs)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return low;
+}
+
+int WaterfallHistory::readWindow(quint8 *dest, int width, int lines, int startAge, int rowsPerLine,
+                                 qint64 centerFreq, qint32 spanHz) const {
+    std::memset(dest, 0, size_t(width) * lines);
+    if (!m_map || width <= 0 || spanHz <= 0 || rowsPerLine <= 0)
+        return 0;
+
+    const double viewStart = double(centerFreq) - spanHz / 2.0;
+    const double columnHz = double(spanHz) / width;
+    const int rows = rowCount();
+    int filled = 0;
+
+    for (int line = 0; line < lines; ++line) {
+        const int firstAge = startAge + (lines - 1 - line) * rowsPerLine;
+        if (firstAge >= rows)
+            continue;
+        quint8 *out = dest + qint64(line) * width;
+
+        for (int age = firstAge; age < std::min(firstAge + rowsPerLine, rows); ++age) {
+            const RowHeader *rowHeader = row(age);
+            const quint8 *bins = reinterpret_cast<const quint8 *>(rowHeader + 1);
+            const int binCount = rowHeader->binCount;
+            if (binCount == 0 || rowHeader->spanHz <= 0)
+                continue;
+
+            // Column c center -> bin index, linear in c
+            const double binHz = double(rowHeader->spanHz) / binCount;
+            const double rowStart = double(rowHeader->centerFreq) - rowHeader->spanHz / 2.0;
+            const double first = (viewStart + columnHz / 2.0 - rowStart) / binHz;
+            const double step = columnHz / binHz;
+
+            const int columnBegin = std::max(0, int(std::ceil(-first / step)));
+            const int columnEnd = std::min(width, int(std::ceil((binCount - first) / step)));
+            for (int c = columnBegin; c < columnEnd; ++c) {
+                const int bin = std::min(binCount - 1, int(first + c * step));
+                out[c] = std::max(out[c], bins[bin]);
+            }
+        }
+        filled++;
+    }
+    return filled;
+}
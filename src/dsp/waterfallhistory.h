@@ -0,0 +1,95 @@
+#ifndef WATERFALLHISTORY_H
+#define WATERFALLHISTORY_H
+
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @brief Long-term waterfall history in a memory-mapped ring file (one file per band)
+ *
+ * Each row is (timestamp, center frequency, span, bins) at a fixed record size, so
+ * any row is one pointer offset away and the file never has to be read as a whole:
+ * the OS pages in only what readWindow() touches. Bins stay in the K4's own 8-bit
+ * quantization (1 dB per step on the panadapter); packets wider than ROW_BINS are
+ * max-pooled down to it. Packets arriving within ROW_INTERVAL_MS of the newest row
+ * (same center and span) are merged into it by per-bin maximum, which keeps the
+ * file at ~4 rows/s: DEFAULT_CAPACITY_ROWS holds about two hours in ~30 MB.
+ *
+ * The file header and rows are stored in host byte order; the file is a local cache,
+ * not an interchange format. GUI thread only.
+ */
+class WaterfallHistory {
+public:
+    struct RowHeader {
+        qint64 timestampMs; // Milliseconds since the epoch
+        qint64 centerFreq;  // Hz, as reported in the PAN packet
+        qint32 spanHz;      // Span covered by the stored bins
+        quint16 binCount;   // Valid bins (<= ROW_BINS)
+        quint16 reserved;
+    };
+
+    static constexpr int ROW_BINS = 1024;
+    static constexpr int ROW_BYTES = sizeof(RowHeader) + ROW_BINS;
+    static constexpr qint64 ROW_INTERVAL_MS = 250;
+    static constexpr int DEFAULT_CAPACITY_ROWS = 2 * 3600 * 1000 / ROW_INTERVAL_MS; // Two hours
+
+    WaterfallHistory() = default;
+    ~WaterfallHistory() { close(); }
+
+    WaterfallHistory(const WaterfallHistory &) = delete;
+    WaterfallHistory &operator=(const WaterfallHistory &) = delete;
+
+    // Open (or create) the ring file. An existing file with a different layout or
+    // capacity is discarded and started fresh.
+    bool open(const QString &path, int capacityRows = DEFAULT_CAPACITY_ROWS);
+    void close();
+    bool isOpen() const { return m_map != nullptr; }
+    QString path() const { return m_file.fileName(); }
+
+    // Record one packet's bins (raw K4 bytes). Returns true if a new row was started,
+    // false if the packet was merged into the newest row (or nothing was recorded).
+    bool append(qint64 timestampMs, qint64 centerFreq, qint32 spanHz, const quint8 *bins, int count);
+
+    int rowCount() const;
+    int capacity() const;
+
+    // Row by age (0 = newest); pointers into the mapping, valid until the next append() or close()
+    const RowHeader *row(int age) const;
+    const quint8 *rowBins(int age) const;
+
+    // Age of the newest row recorded at or before timestampMs (rowCount() - 1 if all are newer)
+    int ageAt(qint64 timestampMs) const;
+
+    // Page a window of history into dest (lines x width bytes, line 0 = oldest, lines - 1 = newest,
+    // the waterfall texture's row order). Line lines - 1 starts startAge rows back; each line is the
+    // per-bin maximum of rowsPerLine rows. Rows are reprojected onto [centerFreq - spanHz / 2,
+    // centerFreq + spanHz / 2) so history recorded at another center or span lines up; columns
+    // with no data are 0. Returns the number of lines that received any row.
+    int readWindow(quint8 *dest, int width, int lines, int startAge, int rowsPerLine, qint64 centerFreq,
+                   qint32 spanHz) const;
+
+private:
+    struct FileHeader {
+        char magic[8];
+        quint32 version;
+        quint32 rowBytes;
+        quint32 rowBins;
+        quint32 capacity;
+        quint32 writeIndex; // Slot the next new row goes into
+        quint32 count;      // Valid rows
+        quint8 reserved[32];
+    };
+
+    static constexpr char MAGIC[8] = {'Q', 'K', '4', 'W', 'F', 'H', 'S', 'T'};
+    static constexpr quint32 VERSION = 1;
+
+    FileHeader *header() const { return reinterpret_cast<FileHeader *>(m_map); }
+    uchar *slot(int index) const { return m_map + sizeof(FileHeader) + qint64(index) * ROW_BYTES; }
+    int slotForAge(int age) const;
+
+    QFile m_file;
+    uchar *m_map = nullptr;
+};
+
+#endif // WATERFALLHISTORY_H
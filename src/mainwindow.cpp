@@ -30,9 +30,8 @@
 #include "models/menumodel.h"
 #include "dsp/panadapter_rhi.h"
 #include "dsp/minipan_rhi.h"
+#include "dsp/renderscheduler.h"
 #include "audio/audioengine.h"
-#include "audio/opusdecoder.h"
-#include "audio/opusencoder.h"
 #include "audio/sidetonegenerator.h"
 #include "hardware/kpoddevice.h"
 #include "hardware/halikeydevice.h"
@@ -42,6 +41,7 @@
 #include "network/catserver.h"
 #include "settings/radiosettings.h"
 #include <QVBoxLayout>
+#include <QStandardPaths>
 #include <QInputDialog>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -74,6 +74,20 @@ static int tuningStepToHz(int step) {
     return (step >= 0 && step <= 5) ? table[step] : 1000;
 }
 
+// Frequency in Hz of digits typed into a VFO, read the way FA/FB does: 1-2 digits = MHz, 3-5 = kHz,
+// 6+ = Hz. 0 if the entry is not a frequency.
+static quint64 enteredFrequencyHz(const QString &digits) {
+    bool ok;
+    const quint64 value = digits.toULongLong(&ok);
+    if (!ok || digits.length() > 11)
+        return 0;
+    if (digits.length() <= 2)
+        return value * 1000000;
+    if (digits.length() <= 5)
+        return value * 1000;
+    return value;
+}
+
 static int getNextSpanUp(int currentSpan) {
     if (currentSpan >= SPAN_MAX)
         return SPAN_MAX;
@@ -93,13 +107,11 @@ static int getNextSpanDown(int currentSpan) {
 // ============== MainWindow Implementation ==============
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), m_tcpClient(new TcpClient(this)), m_radioState(new RadioState(this)),
-      m_clockTimer(new QTimer(this)), m_audioEngine(new AudioEngine(this)), m_opusDecoder(new OpusDecoder(this)),
-      m_opusEncoder(new OpusEncoder(this)), m_menuModel(new MenuModel(this)), m_menuOverlay(nullptr) {
-    // Initialize Opus decoder (K4 sends 12kHz stereo: left=Main, right=Sub)
-    m_opusDecoder->initialize(12000, 2);
-
-    // Initialize Opus encoder for TX audio (12kHz mono)
-    m_opusEncoder->initialize(12000, 1);
+      m_clockTimer(new QTimer(this)), m_audioEngine(new AudioEngine(this)), m_menuModel(new MenuModel(this)),
+      m_menuOverlay(nullptr) {
+    // RX audio is decoded on the network thread and fed straight into the audio engine;
+    // TX microphone frames are encoded and sent from there too
+    m_tcpClient->setAudioEngine(m_audioEngine);
 
     // Load saved audio device settings
     QString savedMicDevice = RadioSettings::instance()->micDevice();
@@ -944,17 +956,28 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_tcpClient, &TcpClient::authenticationFailed, this, &MainWindow::onAuthenticationFailed);
 
     // Protocol CAT responses -> RadioState
-    connect(m_tcpClient->protocol(), &Protocol::catResponseReceived, this, &MainWindow::onCatResponse);
+    connect(m_tcpClient, &TcpClient::catResponseReceived, this, &MainWindow::onCatResponse);
+
+    // High-rate fields (VFO readouts, S/TX meters, supply, RIT/XIT) are refreshed once per
+    // display frame from committed change sets; see refreshCoalescedState()
+    m_stateRefreshTimer = new QTimer(this);
+    m_stateRefreshTimer->setSingleShot(true);
+    connect(m_stateRefreshTimer, &QTimer::timeout, this, &MainWindow::refreshCoalescedState);
+    connect(m_radioState, &RadioState::changesCommitted, this, &MainWindow::onRadioStateCommitted);
+
+    // Tuning steps the governor holds back are sent when their slot in the round trip opens
+    m_vfoGovernorTimer = new QTimer(this);
+    m_vfoGovernorTimer->setSingleShot(true);
+    connect(m_vfoGovernorTimer, &QTimer::timeout, this, &MainWindow::sendDueVfoFrequencies);
+    m_vfoGovernorClock.start();
 
     // RadioState signals -> UI updates (VFO A)
-    connect(m_radioState, &RadioState::frequencyChanged, this, &MainWindow::onFrequencyChanged);
     connect(m_radioState, &RadioState::modeChanged, this, &MainWindow::onModeChanged);
     connect(m_radioState, &RadioState::modeChanged, this, [this](RadioState::Mode) {
         onVoxChanged(false); // Refresh VOX display when mode changes (VOX is mode-specific)
     });
     // Data sub-mode changes also update mode label (AFSK, FSK, PSK, DATA)
     connect(m_radioState, &RadioState::dataSubModeChanged, this, [this](int) { updateModeLabels(); });
-    connect(m_radioState, &RadioState::sMeterChanged, this, &MainWindow::onSMeterChanged);
     connect(m_radioState, &RadioState::filterBandwidthChanged, this, &MainWindow::onBandwidthChanged);
     // RX EQ state -> popup (Main and Sub RX share the same EQ)
     connect(m_radioState, &RadioState::rxEqChanged, this, [this]() {
@@ -990,11 +1013,9 @@ MainWindow::MainWindow(QWidget *parent)
     });
 
     // RadioState signals -> UI updates (VFO B)
-    connect(m_radioState, &RadioState::frequencyBChanged, this, &MainWindow::onFrequencyBChanged);
     connect(m_radioState, &RadioState::modeBChanged, this, &MainWindow::onModeBChanged);
     // Data sub-mode changes also update mode label (AFSK, FSK, PSK, DATA)
     connect(m_radioState, &RadioState::dataSubModeBChanged, this, [this](int) { updateModeLabels(); });
-    connect(m_radioState, &RadioState::sMeterBChanged, this, &MainWindow::onSMeterBChanged);
     connect(m_radioState, &RadioState::filterBandwidthBChanged, this, &MainWindow::onBandwidthBChanged);
 
     // Auto-hide mini pan B when VFOs move to different bands (and SUB RX is off)
@@ -1003,9 +1024,6 @@ MainWindow::MainWindow(QWidget *parent)
 
     // RadioState signals -> Status bar updates
     connect(m_radioState, &RadioState::rfPowerChanged, this, &MainWindow::onRfPowerChanged);
-    connect(m_radioState, &RadioState::supplyVoltageChanged, this, &MainWindow::onSupplyVoltageChanged);
-    connect(m_radioState, &RadioState::supplyCurrentChanged, this, &MainWindow::onSupplyCurrentChanged);
-    connect(m_radioState, &RadioState::swrChanged, this, &MainWindow::onSwrChanged);
 
     // Display FPS (synthetic menu item)
     connect(m_radioState, &RadioState::displayFpsChanged, this, &MainWindow::onDisplayFpsChanged);
@@ -1013,39 +1031,6 @@ MainWindow::MainWindow(QWidget *parent)
     // Error/notification messages from K4 (ERxx: format) -> show notification popup
     connect(m_radioState, &RadioState::errorNotificationReceived, this, &MainWindow::onErrorNotification);
 
-    // TX Meter data -> update power displays and VFO multifunction meters during TX
-    connect(m_radioState, &RadioState::txMeterChanged, this, [this](int alc, int comp, double fwdPower, double swr) {
-        // Update status bar power label
-        QString powerStr;
-        if (fwdPower < 10.0) {
-            powerStr = QString("%1 W").arg(fwdPower, 0, 'f', 1);
-        } else {
-            powerStr = QString("%1 W").arg(static_cast<int>(fwdPower));
-        }
-        m_powerLabel->setText(powerStr);
-        // Update side panel power reading
-        m_sideControlPanel->setPowerReading(fwdPower);
-
-        // Calculate PA drain current (Id) from forward power and supply voltage
-        // Formula: Id = ForwardPower / (Voltage × Efficiency)
-        // K4 PA efficiency is approximately 34% (measured: 80W @ 17A @ 13.8V)
-        double voltage = m_radioState->supplyVoltage();
-        double paCurrent = 0.0;
-        if (voltage > 0 && fwdPower > 0) {
-            paCurrent = fwdPower / (voltage * 0.34);
-        }
-
-        // Update TX meters only on the active TX VFO
-        // SPLIT OFF: VFO A transmits, SPLIT ON: VFO B transmits
-        if (m_radioState->splitEnabled()) {
-            m_vfoB->setTxMeters(alc, comp, fwdPower, swr);
-            m_vfoB->setTxMeterCurrent(paCurrent);
-        } else {
-            m_vfoA->setTxMeters(alc, comp, fwdPower, swr);
-            m_vfoA->setTxMeterCurrent(paCurrent);
-        }
-    });
-
     // TX state changes -> switch VFO meters between S-meter (RX) and Po (TX) mode
     // Also change TX indicator color to red when transmitting
     connect(m_radioState, &RadioState::transmitStateChanged, this, [this](bool transmitting) {
@@ -1215,7 +1200,6 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_radioState, &RadioState::qskEnabledChanged, this, &MainWindow::onQskEnabledChanged);
     connect(m_radioState, &RadioState::testModeChanged, this, &MainWindow::onTestModeChanged);
     connect(m_radioState, &RadioState::atuModeChanged, this, &MainWindow::onAtuModeChanged);
-    connect(m_radioState, &RadioState::ritXitChanged, this, &MainWindow::onRitXitChanged);
     connect(m_radioState, &RadioState::messageBankChanged, this, &MainWindow::onMessageBankChanged);
 
     // Filter position indicators
@@ -1381,6 +1365,16 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_radioState, &RadioState::waterfallColorChanged, m_displayPopup, &DisplayPopupWidget::setWaterfallColor);
     connect(m_radioState, &RadioState::averagingChanged, m_displayPopup, &DisplayPopupWidget::setAveraging);
     connect(m_radioState, &RadioState::peakModeChanged, m_displayPopup, &DisplayPopupWidget::setPeakMode);
+    connect(m_radioState, &RadioState::averagingChanged, this, [this](int frames) {
+        m_panadapterA->setAveraging(frames);
+        m_panadapterB->setAveraging(frames);
+    });
+    connect(m_radioState, &RadioState::peakModeChanged, this, [this](bool enabled) {
+        const auto trace = enabled ? PanadapterRhiWidget::SpectrumTrace::PeakHold
+                                   : PanadapterRhiWidget::SpectrumTrace::Average;
+        m_panadapterA->setSpectrumTrace(trace);
+        m_panadapterB->setSpectrumTrace(trace);
+    });
     connect(m_radioState, &RadioState::fixedTuneChanged, m_displayPopup, &DisplayPopupWidget::setFixedTuneMode);
     connect(m_radioState, &RadioState::freezeChanged, m_displayPopup, &DisplayPopupWidget::setFreeze);
     connect(m_radioState, &RadioState::vfoACursorChanged, m_displayPopup, &DisplayPopupWidget::setVfoACursor);
@@ -1576,11 +1570,9 @@ MainWindow::MainWindow(QWidget *parent)
     });
 
     // Protocol spectrum data -> Panadapter
-    connect(m_tcpClient->protocol(), &Protocol::spectrumDataReady, this, &MainWindow::onSpectrumData);
-    connect(m_tcpClient->protocol(), &Protocol::miniSpectrumDataReady, this, &MainWindow::onMiniSpectrumData);
-
-    // Protocol audio data -> Opus decoder -> Speaker
-    connect(m_tcpClient->protocol(), &Protocol::audioDataReady, this, &MainWindow::onAudioData);
+    // (RX audio bypasses the GUI thread: network thread -> Opus decoder -> AudioEngine)
+    connect(m_tcpClient, &TcpClient::spectrumDataReady, this, &MainWindow::onSpectrumData);
+    connect(m_tcpClient, &TcpClient::miniSpectrumDataReady, this, &MainWindow::onMiniSpectrumData);
 
     // Clock timer for date/time display
     connect(m_clockTimer, &QTimer::timeout, this, &MainWindow::updateDateTime);
@@ -1770,32 +1762,36 @@ MainWindow::MainWindow(QWidget *parent)
     // TX;/RX; from external apps controls audio input gate
     // Audio stream itself triggers K4 TX - timing-critical for FT8/FT4
     connect(m_catServer, &CatServer::pttRequested, this, [this](bool on) {
-        m_pttActive = on;
-        if (on) {
-            m_txSequence = 0;
-        }
+        m_tcpClient->setTransmitting(on);
         m_audioEngine->setMicEnabled(on);
         m_bottomMenuBar->setPttActive(on);
     });
 
-    // Connect to settings for CAT server enable/disable
-    connect(RadioSettings::instance(), &RadioSettings::catServerEnabledChanged, this, [this](bool enabled) {
-        if (enabled) {
-            m_catServer->start(RadioSettings::instance()->catServerPort());
-        } else {
-            m_catServer->stop();
-        }
-    });
-    connect(RadioSettings::instance(), &RadioSettings::catServerPortChanged, this, [this](quint16 port) {
+    // Connect to settings for CAT server enable/disable, port and bind address
+    auto startCatServer = [this]() {
+        RadioSettings *settings = RadioSettings::instance();
+        m_catServer->start(settings->catServerPort(), QHostAddress(settings->catServerBindAddress()));
+    };
+    connect(RadioSettings::instance(), &RadioSettings::catServerEnabledChanged, this,
+            [this, startCatServer](bool enabled) {
+                if (enabled) {
+                    startCatServer();
+                } else {
+                    m_catServer->stop();
+                }
+            });
+    auto restartCatServer = [this, startCatServer]() {
         if (RadioSettings::instance()->catServerEnabled()) {
             m_catServer->stop();
-            m_catServer->start(port);
+            startCatServer();
         }
-    });
+    };
+    connect(RadioSettings::instance(), &RadioSettings::catServerPortChanged, this, restartCatServer);
+    connect(RadioSettings::instance(), &RadioSettings::catServerBindAddressChanged, this, restartCatServer);
 
     // Start CAT server if enabled
     if (RadioSettings::instance()->catServerEnabled()) {
-        m_catServer->start(RadioSettings::instance()->catServerPort());
+        startCatServer();
     }
 
     // resize directly instead of deferring - testing if deferred resize affects QRhi
@@ -2691,9 +2687,6 @@ void MainWindow::setupUi() {
     connect(m_bottomMenuBar, &BottomMenuBar::pttPressed, this, &MainWindow::onPttPressed);
     connect(m_bottomMenuBar, &BottomMenuBar::pttReleased, this, &MainWindow::onPttReleased);
 
-    // Connect microphone frames to encoding/transmission
-    connect(m_audioEngine, &AudioEngine::microphoneFrame, this, &MainWindow::onMicrophoneFrame);
-
     // Flush audio jitter buffer on discrete filter/mode changes to avoid stale audio lag.
     // These signals fire once per button press (not continuously like VFO tuning).
     connect(m_radioState, &RadioState::modeChanged, m_audioEngine, &AudioEngine::flushQueue);
@@ -2790,8 +2783,9 @@ void MainWindow::setupVfoSection(QWidget *parent) {
 
     // Connect VFO A frequency entry - send FA command then query to refresh display
     connect(m_vfoA, &VFOWidget::frequencyEntered, this, [this](const QString &freqString) {
-        // FA accepts 1-11 digits: 1-2 = MHz, 3-5 = kHz, 6+ = Hz
-        m_tcpClient->sendCAT(QString("FA%1;FA;").arg(freqString));
+        const quint64 freq = enteredFrequencyHz(freqString);
+        if (freq > 0)
+            sendVfoNow(false, freq);
     });
 
     // Connect VFO A wheel tuning - same pattern as panadapter wheel tuning
@@ -2801,11 +2795,8 @@ void MainWindow::setupVfoSection(QWidget *parent) {
         quint64 currentFreq = m_radioState->vfoA();
         int stepHz = tuningStepToHz(m_radioState->tuningStep());
         qint64 newFreq = static_cast<qint64>(currentFreq) + static_cast<qint64>(steps) * stepHz;
-        if (newFreq > 0) {
-            QString cmd = QString("FA%1;").arg(static_cast<quint64>(newFreq));
-            m_tcpClient->sendCAT(cmd);
-            m_radioState->parseCATCommand(cmd);
-        }
+        if (newFreq > 0)
+            tuneVfo(false, static_cast<quint64>(newFreq));
     });
 
     // Set Mini-Pan A colors to cyan (matching VFO A theme)
@@ -3133,8 +3124,9 @@ void MainWindow::setupVfoSection(QWidget *parent) {
 
     // Connect VFO B frequency entry - send FB command then query to refresh display
     connect(m_vfoB, &VFOWidget::frequencyEntered, this, [this](const QString &freqString) {
-        // FB accepts 1-11 digits: 1-2 = MHz, 3-5 = kHz, 6+ = Hz
-        m_tcpClient->sendCAT(QString("FB%1;FB;").arg(freqString));
+        const quint64 freq = enteredFrequencyHz(freqString);
+        if (freq > 0)
+            sendVfoNow(true, freq);
     });
 
     // Connect VFO B wheel tuning - same pattern as panadapter wheel tuning
@@ -3144,11 +3136,8 @@ void MainWindow::setupVfoSection(QWidget *parent) {
         quint64 currentFreq = m_radioState->vfoB();
         int stepHz = tuningStepToHz(m_radioState->tuningStepB());
         qint64 newFreq = static_cast<qint64>(currentFreq) + static_cast<qint64>(steps) * stepHz;
-        if (newFreq > 0) {
-            QString cmd = QString("FB%1;").arg(static_cast<quint64>(newFreq));
-            m_tcpClient->sendCAT(cmd);
-            m_radioState->parseCATCommand(cmd);
-        }
+        if (newFreq > 0)
+            tuneVfo(true, static_cast<quint64>(newFreq));
     });
 
     layout->addWidget(m_vfoB, 1, Qt::AlignTop);
@@ -3238,6 +3227,11 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
     vfoAPassbandAlpha.setAlpha(64);
     m_panadapterB->setSecondaryPassbandColor(vfoAPassbandAlpha);
     m_panadapterB->setSecondaryMarkerColor(QColor(K4Styles::Colors::VfoACyan));
+
+    // Waterfall history per receiver and band (scrollback with Alt+Wheel)
+    const QString historyDir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/waterfall";
+    m_panadapterA->setHistoryStorage(historyDir, "main");
+    m_panadapterB->setHistoryStorage(historyDir, "sub");
     m_panadapterB->setSecondaryVisible(true);
     layout->addWidget(m_panadapterB);
     m_panadapterB->hide(); // Start hidden (MainOnly mode)
@@ -3366,7 +3360,10 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
 
     // Update panadapter when frequency/mode changes
     connect(m_radioState, &RadioState::frequencyChanged, this,
-            [this](quint64 freq) { m_panadapterA->setTunedFrequency(freq); });
+            [this](quint64 freq) {
+                m_panadapterA->setTunedFrequency(freq);
+                m_panadapterA->setHistoryBand(getBandFromFrequency(freq));
+            });
     connect(m_radioState, &RadioState::modeChanged, this,
             [this](RadioState::Mode mode) { m_panadapterA->setMode(RadioState::modeToString(mode)); });
     connect(m_radioState, &RadioState::filterBandwidthChanged, this,
@@ -3403,10 +3400,7 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         // Guard: only send if connected and frequency is valid
         if (!m_tcpClient->isConnected() || freq <= 0)
             return;
-        QString cmd = QString("FA%1;").arg(freq, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        // Request frequency back to update UI (K4 doesn't echo SET commands)
-        m_tcpClient->sendCAT("FA;");
+        sendVfoNow(false, static_cast<quint64>(freq));
     });
 
     // Mouse control: drag to tune (continuous frequency change while dragging)
@@ -3419,10 +3413,7 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         qint64 snapped = (freq / stepHz) * stepHz;
         if (snapped <= 0)
             return;
-        QString cmd = QString("FA%1;").arg(snapped, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        // Update local state immediately for responsive UI (K4 doesn't echo SET commands)
-        m_radioState->parseCATCommand(cmd);
+        tuneVfo(false, static_cast<quint64>(snapped));
     });
 
     // Mouse control: scroll wheel to adjust frequency by computed step
@@ -3432,11 +3423,8 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         quint64 currentFreq = m_radioState->vfoA();
         int stepHz = tuningStepToHz(m_radioState->tuningStep());
         qint64 newFreq = static_cast<qint64>(currentFreq) + static_cast<qint64>(steps) * stepHz;
-        if (newFreq > 0) {
-            QString cmd = QString("FA%1;").arg(static_cast<quint64>(newFreq));
-            m_tcpClient->sendCAT(cmd);
-            m_radioState->parseCATCommand(cmd);
-        }
+        if (newFreq > 0)
+            tuneVfo(false, static_cast<quint64>(newFreq));
     });
 
     // Shift+Wheel: Adjust scale (dB range) - global setting applies to both panadapters
@@ -3471,9 +3459,7 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
             return;
         if (!m_tcpClient->isConnected() || freq <= 0)
             return;
-        QString cmd = QString("FB%1;").arg(freq, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        m_tcpClient->sendCAT("FB;");
+        sendVfoNow(true, static_cast<quint64>(freq));
     });
 
     connect(m_panadapterA, &PanadapterRhiWidget::frequencyRightDragged, this, [this](qint64 freq) {
@@ -3481,14 +3467,15 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
             return;
         if (!m_tcpClient->isConnected() || freq <= 0)
             return;
-        QString cmd = QString("FB%1;").arg(freq, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        m_radioState->parseCATCommand(cmd);
+        tuneVfo(true, static_cast<quint64>(freq));
     });
 
     // VFO B connections
     connect(m_radioState, &RadioState::frequencyBChanged, this,
-            [this](quint64 freq) { m_panadapterB->setTunedFrequency(freq); });
+            [this](quint64 freq) {
+                m_panadapterB->setTunedFrequency(freq);
+                m_panadapterB->setHistoryBand(getBandFromFrequency(freq));
+            });
     connect(m_radioState, &RadioState::modeBChanged, this,
             [this](RadioState::Mode mode) { m_panadapterB->setMode(RadioState::modeToString(mode)); });
     connect(m_radioState, &RadioState::filterBandwidthBChanged, this,
@@ -3546,10 +3533,7 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         if (!m_tcpClient->isConnected() || freq <= 0)
             return;
         // L=A R=B mode: left-click on Pan B tunes VFO A
-        QString vfo = (m_mouseQsyMode == 1) ? "FA" : "FB";
-        QString cmd = QString("%1%2;").arg(vfo).arg(freq, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        m_tcpClient->sendCAT(vfo + ";");
+        sendVfoNow(m_mouseQsyMode != 1, static_cast<quint64>(freq));
     });
 
     // Mouse control for VFO B: drag to tune (continuous frequency change while dragging)
@@ -3560,14 +3544,11 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
             return;
         // L=A R=B mode: left-drag on Pan B tunes VFO A
         bool tuneA = (m_mouseQsyMode == 1);
-        QString vfo = tuneA ? "FA" : "FB";
         int stepHz = tuningStepToHz(tuneA ? m_radioState->tuningStep() : m_radioState->tuningStepB());
         qint64 snapped = (freq / stepHz) * stepHz;
         if (snapped <= 0)
             return;
-        QString cmd = QString("%1%2;").arg(vfo).arg(snapped, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        m_radioState->parseCATCommand(cmd);
+        tuneVfo(!tuneA, static_cast<quint64>(snapped));
     });
 
     // Mouse control for VFO B: scroll wheel to adjust frequency by computed step
@@ -3577,11 +3558,8 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         quint64 currentFreq = m_radioState->vfoB();
         int stepHz = tuningStepToHz(m_radioState->tuningStepB());
         qint64 newFreq = static_cast<qint64>(currentFreq) + static_cast<qint64>(steps) * stepHz;
-        if (newFreq > 0) {
-            QString cmd = QString("FB%1;").arg(static_cast<quint64>(newFreq));
-            m_tcpClient->sendCAT(cmd);
-            m_radioState->parseCATCommand(cmd);
-        }
+        if (newFreq > 0)
+            tuneVfo(true, static_cast<quint64>(newFreq));
     });
 
     // Shift+Wheel on panadapter B: Adjust scale (same as A - global setting)
@@ -3617,9 +3595,7 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         if (!m_tcpClient->isConnected() || freq <= 0)
             return;
         // L=A R=B mode: right-click always tunes VFO B
-        QString cmd = QString("FB%1;").arg(freq, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        m_tcpClient->sendCAT("FB;");
+        sendVfoNow(true, static_cast<quint64>(freq));
     });
 
     connect(m_panadapterB, &PanadapterRhiWidget::frequencyRightDragged, this, [this](qint64 freq) {
@@ -3628,9 +3604,7 @@ void MainWindow::setupSpectrumPlaceholder(QWidget *parent) {
         if (!m_tcpClient->isConnected() || freq <= 0)
             return;
         // L=A R=B mode: right-drag always tunes VFO B
-        QString cmd = QString("FB%1;").arg(freq, 11, 10, QChar('0'));
-        m_tcpClient->sendCAT(cmd);
-        m_radioState->parseCATCommand(cmd);
+        tuneVfo(true, static_cast<quint64>(freq));
     });
 }
 
@@ -3804,20 +3778,36 @@ void MainWindow::onAuthenticationFailed() {
         QString("color: %1; font-size: 12px; font-weight: bold;").arg(K4Styles::Colors::TxRed));
 }
 
-void MainWindow::onCatResponse(const QString &response) {
-
-    // Parse CAT commands (may contain multiple commands separated by ;)
-    QStringList commands = response.split(';', Qt::SkipEmptyParts);
-    for (const QString &cmd : commands) {
-        m_radioState->parseCATCommand(cmd + ";");
+void MainWindow::onCatResponse(const QByteArray &response) {
+
+    // Parse CAT commands (may contain multiple commands separated by ;). Commands are
+    // walked in place as views; only menu definitions are converted to QString.
+    // The whole packet is one RadioState batch: a single change set per packet
+    m_radioState->beginBatch();
+    const CatView all(response);
+    qsizetype start = 0;
+    while (start < all.length()) {
+        qsizetype end = all.indexOf(';', start);
+        if (end < 0)
+            end = all.length();
+        const CatView cmd = all.mid(start, end - start);
+        start = end + 1;
+        if (cmd.isEmpty())
+            continue;
+
+        // FA/FB reports of tuning steps we have already moved past would pull the VFO back
+        if (isStaleVfoEcho(cmd))
+            continue;
+
+        m_radioState->parseCATCommand(cmd.view());
 
         // Parse MEDF (menu definitions) from RDY response
         if (cmd.startsWith("MEDF")) {
-            m_menuModel->parseMEDF(cmd + ";");
+            m_menuModel->parseMEDF(cmd.toString() + ';');
         }
         // Route ME (menu value) commands to MenuModel for real-time updates
         else if (cmd.startsWith("ME")) {
-            m_menuModel->parseME(cmd + ";");
+            m_menuModel->parseME(cmd.toString() + ';');
         }
         // Parse BN$ (Band Number) response for VFO B (Sub RX)
         else if (cmd.startsWith("BN$")) {
@@ -3838,6 +3828,7 @@ void MainWindow::onCatResponse(const QString &response) {
             }
         }
     }
+    m_radioState->endBatch();
 }
 
 void MainWindow::onFrequencyChanged(quint64 freq) {
@@ -3908,6 +3899,18 @@ void MainWindow::updateConnectionState(TcpClient::ConnectionState state) {
         if (m_audioEngine) {
             m_audioEngine->stop();
         }
+        m_vfoGovernorTimer->stop();
+        m_vfoGovernor.clear();
+
+        // Frame pacing summary for the session
+        {
+            const RenderScheduler::Stats frames = RenderScheduler::instance()->stats();
+            qDebug() << "Render scheduler:" << frames.frameRate << "fps cap," << frames.ticks << "ticks,"
+                     << frames.framesRendered << "rendered," << frames.framesSkipped << "skipped,"
+                     << frames.framesDropped << "dropped," << frames.framesAbandoned << "abandoned,"
+                     << frames.requestsCoalesced << "requests coalesced";
+            RenderScheduler::instance()->resetStats();
+        }
 
         // Clear all UI state to avoid showing stale data
         // Clear spectrum displays
@@ -4099,7 +4102,7 @@ void MainWindow::onRfPowerChanged(double watts, bool isQrp) {
     Q_UNUSED(watts)
     Q_UNUSED(isQrp)
     // NOTE: This is the power SETTING (PC command), not actual TX power.
-    // The power display is updated from txMeterChanged signal during TX.
+    // The power display is updated from TX meter (TM) change sets during TX.
     // We don't update the display here - it should show 0 when not transmitting.
 }
 
@@ -4118,10 +4121,88 @@ void MainWindow::onSwrChanged(double swr) {
     m_sideControlPanel->setSwr(swr);
 }
 
+// TX Meter data -> update power displays and VFO multifunction meters during TX
+void MainWindow::updateTxMeters() {
+    const int alc = m_radioState->alcMeter();
+    const int comp = m_radioState->compressionDb();
+    const double fwdPower = m_radioState->forwardPower();
+    const double swr = m_radioState->swrMeter();
+
+    // Update status bar power label
+    QString powerStr;
+    if (fwdPower < 10.0) {
+        powerStr = QString("%1 W").arg(fwdPower, 0, 'f', 1);
+    } else {
+        powerStr = QString("%1 W").arg(static_cast<int>(fwdPower));
+    }
+    m_powerLabel->setText(powerStr);
+    // Update side panel power reading
+    m_sideControlPanel->setPowerReading(fwdPower);
+
+    // Calculate PA drain current (Id) from forward power and supply voltage
+    // Formula: Id = ForwardPower / (Voltage × Efficiency)
+    // K4 PA efficiency is approximately 34% (measured: 80W @ 17A @ 13.8V)
+    double voltage = m_radioState->supplyVoltage();
+    double paCurrent = 0.0;
+    if (voltage > 0 && fwdPower > 0) {
+        paCurrent = fwdPower / (voltage * 0.34);
+    }
+
+    // Update TX meters only on the active TX VFO
+    // SPLIT OFF: VFO A transmits, SPLIT ON: VFO B transmits
+    if (m_radioState->splitEnabled()) {
+        m_vfoB->setTxMeters(alc, comp, fwdPower, swr);
+        m_vfoB->setTxMeterCurrent(paCurrent);
+    } else {
+        m_vfoA->setTxMeters(alc, comp, fwdPower, swr);
+        m_vfoA->setTxMeterCurrent(paCurrent);
+    }
+}
+
+void MainWindow::onRadioStateCommitted(RadioState::Fields changed) {
+    m_pendingStateRefresh |= (changed & FRAME_COALESCED_FIELDS);
+    if (!m_pendingStateRefresh || m_stateRefreshTimer->isActive())
+        return;
+
+    // Redraw on the next event loop turn, or once a full frame has passed since the last
+    // redraw; everything committed in between lands in the same refresh
+    const int frameMs = 1000 / qMax(1, m_radioState->displayFps());
+    const qint64 sinceLast = m_lastStateRefresh.isValid() ? m_lastStateRefresh.elapsed() : frameMs;
+    m_stateRefreshTimer->start(static_cast<int>(qMax<qint64>(0, frameMs - sinceLast)));
+}
+
+void MainWindow::refreshCoalescedState() {
+    const RadioState::Fields fields = m_pendingStateRefresh;
+    m_pendingStateRefresh = RadioState::Fields();
+    m_lastStateRefresh.start();
+
+    if (fields & RadioState::FieldVfoA)
+        onFrequencyChanged(m_radioState->vfoA());
+    if (fields & RadioState::FieldVfoB)
+        onFrequencyBChanged(m_radioState->vfoB());
+    if (fields & RadioState::FieldSMeter)
+        onSMeterChanged(m_radioState->sMeter());
+    if (fields & RadioState::FieldSMeterB)
+        onSMeterBChanged(m_radioState->sMeterB());
+    if (fields & RadioState::FieldSupply) {
+        onSupplyVoltageChanged(m_radioState->supplyVoltage());
+        onSupplyCurrentChanged(m_radioState->supplyCurrent());
+    }
+    if (fields & RadioState::FieldTxMeter) {
+        updateTxMeters();
+        onSwrChanged(m_radioState->swrMeter());
+    }
+    if (fields & RadioState::FieldRitXit)
+        onRitXitChanged(m_radioState->ritEnabled(), m_radioState->xitEnabled(), m_radioState->ritXitOffset());
+}
+
 void MainWindow::onDisplayFpsChanged(int fps) {
     // Update synthetic menu item value
     m_menuModel->updateValue(MenuModel::SYNTHETIC_DISPLAY_FPS_ID, fps);
 
+    // Spectrum widgets never redraw faster than the radio sends
+    RenderScheduler::instance()->setFrameRate(fps);
+
     // Compare to stored preference and send if different
     if (m_tcpClient->isConnected() && m_currentRadio.displayFps != fps) {
         qDebug() << "Display FPS mismatch: stored=" << m_currentRadio.displayFps << "radio=" << fps << "-> sending #FPS"
@@ -4398,99 +4479,24 @@ void MainWindow::onMiniSpectrumData(int receiver, const QByteArray &data) {
     }
 }
 
-void MainWindow::onAudioData(const QByteArray &payload) {
-    // Only process audio when connected
-    if (!m_tcpClient->isConnected()) {
-        return;
-    }
-
-    // Decode K4 audio packet (handles header parsing, stereo decode, volume/balance mixing)
-    // Returns stereo Float32 PCM (L=Main, R=Sub with mute/balance applied)
-    QByteArray pcmData = m_opusDecoder->decodeK4Packet(payload);
-
-    if (!pcmData.isEmpty()) {
-        m_audioEngine->enqueueAudio(pcmData);
-    }
-}
-
 void MainWindow::onPttPressed() {
     if (!m_tcpClient->isConnected()) {
         return;
     }
 
-    m_pttActive = true;
-    m_txSequence = 0; // Reset sequence on new PTT press
+    m_tcpClient->setTransmitting(true); // Also restarts the TX sequence
     m_audioEngine->setMicEnabled(true);
     m_bottomMenuBar->setPttActive(true);
     qDebug() << "PTT pressed - microphone enabled";
 }
 
 void MainWindow::onPttReleased() {
-    m_pttActive = false;
+    m_tcpClient->setTransmitting(false);
     m_audioEngine->setMicEnabled(false);
     m_bottomMenuBar->setPttActive(false);
     qDebug() << "PTT released - microphone disabled";
 }
 
-void MainWindow::onMicrophoneFrame(const QByteArray &s16leData) {
-    // Only transmit when PTT is active and connected
-    if (!m_pttActive || !m_tcpClient->isConnected()) {
-        return;
-    }
-
-    QByteArray audioData;
-
-    switch (m_currentRadio.encodeMode) {
-    case 0: // EM0 - RAW 32-bit float stereo
-    {
-        // Convert mono S16LE to stereo float32 (K4 expects stereo: L=Main, R=Sub)
-        const qint16 *samples = reinterpret_cast<const qint16 *>(s16leData.constData());
-        int sampleCount = s16leData.size() / sizeof(qint16);
-
-        audioData.resize(sampleCount * 2 * sizeof(float)); // Stereo output
-        float *output = reinterpret_cast<float *>(audioData.data());
-
-        for (int i = 0; i < sampleCount; i++) {
-            float normalized = static_cast<float>(samples[i]) / 32768.0f;
-            output[i * 2] = normalized;     // Left channel
-            output[i * 2 + 1] = normalized; // Right channel (duplicate)
-        }
-        break;
-    }
-
-    case 1: // EM1 - RAW 16-bit S16LE stereo
-    {
-        // Convert mono S16LE to stereo S16LE (K4 expects stereo: L=Main, R=Sub)
-        const qint16 *samples = reinterpret_cast<const qint16 *>(s16leData.constData());
-        int sampleCount = s16leData.size() / sizeof(qint16);
-
-        audioData.resize(sampleCount * 2 * sizeof(qint16)); // Stereo output
-        qint16 *output = reinterpret_cast<qint16 *>(audioData.data());
-
-        for (int i = 0; i < sampleCount; i++) {
-            output[i * 2] = samples[i];     // Left channel
-            output[i * 2 + 1] = samples[i]; // Right channel (duplicate)
-        }
-        break;
-    }
-
-    case 2: // EM2 - Opus Int
-    case 3: // EM3 - Opus Float
-    default:
-        // Use Opus encoding (encoder handles mono-to-stereo internally)
-        audioData = m_opusEncoder->encode(s16leData);
-        break;
-    }
-
-    if (audioData.isEmpty()) {
-        return;
-    }
-
-    // Build and send the audio packet with the selected encode mode
-    QByteArray packet = Protocol::buildAudioPacket(audioData, m_txSequence++, m_currentRadio.encodeMode);
-    m_tcpClient->sendRaw(packet);
-}
-
 bool MainWindow::eventFilter(QObject *watched, QEvent *event) {
     // Handle clicks on VFO A square/mode label -> open mode popup for VFO A
     if ((watched == m_vfoASquare || watched == m_modeALabel) && event->type() == QEvent::MouseButtonPress) {
@@ -4624,9 +4630,74 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
         event->accept();
         return;
     }
+    // Ctrl+Right/Left: next signal up/down (with Shift: on the sub panadapter, VFO B)
+    if ((event->key() == Qt::Key_Right || event->key() == Qt::Key_Left) &&
+        (event->modifiers() & Qt::ControlModifier)) {
+        tuneToNextSignal(event->modifiers() & Qt::ShiftModifier, event->key() == Qt::Key_Right ? 1 : -1);
+        event->accept();
+        return;
+    }
     QMainWindow::keyPressEvent(event);
 }
 
+void MainWindow::tuneToNextSignal(bool vfoB, int direction) {
+    if (!m_tcpClient->isConnected())
+        return;
+    PanadapterRhiWidget *panadapter = vfoB ? m_panadapterB : m_panadapterA;
+    const qint64 current = static_cast<qint64>(vfoB ? m_radioState->vfoB() : m_radioState->vfoA());
+    const qint64 freq = panadapter->nextSignal(current, direction);
+    if (freq <= 0)
+        return;
+    // Local state moves at once so a repeated key steps on from the new signal
+    tuneVfo(vfoB, static_cast<quint64>(freq));
+}
+
+void MainWindow::tuneVfo(bool vfoB, quint64 freq) {
+    const QString cmd = QString("%1%2;").arg(vfoB ? "FB" : "FA").arg(freq, 11, 10, QChar('0'));
+    m_radioState->parseCATCommand(cmd);
+
+    const qint64 now = m_vfoGovernorClock.elapsed();
+    if (m_vfoGovernor.request(vfoB ? VfoGovernor::VfoB : VfoGovernor::VfoA, freq, now))
+        m_tcpClient->sendCAT(cmd);
+    else if (!m_vfoGovernorTimer->isActive())
+        m_vfoGovernorTimer->start(int(m_vfoGovernor.msUntilDue(now)));
+}
+
+void MainWindow::sendVfoNow(bool vfoB, quint64 freq) {
+    const char *prefix = vfoB ? "FB" : "FA";
+    // A held wheel/drag step must not follow this value to the radio
+    const qint64 now = m_vfoGovernorClock.elapsed();
+    m_vfoGovernor.sendNow(vfoB ? VfoGovernor::VfoB : VfoGovernor::VfoA, freq, now);
+    if (m_vfoGovernor.msUntilDue(now) < 0)
+        m_vfoGovernorTimer->stop();
+    // Request frequency back to update UI (K4 doesn't echo SET commands)
+    m_tcpClient->sendCAT(QString("%1%2;%1;").arg(prefix).arg(freq, 11, 10, QChar('0')));
+}
+
+void MainWindow::sendDueVfoFrequencies() {
+    if (!m_tcpClient->isConnected())
+        return;
+    const qint64 now = m_vfoGovernorClock.elapsed();
+    for (const auto &[vfo, freq] : m_vfoGovernor.takeDue(now)) {
+        const char *prefix = vfo == VfoGovernor::VfoB ? "FB" : "FA";
+        m_tcpClient->sendCAT(QString("%1%2;").arg(prefix).arg(freq, 11, 10, QChar('0')));
+    }
+    const qint64 wait = m_vfoGovernor.msUntilDue(now);
+    if (wait >= 0)
+        m_vfoGovernorTimer->start(int(wait));
+}
+
+bool MainWindow::isStaleVfoEcho(CatView cmd) {
+    if (cmd.length() <= 2 || cmd.at(0) != 'F' || (cmd.at(1) != 'A' && cmd.at(1) != 'B'))
+        return false;
+    bool ok;
+    const quint64 freq = cmd.mid(2).toULongLong(&ok);
+    if (!ok)
+        return false;
+    const VfoGovernor::Vfo vfo = cmd.at(1) == 'B' ? VfoGovernor::VfoB : VfoGovernor::VfoA;
+    return !m_vfoGovernor.acceptEcho(vfo, freq, m_vfoGovernorClock.elapsed());
+}
+
 void MainWindow::setPanadapterMode(PanadapterMode mode) {
     m_panadapterMode = mode;
     switch (mode) {
@@ -4936,11 +5007,8 @@ void MainWindow::onKpodEncoderRotated(int ticks) {
         quint64 currentFreq = m_radioState->vfoA();
         int stepHz = tuningStepToHz(m_radioState->tuningStep());
         qint64 newFreq = static_cast<qint64>(currentFreq) + static_cast<qint64>(ticks) * stepHz;
-        if (newFreq > 0) {
-            QString cmd = QString("FA%1;").arg(static_cast<quint64>(newFreq));
-            m_tcpClient->sendCAT(cmd);
-            m_radioState->parseCATCommand(cmd);
-        }
+        if (newFreq > 0)
+            tuneVfo(false, static_cast<quint64>(newFreq));
     } break;
 
     case KpodDevice::RockerCenter: // VFO B
@@ -4948,11 +5016,8 @@ void MainWindow::onKpodEncoderRotated(int ticks) {
         quint64 currentFreq = m_radioState->vfoB();
         int stepHz = tuningStepToHz(m_radioState->tuningStepB());
         qint64 newFreq = static_cast<qint64>(currentFreq) + static_cast<qint64>(ticks) * stepHz;
-        if (newFreq > 0) {
-            QString cmd = QString("FB%1;").arg(static_cast<quint64>(newFreq));
-            m_tcpClient->sendCAT(cmd);
-            m_radioState->parseCATCommand(cmd);
-        }
+        if (newFreq > 0)
+            tuneVfo(true, static_cast<quint64>(newFreq));
     } break;
 
     case KpodDevice::RockerRight: // RIT/XIT
@@ -7,9 +7,11 @@
 #include <QMenuBar>
 #include <QMenu>
 #include <QProgressBar>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QStackedWidget>
 #include "network/tcpclient.h"
+#include "network/vfogovernor.h"
 #include "settings/radiosettings.h"
 #include "models/radiostate.h"
 #include "ui/vfowidget.h"
@@ -17,8 +19,6 @@
 
 class PanadapterRhiWidget;
 class AudioEngine;
-class OpusDecoder;
-class OpusEncoder;
 class SideControlPanel;
 class RightSidePanel;
 class BottomMenuBar;
@@ -77,7 +77,7 @@ private slots:
     void onError(const QString &error);
     void onAuthenticated();
     void onAuthenticationFailed();
-    void onCatResponse(const QString &response);
+    void onCatResponse(const QByteArray &response);
     void onFrequencyChanged(quint64 freq);
     void onFrequencyBChanged(quint64 freq);
     void onModeChanged(RadioState::Mode mode);
@@ -101,9 +101,10 @@ private slots:
     void onMessageBankChanged(int bank);
     void onProcessingChanged();
     void onProcessingChangedB();
+    void onRadioStateCommitted(RadioState::Fields changed);
+    void refreshCoalescedState();
     void onSpectrumData(int receiver, const QByteArray &data, qint64 centerFreq, qint32 sampleRate, float noiseFloor);
     void onMiniSpectrumData(int receiver, const QByteArray &data);
-    void onAudioData(const QByteArray &opusData);
     void showRadioManager();
     void connectToRadio(const RadioEntry &radio);
     void updateDateTime();
@@ -141,7 +142,6 @@ private slots:
     // PTT slots
     void onPttPressed();
     void onPttReleased();
-    void onMicrophoneFrame(const QByteArray &s16leData);
 
     // Display FPS (synthetic menu item)
     void onDisplayFpsChanged(int fps);
@@ -151,6 +151,15 @@ private slots:
     void executeMacro(const QString &functionId);
     void openMacroDialog();
 
+    // Next/previous signal on a panadapter's detected-signal index (Ctrl+Right/Left, +Shift for VFO B)
+    void tuneToNextSignal(bool vfoB, int direction);
+
+    // Tune a VFO from the GUI: RadioState follows at once, the radio through m_vfoGovernor
+    void tuneVfo(bool vfoB, quint64 freq);
+    // Send a VFO frequency at once and read it back (click-to-tune, typed entry), cancelling any held step
+    void sendVfoNow(bool vfoB, quint64 freq);
+    void sendDueVfoFrequencies();
+
     // MAIN RX / SUB RX popup slots
     void onMainRxButtonClicked(int index);
     void onMainRxButtonRightClicked(int index);
@@ -166,6 +175,7 @@ private:
     void updateConnectionState(TcpClient::ConnectionState state);
     QString formatFrequency(quint64 freq);
     void updateModeLabels();
+    void updateTxMeters();
 
     // Band and mini pan helpers
     int getBandFromFrequency(quint64 freq);
@@ -176,14 +186,23 @@ private:
     RadioState *m_radioState;
     QTimer *m_clockTimer;
 
+    // High-rate RadioState fields (VFO readouts, meters, RIT/XIT) are redrawn at most
+    // once per display frame from the committed change sets
+    static constexpr RadioState::Fields FRAME_COALESCED_FIELDS =
+        RadioState::FieldVfoA | RadioState::FieldVfoB | RadioState::FieldSMeter | RadioState::FieldSMeterB |
+        RadioState::FieldTxMeter | RadioState::FieldSupply | RadioState::FieldRitXit;
+    QTimer *m_stateRefreshTimer;
+    QElapsedTimer m_lastStateRefresh;
+    RadioState::Fields m_pendingStateRefresh;
+
+    // FA/FB tuning commands: rate-limited per round trip, latest value wins, stale echoes dropped
+    bool isStaleVfoEcho(CatView cmd);
+    VfoGovernor m_vfoGovernor;
+    QTimer *m_vfoGovernorTimer;
+    QElapsedTimer m_vfoGovernorClock;
+
     // Audio
     AudioEngine *m_audioEngine;
-    OpusDecoder *m_opusDecoder;
-    OpusEncoder *m_opusEncoder;
-
-    // PTT state
-    bool m_pttActive = false;
-    quint8 m_txSequence = 0;
 
     // Top status bar
     QLabel *m_titleLabel;
@@ -0,0 +1,182 @@
+#ifndef CATVIEW_H
+#define CATVIEW_H
+
+#include <QByteArrayView>
+#include <QString>
+#include <cstring>
+#include <limits>
+
+/**
+ * @brief Non-owning view of CAT command text (ASCII)
+ *
+ * Provides the small subset of the QString API that CAT handlers use (mid, left,
+ * right, at, startsWith, indexOf, toInt, ...) but slices and parses in place, so
+ * handling a command such as "SM05" performs no allocation. Only text that is
+ * actually stored (names, versions, decoded text) is converted with toString().
+ *
+ * Slicing clamps to the view like QString::mid(); numeric conversion follows
+ * QString::toInt(): optional surrounding whitespace, optional sign, base 10 only,
+ * and *ok is set to false on empty input, stray characters or overflow.
+ *
+ * The viewed bytes must outlive the view.
+ */
+class CatView {
+public:
+    constexpr CatView() = default;
+    constexpr CatView(const char *data, qsizetype size) : m_data(data), m_size(size) {}
+    CatView(const char *str) : m_data(str), m_size(str ? qsizetype(std::strlen(str)) : 0) {}
+    CatView(QByteArrayView bytes) : m_data(bytes.data()), m_size(bytes.size()) {}
+
+    const char *data() const { return m_data; }
+    qsizetype size() const { return m_size; }
+    qsizetype length() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    QByteArrayView view() const { return QByteArrayView(m_data, m_size); }
+
+    // Unchecked, like QString::at(): callers test length() first
+    char at(qsizetype i) const { return m_data[i]; }
+    char operator[](qsizetype i) const { return m_data[i]; }
+
+    CatView mid(qsizetype pos, qsizetype len = -1) const {
+        if (pos < 0) {
+            if (len >= 0)
+                len = qMax<qsizetype>(len + pos, 0);
+            pos = 0;
+        }
+        if (pos >= m_size)
+            return CatView(m_data + m_size, 0);
+        const qsizetype available = m_size - pos;
+        return CatView(m_data + pos, (len < 0 || len > available) ? available : len);
+    }
+    // Like QString, a negative n or one past the end gives the whole view
+    CatView left(qsizetype n) const { return (n < 0 || n >= m_size) ? *this : CatView(m_data, n); }
+    CatView right(qsizetype n) const { return (n < 0 || n >= m_size) ? *this : CatView(m_data + m_size - n, n); }
+
+    CatView trimmed() const {
+        qsizetype begin = 0;
+        qsizetype end = m_size;
+        while (begin < end && isSpace(m_data[begin]))
+            begin++;
+        while (end > begin && isSpace(m_data[end - 1]))
+            end--;
+        return CatView(m_data + begin, end - begin);
+    }
+
+    void chop(qsizetype n) { m_size = (n >= m_size) ? 0 : m_size - qMax<qsizetype>(n, 0); }
+
+    bool startsWith(CatView prefix) const {
+        return prefix.m_size <= m_size && std::memcmp(m_data, prefix.m_data, size_t(prefix.m_size)) == 0;
+    }
+    bool endsWith(char c) const { return m_size > 0 && m_data[m_size - 1] == c; }
+
+    qsizetype indexOf(char c, qsizetype from = 0) const {
+        if (from < 0 || from >= m_size)
+            return -1;
+        const void *hit = std::memchr(m_data + from, c, size_t(m_size - from));
+        return hit ? static_cast<const char *>(hit) - m_data : -1;
+    }
+    qsizetype indexOf(CatView needle, qsizetype from = 0) const {
+        for (qsizetype i = qMax<qsizetype>(from, 0); i + needle.m_size <= m_size; i++) {
+            if (std::memcmp(m_data + i, needle.m_data, size_t(needle.m_size)) == 0)
+                return i;
+        }
+        return -1;
+    }
+
+    bool operator==(CatView other) const {
+        return m_size == other.m_size && std::memcmp(m_data, other.m_data, size_t(m_size)) == 0;
+    }
+    bool operator!=(CatView other) const { return !(*this == other); }
+
+    int toInt(bool *ok = nullptr) const {
+        bool negative = false;
+        quint64 magnitude = 0;
+        const quint64 limit = quint64(std::numeric_limits<int>::max()) + 1;
+        bool valid = parseInteger(negative, magnitude) && magnitude <= (negative ? limit : limit - 1);
+        if (ok)
+            *ok = valid;
+        if (!valid)
+            return 0;
+        return negative ? int(-qint64(magnitude)) : int(magnitude);
+    }
+
+    quint64 toULongLong(bool *ok = nullptr) const {
+        bool negative = false;
+        quint64 magnitude = 0;
+        bool valid = parseInteger(negative, magnitude) && !negative;
+        if (ok)
+            *ok = valid;
+        return valid ? magnitude : 0;
+    }
+
+    // Plain decimal only ("13.8", "-0.25"): what the K4 reports in status fields
+    double toDouble(bool *ok = nullptr) const {
+        const CatView s = trimmed();
+        qsizetype i = 0;
+        const bool negative = (s.m_size > 0 && s.m_data[0] == '-');
+        if (s.m_size > 0 && (s.m_data[0] == '-' || s.m_data[0] == '+'))
+            i++;
+        quint64 mantissa = 0;
+        int fractionDigits = 0;
+        int digits = 0;
+        bool seenPoint = false;
+        bool valid = true;
+        for (; i < s.m_size; i++) {
+            const char c = s.m_data[i];
+            if (c == '.' && !seenPoint) {
+                seenPoint = true;
+            } else if (c >= '0' && c <= '9' && digits < 18) {
+                mantissa = mantissa * 10 + quint64(c - '0');
+                digits++;
+                if (seenPoint)
+                    fractionDigits++;
+            } else {
+                valid = false;
+                break;
+            }
+        }
+        valid = valid && digits > 0;
+        if (ok)
+            *ok = valid;
+        if (!valid)
+            return 0.0;
+        double scale = 1.0;
+        for (int d = 0; d < fractionDigits; d++)
+            scale *= 10.0;
+        const double value = double(mantissa) / scale;
+        return negative ? -value : value;
+    }
+
+    QString toString() const { return QString::fromLatin1(m_data, m_size); }
+
+private:
+    static bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    bool parseInteger(bool &negative, quint64 &magnitude) const {
+        const CatView s = trimmed();
+        qsizetype i = 0;
+        negative = false;
+        if (s.m_size > 0 && (s.m_data[0] == '-' || s.m_data[0] == '+')) {
+            negative = (s.m_data[0] == '-');
+            i++;
+        }
+        if (i == s.m_size)
+            return false;
+        magnitude = 0;
+        for (; i < s.m_size; i++) {
+            const char c = s.m_data[i];
+            if (c < '0' || c > '9')
+                return false;
+            const quint64 digit = quint64(c - '0');
+            if (magnitude > (std::numeric_limits<quint64>::max() - digit) / 10)
+                return false;
+            magnitude = magnitude * 10 + digit;
+        }
+        return true;
+    }
+
+    const char *m_data = nullptr;
+    qsizetype m_size = 0;
+};
+
+#endif // CATVIEW_H
@@ -4,7 +4,147 @@
 #include <algorithm>
 
 RadioState::RadioState(QObject *parent) : QObject(parent) {
-    registerCommandHandlers();
+    // Every state change signal marks its change-set field; commitChanges() reports them.
+    // Event-style signals (errorNotificationReceived, textBufferReceived) are not tracked.
+    trackChanges(&RadioState::frequencyChanged, FieldVfoA);
+    trackChanges(&RadioState::frequencyBChanged, FieldVfoB);
+    trackChanges(&RadioState::modeChanged, FieldMode);
+    trackChanges(&RadioState::dataSubModeChanged, FieldMode);
+    trackChanges(&RadioState::modeBChanged, FieldModeB);
+    trackChanges(&RadioState::dataSubModeBChanged, FieldModeB);
+
+    trackChanges(&RadioState::filterBandwidthChanged, FieldFilter);
+    trackChanges(&RadioState::filterPositionChanged, FieldFilter);
+    trackChanges(&RadioState::ifShiftChanged, FieldFilter);
+    trackChanges(&RadioState::filterBandwidthBChanged, FieldFilterB);
+    trackChanges(&RadioState::filterPositionBChanged, FieldFilterB);
+    trackChanges(&RadioState::ifShiftBChanged, FieldFilterB);
+
+    trackChanges(&RadioState::sMeterChanged, FieldSMeter);
+    trackChanges(&RadioState::sMeterBChanged, FieldSMeterB);
+    trackChanges(&RadioState::txMeterChanged, FieldTxMeter);
+    trackChanges(&RadioState::swrChanged, FieldTxMeter);
+    trackChanges(&RadioState::powerMeterChanged, FieldTxMeter);
+    trackChanges(&RadioState::transmitStateChanged, FieldTransmit);
+    trackChanges(&RadioState::supplyVoltageChanged, FieldSupply);
+    trackChanges(&RadioState::supplyCurrentChanged, FieldSupply);
+
+    trackChanges(&RadioState::splitChanged, FieldSplit);
+    trackChanges(&RadioState::ritXitChanged, FieldRitXit);
+    trackChanges(&RadioState::voxChanged, FieldVox);
+    trackChanges(&RadioState::voxGainChanged, FieldVox);
+    trackChanges(&RadioState::antiVoxChanged, FieldVox);
+    trackChanges(&RadioState::qskEnabledChanged, FieldQsk);
+    trackChanges(&RadioState::qskDelayChanged, FieldQsk);
+    trackChanges(&RadioState::atuModeChanged, FieldAtu);
+
+    trackChanges(&RadioState::antennaChanged, FieldAntenna);
+    trackChanges(&RadioState::antennaNameChanged, FieldAntenna);
+    trackChanges(&RadioState::mainRxAntCfgChanged, FieldAntenna);
+    trackChanges(&RadioState::subRxAntCfgChanged, FieldAntenna);
+    trackChanges(&RadioState::txAntCfgChanged, FieldAntenna);
+
+    trackChanges(&RadioState::processingChanged, FieldProcessing);
+    trackChanges(&RadioState::notchChanged, FieldProcessing);
+    trackChanges(&RadioState::apfChanged, FieldProcessing);
+    trackChanges(&RadioState::processingChangedB, FieldProcessingB);
+    trackChanges(&RadioState::notchBChanged, FieldProcessingB);
+    trackChanges(&RadioState::apfBChanged, FieldProcessingB);
+
+    trackChanges(&RadioState::subRxEnabledChanged, FieldReceivers);
+    trackChanges(&RadioState::diversityChanged, FieldReceivers);
+    trackChanges(&RadioState::bSetChanged, FieldReceivers);
+
+    trackChanges(&RadioState::rfPowerChanged, FieldTxSettings);
+    trackChanges(&RadioState::keyerSpeedChanged, FieldTxSettings);
+    trackChanges(&RadioState::cwPitchChanged, FieldTxSettings);
+    trackChanges(&RadioState::micGainChanged, FieldTxSettings);
+    trackChanges(&RadioState::compressionChanged, FieldTxSettings);
+    trackChanges(&RadioState::essbChanged, FieldTxSettings);
+    trackChanges(&RadioState::monitorLevelChanged, FieldTxSettings);
+    trackChanges(&RadioState::testModeChanged, FieldTxSettings);
+    trackChanges(&RadioState::messageBankChanged, FieldTxSettings);
+
+    trackChanges(&RadioState::rfGainChanged, FieldRxLevels);
+    trackChanges(&RadioState::squelchChanged, FieldRxLevels);
+    trackChanges(&RadioState::rfGainBChanged, FieldRxLevels);
+    trackChanges(&RadioState::squelchBChanged, FieldRxLevels);
+    trackChanges(&RadioState::afxModeChanged, FieldRxLevels);
+    trackChanges(&RadioState::balanceChanged, FieldRxLevels);
+    trackChanges(&RadioState::audioMixChanged, FieldRxLevels);
+
+    trackChanges(&RadioState::tuningStepChanged, FieldTuning);
+    trackChanges(&RadioState::tuningStepBChanged, FieldTuning);
+    trackChanges(&RadioState::vfoLinkChanged, FieldTuning);
+    trackChanges(&RadioState::lockAChanged, FieldTuning);
+    trackChanges(&RadioState::lockBChanged, FieldTuning);
+
+    trackChanges(&RadioState::refLevelChanged, FieldPanadapter);
+    trackChanges(&RadioState::refLevelBChanged, FieldPanadapter);
+    trackChanges(&RadioState::scaleChanged, FieldPanadapter);
+    trackChanges(&RadioState::spanChanged, FieldPanadapter);
+    trackChanges(&RadioState::spanBChanged, FieldPanadapter);
+    trackChanges(&RadioState::miniPanAEnabledChanged, FieldPanadapter);
+    trackChanges(&RadioState::miniPanBEnabledChanged, FieldPanadapter);
+    trackChanges(&RadioState::autoRefLevelChanged, FieldPanadapter);
+    trackChanges(&RadioState::ddcNbModeChanged, FieldPanadapter);
+    trackChanges(&RadioState::ddcNbLevelChanged, FieldPanadapter);
+
+    trackChanges(&RadioState::dualPanModeLcdChanged, FieldDisplay);
+    trackChanges(&RadioState::dualPanModeExtChanged, FieldDisplay);
+    trackChanges(&RadioState::displayModeLcdChanged, FieldDisplay);
+    trackChanges(&RadioState::displayModeExtChanged, FieldDisplay);
+    trackChanges(&RadioState::displayFpsChanged, FieldDisplay);
+    trackChanges(&RadioState::waterfallColorChanged, FieldDisplay);
+    trackChanges(&RadioState::waterfallHeightChanged, FieldDisplay);
+    trackChanges(&RadioState::waterfallHeightExtChanged, FieldDisplay);
+    trackChanges(&RadioState::averagingChanged, FieldDisplay);
+    trackChanges(&RadioState::peakModeChanged, FieldDisplay);
+    trackChanges(&RadioState::fixedTuneChanged, FieldDisplay);
+    trackChanges(&RadioState::freezeChanged, FieldDisplay);
+    trackChanges(&RadioState::vfoACursorChanged, FieldDisplay);
+    trackChanges(&RadioState::vfoBCursorChanged, FieldDisplay);
+
+    trackChanges(&RadioState::lineOutChanged, FieldAudioIo);
+    trackChanges(&RadioState::lineInChanged, FieldAudioIo);
+    trackChanges(&RadioState::micInputChanged, FieldAudioIo);
+    trackChanges(&RadioState::micSetupChanged, FieldAudioIo);
+
+    trackChanges(&RadioState::rxEqChanged, FieldEq);
+    trackChanges(&RadioState::txEqChanged, FieldEq);
+    trackChanges(&RadioState::textDecodeChanged, FieldTextDecode);
+    trackChanges(&RadioState::textDecodeBChanged, FieldTextDecode);
+}
+
+template <typename Signal> void RadioState::trackChanges(Signal signal, Fields fields) {
+    connect(this, signal, this, [this, fields]() {
+        m_dirtyFields |= fields;
+        if (m_batchDepth == 0)
+            commitChanges();
+    });
+}
+
+void RadioState::beginBatch() {
+    m_batchDepth++;
+}
+
+void RadioState::endBatch() {
+    if (m_batchDepth == 0)
+        return;
+    if (--m_batchDepth == 0)
+        commitChanges();
+}
+
+void RadioState::commitChanges() {
+    const Fields changed = m_dirtyFields;
+    const bool applied = m_commandsApplied;
+    m_dirtyFields = Fields();
+    m_commandsApplied = false;
+
+    if (applied)
+        emit stateUpdated();
+    if (changed)
+        emit changesCommitted(changed);
 }
 
 void RadioState::reset() {
@@ -235,27 +375,32 @@ void RadioState::reset() {
     m_textDecodeLinesB = -1;
 }
 
-void RadioState::parseCATCommand(const QString &command) {
-    QString cmd = command.trimmed();
-    if (cmd.isEmpty())
-        return;
+void RadioState::parseCATCommand(QByteArrayView command) {
+    CatView cmd = CatView(command).trimmed();
 
     // Remove trailing semicolon for parsing
     if (cmd.endsWith(';')) {
         cmd.chop(1);
     }
+    if (cmd.isEmpty())
+        return;
 
-    // Dispatch through handler registry (sorted by prefix length, longest first)
-    for (const auto &entry : m_commandHandlers) {
-        if (cmd.startsWith(entry.prefix)) {
-            entry.handler(cmd);
-            emit stateUpdated();
-            return;
-        }
+    // Dispatch through handler registry (two-byte bucket lookup, longest prefix first).
+    // A command outside a batch is a batch of its own.
+    if (const CommandEntry *entry = findCommand(cmd)) {
+        beginBatch();
+        (this->*entry->handler)(cmd);
+        m_commandsApplied = true;
+        endBatch();
+        return;
     }
 
     // Unknown command - no handler matched
-    // qDebug() << "Unhandled CAT command:" << cmd;
+    // qDebug() << "Unhandled CAT command:" << cmd.toString();
+}
+
+void RadioState::parseCATCommand(const QString &command) {
+    parseCATCommand(QByteArrayView(command.toLatin1()));
 }
 
 // Legacy parseCATCommand content removed - now using handler registry above
@@ -886,155 +1031,259 @@ void RadioState::setSsbTxBw(int bw) {
 // Command Handler Registry
 // =============================================================================
 
-void RadioState::registerCommandHandlers() {
-    // Register handlers in order - will be sorted by prefix length (longest first)
-    // This ensures "MD$" is checked before "MD", "NB$" before "NB", etc.
-
-    // Display commands (# prefix) - register longest first
-    m_commandHandlers.append({"#HWFH", [this](const QString &c) { handleDisplayHWFH(c); }});
-    m_commandHandlers.append({"#HDPM", [this](const QString &c) { handleDisplayHDPM(c); }});
-    m_commandHandlers.append({"#HDSM", [this](const QString &c) { handleDisplayHDSM(c); }});
-    m_commandHandlers.append({"#NBL$", [this](const QString &c) { handleDisplayNBL(c); }});
-    m_commandHandlers.append({"#REF$", [this](const QString &c) { handleDisplayREFSub(c); }});
-    m_commandHandlers.append({"#SPN$", [this](const QString &c) { handleDisplaySPNSub(c); }});
-    m_commandHandlers.append({"#NB$", [this](const QString &c) { handleDisplayNB(c); }});
-    m_commandHandlers.append({"#MP$", [this](const QString &c) { handleDisplayMPSub(c); }});
-    m_commandHandlers.append({"#REF", [this](const QString &c) { handleDisplayREF(c); }});
-    m_commandHandlers.append({"#SPN", [this](const QString &c) { handleDisplaySPN(c); }});
-    m_commandHandlers.append({"#SCL", [this](const QString &c) { handleDisplaySCL(c); }});
-    m_commandHandlers.append({"#DPM", [this](const QString &c) { handleDisplayDPM(c); }});
-    m_commandHandlers.append({"#DSM", [this](const QString &c) { handleDisplayDSM(c); }});
-    m_commandHandlers.append({"#FPS", [this](const QString &c) { handleDisplayFPS(c); }});
-    m_commandHandlers.append({"#WFC", [this](const QString &c) { handleDisplayWFC(c); }});
-    m_commandHandlers.append({"#WFH", [this](const QString &c) { handleDisplayWFH(c); }});
-    m_commandHandlers.append({"#AVG", [this](const QString &c) { handleDisplayAVG(c); }});
-    m_commandHandlers.append({"#PKM", [this](const QString &c) { handleDisplayPKM(c); }});
-    m_commandHandlers.append({"#FXT", [this](const QString &c) { handleDisplayFXT(c); }});
-    m_commandHandlers.append({"#FXA", [this](const QString &c) { handleDisplayFXA(c); }});
-    m_commandHandlers.append({"#FRZ", [this](const QString &c) { handleDisplayFRZ(c); }});
-    m_commandHandlers.append({"#VFA", [this](const QString &c) { handleDisplayVFA(c); }});
-    m_commandHandlers.append({"#VFB", [this](const QString &c) { handleDisplayVFB(c); }});
-    m_commandHandlers.append({"#MP", [this](const QString &c) { handleDisplayMP(c); }});
-    m_commandHandlers.append({"#AR", [this](const QString &c) { handleDisplayAR(c); }});
-
-    // Multi-char commands with $ suffix (must come before their base commands)
-    m_commandHandlers.append({"SIFP", [this](const QString &c) { handleSIFP(c); }});
-    m_commandHandlers.append({"SIRC", [this](const QString &c) { handleSIRC(c); }});
-    m_commandHandlers.append({"TD$", [this](const QString &c) { handleTDSub(c); }});
-    m_commandHandlers.append({"TB$", [this](const QString &c) { handleTBSub(c); }});
-    m_commandHandlers.append({"DT$", [this](const QString &c) { handleDTSub(c); }});
-    m_commandHandlers.append({"MD$", [this](const QString &c) { handleMDSub(c); }});
-    m_commandHandlers.append({"BW$", [this](const QString &c) { handleBWSub(c); }});
-    m_commandHandlers.append({"IS$", [this](const QString &c) { handleISSub(c); }});
-    m_commandHandlers.append({"FP$", [this](const QString &c) { handleFPSub(c); }});
-    m_commandHandlers.append({"RG$", [this](const QString &c) { handleRGSub(c); }});
-    m_commandHandlers.append({"SQ$", [this](const QString &c) { handleSQSub(c); }});
-    m_commandHandlers.append({"SM$", [this](const QString &c) { handleSMSub(c); }});
-    m_commandHandlers.append({"NB$", [this](const QString &c) { handleNBSub(c); }});
-    m_commandHandlers.append({"NR$", [this](const QString &c) { handleNRSub(c); }});
-    m_commandHandlers.append({"PA$", [this](const QString &c) { handlePASub(c); }});
-    m_commandHandlers.append({"RA$", [this](const QString &c) { handleRASub(c); }});
-    m_commandHandlers.append({"GT$", [this](const QString &c) { handleGTSub(c); }});
-    m_commandHandlers.append({"NA$", [this](const QString &c) { handleNASub(c); }});
-    m_commandHandlers.append({"NM$", [this](const QString &c) { handleNMSub(c); }});
-    m_commandHandlers.append({"AP$", [this](const QString &c) { handleAPSub(c); }});
-    m_commandHandlers.append({"LK$", [this](const QString &c) { handleLKSub(c); }});
-    m_commandHandlers.append({"VT$", [this](const QString &c) { handleVTSub(c); }});
-    m_commandHandlers.append({"AR$", [this](const QString &c) { handleARSub(c); }});
-
-    // 3-char commands
-    m_commandHandlers.append({"ACN", [this](const QString &c) { handleACN(c); }});
-    m_commandHandlers.append({"ACM", [this](const QString &c) { handleACM(c); }});
-    m_commandHandlers.append({"ACS", [this](const QString &c) { handleACS(c); }});
-    m_commandHandlers.append({"ACT", [this](const QString &c) { handleACT(c); }});
-    m_commandHandlers.append({"RV.", [this](const QString &c) { handleRV(c); }});
-
-    // 2-char base commands
-    m_commandHandlers.append({"FA", [this](const QString &c) { handleFA(c); }});
-    m_commandHandlers.append({"FB", [this](const QString &c) { handleFB(c); }});
-    m_commandHandlers.append({"FT", [this](const QString &c) { handleFT(c); }});
-    m_commandHandlers.append({"FP", [this](const QString &c) { handleFP(c); }});
-    m_commandHandlers.append({"FX", [this](const QString &c) { handleFX(c); }});
-    m_commandHandlers.append({"MD", [this](const QString &c) { handleMD(c); }});
-    m_commandHandlers.append({"BL", [this](const QString &c) { handleBL(c); }});
-    m_commandHandlers.append({"BW", [this](const QString &c) { handleBW(c); }});
-    m_commandHandlers.append({"IS", [this](const QString &c) { handleIS(c); }});
-    m_commandHandlers.append({"CW", [this](const QString &c) { handleCW(c); }});
-    m_commandHandlers.append({"RG", [this](const QString &c) { handleRG(c); }});
-    m_commandHandlers.append({"SQ", [this](const QString &c) { handleSQ(c); }});
-    m_commandHandlers.append({"MG", [this](const QString &c) { handleMG(c); }});
-    m_commandHandlers.append({"ML", [this](const QString &c) { handleML(c); }});
-    m_commandHandlers.append({"CP", [this](const QString &c) { handleCP(c); }});
-    m_commandHandlers.append({"PC", [this](const QString &c) { handlePC(c); }});
-    m_commandHandlers.append({"KS", [this](const QString &c) { handleKS(c); }});
-    m_commandHandlers.append({"SM", [this](const QString &c) { handleSM(c); }});
-    m_commandHandlers.append({"PO", [this](const QString &c) { handlePO(c); }});
-    m_commandHandlers.append({"TM", [this](const QString &c) { handleTM(c); }});
-    m_commandHandlers.append({"TX", [this](const QString &c) { handleTX(c); }});
-    m_commandHandlers.append({"RX", [this](const QString &c) { handleRX(c); }});
-    m_commandHandlers.append({"NB", [this](const QString &c) { handleNB(c); }});
-    m_commandHandlers.append({"NR", [this](const QString &c) { handleNR(c); }});
-    m_commandHandlers.append({"NA", [this](const QString &c) { handleNA(c); }});
-    m_commandHandlers.append({"NM", [this](const QString &c) { handleNM(c); }});
-    m_commandHandlers.append({"PA", [this](const QString &c) { handlePA(c); }});
-    m_commandHandlers.append({"RA", [this](const QString &c) { handleRA(c); }});
-    m_commandHandlers.append({"GT", [this](const QString &c) { handleGT(c); }});
-    m_commandHandlers.append({"AP", [this](const QString &c) { handleAP(c); }});
-    m_commandHandlers.append({"LN", [this](const QString &c) { handleLN(c); }});
-    m_commandHandlers.append({"LK", [this](const QString &c) { handleLK(c); }});
-    m_commandHandlers.append({"LO", [this](const QString &c) { handleLO(c); }});
-    m_commandHandlers.append({"LI", [this](const QString &c) { handleLI(c); }});
-    m_commandHandlers.append({"VT", [this](const QString &c) { handleVT(c); }});
-    m_commandHandlers.append({"VX", [this](const QString &c) { handleVX(c); }});
-    m_commandHandlers.append({"VG", [this](const QString &c) { handleVG(c); }});
-    m_commandHandlers.append({"VI", [this](const QString &c) { handleVI(c); }});
-    m_commandHandlers.append({"MI", [this](const QString &c) { handleMI(c); }});
-    m_commandHandlers.append({"MS", [this](const QString &c) { handleMS(c); }});
-    m_commandHandlers.append({"MX", [this](const QString &c) { handleMX(c); }});
-    m_commandHandlers.append({"MN", [this](const QString &c) { handleMN(c); }});
-    m_commandHandlers.append({"ES", [this](const QString &c) { handleES(c); }});
-    m_commandHandlers.append({"SD", [this](const QString &c) { handleSD(c); }});
-    m_commandHandlers.append({"SB", [this](const QString &c) { handleSB(c); }});
-    m_commandHandlers.append({"DV", [this](const QString &c) { handleDV(c); }});
-    m_commandHandlers.append({"DT", [this](const QString &c) { handleDT(c); }});
-    m_commandHandlers.append({"TS", [this](const QString &c) { handleTS(c); }});
-    m_commandHandlers.append({"TB", [this](const QString &c) { handleTB(c); }});
-    m_commandHandlers.append({"TD", [this](const QString &c) { handleTD(c); }});
-    m_commandHandlers.append({"TE", [this](const QString &c) { handleTE(c); }});
-    m_commandHandlers.append({"BS", [this](const QString &c) { handleBS(c); }});
-    m_commandHandlers.append({"AN", [this](const QString &c) { handleAN(c); }});
-    m_commandHandlers.append({"AR", [this](const QString &c) { handleAR(c); }});
-    m_commandHandlers.append({"AT", [this](const QString &c) { handleAT(c); }});
-    m_commandHandlers.append({"RT", [this](const QString &c) { handleRT(c); }});
-    m_commandHandlers.append({"XT", [this](const QString &c) { handleXT(c); }});
-    m_commandHandlers.append({"RO", [this](const QString &c) { handleRO(c); }});
-    m_commandHandlers.append({"RE", [this](const QString &c) { handleRE(c); }});
-    m_commandHandlers.append({"ID", [this](const QString &c) { handleID(c); }});
-    m_commandHandlers.append({"OM", [this](const QString &c) { handleOM(c); }});
-    m_commandHandlers.append({"ER", [this](const QString &c) { handleER(c); }});
-
-    // Sort by prefix length (longest first) for correct matching
-    std::sort(m_commandHandlers.begin(), m_commandHandlers.end(),
-              [](const CommandEntry &a, const CommandEntry &b) { return a.prefix.length() > b.prefix.length(); });
+namespace {
+
+// Dispatch buckets are keyed on the first two command bytes: '#' or A-Z, then A-Z.
+// Every registered prefix is at least two characters long.
+constexpr int DISPATCH_BUCKETS = 27 * 26;
+
+constexpr int dispatchBucket(int c0, int c1) {
+    const int first = (c0 == '#') ? 26 : (c0 >= 'A' && c0 <= 'Z') ? c0 - 'A' : -1;
+    if (first < 0 || c1 < 'A' || c1 > 'Z')
+        return -1;
+    return first * 26 + (c1 - 'A');
+}
+
+constexpr int prefixLength(const char *prefix) {
+    int length = 0;
+    while (prefix[length] != '\0')
+        length++;
+    return length;
+}
+
+constexpr bool samePrefix(const char *a, const char *b) {
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+// Registry entries grouped by bucket, longest prefix first within each bucket
+// (so "MD$" is tried before "MD", "#REF$" before "#REF")
+template <std::size_t N> struct DispatchIndex {
+    quint8 order[N] = {};
+    quint8 bucketStart[DISPATCH_BUCKETS + 1] = {};
+};
+
+template <typename Entry, std::size_t N> constexpr DispatchIndex<N> buildDispatchIndex(const Entry (&table)[N]) {
+    static_assert(N < 256, "Dispatch index stores entry numbers as quint8");
+    DispatchIndex<N> index;
+
+    int counts[DISPATCH_BUCKETS + 1] = {};
+    for (std::size_t i = 0; i < N; i++) {
+        const int bucket = dispatchBucket(table[i].prefix[0], table[i].prefix[1]);
+        if (bucket < 0)
+            throw "CAT prefix must start with '#' or A-Z followed by A-Z"; // Fails compilation
+        counts[bucket + 1]++;
+    }
+    for (int b = 0; b < DISPATCH_BUCKETS; b++) {
+        counts[b + 1] += counts[b];
+        index.bucketStart[b + 1] = static_cast<quint8>(counts[b + 1]);
+    }
+
+    int fill[DISPATCH_BUCKETS] = {};
+    for (int b = 0; b < DISPATCH_BUCKETS; b++)
+        fill[b] = counts[b];
+    for (std::size_t i = 0; i < N; i++) {
+        const int bucket = dispatchBucket(table[i].prefix[0], table[i].prefix[1]);
+        index.order[fill[bucket]++] = static_cast<quint8>(i);
+    }
+
+    // A duplicate would silently shadow the other handler. Duplicates share a bucket.
+    for (int b = 0; b < DISPATCH_BUCKETS; b++) {
+        for (int i = index.bucketStart[b]; i < index.bucketStart[b + 1]; i++) {
+            for (int j = i + 1; j < index.bucketStart[b + 1]; j++) {
+                if (samePrefix(table[index.order[i]].prefix, table[index.order[j]].prefix))
+                    throw "CAT prefix registered twice"; // Fails compilation
+            }
+        }
+    }
+
+    // Buckets hold one to three entries, insertion sort is plenty
+    for (int b = 0; b < DISPATCH_BUCKETS; b++) {
+        for (int i = index.bucketStart[b] + 1; i < index.bucketStart[b + 1]; i++) {
+            const quint8 entry = index.order[i];
+            int j = i;
+            while (j > index.bucketStart[b] && prefixLength(table[index.order[j - 1]].prefix) <
+                                                   prefixLength(table[entry].prefix)) {
+                index.order[j] = index.order[j - 1];
+                j--;
+            }
+            index.order[j] = entry;
+        }
+    }
+    return index;
+}
+
+} // namespace
+
+const RadioState::CommandEntry *RadioState::findCommand(CatView cmd) {
+    // Prefix -> handler table. Order does not matter: the index built from it at
+    // compile time checks longer prefixes first within each two-byte bucket.
+    static constexpr CommandEntry COMMANDS[] = {
+        // Display commands (# prefix)
+        {"#HWFH", &RadioState::handleDisplayHWFH},
+        {"#HDPM", &RadioState::handleDisplayHDPM},
+        {"#HDSM", &RadioState::handleDisplayHDSM},
+        {"#NBL$", &RadioState::handleDisplayNBL},
+        {"#REF$", &RadioState::handleDisplayREFSub},
+        {"#SPN$", &RadioState::handleDisplaySPNSub},
+        {"#NB$", &RadioState::handleDisplayNB},
+        {"#MP$", &RadioState::handleDisplayMPSub},
+        {"#REF", &RadioState::handleDisplayREF},
+        {"#SPN", &RadioState::handleDisplaySPN},
+        {"#SCL", &RadioState::handleDisplaySCL},
+        {"#DPM", &RadioState::handleDisplayDPM},
+        {"#DSM", &RadioState::handleDisplayDSM},
+        {"#FPS", &RadioState::handleDisplayFPS},
+        {"#WFC", &RadioState::handleDisplayWFC},
+        {"#WFH", &RadioState::handleDisplayWFH},
+        {"#AVG", &RadioState::handleDisplayAVG},
+        {"#PKM", &RadioState::handleDisplayPKM},
+        {"#FXT", &RadioState::handleDisplayFXT},
+        {"#FXA", &RadioState::handleDisplayFXA},
+        {"#FRZ", &RadioState::handleDisplayFRZ},
+        {"#VFA", &RadioState::handleDisplayVFA},
+        {"#VFB", &RadioState::handleDisplayVFB},
+        {"#MP", &RadioState::handleDisplayMP},
+        {"#AR", &RadioState::handleDisplayAR},
+
+        // Multi-char commands with $ suffix
+        {"SIFP", &RadioState::handleSIFP},
+        {"SIRC", &RadioState::handleSIRC},
+        {"TD$", &RadioState::handleTDSub},
+        {"TB$", &RadioState::handleTBSub},
+        {"DT$", &RadioState::handleDTSub},
+        {"MD$", &RadioState::handleMDSub},
+        {"BW$", &RadioState::handleBWSub},
+        {"IS$", &RadioState::handleISSub},
+        {"FP$", &RadioState::handleFPSub},
+        {"RG$", &RadioState::handleRGSub},
+        {"SQ$", &RadioState::handleSQSub},
+        {"SM$", &RadioState::handleSMSub},
+        {"NB$", &RadioState::handleNBSub},
+        {"NR$", &RadioState::handleNRSub},
+        {"PA$", &RadioState::handlePASub},
+        {"RA$", &RadioState::handleRASub},
+        {"GT$", &RadioState::handleGTSub},
+        {"NA$", &RadioState::handleNASub},
+        {"NM$", &RadioState::handleNMSub},
+        {"AP$", &RadioState::handleAPSub},
+        {"LK$", &RadioState::handleLKSub},
+        {"VT$", &RadioState::handleVTSub},
+        {"AR$", &RadioState::handleARSub},
+
+        // 3-char commands
+        {"ACN", &RadioState::handleACN},
+        {"ACM", &RadioState::handleACM},
+        {"ACS", &RadioState::handleACS},
+        {"ACT", &RadioState::handleACT},
+        {"RV.", &RadioState::handleRV},
+
+        // 2-char base commands
+        {"FA", &RadioState::handleFA},
+        {"FB", &RadioState::handleFB},
+        {"FT", &RadioState::handleFT},
+        {"FP", &RadioState::handleFP},
+        {"FX", &RadioState::handleFX},
+        {"MD", &RadioState::handleMD},
+        {"BL", &RadioState::handleBL},
+        {"BW", &RadioState::handleBW},
+        {"IS", &RadioState::handleIS},
+        {"CW", &RadioState::handleCW},
+        {"RG", &RadioState::handleRG},
+        {"SQ", &RadioState::handleSQ},
+        {"MG", &RadioState::handleMG},
+        {"ML", &RadioState::handleML},
+        {"CP", &RadioState::handleCP},
+        {"PC", &RadioState::handlePC},
+        {"KS", &RadioState::handleKS},
+        {"SM", &RadioState::handleSM},
+        {"PO", &RadioState::handlePO},
+        {"TM", &RadioState::handleTM},
+        {"TX", &RadioState::handleTX},
+        {"RX", &RadioState::handleRX},
+        {"NB", &RadioState::handleNB},
+        {"NR", &RadioState::handleNR},
+        {"NA", &RadioState::handleNA},
+        {"NM", &RadioState::handleNM},
+        {"PA", &RadioState::handlePA},
+        {"RA", &RadioState::handleRA},
+        {"GT", &RadioState::handleGT},
+        {"AP", &RadioState::handleAP},
+        {"LN", &RadioState::handleLN},
+        {"LK", &RadioState::handleLK},
+        {"LO", &RadioState::handleLO},
+        {"LI", &RadioState::handleLI},
+        {"VT", &RadioState::handleVT},
+        {"VX", &RadioState::handleVX},
+        {"VG", &RadioState::handleVG},
+        {"VI", &RadioState::handleVI},
+        {"MI", &RadioState::handleMI},
+        {"MS", &RadioState::handleMS},
+        {"MX", &RadioState::handleMX},
+        {"MN", &RadioState::handleMN},
+        {"ES", &RadioState::handleES},
+        {"SD", &RadioState::handleSD},
+        {"SB", &RadioState::handleSB},
+        {"DV", &RadioState::handleDV},
+        {"DT", &RadioState::handleDT},
+        {"TS", &RadioState::handleTS},
+        {"TB", &RadioState::handleTB},
+        {"TD", &RadioState::handleTD},
+        {"TE", &RadioState::handleTE},
+        {"BS", &RadioState::handleBS},
+        {"AN", &RadioState::handleAN},
+        {"AR", &RadioState::handleAR},
+        {"AT", &RadioState::handleAT},
+        {"RT", &RadioState::handleRT},
+        {"XT", &RadioState::handleXT},
+        {"RO", &RadioState::handleRO},
+        {"RE", &RadioState::handleRE},
+        {"ID", &RadioState::handleID},
+        {"OM", &RadioState::handleOM},
+        {"ER", &RadioState::handleER},
+    };
+    static constexpr auto INDEX = buildDispatchIndex(COMMANDS);
+
+    if (cmd.size() < 2)
+        return nullptr;
+
+    const int bucket = dispatchBucket(cmd[0], cmd[1]);
+    if (bucket < 0)
+        return nullptr;
+
+    for (int i = INDEX.bucketStart[bucket]; i < INDEX.bucketStart[bucket + 1]; i++) {
+        const CommandEntry &entry = COMMANDS[INDEX.order[i]];
+        if (cmd.startsWith(entry.prefix))
+            return &entry;
+    }
+    return nullptr;
+}
+
+const char *RadioState::commandPrefix(QByteArrayView command) {
+    const CommandEntry *entry = findCommand(command);
+    return entry ? entry->prefix : nullptr;
 }
 
 // =============================================================================
 // Individual Command Handlers - VFO/Frequency
 // =============================================================================
 
-void RadioState::handleFA(const QString &cmd) {
+void RadioState::handleFA(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
     quint64 freq = cmd.mid(2).toULongLong(&ok);
-    if (ok) {
+    if (ok && (m_vfoA != freq || m_frequency != freq)) {
         m_vfoA = freq;
         m_frequency = freq;
         emit frequencyChanged(freq);
     }
 }
 
-void RadioState::handleFB(const QString &cmd) {
+void RadioState::handleFB(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1045,7 +1294,7 @@ void RadioState::handleFB(const QString &cmd) {
     }
 }
 
-void RadioState::handleFT(const QString &cmd) {
+void RadioState::handleFT(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool newSplit = (cmd.mid(2) == "1");
@@ -1059,7 +1308,7 @@ void RadioState::handleFT(const QString &cmd) {
 // Individual Command Handlers - Mode
 // =============================================================================
 
-void RadioState::handleMD(const QString &cmd) {
+void RadioState::handleMD(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1077,7 +1326,7 @@ void RadioState::handleMD(const QString &cmd) {
     }
 }
 
-void RadioState::handleMDSub(const QString &cmd) {
+void RadioState::handleMDSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -1095,7 +1344,7 @@ void RadioState::handleMDSub(const QString &cmd) {
 // Individual Command Handlers - Bandwidth/Filter
 // =============================================================================
 
-void RadioState::handleBW(const QString &cmd) {
+void RadioState::handleBW(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1109,7 +1358,7 @@ void RadioState::handleBW(const QString &cmd) {
     }
 }
 
-void RadioState::handleBWSub(const QString &cmd) {
+void RadioState::handleBWSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -1123,7 +1372,7 @@ void RadioState::handleBWSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleIS(const QString &cmd) {
+void RadioState::handleIS(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1134,7 +1383,7 @@ void RadioState::handleIS(const QString &cmd) {
     }
 }
 
-void RadioState::handleISSub(const QString &cmd) {
+void RadioState::handleISSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -1145,7 +1394,7 @@ void RadioState::handleISSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleCW(const QString &cmd) {
+void RadioState::handleCW(CatView cmd) {
     // CW pitch - but skip CW-R mode strings
     if (cmd.length() < 4 || cmd.startsWith("CW-"))
         return;
@@ -1160,7 +1409,7 @@ void RadioState::handleCW(const QString &cmd) {
     }
 }
 
-void RadioState::handleFP(const QString &cmd) {
+void RadioState::handleFP(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1171,7 +1420,7 @@ void RadioState::handleFP(const QString &cmd) {
     }
 }
 
-void RadioState::handleFPSub(const QString &cmd) {
+void RadioState::handleFPSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -1186,7 +1435,7 @@ void RadioState::handleFPSub(const QString &cmd) {
 // Individual Command Handlers - Gain/Level
 // =============================================================================
 
-void RadioState::handleRG(const QString &cmd) {
+void RadioState::handleRG(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1197,7 +1446,7 @@ void RadioState::handleRG(const QString &cmd) {
     }
 }
 
-void RadioState::handleRGSub(const QString &cmd) {
+void RadioState::handleRGSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -1208,7 +1457,7 @@ void RadioState::handleRGSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleSQ(const QString &cmd) {
+void RadioState::handleSQ(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1219,7 +1468,7 @@ void RadioState::handleSQ(const QString &cmd) {
     }
 }
 
-void RadioState::handleSQSub(const QString &cmd) {
+void RadioState::handleSQSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -1230,7 +1479,7 @@ void RadioState::handleSQSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleMG(const QString &cmd) {
+void RadioState::handleMG(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1241,7 +1490,7 @@ void RadioState::handleMG(const QString &cmd) {
     }
 }
 
-void RadioState::handleCP(const QString &cmd) {
+void RadioState::handleCP(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1252,7 +1501,7 @@ void RadioState::handleCP(const QString &cmd) {
     }
 }
 
-void RadioState::handleML(const QString &cmd) {
+void RadioState::handleML(CatView cmd) {
     // Monitor Level - MLmnnn where m=mode (0=CW, 1=Data, 2=Voice), nnn=000-100
     if (cmd.length() < 5)
         return;
@@ -1283,15 +1532,15 @@ void RadioState::handleML(const QString &cmd) {
     }
 }
 
-void RadioState::handleBL(const QString &cmd) {
+void RadioState::handleBL(CatView cmd) {
     // Balance - BLm±nn where m=mode (0=NOR, 1=BAL), ±nn=offset (-50 to +50)
     // Examples: BL0+00, BL0+02, BL0-03, BL1+00, BL1-01
     if (cmd.length() < 5)
         return;
-    int mode = cmd[2].digitValue();
+    int mode = cmd[2] - '0';
     if (mode < 0 || mode > 1)
         return;
-    QChar sign = cmd[3];
+    char sign = cmd[3];
     bool ok;
     int nn = cmd.mid(4).toInt(&ok);
     if (!ok)
@@ -1305,23 +1554,23 @@ void RadioState::handleBL(const QString &cmd) {
     }
 }
 
-void RadioState::handleMX(const QString &cmd) {
+void RadioState::handleMX(CatView cmd) {
     // Audio Mix routing - MXL.R where L and R are component strings
     // Format: "MX" followed by "left.right" e.g. "MXA.B", "MXAB.AB", "MXA.-A"
     // Components: A=main(0), B=sub(1), AB=main+sub(2), -A=neg main(3)
     if (cmd.length() < 5)
         return;
 
-    QString body = cmd.mid(2); // e.g. "A.B", "AB.AB", "A.-A"
+    CatView body = cmd.mid(2); // e.g. "A.B", "AB.AB", "A.-A"
     int dotPos = body.indexOf('.');
     if (dotPos < 1 || dotPos >= body.length() - 1)
         return;
 
-    QString leftStr = body.left(dotPos);
-    QString rightStr = body.mid(dotPos + 1);
+    CatView leftStr = body.left(dotPos);
+    CatView rightStr = body.mid(dotPos + 1);
 
     // Map component string to MixSource value
-    auto mapComponent = [](const QString &s) -> int {
+    auto mapComponent = [](CatView s) -> int {
         if (s == "A")
             return 0; // MixA
         if (s == "B")
@@ -1345,7 +1594,7 @@ void RadioState::handleMX(const QString &cmd) {
     }
 }
 
-void RadioState::handlePC(const QString &cmd) {
+void RadioState::handlePC(CatView cmd) {
     // Power Control - PCnnnr; where nnn=power value, r=L/H/X
     // L = QRP (0.1-10W): nnn is watts*10 (e.g., 099 = 9.9W)
     // H = QRO (1-110W): nnn is watts directly (e.g., 050 = 50W)
@@ -1358,7 +1607,7 @@ void RadioState::handlePC(const QString &cmd) {
     if (!ok)
         return;
 
-    QChar mode = cmd.at(5);
+    char mode = cmd.at(5);
     double watts;
     bool qrp;
 
@@ -1389,7 +1638,7 @@ void RadioState::handlePC(const QString &cmd) {
     }
 }
 
-void RadioState::handleKS(const QString &cmd) {
+void RadioState::handleKS(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -1404,54 +1653,62 @@ void RadioState::handleKS(const QString &cmd) {
 // Individual Command Handlers - Meters
 // =============================================================================
 
-void RadioState::handleSM(const QString &cmd) {
+void RadioState::handleSM(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
     int bars = cmd.mid(2).toInt(&ok);
     if (ok) {
+        double value;
         if (bars <= 18) {
-            m_sMeter = bars / 2.0;
+            value = bars / 2.0;
         } else {
             int dbAboveS9 = (bars - 18) * 3;
-            m_sMeter = 9.0 + dbAboveS9 / 10.0;
+            value = 9.0 + dbAboveS9 / 10.0;
+        }
+        if (value != m_sMeter) {
+            m_sMeter = value;
+            emit sMeterChanged(m_sMeter);
         }
-        emit sMeterChanged(m_sMeter);
     }
 }
 
-void RadioState::handleSMSub(const QString &cmd) {
+void RadioState::handleSMSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
     int bars = cmd.mid(3).toInt(&ok);
     if (ok) {
+        double value;
         if (bars <= 18) {
-            m_sMeterB = bars / 2.0;
+            value = bars / 2.0;
         } else {
             int dbAboveS9 = (bars - 18) * 3;
-            m_sMeterB = 9.0 + dbAboveS9 / 10.0;
+            value = 9.0 + dbAboveS9 / 10.0;
+        }
+        if (value != m_sMeterB) {
+            m_sMeterB = value;
+            emit sMeterBChanged(m_sMeterB);
         }
-        emit sMeterBChanged(m_sMeterB);
     }
 }
 
-void RadioState::handlePO(const QString &cmd) {
+void RadioState::handlePO(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
     int po = cmd.mid(2).toInt(&ok);
-    if (ok) {
+    if (ok && po != m_powerMeter) {
         m_powerMeter = po;
         emit powerMeterChanged(m_powerMeter);
     }
 }
 
-void RadioState::handleTM(const QString &cmd) {
+void RadioState::handleTM(CatView cmd) {
     // TX Meter Data (TM) - TMaaabbbcccddd; (ALC, CMP, FWD, SWR) - 3-digit fields
     if (cmd.length() < 14)
         return;
-    QString data = cmd.mid(2);
+    CatView data = cmd.mid(2);
     if (data.length() < 12)
         return;
 
@@ -1464,21 +1721,28 @@ void RadioState::handleTM(const QString &cmd) {
     if (!ok1 || !ok2 || !ok3 || !ok4)
         return;
 
+    // FWD is watts in QRO, tenths in QRP
+    const double forwardPower = m_isQrpMode ? fwd / 10.0 : fwd;
+    const double swr = swrRaw / 10.0; // SWR in 1/10th units
+    if (alc == m_alcMeter && cmp == m_compressionDb && forwardPower == m_forwardPower && swr == m_swrMeter)
+        return;
+
+    const bool swrDiffers = (swr != m_swrMeter);
     m_alcMeter = alc;
     m_compressionDb = cmp;
-    // FWD is watts in QRO, tenths in QRP
-    m_forwardPower = m_isQrpMode ? fwd / 10.0 : fwd;
-    m_swrMeter = swrRaw / 10.0; // SWR in 1/10th units
+    m_forwardPower = forwardPower;
+    m_swrMeter = swr;
 
     emit txMeterChanged(m_alcMeter, m_compressionDb, m_forwardPower, m_swrMeter);
-    emit swrChanged(m_swrMeter);
+    if (swrDiffers)
+        emit swrChanged(m_swrMeter);
 }
 
 // =============================================================================
 // Individual Command Handlers - TX/RX State
 // =============================================================================
 
-void RadioState::handleTX(const QString &cmd) {
+void RadioState::handleTX(CatView cmd) {
     Q_UNUSED(cmd)
     if (!m_isTransmitting) {
         m_isTransmitting = true;
@@ -1486,7 +1750,7 @@ void RadioState::handleTX(const QString &cmd) {
     }
 }
 
-void RadioState::handleRX(const QString &cmd) {
+void RadioState::handleRX(CatView cmd) {
     Q_UNUSED(cmd)
     if (m_isTransmitting) {
         m_isTransmitting = false;
@@ -1498,11 +1762,11 @@ void RadioState::handleRX(const QString &cmd) {
 // Individual Command Handlers - Processing (NB, NR, PA, RA, GT, NA, NM)
 // =============================================================================
 
-void RadioState::handleNB(const QString &cmd) {
+void RadioState::handleNB(CatView cmd) {
     // NB - Noise Blanker Main: NBnnm or NBnnmf where nn=level, m=on/off, f=filter
     if (cmd.length() < 4)
         return;
-    QString nbStr = cmd.mid(2);
+    CatView nbStr = cmd.mid(2);
     if (nbStr.length() < 3)
         return;
 
@@ -1512,24 +1776,31 @@ void RadioState::handleNB(const QString &cmd) {
     if (!ok1 || !ok2)
         return;
 
-    m_noiseBlankerLevel = qMin(level, 15);
-    m_noiseBlankerEnabled = (enabled == 1);
-
+    int filterWidth = m_noiseBlankerFilterWidth;
     if (nbStr.length() >= 4) {
         bool ok3;
         int filter = nbStr.mid(3, 1).toInt(&ok3);
         if (ok3) {
-            m_noiseBlankerFilterWidth = qMin(filter, 2);
+            filterWidth = qMin(filter, 2);
         }
     }
-    emit processingChanged();
+
+    const int newLevel = qMin(level, 15);
+    const bool newEnabled = (enabled == 1);
+    if (newLevel != m_noiseBlankerLevel || newEnabled != m_noiseBlankerEnabled ||
+        filterWidth != m_noiseBlankerFilterWidth) {
+        m_noiseBlankerLevel = newLevel;
+        m_noiseBlankerEnabled = newEnabled;
+        m_noiseBlankerFilterWidth = filterWidth;
+        emit processingChanged();
+    }
 }
 
-void RadioState::handleNBSub(const QString &cmd) {
+void RadioState::handleNBSub(CatView cmd) {
     // NB$ - Noise Blanker Sub
     if (cmd.length() < 5)
         return;
-    QString nbStr = cmd.mid(3);
+    CatView nbStr = cmd.mid(3);
     if (nbStr.length() < 3)
         return;
 
@@ -1539,162 +1810,159 @@ void RadioState::handleNBSub(const QString &cmd) {
     if (!ok1 || !ok2)
         return;
 
-    m_noiseBlankerLevelB = qMin(level, 15);
-    m_noiseBlankerEnabledB = (enabled == 1);
-
+    int filterWidth = m_noiseBlankerFilterWidthB;
     if (nbStr.length() >= 4) {
         bool ok3;
         int filter = nbStr.mid(3, 1).toInt(&ok3);
         if (ok3) {
-            m_noiseBlankerFilterWidthB = qMin(filter, 2);
+            filterWidth = qMin(filter, 2);
         }
     }
-    emit processingChangedB();
+
+    const int newLevel = qMin(level, 15);
+    const bool newEnabled = (enabled == 1);
+    if (newLevel != m_noiseBlankerLevelB || newEnabled != m_noiseBlankerEnabledB ||
+        filterWidth != m_noiseBlankerFilterWidthB) {
+        m_noiseBlankerLevelB = newLevel;
+        m_noiseBlankerEnabledB = newEnabled;
+        m_noiseBlankerFilterWidthB = filterWidth;
+        emit processingChangedB();
+    }
 }
 
-void RadioState::handleNR(const QString &cmd) {
+void RadioState::handleNR(CatView cmd) {
     // NR - Noise Reduction Main
     if (cmd.length() < 3)
         return;
-    QString nrStr = cmd.mid(2);
+    CatView nrStr = cmd.mid(2);
     if (nrStr.length() < 3)
         return;
 
     bool ok1, ok2;
     int level = nrStr.left(2).toInt(&ok1);
     int enabled = nrStr.right(1).toInt(&ok2);
-    if (ok1 && ok2) {
+    if (ok1 && ok2 && (level != m_noiseReductionLevel || (enabled == 1) != m_noiseReductionEnabled)) {
         m_noiseReductionLevel = level;
         m_noiseReductionEnabled = (enabled == 1);
         emit processingChanged();
     }
 }
 
-void RadioState::handleNRSub(const QString &cmd) {
+void RadioState::handleNRSub(CatView cmd) {
     // NR$ - Noise Reduction Sub
     if (cmd.length() < 4)
         return;
-    QString nrStr = cmd.mid(3);
+    CatView nrStr = cmd.mid(3);
     if (nrStr.length() < 3)
         return;
 
     bool ok1, ok2;
     int level = nrStr.left(2).toInt(&ok1);
     int enabled = nrStr.right(1).toInt(&ok2);
-    if (ok1 && ok2) {
+    if (ok1 && ok2 && (level != m_noiseReductionLevelB || (enabled == 1) != m_noiseReductionEnabledB)) {
         m_noiseReductionLevelB = level;
         m_noiseReductionEnabledB = (enabled == 1);
         emit processingChangedB();
     }
 }
 
-void RadioState::handlePA(const QString &cmd) {
+void RadioState::handlePA(CatView cmd) {
     // PA - Preamp Main: PAnm where n=level, m=on/off
     if (cmd.length() < 4)
         return;
-    QString paStr = cmd.mid(2);
+    CatView paStr = cmd.mid(2);
     if (paStr.length() < 2)
         return;
 
     bool ok1, ok2;
     int level = paStr.left(1).toInt(&ok1);
     int enabled = paStr.mid(1, 1).toInt(&ok2);
-    if (ok1 && ok2) {
+    if (ok1 && ok2 && (level != m_preamp || (enabled == 1) != m_preampEnabled)) {
         m_preamp = level;
         m_preampEnabled = (enabled == 1);
         emit processingChanged();
     }
 }
 
-void RadioState::handlePASub(const QString &cmd) {
+void RadioState::handlePASub(CatView cmd) {
     // PA$ - Preamp Sub
     if (cmd.length() < 5)
         return;
-    QString paStr = cmd.mid(3);
+    CatView paStr = cmd.mid(3);
     if (paStr.length() < 2)
         return;
 
     bool ok1, ok2;
     int level = paStr.left(1).toInt(&ok1);
     int enabled = paStr.mid(1, 1).toInt(&ok2);
-    if (ok1 && ok2) {
+    if (ok1 && ok2 && (level != m_preampB || (enabled == 1) != m_preampEnabledB)) {
         m_preampB = level;
         m_preampEnabledB = (enabled == 1);
         emit processingChangedB();
     }
 }
 
-void RadioState::handleRA(const QString &cmd) {
+void RadioState::handleRA(CatView cmd) {
     // RA - Attenuator Main: RAnnotm where nn=level, m=on/off
     if (cmd.length() < 5)
         return;
-    QString raStr = cmd.mid(2);
+    CatView raStr = cmd.mid(2);
     if (raStr.length() < 3)
         return;
 
     bool ok1, ok2;
     int level = raStr.left(2).toInt(&ok1);
     int enabled = raStr.mid(2, 1).toInt(&ok2);
-    if (ok1 && ok2) {
+    if (ok1 && ok2 && (level != m_attenuatorLevel || (enabled == 1) != m_attenuatorEnabled)) {
         m_attenuatorLevel = level;
         m_attenuatorEnabled = (enabled == 1);
         emit processingChanged();
     }
 }
 
-void RadioState::handleRASub(const QString &cmd) {
+void RadioState::handleRASub(CatView cmd) {
     // RA$ - Attenuator Sub
     if (cmd.length() < 6)
         return;
-    QString raStr = cmd.mid(3);
+    CatView raStr = cmd.mid(3);
     if (raStr.length() < 3)
         return;
 
     bool ok1, ok2;
     int level = raStr.left(2).toInt(&ok1);
     int enabled = raStr.mid(2, 1).toInt(&ok2);
-    if (ok1 && ok2) {
+    if (ok1 && ok2 && (level != m_attenuatorLevelB || (enabled == 1) != m_attenuatorEnabledB)) {
         m_attenuatorLevelB = level;
         m_attenuatorEnabledB = (enabled == 1);
         emit processingChangedB();
     }
 }
 
-void RadioState::handleGT(const QString &cmd) {
+void RadioState::handleGT(CatView cmd) {
     // GT - AGC Speed Main: GTn where n=0(off)/1(slow)/2(fast)
     if (cmd.length() <= 2)
         return;
     bool ok;
     int gt = cmd.mid(2).toInt(&ok);
-    if (ok) {
-        if (gt == 0)
-            m_agcSpeed = AGC_Off;
-        else if (gt == 1)
-            m_agcSpeed = AGC_Slow;
-        else if (gt == 2)
-            m_agcSpeed = AGC_Fast;
+    if (ok && gt >= AGC_Off && gt <= AGC_Fast && static_cast<AGCSpeed>(gt) != m_agcSpeed) {
+        m_agcSpeed = static_cast<AGCSpeed>(gt);
         emit processingChanged();
     }
 }
 
-void RadioState::handleGTSub(const QString &cmd) {
+void RadioState::handleGTSub(CatView cmd) {
     // GT$ - AGC Speed Sub
     if (cmd.length() < 4)
         return;
     bool ok;
     int gt = cmd.mid(3).toInt(&ok);
-    if (ok) {
-        if (gt == 0)
-            m_agcSpeedB = AGC_Off;
-        else if (gt == 1)
-            m_agcSpeedB = AGC_Slow;
-        else if (gt == 2)
-            m_agcSpeedB = AGC_Fast;
+    if (ok && gt >= AGC_Off && gt <= AGC_Fast && static_cast<AGCSpeed>(gt) != m_agcSpeedB) {
+        m_agcSpeedB = static_cast<AGCSpeed>(gt);
         emit processingChangedB();
     }
 }
 
-void RadioState::handleNA(const QString &cmd) {
+void RadioState::handleNA(CatView cmd) {
     // NA - Auto Notch Main
     if (cmd.length() < 3)
         return;
@@ -1705,7 +1973,7 @@ void RadioState::handleNA(const QString &cmd) {
     }
 }
 
-void RadioState::handleNASub(const QString &cmd) {
+void RadioState::handleNASub(CatView cmd) {
     // NA$ - Auto Notch Sub
     if (cmd.length() < 4)
         return;
@@ -1716,11 +1984,11 @@ void RadioState::handleNASub(const QString &cmd) {
     }
 }
 
-void RadioState::handleNM(const QString &cmd) {
+void RadioState::handleNM(CatView cmd) {
     // NM - Manual Notch Main: NMnnnnm or NMm
     if (cmd.length() < 3)
         return;
-    QString data = cmd.mid(2);
+    CatView data = cmd.mid(2);
     if (data.length() >= 5) {
         bool ok;
         int pitch = data.left(4).toInt(&ok);
@@ -1746,11 +2014,11 @@ void RadioState::handleNM(const QString &cmd) {
     }
 }
 
-void RadioState::handleNMSub(const QString &cmd) {
+void RadioState::handleNMSub(CatView cmd) {
     // NM$ - Manual Notch Sub
     if (cmd.length() < 4)
         return;
-    QString data = cmd.mid(3);
+    CatView data = cmd.mid(3);
     if (data.length() >= 5) {
         bool ok;
         int pitch = data.left(4).toInt(&ok);
@@ -1780,7 +2048,7 @@ void RadioState::handleNMSub(const QString &cmd) {
 // Individual Command Handlers - Audio/Effects
 // =============================================================================
 
-void RadioState::handleFX(const QString &cmd) {
+void RadioState::handleFX(CatView cmd) {
     // FX - Audio Effects: FXn where n=0(off)/1(delay)/2(pitch-map)
     if (cmd.length() < 3)
         return;
@@ -1792,7 +2060,7 @@ void RadioState::handleFX(const QString &cmd) {
     }
 }
 
-void RadioState::handleAP(const QString &cmd) {
+void RadioState::handleAP(CatView cmd) {
     // AP - Audio Peak Filter Main: APmb where m=enabled, b=bandwidth
     if (cmd.length() < 4)
         return;
@@ -1813,7 +2081,7 @@ void RadioState::handleAP(const QString &cmd) {
     }
 }
 
-void RadioState::handleAPSub(const QString &cmd) {
+void RadioState::handleAPSub(CatView cmd) {
     // AP$ - Audio Peak Filter Sub
     if (cmd.length() < 5)
         return;
@@ -1838,7 +2106,7 @@ void RadioState::handleAPSub(const QString &cmd) {
 // Individual Command Handlers - VFO Control
 // =============================================================================
 
-void RadioState::handleLN(const QString &cmd) {
+void RadioState::handleLN(CatView cmd) {
     // LN - VFO Link
     if (cmd.length() < 3)
         return;
@@ -1853,7 +2121,7 @@ void RadioState::handleLN(const QString &cmd) {
     }
 }
 
-void RadioState::handleLK(const QString &cmd) {
+void RadioState::handleLK(CatView cmd) {
     // LK - VFO A Lock
     if (cmd.length() < 3)
         return;
@@ -1868,7 +2136,7 @@ void RadioState::handleLK(const QString &cmd) {
     }
 }
 
-void RadioState::handleLKSub(const QString &cmd) {
+void RadioState::handleLKSub(CatView cmd) {
     // LK$ - VFO B Lock
     if (cmd.length() < 4)
         return;
@@ -1883,11 +2151,11 @@ void RadioState::handleLKSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleVT(const QString &cmd) {
+void RadioState::handleVT(CatView cmd) {
     // VT - Tuning Step Main
     if (cmd.length() <= 2)
         return;
-    QString vtStr = cmd.mid(2);
+    CatView vtStr = cmd.mid(2);
     if (vtStr.isEmpty())
         return;
 
@@ -1902,11 +2170,11 @@ void RadioState::handleVT(const QString &cmd) {
     }
 }
 
-void RadioState::handleVTSub(const QString &cmd) {
+void RadioState::handleVTSub(CatView cmd) {
     // VT$ - Tuning Step Sub
     if (cmd.length() <= 3)
         return;
-    QString vtStr = cmd.mid(3);
+    CatView vtStr = cmd.mid(3);
     if (vtStr.isEmpty())
         return;
 
@@ -1925,11 +2193,11 @@ void RadioState::handleVTSub(const QString &cmd) {
 // Individual Command Handlers - VOX
 // =============================================================================
 
-void RadioState::handleVX(const QString &cmd) {
+void RadioState::handleVX(CatView cmd) {
     // VX - VOX Enable: VXmn where m=mode (C/V/D), n=0/1
     if (cmd.length() < 4)
         return;
-    QChar mode = cmd.at(2);
+    char mode = cmd.at(2);
     bool enabled = (cmd.at(3) == '1');
     bool changed = false;
     if (mode == 'C' && m_voxCW != enabled) {
@@ -1947,11 +2215,11 @@ void RadioState::handleVX(const QString &cmd) {
     }
 }
 
-void RadioState::handleVG(const QString &cmd) {
+void RadioState::handleVG(CatView cmd) {
     // VG - VOX Gain: VGmnnn where m=V(voice)/D(data), nnn=000-060
     if (cmd.length() < 5)
         return;
-    QChar modeChar = cmd.at(2);
+    char modeChar = cmd.at(2);
     bool ok;
     int gain = cmd.mid(3, 3).toInt(&ok);
     if (ok && gain >= 0 && gain <= 60) {
@@ -1965,7 +2233,7 @@ void RadioState::handleVG(const QString &cmd) {
     }
 }
 
-void RadioState::handleVI(const QString &cmd) {
+void RadioState::handleVI(CatView cmd) {
     // VI - Anti-VOX: VInnn where nnn=000-060
     if (cmd.length() < 5)
         return;
@@ -1981,7 +2249,7 @@ void RadioState::handleVI(const QString &cmd) {
 // Individual Command Handlers - Audio I/O
 // =============================================================================
 
-void RadioState::handleLO(const QString &cmd) {
+void RadioState::handleLO(CatView cmd) {
     // LO - Line Out: LOlllrrrm where lll=left, rrr=right, m=mode
     if (cmd.length() < 9)
         return;
@@ -2009,7 +2277,7 @@ void RadioState::handleLO(const QString &cmd) {
     }
 }
 
-void RadioState::handleLI(const QString &cmd) {
+void RadioState::handleLI(CatView cmd) {
     // LI - Line In: LIuuullls where uuu=soundcard, lll=linein, s=source
     if (cmd.length() < 9)
         return;
@@ -2038,7 +2306,7 @@ void RadioState::handleLI(const QString &cmd) {
     }
 }
 
-void RadioState::handleMI(const QString &cmd) {
+void RadioState::handleMI(CatView cmd) {
     // MI - Mic Input Select
     if (cmd.length() < 3)
         return;
@@ -2049,7 +2317,7 @@ void RadioState::handleMI(const QString &cmd) {
     }
 }
 
-void RadioState::handleMS(const QString &cmd) {
+void RadioState::handleMS(CatView cmd) {
     // MS - Mic Setup: MSabcde
     if (cmd.length() < 7)
         return;
@@ -2084,7 +2352,7 @@ void RadioState::handleMS(const QString &cmd) {
         emit micSetupChanged();
 }
 
-void RadioState::handleES(const QString &cmd) {
+void RadioState::handleES(CatView cmd) {
     // ES - ESSB: ESnbb where n=0/1, bb=bandwidth
     if (cmd.length() < 4)
         return;
@@ -2121,12 +2389,12 @@ void RadioState::handleES(const QString &cmd) {
 // Individual Command Handlers - QSK/Delay
 // =============================================================================
 
-void RadioState::handleSD(const QString &cmd) {
+void RadioState::handleSD(CatView cmd) {
     // SD - QSK/VOX Delay: SDxMzzz where x=QSK flag, M=mode, zzz=delay
     if (cmd.length() < 7)
         return;
-    QChar qskFlag = cmd.at(2);
-    QChar modeChar = cmd.at(3);
+    char qskFlag = cmd.at(2);
+    char modeChar = cmd.at(3);
     bool ok;
     int delay = cmd.mid(4, 3).toInt(&ok);
     if (!ok)
@@ -2167,15 +2435,18 @@ void RadioState::handleSD(const QString &cmd) {
 // Individual Command Handlers - Control State
 // =============================================================================
 
-void RadioState::handleSB(const QString &cmd) {
+void RadioState::handleSB(CatView cmd) {
     // SB - Sub Receiver: SB0=off, SB1=on, SB3=on (diversity)
     if (cmd.length() <= 2)
         return;
-    m_subReceiverEnabled = (cmd.mid(2) != "0");
-    emit subRxEnabledChanged(m_subReceiverEnabled);
+    bool enabled = (cmd.mid(2) != "0");
+    if (enabled != m_subReceiverEnabled) {
+        m_subReceiverEnabled = enabled;
+        emit subRxEnabledChanged(m_subReceiverEnabled);
+    }
 }
 
-void RadioState::handleDV(const QString &cmd) {
+void RadioState::handleDV(CatView cmd) {
     // DV - Diversity
     if (cmd.length() <= 2)
         return;
@@ -2186,7 +2457,7 @@ void RadioState::handleDV(const QString &cmd) {
     }
 }
 
-void RadioState::handleTS(const QString &cmd) {
+void RadioState::handleTS(CatView cmd) {
     // TS - Test Mode
     if (cmd.length() < 3)
         return;
@@ -2197,7 +2468,7 @@ void RadioState::handleTS(const QString &cmd) {
     }
 }
 
-void RadioState::handleBS(const QString &cmd) {
+void RadioState::handleBS(CatView cmd) {
     // BS - B SET
     if (cmd.length() < 3)
         return;
@@ -2212,7 +2483,7 @@ void RadioState::handleBS(const QString &cmd) {
 // Individual Command Handlers - Antenna
 // =============================================================================
 
-void RadioState::handleAN(const QString &cmd) {
+void RadioState::handleAN(CatView cmd) {
     if (cmd.length() <= 2)
         return;
     bool ok;
@@ -2223,7 +2494,7 @@ void RadioState::handleAN(const QString &cmd) {
     }
 }
 
-void RadioState::handleAR(const QString &cmd) {
+void RadioState::handleAR(CatView cmd) {
     if (cmd.startsWith("AR$"))
         return;
     if (cmd.length() <= 2)
@@ -2236,7 +2507,7 @@ void RadioState::handleAR(const QString &cmd) {
     }
 }
 
-void RadioState::handleARSub(const QString &cmd) {
+void RadioState::handleARSub(CatView cmd) {
     if (cmd.length() <= 3)
         return;
     bool ok;
@@ -2247,7 +2518,7 @@ void RadioState::handleARSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleAT(const QString &cmd) {
+void RadioState::handleAT(CatView cmd) {
     if (cmd.length() < 3)
         return;
     bool ok;
@@ -2258,13 +2529,13 @@ void RadioState::handleAT(const QString &cmd) {
     }
 }
 
-void RadioState::handleACN(const QString &cmd) {
+void RadioState::handleACN(CatView cmd) {
     if (cmd.length() < 4)
         return;
     bool ok;
     int index = cmd.mid(3, 1).toInt(&ok);
     if (ok && index >= 1 && index <= 7) {
-        QString name = cmd.mid(4).trimmed();
+        QString name = cmd.mid(4).trimmed().toString();
         if (!name.isEmpty() && name != m_antennaNames.value(index)) {
             m_antennaNames[index] = name;
             emit antennaNameChanged(index, name);
@@ -2272,7 +2543,7 @@ void RadioState::handleACN(const QString &cmd) {
     }
 }
 
-void RadioState::handleACM(const QString &cmd) {
+void RadioState::handleACM(CatView cmd) {
     if (cmd.length() < 11)
         return;
     bool displayAll = (cmd.at(3) == '1');
@@ -2289,7 +2560,7 @@ void RadioState::handleACM(const QString &cmd) {
         emit mainRxAntCfgChanged();
 }
 
-void RadioState::handleACS(const QString &cmd) {
+void RadioState::handleACS(CatView cmd) {
     if (cmd.length() < 11)
         return;
     bool displayAll = (cmd.at(3) == '1');
@@ -2306,7 +2577,7 @@ void RadioState::handleACS(const QString &cmd) {
         emit subRxAntCfgChanged();
 }
 
-void RadioState::handleACT(const QString &cmd) {
+void RadioState::handleACT(CatView cmd) {
     if (cmd.length() < 7)
         return;
     bool displayAll = (cmd.at(3) == '1');
@@ -2327,7 +2598,7 @@ void RadioState::handleACT(const QString &cmd) {
 // Individual Command Handlers - RIT/XIT
 // =============================================================================
 
-void RadioState::handleRT(const QString &cmd) {
+void RadioState::handleRT(CatView cmd) {
     if (cmd.length() < 3 || (cmd.at(2) != '0' && cmd.at(2) != '1'))
         return;
     bool enabled = (cmd.at(2) == '1');
@@ -2337,7 +2608,7 @@ void RadioState::handleRT(const QString &cmd) {
     }
 }
 
-void RadioState::handleXT(const QString &cmd) {
+void RadioState::handleXT(CatView cmd) {
     if (cmd.length() < 3 || (cmd.at(2) != '0' && cmd.at(2) != '1'))
         return;
     bool enabled = (cmd.at(2) == '1');
@@ -2347,7 +2618,7 @@ void RadioState::handleXT(const QString &cmd) {
     }
 }
 
-void RadioState::handleRO(const QString &cmd) {
+void RadioState::handleRO(CatView cmd) {
     if (cmd.length() < 3)
         return;
     bool ok;
@@ -2362,7 +2633,7 @@ void RadioState::handleRO(const QString &cmd) {
 // Individual Command Handlers - Text Decode
 // =============================================================================
 
-void RadioState::handleTD(const QString &cmd) {
+void RadioState::handleTD(CatView cmd) {
     if (cmd.length() < 5)
         return;
     int mode = cmd.mid(2, 1).toInt();
@@ -2385,7 +2656,7 @@ void RadioState::handleTD(const QString &cmd) {
         emit textDecodeChanged();
 }
 
-void RadioState::handleTDSub(const QString &cmd) {
+void RadioState::handleTDSub(CatView cmd) {
     if (cmd.length() < 6)
         return;
     int mode = cmd.mid(3, 1).toInt();
@@ -2408,31 +2679,31 @@ void RadioState::handleTDSub(const QString &cmd) {
         emit textDecodeBChanged();
 }
 
-void RadioState::handleTB(const QString &cmd) {
+void RadioState::handleTB(CatView cmd) {
     if (cmd.length() < 5)
         return;
-    QString text = cmd.mid(5);
+    CatView text = cmd.mid(5);
     if (text.endsWith(';'))
         text.chop(1);
     if (!text.isEmpty())
-        emit textBufferReceived(text, false);
+        emit textBufferReceived(text.toString(), false);
 }
 
-void RadioState::handleTBSub(const QString &cmd) {
+void RadioState::handleTBSub(CatView cmd) {
     if (cmd.length() < 6)
         return;
-    QString text = cmd.mid(6);
+    CatView text = cmd.mid(6);
     if (text.endsWith(';'))
         text.chop(1);
     if (!text.isEmpty())
-        emit textBufferReceived(text, true);
+        emit textBufferReceived(text.toString(), true);
 }
 
 // =============================================================================
 // Individual Command Handlers - Data Mode
 // =============================================================================
 
-void RadioState::handleDT(const QString &cmd) {
+void RadioState::handleDT(CatView cmd) {
     if (cmd.length() < 3)
         return;
     bool ok;
@@ -2448,7 +2719,7 @@ void RadioState::handleDT(const QString &cmd) {
     }
 }
 
-void RadioState::handleDTSub(const QString &cmd) {
+void RadioState::handleDTSub(CatView cmd) {
     if (cmd.length() < 4)
         return;
     bool ok;
@@ -2468,7 +2739,7 @@ void RadioState::handleDTSub(const QString &cmd) {
 // Individual Command Handlers - Equalizer
 // =============================================================================
 
-void RadioState::handleRE(const QString &cmd) {
+void RadioState::handleRE(CatView cmd) {
     if (cmd.length() < 26)
         return;
     bool changed = false;
@@ -2485,7 +2756,7 @@ void RadioState::handleRE(const QString &cmd) {
         emit rxEqChanged();
 }
 
-void RadioState::handleTE(const QString &cmd) {
+void RadioState::handleTE(CatView cmd) {
     if (cmd.length() < 26)
         return;
     bool changed = false;
@@ -2506,17 +2777,17 @@ void RadioState::handleTE(const QString &cmd) {
 // Individual Command Handlers - Radio Info
 // =============================================================================
 
-void RadioState::handleID(const QString &cmd) {
+void RadioState::handleID(CatView cmd) {
     if (cmd.length() > 2)
-        m_radioID = cmd.mid(2);
+        m_radioID = cmd.mid(2).toString();
 }
 
-void RadioState::handleOM(const QString &cmd) {
+void RadioState::handleOM(CatView cmd) {
     // OM format: 12-char string where each position indicates an option
     // Positions: 0=ATU, 1=PA, 2=XVTR, 3=SubRX, 4=HD, 5=Mini, 6=Linear, 7=KPA1500, 8=model marker
     if (cmd.length() <= 2)
         return;
-    m_optionModules = cmd.mid(2).trimmed();
+    m_optionModules = cmd.mid(2).trimmed().toString();
     if (m_optionModules.length() > 8) {
         bool hasS = m_optionModules.length() > 3 && m_optionModules[3] == 'S';
         bool hasH = m_optionModules.length() > 4 && m_optionModules[4] == 'H';
@@ -2532,26 +2803,26 @@ void RadioState::handleOM(const QString &cmd) {
     }
 }
 
-void RadioState::handleRV(const QString &cmd) {
+void RadioState::handleRV(CatView cmd) {
     // RV.COMPONENT-VERSION format (e.g., "RV.DDC0-00.65 (0:35)")
     if (cmd.length() <= 3)
         return;
-    QString versionData = cmd.mid(3);
-    int dashIndex = versionData.indexOf('-');
+    CatView versionData = cmd.mid(3);
+    qsizetype dashIndex = versionData.indexOf('-');
     if (dashIndex > 0) {
-        QString component = versionData.left(dashIndex);
-        QString version = versionData.mid(dashIndex + 1);
+        QString component = versionData.left(dashIndex).toString();
+        QString version = versionData.mid(dashIndex + 1).toString();
         m_firmwareVersions[component] = version;
     }
 }
 
-void RadioState::handleSIFP(const QString &cmd) {
-    QString data = cmd.mid(4);
+void RadioState::handleSIFP(CatView cmd) {
+    CatView data = cmd.mid(4);
     // Parse VS (voltage)
-    int vsIndex = data.indexOf("VS:");
+    qsizetype vsIndex = data.indexOf("VS:");
     if (vsIndex >= 0) {
-        int commaIndex = data.indexOf(',', vsIndex);
-        QString vsStr =
+        qsizetype commaIndex = data.indexOf(',', vsIndex);
+        CatView vsStr =
             (commaIndex > vsIndex) ? data.mid(vsIndex + 3, commaIndex - vsIndex - 3) : data.mid(vsIndex + 3);
         bool ok;
         double voltage = vsStr.toDouble(&ok);
@@ -2561,10 +2832,10 @@ void RadioState::handleSIFP(const QString &cmd) {
         }
     }
     // Parse IS (current)
-    int isIndex = data.indexOf("IS:");
+    qsizetype isIndex = data.indexOf("IS:");
     if (isIndex >= 0) {
-        int commaIndex = data.indexOf(',', isIndex);
-        QString isStr =
+        qsizetype commaIndex = data.indexOf(',', isIndex);
+        CatView isStr =
             (commaIndex > isIndex) ? data.mid(isIndex + 3, commaIndex - isIndex - 3) : data.mid(isIndex + 3);
         bool ok;
         double current = isStr.toDouble(&ok);
@@ -2575,11 +2846,11 @@ void RadioState::handleSIFP(const QString &cmd) {
     }
 }
 
-void RadioState::handleSIRC(const QString &cmd) {
+void RadioState::handleSIRC(CatView cmd) {
     Q_UNUSED(cmd)
 }
 
-void RadioState::handleMN(const QString &cmd) {
+void RadioState::handleMN(CatView cmd) {
     if (cmd.length() < 3)
         return;
     bool ok;
@@ -2590,13 +2861,13 @@ void RadioState::handleMN(const QString &cmd) {
     }
 }
 
-void RadioState::handleER(const QString &cmd) {
-    int colonPos = cmd.indexOf(':');
+void RadioState::handleER(CatView cmd) {
+    qsizetype colonPos = cmd.indexOf(':');
     if (colonPos > 2) {
         bool ok;
         int errorCode = cmd.mid(2, colonPos - 2).toInt(&ok);
         if (ok)
-            emit errorNotificationReceived(errorCode, cmd.mid(colonPos + 1));
+            emit errorNotificationReceived(errorCode, cmd.mid(colonPos + 1).toString());
     }
 }
 
@@ -2604,7 +2875,7 @@ void RadioState::handleER(const QString &cmd) {
 // Individual Command Handlers - Display (# prefix)
 // =============================================================================
 
-void RadioState::handleDisplayREF(const QString &cmd) {
+void RadioState::handleDisplayREF(CatView cmd) {
     if (cmd.startsWith("#REF$") || cmd.length() <= 4)
         return;
     bool ok;
@@ -2615,7 +2886,7 @@ void RadioState::handleDisplayREF(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayREFSub(const QString &cmd) {
+void RadioState::handleDisplayREFSub(CatView cmd) {
     if (cmd.length() <= 5)
         return;
     bool ok;
@@ -2626,7 +2897,7 @@ void RadioState::handleDisplayREFSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplaySCL(const QString &cmd) {
+void RadioState::handleDisplaySCL(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2637,7 +2908,7 @@ void RadioState::handleDisplaySCL(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplaySPN(const QString &cmd) {
+void RadioState::handleDisplaySPN(CatView cmd) {
     if (cmd.startsWith("#SPN$") || cmd.length() <= 4)
         return;
     bool ok;
@@ -2648,7 +2919,7 @@ void RadioState::handleDisplaySPN(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplaySPNSub(const QString &cmd) {
+void RadioState::handleDisplaySPNSub(CatView cmd) {
     if (cmd.length() <= 5)
         return;
     bool ok;
@@ -2659,7 +2930,7 @@ void RadioState::handleDisplaySPNSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayMP(const QString &cmd) {
+void RadioState::handleDisplayMP(CatView cmd) {
     if (cmd.startsWith("#MP$") || cmd.length() <= 3)
         return;
     bool enabled = (cmd.at(3) == '1');
@@ -2669,7 +2940,7 @@ void RadioState::handleDisplayMP(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayMPSub(const QString &cmd) {
+void RadioState::handleDisplayMPSub(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool enabled = (cmd.at(4) == '1');
@@ -2679,7 +2950,7 @@ void RadioState::handleDisplayMPSub(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayDPM(const QString &cmd) {
+void RadioState::handleDisplayDPM(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2690,7 +2961,7 @@ void RadioState::handleDisplayDPM(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayHDPM(const QString &cmd) {
+void RadioState::handleDisplayHDPM(CatView cmd) {
     if (cmd.length() <= 5)
         return;
     bool ok;
@@ -2701,7 +2972,7 @@ void RadioState::handleDisplayHDPM(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayDSM(const QString &cmd) {
+void RadioState::handleDisplayDSM(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2712,7 +2983,7 @@ void RadioState::handleDisplayDSM(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayHDSM(const QString &cmd) {
+void RadioState::handleDisplayHDSM(CatView cmd) {
     if (cmd.length() <= 5)
         return;
     bool ok;
@@ -2723,7 +2994,7 @@ void RadioState::handleDisplayHDSM(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayFPS(const QString &cmd) {
+void RadioState::handleDisplayFPS(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2734,7 +3005,7 @@ void RadioState::handleDisplayFPS(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayWFC(const QString &cmd) {
+void RadioState::handleDisplayWFC(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2745,7 +3016,7 @@ void RadioState::handleDisplayWFC(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayWFH(const QString &cmd) {
+void RadioState::handleDisplayWFH(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2756,7 +3027,7 @@ void RadioState::handleDisplayWFH(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayHWFH(const QString &cmd) {
+void RadioState::handleDisplayHWFH(CatView cmd) {
     if (cmd.length() <= 5)
         return;
     bool ok;
@@ -2767,7 +3038,7 @@ void RadioState::handleDisplayHWFH(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayAVG(const QString &cmd) {
+void RadioState::handleDisplayAVG(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2778,7 +3049,7 @@ void RadioState::handleDisplayAVG(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayPKM(const QString &cmd) {
+void RadioState::handleDisplayPKM(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2789,7 +3060,7 @@ void RadioState::handleDisplayPKM(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayFXT(const QString &cmd) {
+void RadioState::handleDisplayFXT(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2800,7 +3071,7 @@ void RadioState::handleDisplayFXT(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayFXA(const QString &cmd) {
+void RadioState::handleDisplayFXA(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2811,7 +3082,7 @@ void RadioState::handleDisplayFXA(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayFRZ(const QString &cmd) {
+void RadioState::handleDisplayFRZ(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2822,7 +3093,7 @@ void RadioState::handleDisplayFRZ(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayVFA(const QString &cmd) {
+void RadioState::handleDisplayVFA(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2833,7 +3104,7 @@ void RadioState::handleDisplayVFA(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayVFB(const QString &cmd) {
+void RadioState::handleDisplayVFB(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2844,10 +3115,10 @@ void RadioState::handleDisplayVFB(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayAR(const QString &cmd) {
+void RadioState::handleDisplayAR(CatView cmd) {
     if (cmd.length() < 12)
         return;
-    QChar mode = cmd.at(cmd.length() - 1);
+    char mode = cmd.at(cmd.length() - 1);
     int newValue = (mode == 'A') ? 1 : 0;
     if (newValue != m_autoRefLevel) {
         m_autoRefLevel = newValue;
@@ -2855,7 +3126,7 @@ void RadioState::handleDisplayAR(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayNB(const QString &cmd) {
+void RadioState::handleDisplayNB(CatView cmd) {
     if (cmd.length() <= 4)
         return;
     bool ok;
@@ -2866,7 +3137,7 @@ void RadioState::handleDisplayNB(const QString &cmd) {
     }
 }
 
-void RadioState::handleDisplayNBL(const QString &cmd) {
+void RadioState::handleDisplayNBL(CatView cmd) {
     if (cmd.length() <= 5)
         return;
     bool ok;
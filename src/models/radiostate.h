@@ -5,7 +5,7 @@
 #include <QObject>
 #include <QString>
 #include <QVector>
-#include <functional>
+#include "catview.h"
 
 class RadioState : public QObject {
     Q_OBJECT
@@ -17,13 +17,64 @@ public:
     enum AGCSpeed { AGC_Off = 0, AGC_Slow = 1, AGC_Fast = 2 };
     Q_ENUM(AGCSpeed)
 
+    // Change-set fields reported by changesCommitted(). Each field groups the change
+    // signals that feed one area of the UI (see the table in the constructor).
+    enum Field : quint32 {
+        FieldVfoA = 1u << 0,         // frequencyChanged
+        FieldVfoB = 1u << 1,         // frequencyBChanged
+        FieldMode = 1u << 2,         // modeChanged, dataSubModeChanged
+        FieldModeB = 1u << 3,        // modeBChanged, dataSubModeBChanged
+        FieldFilter = 1u << 4,       // Bandwidth, position, IF shift VFO A
+        FieldFilterB = 1u << 5,      // Bandwidth, position, IF shift VFO B
+        FieldSMeter = 1u << 6,       // sMeterChanged
+        FieldSMeterB = 1u << 7,      // sMeterBChanged
+        FieldTxMeter = 1u << 8,      // txMeterChanged, swrChanged, powerMeterChanged
+        FieldTransmit = 1u << 9,     // transmitStateChanged
+        FieldSupply = 1u << 10,      // Supply voltage/current
+        FieldSplit = 1u << 11,       // splitChanged
+        FieldRitXit = 1u << 12,      // ritXitChanged
+        FieldVox = 1u << 13,         // VOX state, gain, anti-VOX
+        FieldQsk = 1u << 14,         // QSK state and delay
+        FieldAtu = 1u << 15,         // atuModeChanged
+        FieldAntenna = 1u << 16,     // Antenna selection, names, configuration
+        FieldProcessing = 1u << 17,  // NB/NR/PA/RA/AGC, notch, APF Main RX
+        FieldProcessingB = 1u << 18, // NB/NR/PA/RA/AGC, notch, APF Sub RX
+        FieldReceivers = 1u << 19,   // Sub RX, diversity, B SET
+        FieldTxSettings = 1u << 20,  // Power, keyer, pitch, mic gain, compression, ESSB, monitor, test, message bank
+        FieldRxLevels = 1u << 21,    // RF gain, squelch, audio effects, balance, mix
+        FieldTuning = 1u << 22,      // Tuning steps, VFO link/locks
+        FieldPanadapter = 1u << 23,  // Ref level, scale, span, Mini-Pan, DDC NB
+        FieldDisplay = 1u << 24,     // Display settings (# commands)
+        FieldAudioIo = 1u << 25,     // Line out/in, mic input/setup
+        FieldEq = 1u << 26,          // RX/TX EQ
+        FieldTextDecode = 1u << 27,  // Text decode settings
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+    Q_FLAG(Fields)
+
     explicit RadioState(QObject *parent = nullptr);
 
     // Reset all state to initial values (used on disconnect for clean reconnect)
     void reset();
 
-    // Parse a CAT command response and update state
+    // Batch mode: commands parsed between beginBatch() and endBatch() (e.g. one CAT
+    // packet) are committed together, with a single stateUpdated() and one
+    // changesCommitted() carrying the union of changed fields. Batches nest. Outside a
+    // batch, every command and every optimistic setter commits on its own.
+    void beginBatch();
+    void endBatch();
+    bool inBatch() const { return m_batchDepth > 0; }
+
+    // Parse a CAT command response and update state. The byte view overload is the
+    // network path and does not allocate; the QString overloads are for optimistic
+    // updates built in the UI.
+    void parseCATCommand(QByteArrayView command);
     void parseCATCommand(const QString &command);
+    void parseCATCommand(const char *command) { parseCATCommand(QByteArrayView(command)); }
+
+    // Registry prefix that parseCATCommand() would dispatch command (no trailing ';') to,
+    // or nullptr if no handler matches
+    static const char *commandPrefix(QByteArrayView command);
 
     // Frequency and VFO
     quint64 frequency() const { return m_frequency; }
@@ -660,9 +711,19 @@ signals:
     void textDecodeBChanged();                                  // TD$$ command - Sub RX settings changed
     void textBufferReceived(const QString &text, bool isSubRx); // TB$ decoded text
 
+    // One or more commands were applied (once per batch)
     void stateUpdated();
+    // Fields whose change signals fired since the last commit (once per batch, only if non-empty)
+    void changesCommitted(RadioState::Fields changed);
 
 private:
+    // Batch/change-set bookkeeping
+    template <typename Signal> void trackChanges(Signal signal, Fields fields);
+    void commitChanges();
+    int m_batchDepth = 0;
+    bool m_commandsApplied = false;
+    Fields m_dirtyFields;
+
     // Frequency and VFO
     quint64 m_frequency = 0;
     quint64 m_vfoA = 0;
@@ -930,181 +991,180 @@ private:
     // =========================================================================
     // Command Handler Registry
     // =========================================================================
-    // Handler function type: takes command string (already trimmed, no trailing ;)
-    using CommandHandler = std::function<void(const QString &)>;
+    // Handler member function: takes a view of the command (already trimmed, no trailing ;)
+    using CommandHandler = void (RadioState::*)(CatView);
 
     // Registry entry: prefix to match and handler function
     struct CommandEntry {
-        QString prefix;
+        const char *prefix;
         CommandHandler handler;
     };
 
-    // Sorted list of command handlers (longest prefix first for correct matching)
-    QVector<CommandEntry> m_commandHandlers;
-
-    // Initialize command handler registry (called from constructor)
-    void registerCommandHandlers();
+    // Look up the handler for a command via the compile-time dispatch index
+    static const CommandEntry *findCommand(CatView cmd);
 
     // =========================================================================
     // Individual Command Handlers (grouped by function)
     // =========================================================================
 
     // VFO/Frequency commands
-    void handleFA(const QString &cmd); // VFO A frequency
-    void handleFB(const QString &cmd); // VFO B frequency
-    void handleFT(const QString &cmd); // Split TX/RX
+    void handleFA(CatView cmd); // VFO A frequency
+    void handleFB(CatView cmd); // VFO B frequency
+    void handleFT(CatView cmd); // Split TX/RX
 
     // Mode commands
-    void handleMD(const QString &cmd);    // Mode VFO A
-    void handleMDSub(const QString &cmd); // Mode VFO B (MD$)
+    void handleMD(CatView cmd);    // Mode VFO A
+    void handleMDSub(CatView cmd); // Mode VFO B (MD$)
 
     // Bandwidth/Filter commands
-    void handleBW(const QString &cmd);    // Bandwidth VFO A
-    void handleBWSub(const QString &cmd); // Bandwidth VFO B (BW$)
-    void handleIS(const QString &cmd);    // IF Shift VFO A
-    void handleISSub(const QString &cmd); // IF Shift VFO B (IS$)
-    void handleCW(const QString &cmd);    // CW pitch
-    void handleFP(const QString &cmd);    // Filter position VFO A
-    void handleFPSub(const QString &cmd); // Filter position VFO B (FP$)
+    void handleBW(CatView cmd);    // Bandwidth VFO A
+    void handleBWSub(CatView cmd); // Bandwidth VFO B (BW$)
+    void handleIS(CatView cmd);    // IF Shift VFO A
+    void handleISSub(CatView cmd); // IF Shift VFO B (IS$)
+    void handleCW(CatView cmd);    // CW pitch
+    void handleFP(CatView cmd);    // Filter position VFO A
+    void handleFPSub(CatView cmd); // Filter position VFO B (FP$)
 
     // Gain/Level commands
-    void handleRG(const QString &cmd);    // RF Gain Main
-    void handleRGSub(const QString &cmd); // RF Gain Sub (RG$)
-    void handleSQ(const QString &cmd);    // Squelch Main
-    void handleSQSub(const QString &cmd); // Squelch Sub (SQ$)
-    void handleMG(const QString &cmd);    // Mic Gain
-    void handleCP(const QString &cmd);    // Compression
-    void handleML(const QString &cmd);    // Monitor Level
-    void handlePC(const QString &cmd);    // Power Control
-    void handleKS(const QString &cmd);    // Keyer Speed
+    void handleRG(CatView cmd);    // RF Gain Main
+    void handleRGSub(CatView cmd); // RF Gain Sub (RG$)
+    void handleSQ(CatView cmd);    // Squelch Main
+    void handleSQSub(CatView cmd); // Squelch Sub (SQ$)
+    void handleMG(CatView cmd);    // Mic Gain
+    void handleCP(CatView cmd);    // Compression
+    void handleML(CatView cmd);    // Monitor Level
+    void handlePC(CatView cmd);    // Power Control
+    void handleKS(CatView cmd);    // Keyer Speed
 
     // Meter commands
-    void handleSM(const QString &cmd);    // S-Meter Main
-    void handleSMSub(const QString &cmd); // S-Meter Sub (SM$)
-    void handlePO(const QString &cmd);    // Power Output
-    void handleTM(const QString &cmd);    // TX Meter
+    void handleSM(CatView cmd);    // S-Meter Main
+    void handleSMSub(CatView cmd); // S-Meter Sub (SM$)
+    void handlePO(CatView cmd);    // Power Output
+    void handleTM(CatView cmd);    // TX Meter
 
     // TX/RX state
-    void handleTX(const QString &cmd); // Transmit
-    void handleRX(const QString &cmd); // Receive
+    void handleTX(CatView cmd); // Transmit
+    void handleRX(CatView cmd); // Receive
 
     // Processing commands (NB, NR, PA, RA, GT, NA, NM)
-    void handleNB(const QString &cmd);    // Noise Blanker Main
-    void handleNBSub(const QString &cmd); // Noise Blanker Sub (NB$)
-    void handleNR(const QString &cmd);    // Noise Reduction Main
-    void handleNRSub(const QString &cmd); // Noise Reduction Sub (NR$)
-    void handlePA(const QString &cmd);    // Preamp Main
-    void handlePASub(const QString &cmd); // Preamp Sub (PA$)
-    void handleRA(const QString &cmd);    // Attenuator Main
-    void handleRASub(const QString &cmd); // Attenuator Sub (RA$)
-    void handleGT(const QString &cmd);    // AGC Speed Main
-    void handleGTSub(const QString &cmd); // AGC Speed Sub (GT$)
-    void handleNA(const QString &cmd);    // Auto Notch Main
-    void handleNASub(const QString &cmd); // Auto Notch Sub (NA$)
-    void handleNM(const QString &cmd);    // Manual Notch Main
-    void handleNMSub(const QString &cmd); // Manual Notch Sub (NM$)
+    void handleNB(CatView cmd);    // Noise Blanker Main
+    void handleNBSub(CatView cmd); // Noise Blanker Sub (NB$)
+    void handleNR(CatView cmd);    // Noise Reduction Main
+    void handleNRSub(CatView cmd); // Noise Reduction Sub (NR$)
+    void handlePA(CatView cmd);    // Preamp Main
+    void handlePASub(CatView cmd); // Preamp Sub (PA$)
+    void handleRA(CatView cmd);    // Attenuator Main
+    void handleRASub(CatView cmd); // Attenuator Sub (RA$)
+    void handleGT(CatView cmd);    // AGC Speed Main
+    void handleGTSub(CatView cmd); // AGC Speed Sub (GT$)
+    void handleNA(CatView cmd);    // Auto Notch Main
+    void handleNASub(CatView cmd); // Auto Notch Sub (NA$)
+    void handleNM(CatView cmd);    // Manual Notch Main
+    void handleNMSub(CatView cmd); // Manual Notch Sub (NM$)
 
     // Balance and audio mix commands
-    void handleBL(const QString &cmd); // Audio Balance (BL)
-    void handleMX(const QString &cmd); // Audio Mix routing (MX)
+    void handleBL(CatView cmd); // Audio Balance (BL)
+    void handleMX(CatView cmd); // Audio Mix routing (MX)
 
     // Audio/Effects commands
-    void handleFX(const QString &cmd);    // Audio Effects
-    void handleAP(const QString &cmd);    // Audio Peak Filter Main
-    void handleAPSub(const QString &cmd); // Audio Peak Filter Sub (AP$)
+    void handleFX(CatView cmd);    // Audio Effects
+    void handleAP(CatView cmd);    // Audio Peak Filter Main
+    void handleAPSub(CatView cmd); // Audio Peak Filter Sub (AP$)
 
     // VFO control commands
-    void handleLN(const QString &cmd);    // VFO Link
-    void handleLK(const QString &cmd);    // VFO A Lock
-    void handleLKSub(const QString &cmd); // VFO B Lock (LK$)
-    void handleVT(const QString &cmd);    // Tuning Step Main
-    void handleVTSub(const QString &cmd); // Tuning Step Sub (VT$)
+    void handleLN(CatView cmd);    // VFO Link
+    void handleLK(CatView cmd);    // VFO A Lock
+    void handleLKSub(CatView cmd); // VFO B Lock (LK$)
+    void handleVT(CatView cmd);    // Tuning Step Main
+    void handleVTSub(CatView cmd); // Tuning Step Sub (VT$)
 
     // VOX commands
-    void handleVX(const QString &cmd); // VOX enable
-    void handleVG(const QString &cmd); // VOX Gain
-    void handleVI(const QString &cmd); // Anti-VOX
+    void handleVX(CatView cmd); // VOX enable
+    void handleVG(CatView cmd); // VOX Gain
+    void handleVI(CatView cmd); // Anti-VOX
 
     // Audio I/O commands
-    void handleLO(const QString &cmd); // Line Out
-    void handleLI(const QString &cmd); // Line In
-    void handleMI(const QString &cmd); // Mic Input
-    void handleMS(const QString &cmd); // Mic Setup
-    void handleES(const QString &cmd); // ESSB
+    void handleLO(CatView cmd); // Line Out
+    void handleLI(CatView cmd); // Line In
+    void handleMI(CatView cmd); // Mic Input
+    void handleMS(CatView cmd); // Mic Setup
+    void handleES(CatView cmd); // ESSB
 
     // QSK/Delay commands
-    void handleSD(const QString &cmd); // QSK/VOX Delay
+    void handleSD(CatView cmd); // QSK/VOX Delay
 
     // Control state commands
-    void handleSB(const QString &cmd); // Sub Receiver
-    void handleDV(const QString &cmd); // Diversity
-    void handleTS(const QString &cmd); // Test Mode
-    void handleBS(const QString &cmd); // B SET
+    void handleSB(CatView cmd); // Sub Receiver
+    void handleDV(CatView cmd); // Diversity
+    void handleTS(CatView cmd); // Test Mode
+    void handleBS(CatView cmd); // B SET
 
     // Antenna commands
-    void handleAN(const QString &cmd);    // TX Antenna
-    void handleAR(const QString &cmd);    // RX Antenna Main
-    void handleARSub(const QString &cmd); // RX Antenna Sub (AR$)
-    void handleAT(const QString &cmd);    // ATU Mode
-    void handleACN(const QString &cmd);   // Antenna Names
-    void handleACM(const QString &cmd);   // Main RX Antenna Config
-    void handleACS(const QString &cmd);   // Sub RX Antenna Config
-    void handleACT(const QString &cmd);   // TX Antenna Config
+    void handleAN(CatView cmd);    // TX Antenna
+    void handleAR(CatView cmd);    // RX Antenna Main
+    void handleARSub(CatView cmd); // RX Antenna Sub (AR$)
+    void handleAT(CatView cmd);    // ATU Mode
+    void handleACN(CatView cmd);   // Antenna Names
+    void handleACM(CatView cmd);   // Main RX Antenna Config
+    void handleACS(CatView cmd);   // Sub RX Antenna Config
+    void handleACT(CatView cmd);   // TX Antenna Config
 
     // RIT/XIT commands
-    void handleRT(const QString &cmd); // RIT
-    void handleXT(const QString &cmd); // XIT
-    void handleRO(const QString &cmd); // RIT/XIT Offset
+    void handleRT(CatView cmd); // RIT
+    void handleXT(CatView cmd); // XIT
+    void handleRO(CatView cmd); // RIT/XIT Offset
 
     // Text decode commands
-    void handleTD(const QString &cmd);    // Text Decode Main
-    void handleTDSub(const QString &cmd); // Text Decode Sub (TD$)
-    void handleTB(const QString &cmd);    // Text Buffer Main
-    void handleTBSub(const QString &cmd); // Text Buffer Sub (TB$)
+    void handleTD(CatView cmd);    // Text Decode Main
+    void handleTDSub(CatView cmd); // Text Decode Sub (TD$)
+    void handleTB(CatView cmd);    // Text Buffer Main
+    void handleTBSub(CatView cmd); // Text Buffer Sub (TB$)
 
     // Data mode commands
-    void handleDT(const QString &cmd);    // Data Sub-Mode Main
-    void handleDTSub(const QString &cmd); // Data Sub-Mode Sub (DT$)
+    void handleDT(CatView cmd);    // Data Sub-Mode Main
+    void handleDTSub(CatView cmd); // Data Sub-Mode Sub (DT$)
 
     // Equalizer commands
-    void handleRE(const QString &cmd); // RX EQ
-    void handleTE(const QString &cmd); // TX EQ
+    void handleRE(CatView cmd); // RX EQ
+    void handleTE(CatView cmd); // TX EQ
 
     // Radio info commands
-    void handleID(const QString &cmd);   // Radio ID
-    void handleOM(const QString &cmd);   // Option Modules
-    void handleRV(const QString &cmd);   // Firmware Version (RV.)
-    void handleSIFP(const QString &cmd); // Power Supply Info
-    void handleSIRC(const QString &cmd); // SIRC status
-    void handleMN(const QString &cmd);   // Message Bank
-    void handleER(const QString &cmd);   // Error notifications
+    void handleID(CatView cmd);   // Radio ID
+    void handleOM(CatView cmd);   // Option Modules
+    void handleRV(CatView cmd);   // Firmware Version (RV.)
+    void handleSIFP(CatView cmd); // Power Supply Info
+    void handleSIRC(CatView cmd); // SIRC status
+    void handleMN(CatView cmd);   // Message Bank
+    void handleER(CatView cmd);   // Error notifications
 
     // Display commands (# prefix)
-    void handleDisplayREF(const QString &cmd);    // #REF - Ref Level Main
-    void handleDisplayREFSub(const QString &cmd); // #REF$ - Ref Level Sub
-    void handleDisplaySCL(const QString &cmd);    // #SCL - Scale
-    void handleDisplaySPN(const QString &cmd);    // #SPN - Span Main
-    void handleDisplaySPNSub(const QString &cmd); // #SPN$ - Span Sub
-    void handleDisplayMP(const QString &cmd);     // #MP - Mini-Pan Main
-    void handleDisplayMPSub(const QString &cmd);  // #MP$ - Mini-Pan Sub
-    void handleDisplayDPM(const QString &cmd);    // #DPM - Dual Pan Mode LCD
-    void handleDisplayHDPM(const QString &cmd);   // #HDPM - Dual Pan Mode EXT
-    void handleDisplayDSM(const QString &cmd);    // #DSM - Display Mode LCD
-    void handleDisplayHDSM(const QString &cmd);   // #HDSM - Display Mode EXT
-    void handleDisplayFPS(const QString &cmd);    // #FPS - Frame Rate
-    void handleDisplayWFC(const QString &cmd);    // #WFC - Waterfall Color
-    void handleDisplayWFH(const QString &cmd);    // #WFH - Waterfall Height LCD
-    void handleDisplayHWFH(const QString &cmd);   // #HWFH - Waterfall Height EXT
-    void handleDisplayAVG(const QString &cmd);    // #AVG - Averaging
-    void handleDisplayPKM(const QString &cmd);    // #PKM - Peak Mode
-    void handleDisplayFXT(const QString &cmd);    // #FXT - Fixed Tune
-    void handleDisplayFXA(const QString &cmd);    // #FXA - Fixed Tune Mode
-    void handleDisplayFRZ(const QString &cmd);    // #FRZ - Freeze
-    void handleDisplayVFA(const QString &cmd);    // #VFA - VFO A Cursor
-    void handleDisplayVFB(const QString &cmd);    // #VFB - VFO B Cursor
-    void handleDisplayAR(const QString &cmd);     // #AR - Auto Ref Level
-    void handleDisplayNB(const QString &cmd);     // #NB$ - DDC NB Mode
-    void handleDisplayNBL(const QString &cmd);    // #NBL$ - DDC NB Level
+    void handleDisplayREF(CatView cmd);    // #REF - Ref Level Main
+    void handleDisplayREFSub(CatView cmd); // #REF$ - Ref Level Sub
+    void handleDisplaySCL(CatView cmd);    // #SCL - Scale
+    void handleDisplaySPN(CatView cmd);    // #SPN - Span Main
+    void handleDisplaySPNSub(CatView cmd); // #SPN$ - Span Sub
+    void handleDisplayMP(CatView cmd);     // #MP - Mini-Pan Main
+    void handleDisplayMPSub(CatView cmd);  // #MP$ - Mini-Pan Sub
+    void handleDisplayDPM(CatView cmd);    // #DPM - Dual Pan Mode LCD
+    void handleDisplayHDPM(CatView cmd);   // #HDPM - Dual Pan Mode EXT
+    void handleDisplayDSM(CatView cmd);    // #DSM - Display Mode LCD
+    void handleDisplayHDSM(CatView cmd);   // #HDSM - Display Mode EXT
+    void handleDisplayFPS(CatView cmd);    // #FPS - Frame Rate
+    void handleDisplayWFC(CatView cmd);    // #WFC - Waterfall Color
+    void handleDisplayWFH(CatView cmd);    // #WFH - Waterfall Height LCD
+    void handleDisplayHWFH(CatView cmd);   // #HWFH - Waterfall Height EXT
+    void handleDisplayAVG(CatView cmd);    // #AVG - Averaging
+    void handleDisplayPKM(CatView cmd);    // #PKM - Peak Mode
+    void handleDisplayFXT(CatView cmd);    // #FXT - Fixed Tune
+    void handleDisplayFXA(CatView cmd);    // #FXA - Fixed Tune Mode
+    void handleDisplayFRZ(CatView cmd);    // #FRZ - Freeze
+    void handleDisplayVFA(CatView cmd);    // #VFA - VFO A Cursor
+    void handleDisplayVFB(CatView cmd);    // #VFB - VFO B Cursor
+    void handleDisplayAR(CatView cmd);     // #AR - Auto Ref Level
+    void handleDisplayNB(CatView cmd);     // #NB$ - DDC NB Mode
+    void handleDisplayNBL(CatView cmd);    // #NBL$ - DDC NB Level
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(RadioState::Fields)
+
 #endif // RADIOSTATE_H
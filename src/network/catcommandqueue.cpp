@@ -0,0 +1,70 @@
+#include "catcommandqueue.h"
+
+namespace {
+
+// Settings whose writes carry the complete new value, longest first so "BW$" wins over "BW".
+// Commands with sub-addresses in their arguments (ML, VG, SD, menu entries) are not listed: two
+// writes with the same prefix can set different things.
+const char *const COLLAPSIBLE_SETTINGS[] = {
+    "#SPN$", "#REF$", "#SPN", "#REF", "#SCL", "BW$", "IS$", "RG$", "SQ$", "FA", "FB", "BW", "IS",
+    "RG",    "SQ",    "PC",   "KS",   "CW",   "MG",  "CP",  "RO",
+};
+
+} // namespace
+
+int CatCommandQueue::settingKeyLength(QStringView command) {
+    for (const char *setting : COLLAPSIBLE_SETTINGS) {
+        const QLatin1String prefix(setting);
+        if (!command.startsWith(prefix) || command.size() <= prefix.size())
+            continue;
+        const QChar next = command.at(prefix.size());
+        if (next == ';' && command.size() == prefix.size() + 1)
+            return int(prefix.size()); // Query
+        if (next.isDigit() || next == '+' || next == '-')
+            return command.endsWith(';') ? int(prefix.size()) : 0;
+    }
+    return 0;
+}
+
+void CatCommandQueue::append(QStringView commands) {
+    qsizetype start = 0;
+    while (start < commands.size()) {
+        qsizetype end = commands.indexOf(';', start);
+        end = end < 0 ? commands.size() : end + 1; // An unterminated tail is passed through as is
+        const QStringView command = commands.sliced(start, end - start).trimmed();
+        if (!command.isEmpty())
+            appendOne(command);
+        start = end;
+    }
+}
+
+void CatCommandQueue::appendOne(QStringView command) {
+    const int keyLength = settingKeyLength(command);
+    const bool query = keyLength > 0 && command.size() == keyLength + 1;
+    if (keyLength > 0) {
+        const QStringView key = command.left(keyLength);
+        for (qsizetype i = m_entries.size() - 1; i >= 0 && m_entries[i].keyLength > 0; --i) {
+            const Entry &queued = m_entries[i];
+            if (queued.keyLength != keyLength || QStringView(queued.command).left(keyLength) != key)
+                continue;
+            // A write never crosses a query of the same setting: the query must see the value
+            // written before it, not the one before the whole batch
+            if (queued.query == query)
+                m_entries.remove(i); // Superseded; at most one can be queued
+            break;
+        }
+    }
+    m_entries.append({command.toString(), keyLength, query});
+}
+
+QString CatCommandQueue::take() {
+    qsizetype length = 0;
+    for (const Entry &entry : std::as_const(m_entries))
+        length += entry.command.size();
+    QString commands;
+    commands.reserve(length);
+    for (const Entry &entry : std::as_const(m_entries))
+        commands += entry.command;
+    m_entries.clear();
+    return commands;
+}
@@ -0,0 +1,47 @@
+#ifndef CATCOMMANDQUEUE_H
+#define CATCOMMANDQUEUE_H
+
+#include <QString>
+#include <QStringView>
+#include <QVector>
+
+/**
+ * @brief Outgoing CAT commands collected over one event-loop turn
+ *
+ * TcpClient appends every command the GUI sends and drains the queue once per turn into a single
+ * CAT packet (Protocol::buildCATPacket takes any number of ';'-terminated commands). Writes of an
+ * absolute setting (FA, BW$, #SPN, ...) are collapsed: a new value replaces a queued write of the
+ * same setting, and a repeated query of it (FA;) replaces the earlier identical query, as long as
+ * only other settings lie between them. A write and a query of the same setting never pass each
+ * other. Anything else - relative steps like RU; or UP;, swaps, menu commands - is a barrier that
+ * keeps the order around it, so fast tuning sends only the latest frequency without reordering what
+ * the radio sees.
+ */
+class CatCommandQueue {
+public:
+    // Append one or more ';'-terminated commands
+    void append(QStringView commands);
+    void clear() { m_entries.clear(); }
+    bool isEmpty() const { return m_entries.isEmpty(); }
+    int size() const { return int(m_entries.size()); }
+
+    // Everything queued, in order, as one payload; empties the queue
+    QString take();
+
+    // Length of the setting prefix of command (e.g. 3 for "BW$0280;" and "BW$;") if it is a write or
+    // query of a collapsible setting, otherwise 0
+    static int settingKeyLength(QStringView command);
+
+private:
+    struct Entry {
+        QString command;
+        int keyLength; // 0 = barrier
+        bool query;    // "FA;" rather than "FA00014074000;"
+    };
+
+    void appendOne(QStringView command);
+
+    QVector<Entry> m_entries;
+};
+
+#endif // CATCOMMANDQUEUE_H
@@ -1,11 +1,10 @@
 #ifndef CATSERVER_H
 #define CATSERVER_H
 
-#include <QList>
-#include <QMap>
+#include <QHostAddress>
 #include <QObject>
-#include <QTcpServer>
-#include <QTcpSocket>
+#include <QThread>
+#include "catserverworker.h"
 
 class RadioState;
 class TcpClient;
@@ -19,6 +18,21 @@ class TcpClient;
  * - Forwarded to real K4 via TcpClient (SET commands)
  *
  * Native K4 CAT passthrough - no protocol translation needed.
+ *
+ * The sockets, command parsing and replies run in a CatServerWorker on a dedicated thread, so
+ * several polling applications never compete with the UI. This GUI-thread facade copies the
+ * RadioState values the server answers from into a CatSnapshot once per committed batch and hands
+ * it over; the worker's signals arrive here queued.
+ *
+ * Auto-info: each client has its own AI level (AIn; SET, default 0), independent of the AI4 link to
+ * the radio. RadioState changes are pushed once per committed batch: AI1 clients get an IF response
+ * when VFO A, mode, RIT/XIT, split or TX state changed, AI2 and up get the GET response of every
+ * changed value (FA, FB, MD, BW, ...). Meter readings change on nearly every batch and are pushed only
+ * to clients that have polled them at least once.
+ *
+ * GET responses that depend only on RadioState are cached by command until a committed change set
+ * touches one of their fields, so repeated polls (IF;, FA; several times a second from a logger) and
+ * auto-info pushes are served as prebuilt bytes without parsing or formatting.
  */
 class CatServer : public QObject {
     Q_OBJECT
@@ -27,15 +41,21 @@ public:
     explicit CatServer(RadioState *state, QObject *parent = nullptr);
     ~CatServer();
 
-    bool start(quint16 port = 9299);
+    // Listen on address (this computer only by default; QHostAddress::Any for the network)
+    bool start(quint16 port = 9299, const QHostAddress &address = QHostAddress::LocalHost);
     void stop();
     bool isListening() const;
     quint16 port() const;
+    QHostAddress address() const;
     int clientCount() const;
 
     // Set the TcpClient for forwarding SET commands to real K4
     void setTcpClient(TcpClient *client);
 
+    // Reply to one command (e.g. "IF;") as a client at AI0 would get it, served from the response
+    // cache when possible. Blocks until the server thread has answered.
+    QByteArray response(const QByteArray &command);
+
 signals:
     void started(quint16 port);
     void stopped();
@@ -50,22 +70,16 @@ signals:
     // This controls the audio input gate, not direct K4 PTT
     void pttRequested(bool on);
 
-private slots:
-    void onNewConnection();
-    void onClientData();
-    void onClientDisconnected();
-
 private:
-    QString handleCommand(const QString &cmd);
-    QString buildFrequencyResponse(quint64 freq, const QString &prefix) const;
-    QString buildModeResponse(int mode) const;
+    CatSnapshot snapshot() const;
+    void publishState(quint32 changedFields);
 
-    QTcpServer *m_server;
+    QThread *m_serverThread;
+    CatServerWorker *m_worker;
     RadioState *m_radioState;
     TcpClient *m_tcpClient = nullptr;
-    QList<QTcpSocket *> m_clients;
-    QMap<QTcpSocket *, QByteArray> m_clientBuffers;
-    quint16 m_port = 0;
+    QHostAddress m_address;
+    CatSnapshot m_published; // Last snapshot handed to the worker
 };
 
 #endif // CATSERVER_H
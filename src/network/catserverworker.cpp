@@ -0,0 +1,524 @@
+#include "catserverworker.h"
+#include "models/radiostate.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QVarLengthArray>
+
+namespace {
+
+// Auto-info for AI2 and up: the GET command whose response reports each field
+struct AutoInfoEntry {
+    RadioState::Field field;
+    const char *command;
+};
+
+constexpr AutoInfoEntry AUTO_INFO_TABLE[] = {
+    {RadioState::FieldVfoA, "FA;"},       {RadioState::FieldVfoB, "FB;"},       {RadioState::FieldMode, "MD;"},
+    {RadioState::FieldMode, "DT;"},       {RadioState::FieldFilter, "BW;"},     {RadioState::FieldSplit, "FT;"},
+    {RadioState::FieldTransmit, "TQ;"},   {RadioState::FieldRitXit, "RT;"},     {RadioState::FieldRitXit, "XT;"},
+    {RadioState::FieldRitXit, "RO;"},     {RadioState::FieldTxSettings, "PC;"}, {RadioState::FieldTxSettings, "KS;"},
+    {RadioState::FieldProcessing, "NB;"}, {RadioState::FieldProcessing, "NR;"}, {RadioState::FieldProcessing, "GT;"},
+    {RadioState::FieldVox, "VX;"},        {RadioState::FieldSMeter, "SM;"},
+};
+
+// What the IF response reports (AI1)
+constexpr quint32 IF_FIELDS = (RadioState::FieldVfoA | RadioState::FieldMode | RadioState::FieldRitXit |
+                               RadioState::FieldSplit | RadioState::FieldTransmit)
+                                  .toInt();
+
+// Fields pushed only to clients that have polled them
+constexpr quint32 POLL_SUBSCRIBED_FIELDS = RadioState::FieldSMeter;
+
+// GET commands whose response depends only on these fields (0 = constant) and can be cached until
+// one of them changes. Commands reading state without a change signal (OM, RV*) and AI, which is
+// per client, are answered fresh every time.
+struct CacheableGet {
+    const char *prefix;
+    quint32 fields;
+};
+
+constexpr CacheableGet CACHEABLE_GETS[] = {
+    {"FA", RadioState::FieldVfoA},         {"FB", RadioState::FieldVfoB},
+    {"MD", RadioState::FieldMode},         {"DT", RadioState::FieldMode},
+    {"BW", RadioState::FieldFilter},       {"FW", RadioState::FieldFilter},
+    {"IF", IF_FIELDS},                     {"TQ", RadioState::FieldTransmit},
+    {"FT", RadioState::FieldSplit},        {"RO", RadioState::FieldRitXit},
+    {"RT", RadioState::FieldRitXit},       {"XT", RadioState::FieldRitXit},
+    {"PC", RadioState::FieldTxSettings},   {"PCX", RadioState::FieldTxSettings},
+    {"KS", RadioState::FieldTxSettings},   {"NB", RadioState::FieldProcessing},
+    {"NR", RadioState::FieldProcessing},   {"GT", RadioState::FieldProcessing},
+    {"VX", RadioState::FieldVox},          {"SM", RadioState::FieldSMeter},
+    {"FR", 0},                             {"ID", 0},
+    {"PS", 0},                             {"K2", 0},
+    {"K3", 0},                             {"TB", 0},
+    {"SB", 0},                             {"AG", 0},
+    {"SQ", 0},                             {"TM", 0},
+};
+
+const CacheableGet *cacheableGet(const QByteArray &command) {
+    if (!command.endsWith(';'))
+        return nullptr;
+    const QByteArrayView name = QByteArrayView(command).chopped(1); // Without ';'
+    for (const CacheableGet &get : CACHEABLE_GETS) {
+        if (name == QByteArrayView(get.prefix))
+            return &get;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+CatServerWorker::CatServerWorker(QObject *parent) : QObject(parent), m_server(new QTcpServer(this)) {
+    connect(m_server, &QTcpServer::newConnection, this, &CatServerWorker::onNewConnection);
+}
+
+QString CatServerWorker::listen(const QHostAddress &address, quint16 port) {
+    close();
+    if (!m_server->listen(address, port)) {
+        return m_server->errorString();
+    }
+    m_port.store(m_server->serverPort(), std::memory_order_release); // The chosen port when port is 0
+    return QString();
+}
+
+void CatServerWorker::close() {
+    for (auto it = m_clients.cbegin(); it != m_clients.cend(); ++it) {
+        it.key()->disconnect(this);
+        it.key()->disconnectFromHost();
+        it.key()->deleteLater();
+    }
+    m_clients.clear();
+    m_clientCount.store(0, std::memory_order_relaxed);
+
+    if (m_server->isListening()) {
+        m_server->close();
+    }
+    m_port.store(0, std::memory_order_release);
+}
+
+void CatServerWorker::updateState(const CatSnapshot &state, quint32 changedFields) {
+    m_state = state;
+    for (auto it = m_responseCache.begin(); it != m_responseCache.end();) {
+        if (it->fields & changedFields)
+            it = m_responseCache.erase(it);
+        else
+            ++it;
+    }
+    if (changedFields)
+        pushAutoInfo(changedFields);
+}
+
+QByteArray CatServerWorker::response(const QByteArray &command) {
+    return respond(command.trimmed(), nullptr);
+}
+
+void CatServerWorker::onNewConnection() {
+    while (m_server->hasPendingConnections()) {
+        QTcpSocket *client = m_server->nextPendingConnection();
+        m_clients.insert(client, Client());
+        m_clientCount.store(int(m_clients.size()), std::memory_order_relaxed);
+
+        connect(client, &QTcpSocket::readyRead, this, &CatServerWorker::onClientData);
+        connect(client, &QTcpSocket::disconnected, this, &CatServerWorker::onClientDisconnected);
+
+        QString address = QString("%1:%2").arg(client->peerAddress().toString()).arg(client->peerPort());
+        emit clientConnected(address);
+    }
+}
+
+void CatServerWorker::onClientData() {
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    auto it = m_clients.find(socket);
+    if (it == m_clients.end())
+        return;
+
+    Client &client = *it;
+    client.buffer.append(socket->readAll());
+
+    // K4 CAT commands are semicolon-terminated. Commands are viewed in place from a cursor and the
+    // consumed bytes are dropped once at the end, not after every command.
+    qsizetype cursor = 0;
+    qsizetype end;
+    while ((end = client.buffer.indexOf(';', cursor)) >= 0) {
+        const QByteArrayView view = QByteArrayView(client.buffer).sliced(cursor, end + 1 - cursor).trimmed();
+        cursor = end + 1;
+
+        if (!view.isEmpty()) {
+            const QByteArray response = respond(QByteArray::fromRawData(view.data(), view.size()), &client);
+            if (!response.isEmpty()) {
+                socket->write(response);
+            }
+        }
+    }
+    client.buffer.remove(0, cursor);
+    if (client.buffer.size() > MAX_PENDING_BYTES) {
+        client.buffer.clear();
+    }
+}
+
+void CatServerWorker::onClientDisconnected() {
+    QTcpSocket *client = qobject_cast<QTcpSocket *>(sender());
+    if (!client || !m_clients.remove(client))
+        return;
+
+    QString address = QString("%1:%2").arg(client->peerAddress().toString()).arg(client->peerPort());
+    m_clientCount.store(int(m_clients.size()), std::memory_order_relaxed);
+    client->deleteLater();
+
+    emit clientDisconnected(address);
+}
+
+QByteArray CatServerWorker::respond(const QByteArray &command, Client *client) {
+    auto cached = m_responseCache.constFind(command);
+    if (cached != m_responseCache.constEnd()) {
+        if (client)
+            client->polledFields |= cached->fields & POLL_SUBSCRIBED_FIELDS;
+        return cached->response;
+    }
+
+    const QByteArray response = handleCommand(QString::fromUtf8(command), client).toUtf8();
+    if (!response.isEmpty()) {
+        // command may view a client's buffer: the key is a deep copy
+        if (const CacheableGet *get = cacheableGet(command))
+            m_responseCache.insert(QByteArray(command.constData(), command.size()), {response, get->fields});
+    }
+    return response;
+}
+
+void CatServerWorker::pushAutoInfo(quint32 changedFields) {
+    bool wantIf = false;
+    bool wantFields = false;
+    for (const Client &state : std::as_const(m_clients)) {
+        wantIf |= state.autoInfo == 1 && (changedFields & IF_FIELDS);
+        wantFields |= state.autoInfo >= 2;
+    }
+    if (!wantIf && !wantFields)
+        return;
+
+    // Each response is built once per batch, whatever the number of clients
+    QByteArray ifResponse;
+    if (wantIf)
+        ifResponse = respond(QByteArrayLiteral("IF;"), nullptr);
+    QVarLengthArray<QPair<quint32, QByteArray>, 16> responses;
+    if (wantFields) {
+        for (const AutoInfoEntry &entry : AUTO_INFO_TABLE) {
+            if (changedFields & entry.field)
+                responses.append({entry.field, respond(QByteArray::fromRawData(entry.command, 3), nullptr)});
+        }
+    }
+
+    for (auto it = m_clients.cbegin(); it != m_clients.cend(); ++it) {
+        const Client &state = it.value();
+        if (state.autoInfo == 1 && !ifResponse.isEmpty()) {
+            it.key()->write(ifResponse);
+        } else if (state.autoInfo >= 2) {
+            QByteArray out;
+            for (const auto &response : responses) {
+                if (!(response.first & POLL_SUBSCRIBED_FIELDS) || (response.first & state.polledFields))
+                    out += response.second;
+            }
+            if (!out.isEmpty())
+                it.key()->write(out);
+        }
+    }
+}
+
+QString CatServerWorker::handleCommand(const QString &cmd, Client *client) {
+    // K4 CAT commands: 2-3 letter prefix, optional parameters, semicolon
+    // GET commands have no parameters (e.g., "FA;", "MD;")
+    // SET commands have parameters (e.g., "FA14074000;", "MD1;")
+
+    QString command = cmd.trimmed();
+    if (!command.endsWith(';')) {
+        return QString(); // Invalid command
+    }
+
+    // Remove trailing semicolon for parsing
+    command = command.left(command.length() - 1);
+
+    if (command.isEmpty()) {
+        return QString();
+    }
+
+    // Handle special commands where numbers are part of the command name
+    // K2, K3, K40, PS - these need special handling before normal parsing
+    if (command == "K2") {
+        return "K22;"; // K2 extended mode level 2
+    }
+    if (command == "K3") {
+        return "K31;"; // K3 extended mode level 1
+    }
+    if (command.startsWith("K2") || command.startsWith("K3") || command.startsWith("K4")) {
+        // K22, K31, K40 etc - SET commands, silently acknowledge
+        return QString();
+    }
+    if (command == "PS") {
+        return "PS1;"; // Power on status
+    }
+    if (command == "RVM") {
+        // Firmware revision - Front Panel version from RadioState
+        QString fp = m_state.firmwareVersions.value("FP", "01.00");
+        return QString("RVM%1;").arg(fp);
+    }
+    if (command == "RVD") {
+        // DSP firmware revision from RadioState
+        QString dsp = m_state.firmwareVersions.value("DSP", "01.00");
+        return QString("RVD%1;").arg(dsp);
+    }
+    if (command.startsWith("PS")) {
+        // PS0, PS1 - power control SET commands, silently acknowledge
+        return QString();
+    }
+
+    // Extract command prefix (2-3 uppercase letters)
+    QString prefix;
+    QString args;
+    for (int i = 0; i < command.length(); i++) {
+        if (command[i].isLetter()) {
+            prefix += command[i].toUpper();
+        } else {
+            args = command.mid(i);
+            break;
+        }
+    }
+
+    // Handle GET commands (no args) - respond from RadioState
+    if (args.isEmpty()) {
+        // Polling a meter subscribes the client to its auto-info
+        if (client) {
+            for (const AutoInfoEntry &entry : AUTO_INFO_TABLE) {
+                if ((entry.field & POLL_SUBSCRIBED_FIELDS) && prefix == QLatin1String(entry.command, 2))
+                    client->polledFields |= entry.field;
+            }
+        }
+        // VFO A frequency
+        if (prefix == "FA") {
+            return buildFrequencyResponse(m_state.frequency, "FA");
+        }
+        // VFO B frequency
+        if (prefix == "FB") {
+            return buildFrequencyResponse(m_state.vfoB, "FB");
+        }
+        // Mode (VFO A)
+        if (prefix == "MD") {
+            return buildModeResponse(m_state.mode);
+        }
+        // PTT state
+        if (prefix == "TQ") {
+            return QString("TQ%1;").arg(m_state.transmitting ? 1 : 0);
+        }
+        // Split state
+        if (prefix == "FT") {
+            return QString("FT%1;").arg(m_state.split ? 1 : 0);
+        }
+        // RX VFO indicator
+        if (prefix == "FR") {
+            return "FR0;"; // Always VFO A for RX
+        }
+        // IF command - comprehensive status (K4 format, 38 chars total)
+        // Format:
+        // IF[freq:11][blanks:5][±offset:6][rit:1][xit:1][bank:1][ch:2][tx:1][mode:2][vfo:1][scan:1][split:1][data:2];
+        if (prefix == "IF") {
+            quint64 freq = m_state.frequency;
+            int offset = m_state.ritXitOffset;
+            int ritOn = m_state.ritEnabled ? 1 : 0;
+            int xitOn = m_state.xitEnabled ? 1 : 0;
+            int mode = m_state.mode;
+            int tx = m_state.transmitting ? 1 : 0;
+            int split = m_state.split ? 1 : 0;
+
+            QString response = QString("IF%1     %2%3%4%5%6%7%8%9%10%11%12%13;")
+                                   .arg(freq, 11, 10, QChar('0')) // P1: freq (11)
+                                   // 5 blanks for step size (P2)
+                                   .arg(offset >= 0 ? "+" : "-")         // P3: offset sign
+                                   .arg(qAbs(offset), 5, 10, QChar('0')) // P3: offset value (5 digits)
+                                   .arg(ritOn)                           // P4: RIT on/off (1)
+                                   .arg(xitOn)                           // P5: XIT on/off (1)
+                                   .arg(0)                               // P6: Memory bank (1)
+                                   .arg("00")                            // P7: Memory channel (2)
+                                   .arg(tx)                              // P8: TX status (1)
+                                   .arg(mode, 2, 10, QChar('0'))         // P9: Mode (2 digits)
+                                   .arg(0)                               // P10: VFO/Mem (1)
+                                   .arg(0)                               // P11: Scan (1)
+                                   .arg(split)                           // P12: Split (1)
+                                   .arg("00");                           // P13: Data submode (2)
+            return response;
+        }
+        // RIT offset
+        if (prefix == "RO") {
+            int offset = m_state.ritXitOffset;
+            return QString("RO%1%2;").arg(offset >= 0 ? "+" : "-").arg(qAbs(offset), 4, 10, QChar('0'));
+        }
+        // RIT on/off
+        if (prefix == "RT") {
+            return QString("RT%1;").arg(m_state.ritEnabled ? 1 : 0);
+        }
+        // XIT on/off
+        if (prefix == "XT") {
+            return QString("XT%1;").arg(m_state.xitEnabled ? 1 : 0);
+        }
+        // RF power
+        if (prefix == "PC") {
+            return QString("PC%1;").arg(static_cast<int>(m_state.rfPower), 3, 10, QChar('0'));
+        }
+        // AGC
+        if (prefix == "GT") {
+            int agc = static_cast<int>(m_state.agcSpeed);
+            // K4 AGC: 0=off, 1=slow, 2=fast
+            return QString("GT%1;").arg(agc, 3, 10, QChar('0'));
+        }
+        // Keyer speed
+        if (prefix == "KS") {
+            return QString("KS%1;").arg(m_state.keyerSpeed, 3, 10, QChar('0'));
+        }
+        // Noise blanker
+        if (prefix == "NB") {
+            return QString("NB%1;").arg(m_state.noiseBlanker ? 1 : 0);
+        }
+        // Noise reduction
+        if (prefix == "NR") {
+            return QString("NR%1;").arg(m_state.noiseReduction ? 1 : 0);
+        }
+        // VOX
+        if (prefix == "VX") {
+            return QString("VX%1;").arg(m_state.vox ? 1 : 0);
+        }
+        // Filter bandwidth
+        if (prefix == "BW") {
+            int bw = m_state.filterBandwidth;
+            return QString("BW%1;").arg(bw, 4, 10, QChar('0'));
+        }
+        // ID - Radio identification
+        if (prefix == "ID") {
+            return "ID017;"; // K4 ID
+        }
+        // DT - Data sub-mode
+        if (prefix == "DT") {
+            return QString("DT%1;").arg(m_state.dataSubMode);
+        }
+        // OM - Option modules query
+        if (prefix == "OM") {
+            // Return option modules from RadioState if available, else default
+            // Format: OM <options>; where options is a 12-char string with dashes for absent
+            QString om = m_state.optionModules;
+            if (om.isEmpty()) {
+                om = "AP----------"; // Basic K4 with ATU and PA (12 chars)
+            }
+            return QString("OM %1;").arg(om); // Note: space after OM
+        }
+        // AI - Auto-information level of this client (the link to the K4 stays at AI4)
+        if (prefix == "AI") {
+            return QString("AI%1;").arg(client ? client->autoInfo : 0);
+        }
+        // TB - Text buffer (CW message queue status)
+        if (prefix == "TB") {
+            return "TB000;"; // No CW messages queued
+        }
+        // SB - Sub RX on/off
+        if (prefix == "SB") {
+            // Check if sub receiver is active (typically based on dual watch or diversity)
+            return "SB0;"; // Sub RX off by default
+        }
+        // SM - S-meter reading
+        if (prefix == "SM") {
+            // S-meter value: 0000-0021 typical range
+            // RadioState stores S-units (0-9 for S1-S9, higher for +dB)
+            int smeter = static_cast<int>(m_state.sMeter);
+            // Convert to K4 format (roughly 3 per S-unit)
+            int k4Value = qBound(0, smeter * 3, 21);
+            return QString("SM%1;").arg(k4Value, 4, 10, QChar('0'));
+        }
+        // PCX - Extended power reading
+        if (prefix == "PCX") {
+            // Format: PCnnnM; where nnn=power (3 digits), M=mode (H=high, L=low/QRP)
+            int power = static_cast<int>(m_state.rfPower);
+            QString mode = m_state.qrpMode ? "L" : "H";
+            return QString("PC%1%2;").arg(power, 3, 10, QChar('0')).arg(mode);
+        }
+        // AG - AF gain (audio volume)
+        if (prefix == "AG") {
+            // Audio gain 0-255, but we don't track this - return 0
+            return "AG000;";
+        }
+        // SQ - Squelch level
+        if (prefix == "SQ") {
+            // Squelch 0-255, but we don't track this - return 0
+            return "SQ000;";
+        }
+        // FW - Filter width (bandwidth)
+        if (prefix == "FW") {
+            int bw = m_state.filterBandwidth;
+            return QString("FW%1;").arg(bw, 8, 10, QChar('0'));
+        }
+        // TM - TX metering (polled during TX)
+        if (prefix == "TM") {
+            // Return TX meter values - format varies by mode
+            // For now return a basic response
+            return "TM0;";
+        }
+    }
+
+    // AI SET commands - set this client's auto-info level, never forwarded to the K4
+    if (prefix == "AI") {
+        bool ok = false;
+        const int level = args.toInt(&ok);
+        if (client && ok)
+            client->autoInfo = qBound(0, level, 5);
+        return QString();
+    }
+
+    // TX/RX commands - control audio input gate for external app transmit
+    // Don't forward to K4 - the audio stream itself triggers K4 TX
+    if (prefix == "TX") {
+        emit pttRequested(true);
+        return QString();
+    }
+    if (prefix == "RX") {
+        emit pttRequested(false);
+        return QString();
+    }
+
+    // SET commands (have args) - forward to real K4
+    // Commands like FA14074000;, MD1;, etc.
+    emit catCommandReceived(cmd);
+
+    // Most SET commands echo the new value
+    return QString();
+}
+
+QString CatServerWorker::buildFrequencyResponse(quint64 freq, const QString &prefix) const {
+    // K4 frequency format: 11 digits with leading zeros
+    return QString("%1%2;").arg(prefix).arg(freq, 11, 10, QChar('0'));
+}
+
+QString CatServerWorker::buildModeResponse(int mode) const {
+    // K4 mode numbers: 1=LSB, 2=USB, 3=CW, 4=FM, 5=AM, 6=DATA, 7=CW-R, 9=DATA-R
+    int k4Mode = 2; // Default USB
+    switch (mode) {
+    case RadioState::LSB:
+        k4Mode = 1;
+        break;
+    case RadioState::USB:
+        k4Mode = 2;
+        break;
+    case RadioState::CW:
+        k4Mode = 3;
+        break;
+    case RadioState::FM:
+        k4Mode = 4;
+        break;
+    case RadioState::AM:
+        k4Mode = 5;
+        break;
+    case RadioState::DATA:
+        k4Mode = 6;
+        break;
+    case RadioState::CW_R:
+        k4Mode = 7;
+        break;
+    case RadioState::DATA_R:
+        k4Mode = 9;
+        break;
+    }
+    return QString("MD%1;").arg(k4Mode);
+}
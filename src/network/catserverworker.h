@@ -0,0 +1,110 @@
+#ifndef CATSERVERWORKER_H
+#define CATSERVERWORKER_H
+
+#include <QHash>
+#include <QHostAddress>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <atomic>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief The RadioState values the CAT server answers from
+ *
+ * Copied on the GUI thread once per committed RadioState batch and handed to the worker by value,
+ * so the server thread never touches RadioState itself.
+ */
+struct CatSnapshot {
+    quint64 frequency = 0;
+    quint64 vfoB = 0;
+    int mode = 0; // RadioState::Mode
+    int dataSubMode = 0;
+    int filterBandwidth = 0;
+    bool transmitting = false;
+    bool split = false;
+    bool ritEnabled = false;
+    bool xitEnabled = false;
+    int ritXitOffset = 0;
+    double rfPower = 0.0;
+    bool qrpMode = false;
+    int agcSpeed = 0; // RadioState::AGCSpeed
+    int keyerSpeed = 0;
+    bool noiseBlanker = false;
+    bool noiseReduction = false;
+    bool vox = false;
+    double sMeter = 0.0;
+    QString optionModules;
+    QMap<QString, QString> firmwareVersions;
+};
+
+/**
+ * @brief CAT server socket handling, on CatServer's own thread
+ *
+ * Owns the QTcpServer and the client sockets. Each client has a line buffer that is scanned from a
+ * cursor and compacted once per read, however many commands arrived. GETs are answered from the
+ * last CatSnapshot through the response cache; auto-info is pushed when a new snapshot arrives.
+ *
+ * Everything but the thread-safe queries runs on the worker thread: call it through
+ * QMetaObject::invokeMethod (see CatServer).
+ */
+class CatServerWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit CatServerWorker(QObject *parent = nullptr);
+
+    // Thread-safe queries
+    bool isListening() const { return m_port.load(std::memory_order_acquire) != 0; }
+    quint16 port() const { return m_port.load(std::memory_order_acquire); }
+    int clientCount() const { return m_clientCount.load(std::memory_order_relaxed); }
+
+    // Worker thread. listen() returns an error message, empty on success.
+    QString listen(const QHostAddress &address, quint16 port);
+    void close();
+    void updateState(const CatSnapshot &state, quint32 changedFields);
+    QByteArray response(const QByteArray &command);
+
+signals:
+    void clientConnected(const QString &address);
+    void clientDisconnected(const QString &address);
+    void catCommandReceived(const QString &command);
+    void pttRequested(bool on);
+
+private slots:
+    void onNewConnection();
+    void onClientData();
+    void onClientDisconnected();
+
+private:
+    struct Client {
+        QByteArray buffer;        // Received bytes; commands before the last ';' are consumed per read
+        int autoInfo = 0;         // AI level the client set
+        quint32 polledFields = 0; // Poll-subscribed RadioState::Field bits the client has asked for
+    };
+
+    struct CachedResponse {
+        QByteArray response;
+        quint32 fields; // RadioState::Field bits that invalidate it (0 = constant)
+    };
+
+    // A client sending this much without a ';' is not speaking CAT
+    static constexpr int MAX_PENDING_BYTES = 4096;
+
+    QByteArray respond(const QByteArray &command, Client *client);
+    QString handleCommand(const QString &cmd, Client *client = nullptr);
+    void pushAutoInfo(quint32 changedFields);
+    QString buildFrequencyResponse(quint64 freq, const QString &prefix) const;
+    QString buildModeResponse(int mode) const;
+
+    QTcpServer *m_server;
+    QHash<QTcpSocket *, Client> m_clients;
+    QHash<QByteArray, CachedResponse> m_responseCache; // Keyed by command, e.g. "FA;"
+    CatSnapshot m_state;
+    std::atomic<quint16> m_port{0}; // 0 while not listening
+    std::atomic<int> m_clientCount{0};
+};
+
+#endif // CATSERVERWORKER_H
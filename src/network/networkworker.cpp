@@ -0,0 +1,435 @@
+#include "networkworker.h"
+#include "../audio/audioengine.h"
+#include "../audio/opusdecoder.h"
+#include <QDebug>
+#include <QtEndian>
+#include <QSslCipher>
+#include <QSslConfiguration>
+#include <QSslPreSharedKeyAuthenticator>
+
+NetworkWorker::NetworkWorker(QObject *parent)
+    : QObject(parent), m_socket(new QSslSocket(this)), m_protocol(new Protocol(this)), m_authTimer(new QTimer(this)),
+      m_pingTimer(new QTimer(this)), m_opusDecoder(new OpusDecoder(this)), m_port(K4Protocol::DEFAULT_PORT),
+      m_encodeMode(3), m_streamingLatency(3), m_authResponseReceived(false) {
+    // Initialize Opus decoder (K4 sends 12kHz stereo: left=Main, right=Sub)
+    m_opusDecoder->initialize(12000, 2);
+    m_decodeBuffer.resize(OpusDecoder::MAX_DECODED_SAMPLES);
+    m_audioClock.start();
+
+    // Socket signals
+    connect(m_socket, &QSslSocket::connected, this, &NetworkWorker::onSocketConnected);
+    connect(m_socket, &QSslSocket::encrypted, this, &NetworkWorker::onSocketEncrypted);
+    connect(m_socket, &QSslSocket::disconnected, this, &NetworkWorker::onSocketDisconnected);
+    connect(m_socket, &QSslSocket::readyRead, this, &NetworkWorker::onReadyRead);
+    connect(m_socket, &QSslSocket::errorOccurred, this, &NetworkWorker::onSocketError);
+
+    // SSL-specific signals
+    connect(m_socket, &QSslSocket::sslErrors, this, &NetworkWorker::onSslErrors);
+    connect(m_socket, &QSslSocket::preSharedKeyAuthenticationRequired, this,
+            &NetworkWorker::onPreSharedKeyAuthenticationRequired);
+
+    // Auth timeout timer (single shot)
+    m_authTimer->setSingleShot(true);
+    connect(m_authTimer, &QTimer::timeout, this, &NetworkWorker::onAuthTimeout);
+
+    // Ping timer for keep-alive
+    m_pingTimer->setInterval(K4Protocol::PING_INTERVAL_MS);
+    connect(m_pingTimer, &QTimer::timeout, this, &NetworkWorker::onPingTimer);
+
+    // Protocol signals - all direct, on the network thread
+    connect(m_protocol, &Protocol::packetReceived, this, &NetworkWorker::onPacketReceived);
+    connect(m_protocol, &Protocol::audioDataReady, this, &NetworkWorker::onAudioData);
+    connect(m_protocol, &Protocol::catResponseReceived, this,
+            [this](const QByteArray &response) { m_pendingCat.append(response); });
+    connect(m_protocol, &Protocol::spectrumDataReady, this,
+            [this](int receiver, const QByteArray &bins, qint64 centerFreq, qint32 sampleRate, float noiseFloor) {
+                SpectrumFrame frame;
+                frame.receiver = receiver;
+                frame.bins = bins;
+                frame.centerFreq = centerFreq;
+                frame.sampleRate = sampleRate;
+                frame.noiseFloor = noiseFloor;
+                if (!m_spectrumQueue.push(std::move(frame))) {
+                    m_droppedSpectrumFrames++;
+                }
+            });
+    connect(m_protocol, &Protocol::miniSpectrumDataReady, this, [this](int receiver, const QByteArray &bins) {
+        SpectrumFrame frame;
+        frame.receiver = receiver;
+        frame.mini = true;
+        frame.bins = bins;
+        if (!m_spectrumQueue.push(std::move(frame))) {
+            m_droppedSpectrumFrames++;
+        }
+    });
+}
+
+NetworkWorker::~NetworkWorker() {
+    shutdown();
+}
+
+void NetworkWorker::shutdown() {
+    m_pingTimer->stop();
+    m_authTimer->stop();
+    if (m_socket->state() != QAbstractSocket::UnconnectedState) {
+        m_socket->abort();
+    }
+}
+
+void NetworkWorker::connectToHost(const QString &host, quint16 port, const QString &password, bool useTls,
+                                  const QString &identity, int encodeMode, int streamingLatency) {
+    if (connectionState() != TcpClient::Disconnected) {
+        disconnectFromHost();
+    }
+
+    m_host = host;
+    m_port = port;
+    m_password = password; // Also used as PSK when TLS enabled
+    m_useTls = useTls;
+    m_identity = identity;                 // TLS-PSK identity (optional)
+    m_encodeMode = encodeMode;             // Audio encode mode (0=RAW32, 1=RAW16, 2=Opus Int, 3=Opus Float)
+    m_streamingLatency = streamingLatency; // Remote streaming audio latency (0-7)
+    m_authResponseReceived = false;
+
+    setState(TcpClient::Connecting);
+
+    if (useTls) {
+        // Log OpenSSL version Qt is using
+        qDebug() << "=== SSL Library Info ===";
+        qDebug() << "  Build version:" << QSslSocket::sslLibraryBuildVersionString();
+        qDebug() << "  Runtime version:" << QSslSocket::sslLibraryVersionString();
+        qDebug() << "  Supports SSL:" << QSslSocket::supportsSsl();
+
+        // Configure TLS for PSK authentication - require TLS 1.2 minimum
+        QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
+        sslConfig.setProtocol(QSsl::TlsV1_2OrLater);
+        sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone); // PSK doesn't use certificates
+
+        // Filter to only TLS 1.2+ PSK ciphers
+        QList<QSslCipher> tls12PskCiphers;
+        qDebug() << "=== Available PSK Ciphers ===";
+        for (const QSslCipher &cipher : QSslConfiguration::supportedCiphers()) {
+            if (cipher.name().contains("PSK")) {
+                qDebug() << "  " << cipher.name() << "(" << cipher.protocolString() << ")";
+                // Only include TLS 1.2+ ciphers
+                if (cipher.protocol() == QSsl::TlsV1_2 || cipher.protocol() == QSsl::TlsV1_3) {
+                    tls12PskCiphers.append(cipher);
+                }
+            }
+        }
+        qDebug() << "=== Offering" << tls12PskCiphers.size() << "TLS 1.2+ PSK ciphers ===";
+        for (const QSslCipher &cipher : tls12PskCiphers) {
+            qDebug() << "  " << cipher.name();
+        }
+        if (!tls12PskCiphers.isEmpty()) {
+            sslConfig.setCiphers(tls12PskCiphers);
+        }
+
+        m_socket->setSslConfiguration(sslConfig);
+
+        qDebug() << "Connecting with TLS/PSK to" << host << ":" << port;
+        m_socket->connectToHostEncrypted(host, port);
+    } else {
+        qDebug() << "Connecting (unencrypted) to" << host << ":" << port;
+        m_socket->connectToHost(host, port);
+    }
+}
+
+void NetworkWorker::disconnectFromHost() {
+    m_pingTimer->stop();
+    m_authTimer->stop();
+
+    if (m_socket->state() != QAbstractSocket::UnconnectedState) {
+        // Send graceful disconnect command
+        if (connectionState() == TcpClient::Connected) {
+            sendCAT(K4Protocol::Commands::DISCONNECT);
+        }
+        m_socket->disconnectFromHost();
+    }
+
+    setState(TcpClient::Disconnected);
+}
+
+void NetworkWorker::sendCAT(const QString &command) {
+    if (connectionState() == TcpClient::Connected) {
+        QByteArray packet = Protocol::buildCATPacket(command);
+        m_socket->write(packet);
+        m_socket->flush(); // Ensure immediate send
+    }
+}
+
+void NetworkWorker::sendRaw(const QByteArray &data) {
+    if (m_socket->state() == QAbstractSocket::ConnectedState) {
+        m_socket->write(data);
+    }
+}
+
+void NetworkWorker::setAudioEngine(AudioEngine *engine) {
+    if (m_audioEngine) {
+        disconnect(m_audioEngine, nullptr, this, nullptr);
+    }
+    m_audioEngine = engine;
+    m_lastEncodeMode = -1;
+
+    // Emitted on the audio thread, delivered queued here
+    if (m_audioEngine) {
+        connect(m_audioEngine, &AudioEngine::microphoneFramesReady, this, &NetworkWorker::onMicrophoneFramesReady);
+    }
+}
+
+void NetworkWorker::setTransmitting(bool transmitting) {
+    m_transmitting = transmitting;
+    if (transmitting) {
+        m_txAudio.reset(); // Sequence restarts on every PTT press
+    }
+}
+
+void NetworkWorker::onMicrophoneFramesReady() {
+    if (!m_audioEngine) {
+        return;
+    }
+
+    // Re-arm before draining so frames queued meanwhile trigger another wake-up
+    m_audioEngine->beginMicrophoneDrain();
+
+    // Frames are always consumed; they only go out while transmitting and connected
+    const bool send = m_transmitting && connectionState() == TcpClient::Connected;
+    while (const AudioEngine::MicrophoneFrame *frame = m_audioEngine->frontMicrophoneFrame()) {
+        if (send) {
+            const int size = m_txAudio.encodeFrame(frame->samples.data(), static_cast<quint8>(m_encodeMode));
+            if (size > 0) {
+                m_socket->write(m_txAudio.packetData(), size);
+            }
+        }
+        m_audioEngine->discardMicrophoneFrame();
+    }
+}
+
+void NetworkWorker::setState(TcpClient::ConnectionState state) {
+    if (m_state.exchange(state, std::memory_order_acq_rel) != state) {
+        emit stateChanged(state);
+    }
+}
+
+void NetworkWorker::onSocketConnected() {
+    if (m_useTls) {
+        // TLS connection: TCP connected, now waiting for TLS handshake to complete
+        // The encrypted() signal will fire when TLS is fully established
+        qDebug() << "TCP connected, starting TLS handshake...";
+        // Don't change state yet - wait for encrypted() signal
+    } else {
+        // Non-TLS: need to send SHA-384 password hash
+        qDebug() << "Socket connected, sending authentication...";
+        setState(TcpClient::Authenticating);
+        sendAuthentication();
+        m_authTimer->start(K4Protocol::AUTH_TIMEOUT_MS);
+    }
+}
+
+void NetworkWorker::onSocketEncrypted() {
+    // TLS handshake completed successfully
+    QSslCipher negotiated = m_socket->sessionCipher();
+    qDebug() << "=== TLS/PSK Connection Established ===";
+    qDebug() << "  Negotiated cipher:" << negotiated.name();
+    qDebug() << "  Protocol:" << negotiated.protocolString();
+    qDebug() << "  Key exchange:" << negotiated.keyExchangeMethod();
+    qDebug() << "  Encryption:" << negotiated.encryptionMethod();
+    setState(TcpClient::Authenticating);
+    // Start auth timeout - waiting for first packet to confirm connection works
+    m_authTimer->start(K4Protocol::AUTH_TIMEOUT_MS);
+    // Note: For TLS/PSK, no additional password auth needed - data flows immediately
+}
+
+void NetworkWorker::onSocketDisconnected() {
+    qDebug() << "Socket disconnected";
+    m_pingTimer->stop();
+    m_authTimer->stop();
+
+    if (connectionState() == TcpClient::Authenticating && !m_authResponseReceived) {
+        emit authenticationFailed();
+        emit errorOccurred("Authentication failed - connection closed by radio");
+    }
+
+    setState(TcpClient::Disconnected);
+}
+
+void NetworkWorker::onReadyRead() {
+    m_protocol->parse(m_socket->readAll());
+    flushIncoming();
+}
+
+void NetworkWorker::flushIncoming() {
+    // All CAT packets from this read go to the GUI as one batch
+    if (!m_pendingCat.isEmpty()) {
+        const bool queued = m_catQueue.push(std::move(m_pendingCat));
+        if (queued)
+            m_pendingCat = QByteArray();
+        m_catBacklog.store(!queued, std::memory_order_release);
+    }
+
+    if (m_droppedSpectrumFrames > 0) {
+        qWarning() << "NetworkWorker: GUI thread stalled, dropped" << m_droppedSpectrumFrames << "spectrum frames";
+        m_droppedSpectrumFrames = 0;
+    }
+
+    // Wake the GUI thread once; further reads just add to the queues until it drains them. A held-back
+    // CAT batch needs a drain too: the GUI may have emptied the queue before the backlog was recorded,
+    // and only its endDrain() retries it.
+    if (!m_catQueue.isEmpty() || !m_spectrumQueue.isEmpty() || m_catBacklog.load(std::memory_order_acquire)) {
+        if (!m_incomingPending.exchange(true, std::memory_order_acq_rel)) {
+            emit incomingReady();
+        }
+    }
+}
+
+void NetworkWorker::beginDrain() {
+    // Re-arm before popping so data queued during the drain triggers another wake-up
+    m_incomingPending.store(false, std::memory_order_release);
+}
+
+void NetworkWorker::endDrain() {
+    // A CAT batch held back by a full queue goes out now, not with the next socket read
+    if (m_catBacklog.exchange(false, std::memory_order_acq_rel))
+        QMetaObject::invokeMethod(this, &NetworkWorker::flushIncoming, Qt::QueuedConnection);
+}
+
+void NetworkWorker::onPacketReceived(quint8 type) {
+    // Any packet means auth succeeded
+    if (connectionState() == TcpClient::Authenticating && !m_authResponseReceived) {
+        m_authResponseReceived = true;
+        m_authTimer->stop();
+        qDebug() << "Authentication successful, received packet type:" << type;
+        setState(TcpClient::Connected);
+        emit authenticated();
+        m_pingTimer->start();
+
+        // New audio stream: sequence numbers, jitter history and stream gain start over
+        m_lastEncodeMode = -1;
+        if (m_audioEngine) {
+            m_audioEngine->jitterBuffer()->resetSequence();
+        }
+
+        // Send initialization sequence
+        // RDY triggers comprehensive state dump containing all radio state:
+        // FA, FB, MD, MD$, BW, BW$, IS, CW, KS, PC, SD (per mode), SQ, RG, SQ$, RG$,
+        // #SPN, #REF, VXC, VXV, VXD, and all menu definitions (MEDF)
+        sendCAT(K4Protocol::Commands::READY);              // Triggers comprehensive state dump
+        sendCAT(K4Protocol::Commands::ENABLE_K4_MODE);     // Enable advanced K4 protocol mode
+        sendCAT(K4Protocol::Commands::ENABLE_LONG_ERRORS); // Request long format error messages
+        // Set audio encode mode (0=RAW32, 1=RAW16, 2=Opus Int, 3=Opus Float)
+        qDebug() << "Sending:" << QString("EM%1;").arg(m_encodeMode);
+        sendCAT(QString("EM%1;").arg(m_encodeMode));
+        // Set streaming audio latency (0-7, higher values for high-latency connections)
+        qDebug() << "Sending:" << QString("SL%1;").arg(m_streamingLatency);
+        sendCAT(QString("SL%1;").arg(m_streamingLatency));
+    }
+}
+
+void NetworkWorker::onAudioData(const QByteArray &payload) {
+    // Only process audio when connected
+    if (connectionState() != TcpClient::Connected || !m_audioEngine) {
+        return;
+    }
+
+    if (payload.size() <= K4Protocol::AudioPacket::HEADER_SIZE) {
+        return;
+    }
+
+    // Sequence/jitter bookkeeping happens at arrival, before any decode work
+    JitterBuffer *jitterBuffer = m_audioEngine->jitterBuffer();
+    const uchar *header = reinterpret_cast<const uchar *>(payload.constData());
+    const quint8 sequence = header[K4Protocol::AudioPacket::SEQUENCE_OFFSET];
+    const int frameSize = qFromLittleEndian<quint16>(header + K4Protocol::AudioPacket::FRAME_SIZE_OFFSET);
+    const int lost = jitterBuffer->packetArrived(sequence, frameSize, m_audioClock.nsecsElapsed() / 1000);
+    if (lost < 0) {
+        return; // Duplicate or stale packet
+    }
+
+    // Decoded samples are normalized but not boosted; the playback mix applies the gain
+    const quint8 encodeMode = header[K4Protocol::AudioPacket::MODE_OFFSET];
+    if (encodeMode != m_lastEncodeMode) {
+        m_lastEncodeMode = encodeMode;
+        m_audioEngine->setStreamGain(OpusDecoder::streamGain(encodeMode));
+    }
+
+    float *buffer = m_decodeBuffer.data();
+    const int bufferSize = static_cast<int>(m_decodeBuffer.size());
+
+    // Fill sequence gaps: PLC for all but the newest missing frame, which this
+    // packet's FEC data can recover. Must run before the packet itself is decoded.
+    for (int i = 0; i < lost; i++) {
+        int samples = m_opusDecoder->concealK4Frame(payload, buffer, bufferSize, i == lost - 1);
+        if (samples > 0) {
+            jitterBuffer->write(buffer, samples, true);
+        }
+    }
+
+    // Decode K4 audio packet here so the audio path never waits on the GUI thread
+    // Raw stereo Float32 PCM (L=Main, R=Sub) lands in a reused buffer; mix/volume is applied at playback
+    int samples = m_opusDecoder->decodeK4Packet(payload, buffer, bufferSize);
+
+    if (samples > 0) {
+        jitterBuffer->write(buffer, samples);
+    }
+}
+
+void NetworkWorker::onSocketError(QAbstractSocket::SocketError error) {
+    Q_UNUSED(error)
+    m_pingTimer->stop();
+    m_authTimer->stop();
+
+    QString errorMsg = m_socket->errorString();
+    qDebug() << "Socket error:" << errorMsg;
+
+    if (connectionState() == TcpClient::Authenticating) {
+        emit authenticationFailed();
+    }
+
+    emit errorOccurred(errorMsg);
+    setState(TcpClient::Disconnected);
+}
+
+void NetworkWorker::onSslErrors(const QList<QSslError> &errors) {
+    // Log SSL errors but continue - PSK doesn't use certificates so some errors are expected
+    for (const QSslError &error : errors) {
+        qDebug() << "SSL error (ignored for PSK):" << error.errorString();
+    }
+    // Ignore all SSL errors for PSK connections (no certificate verification)
+    m_socket->ignoreSslErrors();
+}
+
+void NetworkWorker::onPreSharedKeyAuthenticationRequired(QSslPreSharedKeyAuthenticator *authenticator) {
+    qDebug() << "PSK authentication requested, identity hint:" << authenticator->identityHint();
+
+    // Set the identity (empty or user-specified) and the pre-shared key (password field)
+    authenticator->setIdentity(m_identity.toUtf8());
+    authenticator->setPreSharedKey(m_password.toUtf8());
+
+    qDebug() << "PSK credentials provided, identity:" << (m_identity.isEmpty() ? "(empty)" : m_identity);
+}
+
+void NetworkWorker::onAuthTimeout() {
+    if (connectionState() == TcpClient::Authenticating && !m_authResponseReceived) {
+        qDebug() << "Authentication timeout";
+        emit authenticationFailed();
+        emit errorOccurred("Authentication timeout - no response from radio");
+        disconnectFromHost();
+    }
+}
+
+void NetworkWorker::onPingTimer() {
+    if (connectionState() == TcpClient::Connected) {
+        sendCAT(K4Protocol::Commands::PING);
+    }
+}
+
+void NetworkWorker::sendAuthentication() {
+    // Build SHA-384 hash of password as hex string
+    QByteArray authData = Protocol::buildAuthData(m_password);
+    qDebug() << "Sending auth hash (" << authData.size() << "bytes)";
+
+    // Send raw auth data (not wrapped in K4 packet - just the hex string)
+    m_socket->write(authData);
+    m_socket->flush();
+    // Radio will respond with packets, which triggers auth success and init sequence
+}
@@ -0,0 +1,134 @@
+#ifndef NETWORKWORKER_H
+#define NETWORKWORKER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QSslSocket>
+#include <QTimer>
+#include <atomic>
+#include <vector>
+#include "protocol.h"
+#include "spscqueue.h"
+#include "tcpclient.h"
+#include "../audio/txaudiopipeline.h"
+
+class AudioEngine;
+class OpusDecoder;
+
+/**
+ * @brief K4 connection worker that runs on TcpClient's network thread
+ *
+ * Owns the socket, TLS, authentication, keep-alive, framing and packet demux.
+ * Audio packets are decoded here and pushed straight into AudioEngine's playback
+ * ring; CAT text and spectrum frames are queued for the GUI thread, which is
+ * woken at most once per batch (see TcpClient::onIncomingReady). In the other
+ * direction, microphone frames from AudioEngine are encoded and written to the
+ * socket here by a TxAudioPipeline while transmitting.
+ *
+ * All slots must be invoked through queued connections from other threads.
+ */
+class NetworkWorker : public QObject {
+    Q_OBJECT
+
+public:
+    // PAN or MiniPAN frame queued for the GUI thread
+    struct SpectrumFrame {
+        int receiver = 0;
+        bool mini = false;
+        QByteArray bins;
+        qint64 centerFreq = 0;
+        qint32 sampleRate = 0;
+        float noiseFloor = 0.0f;
+    };
+
+    explicit NetworkWorker(QObject *parent = nullptr);
+    ~NetworkWorker() override;
+
+    // Called on the network thread (see TcpClient::setAudioEngine)
+    void setAudioEngine(AudioEngine *engine);
+
+    // Thread-safe state queries
+    TcpClient::ConnectionState connectionState() const { return m_state.load(std::memory_order_acquire); }
+    bool isUsingTls() const { return m_useTls.load(std::memory_order_relaxed); }
+
+    // GUI thread (consumer side): drain queued data after incomingReady(), between beginDrain()
+    // and endDrain()
+    void beginDrain();
+    void endDrain();
+    bool popCatResponse(QByteArray &response) { return m_catQueue.pop(response); }
+    bool popSpectrumFrame(SpectrumFrame &frame) { return m_spectrumQueue.pop(frame); }
+
+public slots:
+    void connectToHost(const QString &host, quint16 port, const QString &password, bool useTls,
+                       const QString &identity, int encodeMode, int streamingLatency);
+    void disconnectFromHost();
+    void sendCAT(const QString &command);
+    void sendRaw(const QByteArray &data);
+    void setTransmitting(bool transmitting);
+    void shutdown();
+
+signals:
+    void stateChanged(TcpClient::ConnectionState state);
+    void errorOccurred(const QString &error);
+    void authenticated();
+    void authenticationFailed();
+
+    // New CAT/spectrum data is queued; not re-emitted until the GUI calls beginDrain()
+    void incomingReady();
+
+private slots:
+    void onSocketConnected();
+    void onSocketEncrypted();
+    void onSocketDisconnected();
+    void onReadyRead();
+    void onSocketError(QAbstractSocket::SocketError error);
+    void onSslErrors(const QList<QSslError> &errors);
+    void onPreSharedKeyAuthenticationRequired(QSslPreSharedKeyAuthenticator *authenticator);
+    void onAuthTimeout();
+    void onPingTimer();
+    void onMicrophoneFramesReady();
+
+private:
+    void setState(TcpClient::ConnectionState state);
+    void sendAuthentication();
+    void onPacketReceived(quint8 type);
+    void onAudioData(const QByteArray &payload);
+    void flushIncoming();
+
+    QSslSocket *m_socket;
+    Protocol *m_protocol;
+    QTimer *m_authTimer;
+    QTimer *m_pingTimer;
+    OpusDecoder *m_opusDecoder;
+    AudioEngine *m_audioEngine = nullptr;
+    std::vector<float> m_decodeBuffer; // Decoded RX audio, reused for every packet
+    QElapsedTimer m_audioClock;        // Arrival timestamps for jitter estimation
+    int m_lastEncodeMode = -1;         // Encode mode of the last audio packet (selects stream gain)
+    TxAudioPipeline m_txAudio;         // Mic frame -> framed TX packet, preallocated
+    bool m_transmitting = false;       // PTT: send mic frames instead of discarding them
+
+    QString m_host;
+    quint16 m_port;
+    QString m_password; // Also used as PSK when TLS enabled
+    std::atomic<bool> m_useTls{false};
+    QString m_identity;     // TLS-PSK identity (optional)
+    int m_encodeMode;       // Audio encode mode (0-3)
+    int m_streamingLatency; // Remote streaming audio latency (0-7)
+    std::atomic<TcpClient::ConnectionState> m_state{TcpClient::Disconnected};
+    bool m_authResponseReceived;
+
+    // Network thread -> GUI thread hand-off. CAT text from one read is batched into a
+    // single entry; if the queue is full it keeps accumulating in m_pendingCat so no
+    // state update is ever lost, and is retried as soon as the GUI has drained the queue.
+    SpscQueue<QByteArray> m_catQueue{CAT_QUEUE_SIZE};
+    SpscQueue<SpectrumFrame> m_spectrumQueue{SPECTRUM_QUEUE_SIZE};
+    QByteArray m_pendingCat;
+    std::atomic<bool> m_catBacklog{false}; // m_pendingCat is waiting for room in m_catQueue
+    std::atomic<bool> m_incomingPending{false};
+    int m_droppedSpectrumFrames = 0;
+
+    static constexpr int CAT_QUEUE_SIZE = 256;
+    static constexpr int SPECTRUM_QUEUE_SIZE = 128; // ~1s of PAN+MiniPAN for both receivers
+};
+
+#endif // NETWORKWORKER_H
@@ -2,16 +2,28 @@
 #include <QCryptographicHash>
 #include <QtEndian>
 #include <QDebug>
+#include <cstring>
 
-Protocol::Protocol(QObject *parent) : QObject(parent) {}
+Protocol::Protocol(QObject *parent) : QObject(parent) {
+    m_buffer.reserve(K4Protocol::INITIAL_BUFFER_SIZE);
+}
 
 void Protocol::parse(const QByteArray &data) {
+    // Compact before appending only when it is free (everything consumed), when the consumed
+    // prefix has grown large, or when the append would otherwise reallocate. The unread tail
+    // is at most one partial packet, so this moves a few KB at most and happens rarely.
+    if (m_readPos > 0 && (m_readPos == m_buffer.size() || m_readPos >= K4Protocol::COMPACT_THRESHOLD ||
+                          m_buffer.size() + data.size() > m_buffer.capacity())) {
+        compactBuffer();
+    }
+
     m_buffer.append(data);
 
     // Prevent unbounded buffer growth from malformed data
-    if (m_buffer.size() > K4Protocol::MAX_BUFFER_SIZE) {
-        qWarning() << "Protocol buffer overflow (" << m_buffer.size() << "bytes), clearing";
-        m_buffer.clear();
+    if (m_buffer.size() - m_readPos > K4Protocol::MAX_BUFFER_SIZE) {
+        qWarning() << "Protocol buffer overflow (" << m_buffer.size() - m_readPos << "bytes), clearing";
+        m_buffer.resize(0);
+        m_readPos = 0;
         return;
     }
 
@@ -19,78 +31,83 @@ void Protocol::parse(const QByteArray &data) {
     // All K4 data comes wrapped in binary packets with START/END markers
     while (true) {
         // Look for start marker
-        int startPos = m_buffer.indexOf(K4Protocol::START_MARKER);
+        int startPos = m_buffer.indexOf(K4Protocol::START_MARKER, m_readPos);
         if (startPos == -1) {
-            // No start marker found, clear buffer up to last 3 bytes
+            // No start marker found, discard everything except the last 3 bytes
             // (in case partial marker is at the end)
-            if (m_buffer.size() > 3) {
-                m_buffer = m_buffer.right(3);
+            if (m_buffer.size() - m_readPos > 3) {
+                m_readPos = m_buffer.size() - 3;
             }
             break;
         }
 
         // Discard any data before the start marker
-        if (startPos > 0) {
-            m_buffer = m_buffer.mid(startPos);
-        }
+        m_readPos = startPos;
 
         // Check if we have enough data for the header (4 marker + 4 length = 8 bytes)
-        if (m_buffer.size() < 8) {
+        const qint64 available = m_buffer.size() - m_readPos;
+        if (available < 8) {
             break;
         }
 
+        const char *packet = m_buffer.constData() + m_readPos;
+
         // Read payload length (big-endian uint32)
-        quint32 payloadLength = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(m_buffer.constData() + 4));
+        quint32 payloadLength = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(packet + 4));
 
         // Calculate total packet size: start(4) + length(4) + payload + end(4)
-        int totalPacketSize = 4 + 4 + payloadLength + 4;
+        qint64 totalPacketSize = 4 + 4 + qint64(payloadLength) + 4;
 
         // Check if we have the complete packet
-        if (m_buffer.size() < totalPacketSize) {
+        if (available < totalPacketSize) {
             break;
         }
 
         // Verify end marker
-        QByteArray endMarker = m_buffer.mid(totalPacketSize - 4, 4);
-        if (endMarker != K4Protocol::END_MARKER) {
+        if (memcmp(packet + totalPacketSize - 4, K4Protocol::END_MARKER.constData(), 4) != 0) {
             // Invalid packet, skip past the start marker and try again
             qWarning() << "Invalid K4 packet: bad end marker";
-            m_buffer = m_buffer.mid(4);
+            m_readPos += 4;
             continue;
         }
 
-        // Extract payload
-        QByteArray payload = m_buffer.mid(8, payloadLength);
-
-        // Remove processed packet from buffer
-        m_buffer = m_buffer.mid(totalPacketSize);
+        // Consume the packet before dispatch, then hand out a view of the payload in place
+        m_readPos += static_cast<int>(totalPacketSize);
+        processPacket(QByteArrayView(packet + 8, payloadLength));
+    }
+}
 
-        // Process the complete packet
-        processPacket(payload);
+void Protocol::compactBuffer() {
+    const int unread = m_buffer.size() - m_readPos;
+    if (unread > 0) {
+        memmove(m_buffer.data(), m_buffer.constData() + m_readPos, unread);
+        m_bytesCompacted += unread;
     }
+    m_buffer.resize(unread); // Keeps capacity
+    m_readPos = 0;
 }
 
-void Protocol::processPacket(const QByteArray &payload) {
+void Protocol::processPacket(QByteArrayView payload) {
     if (payload.isEmpty()) {
         return;
     }
 
     quint8 type = static_cast<quint8>(payload[0]);
-    emit packetReceived(type, payload);
+    emit packetReceived(type);
 
+    // Signals below carry owning copies of only the bytes each consumer needs
     switch (type) {
     case K4Protocol::CAT: {
         // CAT response: [0x00][0x00][0x00][ASCII data]
         if (payload.size() > 3) {
-            QString response = QString::fromLatin1(payload.mid(3));
-            emit catResponseReceived(response);
+            emit catResponseReceived(payload.sliced(3).toByteArray());
         }
         break;
     }
     case K4Protocol::Audio: {
         // Audio packet structure - see K4Protocol::AudioPacket namespace for offset definitions
         if (payload.size() > K4Protocol::AudioPacket::HEADER_SIZE) {
-            emit audioDataReady(payload);
+            emit audioDataReady(payload.toByteArray());
         }
         break;
     }
@@ -100,15 +117,15 @@ void Protocol::processPacket(const QByteArray &payload) {
         if (payload.size() > HEADER_SIZE) {
             int receiver = static_cast<quint8>(payload[RECEIVER_OFFSET]);
             qint64 centerFreq =
-                qFromLittleEndian<qint64>(reinterpret_cast<const uchar *>(payload.constData() + CENTER_FREQ_OFFSET));
+                qFromLittleEndian<qint64>(reinterpret_cast<const uchar *>(payload.data() + CENTER_FREQ_OFFSET));
             qint32 sampleRate =
-                qFromLittleEndian<qint32>(reinterpret_cast<const uchar *>(payload.constData() + SAMPLE_RATE_OFFSET));
+                qFromLittleEndian<qint32>(reinterpret_cast<const uchar *>(payload.data() + SAMPLE_RATE_OFFSET));
             qint32 noiseFloorRaw =
-                qFromLittleEndian<qint32>(reinterpret_cast<const uchar *>(payload.constData() + NOISE_FLOOR_OFFSET));
+                qFromLittleEndian<qint32>(reinterpret_cast<const uchar *>(payload.data() + NOISE_FLOOR_OFFSET));
             float noiseFloor = noiseFloorRaw / 10.0f;
 
-            QByteArray bins = payload.mid(BINS_OFFSET);
-            emit spectrumDataReady(receiver, bins, centerFreq, sampleRate, noiseFloor);
+            emit spectrumDataReady(receiver, payload.sliced(BINS_OFFSET).toByteArray(), centerFreq, sampleRate,
+                                   noiseFloor);
         }
         break;
     }
@@ -117,8 +134,7 @@ void Protocol::processPacket(const QByteArray &payload) {
         using namespace K4Protocol::MiniPanPacket;
         if (payload.size() > HEADER_SIZE) {
             int receiver = static_cast<quint8>(payload[RECEIVER_OFFSET]);
-            QByteArray bins = payload.mid(BINS_OFFSET);
-            emit miniSpectrumDataReady(receiver, bins);
+            emit miniSpectrumDataReady(receiver, payload.sliced(BINS_OFFSET).toByteArray());
         }
         break;
     }
@@ -181,22 +197,30 @@ QByteArray Protocol::buildAudioPacket(const QByteArray &audioData, quint8 sequen
     // Byte 6:    Sample rate code = 0x00 (12000 Hz)
     // Byte 7+:   Audio data (format depends on encode mode)
 
-    QByteArray payload;
-    payload.reserve(7 + audioData.size());
+    // Built in one allocation: header, body and framing written straight into the packet
+    QByteArray packet(AUDIO_BODY_OFFSET + audioData.size() + 4, Qt::Uninitialized);
+    writeAudioHeader(packet.data(), sequence, encodeMode);
+    std::memcpy(packet.data() + AUDIO_BODY_OFFSET, audioData.constData(), audioData.size());
+    finishPacket(packet.data(), K4Protocol::AudioPacket::HEADER_SIZE + audioData.size());
+    return packet;
+}
 
-    payload.append(static_cast<char>(K4Protocol::Audio)); // 0x01
-    payload.append(static_cast<char>(0x01));              // Version
-    payload.append(static_cast<char>(sequence));          // Sequence
-    payload.append(static_cast<char>(encodeMode));        // Encode mode
+void Protocol::writeAudioHeader(char *packet, quint8 sequence, quint8 encodeMode) {
+    char *header = packet + K4Protocol::FRAME_HEADER_SIZE;
+    header[K4Protocol::AudioPacket::TYPE_OFFSET] = static_cast<char>(K4Protocol::Audio);
+    header[K4Protocol::AudioPacket::VERSION_OFFSET] = 0x01;
+    header[K4Protocol::AudioPacket::SEQUENCE_OFFSET] = static_cast<char>(sequence);
+    header[K4Protocol::AudioPacket::MODE_OFFSET] = static_cast<char>(encodeMode);
 
     // Frame size: 240 samples (little-endian)
-    quint16 frameSize = 240;
-    payload.append(static_cast<char>(frameSize & 0xFF));
-    payload.append(static_cast<char>((frameSize >> 8) & 0xFF));
+    qToLittleEndian<quint16>(240, header + K4Protocol::AudioPacket::FRAME_SIZE_OFFSET);
 
-    payload.append(static_cast<char>(0x00)); // Sample rate code (0 = 12kHz)
-
-    payload.append(audioData);
+    header[K4Protocol::AudioPacket::SAMPLE_RATE_OFFSET] = 0x00; // Sample rate code (0 = 12kHz)
+}
 
-    return buildPacket(payload);
+int Protocol::finishPacket(char *packet, int payloadSize) {
+    std::memcpy(packet, K4Protocol::START_MARKER.constData(), 4);
+    qToBigEndian<quint32>(payloadSize, packet + 4);
+    std::memcpy(packet + K4Protocol::FRAME_HEADER_SIZE + payloadSize, K4Protocol::END_MARKER.constData(), 4);
+    return payloadSize + K4Protocol::FRAME_OVERHEAD;
 }
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QByteArrayView>
 
 // K4 Protocol Constants
 namespace K4Protocol {
@@ -11,6 +12,10 @@ namespace K4Protocol {
 inline const QByteArray START_MARKER = QByteArray::fromHex("FEFDFCFB");
 inline const QByteArray END_MARKER = QByteArray::fromHex("FBFCFDFE");
 
+// Framing around every payload: start marker + big-endian length before, end marker after
+constexpr int FRAME_HEADER_SIZE = 8;
+constexpr int FRAME_OVERHEAD = 12;
+
 // Payload types (first byte of payload)
 enum PayloadType : quint8 {
     CAT = 0x00,    // CAT command (ASCII)
@@ -29,7 +34,9 @@ constexpr int CONNECTION_TIMEOUT_MS = 10000; // 10 seconds
 constexpr int AUTH_TIMEOUT_MS = 5000;        // 5 seconds for auth response
 
 // Buffer limits
-constexpr int MAX_BUFFER_SIZE = 1024 * 1024; // 1MB max buffer before reset
+constexpr int MAX_BUFFER_SIZE = 1024 * 1024;  // 1MB max unread data before reset
+constexpr int INITIAL_BUFFER_SIZE = 64 * 1024; // Receive buffer capacity reserved up front
+constexpr int COMPACT_THRESHOLD = 32 * 1024;   // Consumed bytes before the receive buffer is compacted
 
 // PAN packet byte offsets (Type 0x02)
 namespace PanPacket {
@@ -90,6 +97,9 @@ public:
     // Parse incoming raw data, extracts complete K4 packets
     void parse(const QByteArray &data);
 
+    // Total bytes moved by receive buffer compaction (framing overhead, for benchmarks)
+    quint64 bytesCompacted() const { return m_bytesCompacted; }
+
     // Build a K4 packet from payload
     static QByteArray buildPacket(const QByteArray &payload);
 
@@ -104,19 +114,33 @@ public:
     // encodeMode: 0=RAW32, 1=RAW16, 2=Opus Int, 3=Opus Float (default)
     static QByteArray buildAudioPacket(const QByteArray &audioData, quint8 sequence, quint8 encodeMode = 0x03);
 
+    // In-place TX audio packet in a caller-owned buffer: writeAudioHeader() fills the audio
+    // header, the caller writes the audio body at AUDIO_BODY_OFFSET, then finishPacket()
+    // adds the framing and returns the total packet size. No allocation or copies.
+    static constexpr int AUDIO_BODY_OFFSET = K4Protocol::FRAME_HEADER_SIZE + K4Protocol::AudioPacket::HEADER_SIZE;
+    static void writeAudioHeader(char *packet, quint8 sequence, quint8 encodeMode);
+    static int finishPacket(char *packet, int payloadSize);
+
 signals:
     void audioDataReady(const QByteArray &opusData);
     // receiver: 0 = Main (VFO A), 1 = Sub (VFO B)
     void spectrumDataReady(int receiver, const QByteArray &spectrumData, qint64 centerFreq, qint32 sampleRate,
                            float noiseFloor);
     void miniSpectrumDataReady(int receiver, const QByteArray &spectrumData);
-    void catResponseReceived(const QString &response);
-    void packetReceived(quint8 type, const QByteArray &payload);
+    void catResponseReceived(const QByteArray &response); // ASCII, one or more commands
+    // Fired for every framed packet before type-specific dispatch (payload is not copied)
+    void packetReceived(quint8 type);
 
 private:
-    void processPacket(const QByteArray &packet);
+    // payload is a view into m_buffer, valid only for the duration of the call
+    void processPacket(QByteArrayView payload);
+    void compactBuffer();
 
+    // Receive buffer with a read cursor: parsed packets advance m_readPos instead of
+    // reallocating the buffer, and the unread tail is moved to the front only rarely
     QByteArray m_buffer;
+    int m_readPos = 0;
+    quint64 m_bytesCompacted = 0;
 };
 
 #endif // PROTOCOL_H
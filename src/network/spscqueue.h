@@ -0,0 +1,110 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ *
+ * Used to hand data between exactly two threads (e.g. network thread -> GUI thread)
+ * without locks or per-item allocation of queue nodes. All slots are constructed up
+ * front; push() and pop() move values in and out of them.
+ *
+ * Thread rules: push()/back()/commit() only from the producer thread, pop()/front()/
+ * discard()/clear() only from the consumer thread. Capacity is rounded up to a power of two.
+ */
+template <typename T> class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Producer: returns false (and leaves value untouched) if the queue is full
+    bool push(T &&value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+            return false;
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T &value) {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    // Producer: the next free slot, filled in place and published with commit()
+    // (nullptr if full). Avoids building large elements on the side and moving them in.
+    T *back() {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+            return nullptr;
+        }
+        return &m_slots[tail & m_mask];
+    }
+
+    // Producer: publish the slot returned by back()
+    void commit() { m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Consumer: returns false if the queue is empty
+    bool pop(T &value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: peek at the oldest element without removing it (nullptr if empty)
+    T *front() {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &m_slots[head & m_mask];
+    }
+
+    // Consumer: drop the oldest element (after front())
+    void discard() {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head != m_tail.load(std::memory_order_acquire)) {
+            m_head.store(head + 1, std::memory_order_release);
+        }
+    }
+
+    // Consumer: drop everything currently queued
+    void clear() { m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release); }
+
+    // Approximate when called from the producer; exact from the consumer
+    std::size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const { return size() == 0; }
+    std::size_t capacity() const { return m_mask + 1; }
+
+private:
+    std::vector<T> m_slots;
+    std::size_t m_mask = 0;
+
+    // Separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+#endif // SPSCQUEUE_H
@@ -1,167 +1,88 @@
 #include "tcpclient.h"
+#include "networkworker.h"
 #include <QDebug>
-#include <QSslCipher>
-#include <QSslConfiguration>
-#include <QSslPreSharedKeyAuthenticator>
-#include <QSslSocket>
 
 TcpClient::TcpClient(QObject *parent)
-    : QObject(parent), m_socket(new QSslSocket(this)), m_protocol(new Protocol(this)), m_authTimer(new QTimer(this)),
-      m_pingTimer(new QTimer(this)), m_port(K4Protocol::DEFAULT_PORT), m_useTls(false), m_encodeMode(3),
-      m_streamingLatency(3), m_state(Disconnected), m_authResponseReceived(false) {
-    // Socket signals
-    connect(m_socket, &QSslSocket::connected, this, &TcpClient::onSocketConnected);
-    connect(m_socket, &QSslSocket::encrypted, this, &TcpClient::onSocketEncrypted);
-    connect(m_socket, &QSslSocket::disconnected, this, &TcpClient::onSocketDisconnected);
-    connect(m_socket, &QSslSocket::readyRead, this, &TcpClient::onReadyRead);
-    connect(m_socket, &QSslSocket::errorOccurred, this, &TcpClient::onSocketError);
+    : QObject(parent), m_networkThread(new QThread(this)), m_worker(new NetworkWorker()), m_state(Disconnected) {
+    m_networkThread->setObjectName("K4Network");
+    m_worker->moveToThread(m_networkThread);
 
-    // SSL-specific signals
-    connect(m_socket, &QSslSocket::sslErrors, this, &TcpClient::onSslErrors);
-    connect(m_socket, &QSslSocket::preSharedKeyAuthenticationRequired, this,
-            &TcpClient::onPreSharedKeyAuthenticationRequired);
+    // Worker signals arrive queued on the GUI thread
+    connect(m_worker, &NetworkWorker::stateChanged, this, &TcpClient::onWorkerStateChanged);
+    connect(m_worker, &NetworkWorker::errorOccurred, this, &TcpClient::errorOccurred);
+    connect(m_worker, &NetworkWorker::authenticated, this, &TcpClient::authenticated);
+    connect(m_worker, &NetworkWorker::authenticationFailed, this, &TcpClient::authenticationFailed);
+    connect(m_worker, &NetworkWorker::incomingReady, this, &TcpClient::onIncomingReady);
 
-    // Auth timeout timer (single shot)
-    m_authTimer->setSingleShot(true);
-    connect(m_authTimer, &QTimer::timeout, this, &TcpClient::onAuthTimeout);
+    // Clean up worker when thread finishes
+    connect(m_networkThread, &QThread::finished, m_worker, &QObject::deleteLater);
 
-    // Ping timer for keep-alive
-    m_pingTimer->setInterval(K4Protocol::PING_INTERVAL_MS);
-    connect(m_pingTimer, &QTimer::timeout, this, &TcpClient::onPingTimer);
-
-    // Protocol signals - any packet means auth succeeded
-    connect(m_protocol, &Protocol::packetReceived, this, [this](quint8 type, const QByteArray &payload) {
-        Q_UNUSED(payload)
-        if (m_state == Authenticating && !m_authResponseReceived) {
-            m_authResponseReceived = true;
-            m_authTimer->stop();
-            qDebug() << "Authentication successful, received packet type:" << type;
-            setState(Connected);
-            emit authenticated();
-            startPingTimer();
-
-            // Send initialization sequence
-            // RDY triggers comprehensive state dump containing all radio state:
-            // FA, FB, MD, MD$, BW, BW$, IS, CW, KS, PC, SD (per mode), SQ, RG, SQ$, RG$,
-            // #SPN, #REF, VXC, VXV, VXD, and all menu definitions (MEDF)
-            sendCAT(K4Protocol::Commands::READY);              // Triggers comprehensive state dump
-            sendCAT(K4Protocol::Commands::ENABLE_K4_MODE);     // Enable advanced K4 protocol mode
-            sendCAT(K4Protocol::Commands::ENABLE_LONG_ERRORS); // Request long format error messages
-            // Set audio encode mode (0=RAW32, 1=RAW16, 2=Opus Int, 3=Opus Float)
-            qDebug() << "Sending:" << QString("EM%1;").arg(m_encodeMode);
-            sendCAT(QString("EM%1;").arg(m_encodeMode));
-            // Set streaming audio latency (0-7, higher values for high-latency connections)
-            qDebug() << "Sending:" << QString("SL%1;").arg(m_streamingLatency);
-            sendCAT(QString("SL%1;").arg(m_streamingLatency));
-        }
-    });
-    connect(m_protocol, &Protocol::catResponseReceived, this, &TcpClient::onCatResponse);
+    // Audio decode runs on this thread, so keep it ahead of normal GUI work
+    m_networkThread->start(QThread::HighPriority);
 }
 
 TcpClient::~TcpClient() {
-    stopPingTimer();
-    if (m_socket->state() != QAbstractSocket::UnconnectedState) {
-        m_socket->abort();
-    }
+    QMetaObject::invokeMethod(m_worker, &NetworkWorker::shutdown, Qt::BlockingQueuedConnection);
+    m_networkThread->quit();
+    m_networkThread->wait();
 }
 
 void TcpClient::connectToHost(const QString &host, quint16 port, const QString &password, bool useTls,
                               const QString &identity, int encodeMode, int streamingLatency) {
-    if (m_state != Disconnected) {
-        disconnectFromHost();
-    }
-
-    m_host = host;
-    m_port = port;
-    m_password = password; // Also used as PSK when TLS enabled
-    m_useTls = useTls;
-    m_identity = identity;                 // TLS-PSK identity (optional)
-    m_encodeMode = encodeMode;             // Audio encode mode (0=RAW32, 1=RAW16, 2=Opus Int, 3=Opus Float)
-    m_streamingLatency = streamingLatency; // Remote streaming audio latency (0-7)
-    m_authResponseReceived = false;
-
-    setState(Connecting);
-
-    if (m_useTls) {
-        // Log OpenSSL version Qt is using
-        qDebug() << "=== SSL Library Info ===";
-        qDebug() << "  Build version:" << QSslSocket::sslLibraryBuildVersionString();
-        qDebug() << "  Runtime version:" << QSslSocket::sslLibraryVersionString();
-        qDebug() << "  Supports SSL:" << QSslSocket::supportsSsl();
-
-        // Configure TLS for PSK authentication - require TLS 1.2 minimum
-        QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
-        sslConfig.setProtocol(QSsl::TlsV1_2OrLater);
-        sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone); // PSK doesn't use certificates
-
-        // Filter to only TLS 1.2+ PSK ciphers
-        QList<QSslCipher> tls12PskCiphers;
-        qDebug() << "=== Available PSK Ciphers ===";
-        for (const QSslCipher &cipher : QSslConfiguration::supportedCiphers()) {
-            if (cipher.name().contains("PSK")) {
-                qDebug() << "  " << cipher.name() << "(" << cipher.protocolString() << ")";
-                // Only include TLS 1.2+ ciphers
-                if (cipher.protocol() == QSsl::TlsV1_2 || cipher.protocol() == QSsl::TlsV1_3) {
-                    tls12PskCiphers.append(cipher);
-                }
-            }
-        }
-        qDebug() << "=== Offering" << tls12PskCiphers.size() << "TLS 1.2+ PSK ciphers ===";
-        for (const QSslCipher &cipher : tls12PskCiphers) {
-            qDebug() << "  " << cipher.name();
-        }
-        if (!tls12PskCiphers.isEmpty()) {
-            sslConfig.setCiphers(tls12PskCiphers);
-        }
-
-        m_socket->setSslConfiguration(sslConfig);
-
-        qDebug() << "Connecting with TLS/PSK to" << host << ":" << port;
-        m_socket->connectToHostEncrypted(host, port);
-    } else {
-        qDebug() << "Connecting (unencrypted) to" << host << ":" << port;
-        m_socket->connectToHost(host, port);
-    }
+    QMetaObject::invokeMethod(m_worker, [=, worker = m_worker]() {
+        worker->connectToHost(host, port, password, useTls, identity, encodeMode, streamingLatency);
+    });
 }
 
 void TcpClient::disconnectFromHost() {
-    stopPingTimer();
-    m_authTimer->stop();
-
-    if (m_socket->state() != QAbstractSocket::UnconnectedState) {
-        // Send graceful disconnect command
-        if (m_state == Connected) {
-            sendCAT(K4Protocol::Commands::DISCONNECT);
-        }
-        m_socket->disconnectFromHost();
-    }
-
-    setState(Disconnected);
+    flushCAT(); // Commands sent before disconnecting still go out
+    QMetaObject::invokeMethod(m_worker, &NetworkWorker::disconnectFromHost);
 }
 
 bool TcpClient::isConnected() const {
-    return m_state == Connected;
+    return m_worker->connectionState() == Connected;
 }
 
 TcpClient::ConnectionState TcpClient::connectionState() const {
-    return m_state;
+    return m_worker->connectionState();
+}
+
+bool TcpClient::isUsingTls() const {
+    return m_worker->isUsingTls();
 }
 
 void TcpClient::sendCAT(const QString &command) {
-    if (m_state == Connected) {
-        QByteArray packet = Protocol::buildCATPacket(command);
-        m_socket->write(packet);
-        m_socket->flush(); // Ensure immediate send
+    if (isConnected()) {
+        // The first command of a turn schedules the flush; the rest join it
+        const bool scheduled = !m_catQueue.isEmpty();
+        m_catQueue.append(command);
+        if (!scheduled)
+            QMetaObject::invokeMethod(this, &TcpClient::flushCAT, Qt::QueuedConnection);
     }
 }
 
+void TcpClient::flushCAT() {
+    if (m_catQueue.isEmpty())
+        return;
+    QMetaObject::invokeMethod(m_worker,
+                              [worker = m_worker, commands = m_catQueue.take()]() { worker->sendCAT(commands); });
+}
+
 void TcpClient::sendRaw(const QByteArray &data) {
-    if (m_socket->state() == QAbstractSocket::ConnectedState) {
-        m_socket->write(data);
-    }
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, data]() { worker->sendRaw(data); });
+}
+
+void TcpClient::setTransmitting(bool transmitting) {
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, transmitting]() { worker->setTransmitting(transmitting); });
 }
 
-void TcpClient::setState(ConnectionState state) {
+void TcpClient::setAudioEngine(AudioEngine *engine) {
+    // The worker reads this pointer on the network thread; set it there to avoid a data race
+    QMetaObject::invokeMethod(
+        m_worker, [worker = m_worker, engine]() { worker->setAudioEngine(engine); }, Qt::BlockingQueuedConnection);
+}
+
+void TcpClient::onWorkerStateChanged(TcpClient::ConnectionState state) {
     if (m_state != state) {
         m_state = state;
         emit stateChanged(state);
@@ -169,128 +90,28 @@ void TcpClient::setState(ConnectionState state) {
         if (state == Connected) {
             emit connected();
         } else if (state == Disconnected) {
+            m_catQueue.clear();
             emit disconnected();
         }
     }
 }
 
-void TcpClient::onSocketConnected() {
-    if (m_useTls) {
-        // TLS connection: TCP connected, now waiting for TLS handshake to complete
-        // The encrypted() signal will fire when TLS is fully established
-        qDebug() << "TCP connected, starting TLS handshake...";
-        // Don't change state yet - wait for encrypted() signal
-    } else {
-        // Non-TLS: need to send SHA-384 password hash
-        qDebug() << "Socket connected, sending authentication...";
-        setState(Authenticating);
-        sendAuthentication();
-        m_authTimer->start(K4Protocol::AUTH_TIMEOUT_MS);
-    }
-}
-
-void TcpClient::onSocketEncrypted() {
-    // TLS handshake completed successfully
-    QSslCipher negotiated = m_socket->sessionCipher();
-    qDebug() << "=== TLS/PSK Connection Established ===";
-    qDebug() << "  Negotiated cipher:" << negotiated.name();
-    qDebug() << "  Protocol:" << negotiated.protocolString();
-    qDebug() << "  Key exchange:" << negotiated.keyExchangeMethod();
-    qDebug() << "  Encryption:" << negotiated.encryptionMethod();
-    setState(Authenticating);
-    // Start auth timeout - waiting for first packet to confirm connection works
-    m_authTimer->start(K4Protocol::AUTH_TIMEOUT_MS);
-    // Note: For TLS/PSK, no additional password auth needed - data flows immediately
-}
-
-void TcpClient::onSocketDisconnected() {
-    qDebug() << "Socket disconnected";
-    stopPingTimer();
-    m_authTimer->stop();
+void TcpClient::onIncomingReady() {
+    m_worker->beginDrain();
 
-    if (m_state == Authenticating && !m_authResponseReceived) {
-        emit authenticationFailed();
-        emit errorOccurred("Authentication failed - connection closed by radio");
+    // Everything queued since the last wake-up is delivered in one pass
+    QByteArray response;
+    while (m_worker->popCatResponse(response)) {
+        emit catResponseReceived(response);
     }
 
-    setState(Disconnected);
-}
-
-void TcpClient::onReadyRead() {
-    QByteArray data = m_socket->readAll();
-    m_protocol->parse(data);
-}
-
-void TcpClient::onSocketError(QAbstractSocket::SocketError error) {
-    Q_UNUSED(error)
-    stopPingTimer();
-    m_authTimer->stop();
-
-    QString errorMsg = m_socket->errorString();
-    qDebug() << "Socket error:" << errorMsg;
-
-    if (m_state == Authenticating) {
-        emit authenticationFailed();
-    }
-
-    emit errorOccurred(errorMsg);
-    setState(Disconnected);
-}
-
-void TcpClient::onSslErrors(const QList<QSslError> &errors) {
-    // Log SSL errors but continue - PSK doesn't use certificates so some errors are expected
-    for (const QSslError &error : errors) {
-        qDebug() << "SSL error (ignored for PSK):" << error.errorString();
-    }
-    // Ignore all SSL errors for PSK connections (no certificate verification)
-    m_socket->ignoreSslErrors();
-}
-
-void TcpClient::onPreSharedKeyAuthenticationRequired(QSslPreSharedKeyAuthenticator *authenticator) {
-    qDebug() << "PSK authentication requested, identity hint:" << authenticator->identityHint();
-
-    // Set the identity (empty or user-specified) and the pre-shared key (password field)
-    authenticator->setIdentity(m_identity.toUtf8());
-    authenticator->setPreSharedKey(m_password.toUtf8());
-
-    qDebug() << "PSK credentials provided, identity:" << (m_identity.isEmpty() ? "(empty)" : m_identity);
-}
-
-void TcpClient::onAuthTimeout() {
-    if (m_state == Authenticating && !m_authResponseReceived) {
-        qDebug() << "Authentication timeout";
-        emit authenticationFailed();
-        emit errorOccurred("Authentication timeout - no response from radio");
-        disconnectFromHost();
-    }
-}
-
-void TcpClient::onPingTimer() {
-    if (m_state == Connected) {
-        sendCAT(K4Protocol::Commands::PING);
+    NetworkWorker::SpectrumFrame frame;
+    while (m_worker->popSpectrumFrame(frame)) {
+        if (frame.mini) {
+            emit miniSpectrumDataReady(frame.receiver, frame.bins);
+        } else {
+            emit spectrumDataReady(frame.receiver, frame.bins, frame.centerFreq, frame.sampleRate, frame.noiseFloor);
+        }
     }
-}
-
-void TcpClient::onCatResponse(const QString &response) {
-    Q_UNUSED(response);
-    // Verbose logging removed for performance
-}
-
-void TcpClient::sendAuthentication() {
-    // Build SHA-384 hash of password as hex string
-    QByteArray authData = Protocol::buildAuthData(m_password);
-    qDebug() << "Sending auth hash (" << authData.size() << "bytes)";
-
-    // Send raw auth data (not wrapped in K4 packet - just the hex string)
-    m_socket->write(authData);
-    m_socket->flush();
-    // Radio will respond with packets, which triggers auth success and init sequence
-}
-
-void TcpClient::startPingTimer() {
-    m_pingTimer->start();
-}
-
-void TcpClient::stopPingTimer() {
-    m_pingTimer->stop();
+    m_worker->endDrain();
 }
@@ -2,10 +2,24 @@
 #define TCPCLIENT_H
 
 #include <QObject>
-#include <QSslSocket>
-#include <QTimer>
+#include <QThread>
+#include "catcommandqueue.h"
 #include "protocol.h"
 
+class AudioEngine;
+class NetworkWorker;
+
+/**
+ * @brief GUI-thread facade for the K4 connection
+ *
+ * The socket, TLS, framing and packet demux run in a NetworkWorker on a dedicated
+ * network thread, so a busy GUI thread can never delay reads. Audio is decoded on
+ * that thread and handed straight to AudioEngine; CAT responses and spectrum frames
+ * are queued lock-free and delivered here in batches, one wake-up per batch.
+ *
+ * Outgoing CAT commands are collected for the rest of the current event-loop turn and sent as one
+ * packet, with superseded setting writes dropped (see CatCommandQueue).
+ */
 class TcpClient : public QObject {
     Q_OBJECT
 
@@ -21,12 +35,18 @@ public:
     void disconnectFromHost();
     bool isConnected() const;
     ConnectionState connectionState() const;
-    bool isUsingTls() const { return m_useTls; }
+    bool isUsingTls() const;
 
+    // Queued until the event loop turns; commands sent in the same turn share one packet
     void sendCAT(const QString &command);
     void sendRaw(const QByteArray &data);
 
-    Protocol *protocol() { return m_protocol; }
+    // PTT state for TX audio: while on, microphone frames are encoded and sent on the
+    // network thread (see TxAudioPipeline); turning it on restarts the packet sequence
+    void setTransmitting(bool transmitting);
+
+    // Decoded RX audio is pushed into this engine directly from the network thread
+    void setAudioEngine(AudioEngine *engine);
 
 signals:
     void stateChanged(ConnectionState state);
@@ -36,38 +56,23 @@ signals:
     void authenticated();
     void authenticationFailed();
 
+    // Incoming data, delivered on the GUI thread
+    void catResponseReceived(const QByteArray &response);
+    // receiver: 0 = Main (VFO A), 1 = Sub (VFO B)
+    void spectrumDataReady(int receiver, const QByteArray &spectrumData, qint64 centerFreq, qint32 sampleRate,
+                           float noiseFloor);
+    void miniSpectrumDataReady(int receiver, const QByteArray &spectrumData);
+
 private slots:
-    void onSocketConnected();
-    void onSocketEncrypted();
-    void onSocketDisconnected();
-    void onReadyRead();
-    void onSocketError(QAbstractSocket::SocketError error);
-    void onSslErrors(const QList<QSslError> &errors);
-    void onPreSharedKeyAuthenticationRequired(QSslPreSharedKeyAuthenticator *authenticator);
-    void onAuthTimeout();
-    void onPingTimer();
-    void onCatResponse(const QString &response);
+    void onWorkerStateChanged(TcpClient::ConnectionState state);
+    void onIncomingReady();
+    void flushCAT();
 
 private:
-    void setState(ConnectionState state);
-    void sendAuthentication();
-    void startPingTimer();
-    void stopPingTimer();
-
-    QSslSocket *m_socket;
-    Protocol *m_protocol;
-    QTimer *m_authTimer;
-    QTimer *m_pingTimer;
-
-    QString m_host;
-    quint16 m_port;
-    QString m_password; // Also used as PSK when TLS enabled
-    bool m_useTls;
-    QString m_identity;     // TLS-PSK identity (optional)
-    int m_encodeMode;       // Audio encode mode (0-3)
-    int m_streamingLatency; // Remote streaming audio latency (0-7)
-    ConnectionState m_state;
-    bool m_authResponseReceived;
+    QThread *m_networkThread;
+    NetworkWorker *m_worker;
+    ConnectionState m_state; // Last state re-emitted on the GUI thread
+    CatCommandQueue m_catQueue;
 };
 
 #endif // TCPCLIENT_H
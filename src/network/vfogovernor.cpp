@@ -0,0 +1,97 @@
+#include "vfogovernor.h"
+#include <QtGlobal>
+
+namespace {
+// An in-flight value the radio has not reported back after this many round trips (and at least
+// ECHO_TIMEOUT_MIN_MS, while the estimate is still settling) is dropped: without auto-info the K4
+// doesn't echo FA/FB writes at all
+constexpr int ECHO_TIMEOUT_RTTS = 4;
+constexpr int ECHO_TIMEOUT_MIN_MS = 1000;
+} // namespace
+
+bool VfoGovernor::request(Vfo vfo, quint64 freq, qint64 nowMs) {
+    State &state = m_vfo[vfo];
+    if (!state.sentBefore || nowMs - state.lastSendMs >= sendIntervalMs()) {
+        state.held = 0;
+        markSent(state, freq, nowMs);
+        return true;
+    }
+    state.held = freq; // Latest wins
+    return false;
+}
+
+void VfoGovernor::sendNow(Vfo vfo, quint64 freq, qint64 nowMs) {
+    State &state = m_vfo[vfo];
+    state.held = 0;
+    markSent(state, freq, nowMs);
+}
+
+QVector<QPair<VfoGovernor::Vfo, quint64>> VfoGovernor::takeDue(qint64 nowMs) {
+    QVector<QPair<Vfo, quint64>> due;
+    for (int i = 0; i < 2; ++i) {
+        State &state = m_vfo[i];
+        if (state.held && nowMs - state.lastSendMs >= sendIntervalMs()) {
+            due.append(qMakePair(Vfo(i), state.held));
+            markSent(state, state.held, nowMs);
+            state.held = 0;
+        }
+    }
+    return due;
+}
+
+qint64 VfoGovernor::msUntilDue(qint64 nowMs) const {
+    qint64 wait = -1;
+    for (const State &state : m_vfo) {
+        if (!state.held)
+            continue;
+        const qint64 left = qMax<qint64>(state.lastSendMs + sendIntervalMs() - nowMs, 0);
+        wait = wait < 0 ? left : qMin(wait, left);
+    }
+    return wait;
+}
+
+bool VfoGovernor::acceptEcho(Vfo vfo, quint64 freq, qint64 nowMs) {
+    State &state = m_vfo[vfo];
+    expire(state, nowMs);
+
+    int match = -1;
+    for (int i = int(state.inFlight.size()) - 1; i >= 0; --i) {
+        if (state.inFlight[i].freq == freq) {
+            match = i;
+            break;
+        }
+    }
+    if (match < 0) {
+        // Not ours: tuned at the radio (or by another client), which overrides what we still expect
+        state.inFlight.clear();
+        state.held = 0;
+        return true;
+    }
+
+    // Smoothed like TCP's SRTT (1/8 gain)
+    const int sample = int(qBound<qint64>(MIN_RTT_MS, nowMs - state.inFlight[match].timeMs, MAX_RTT_MS));
+    m_rttMs = qBound(MIN_RTT_MS, m_rttMs + (sample - m_rttMs) / 8, MAX_RTT_MS);
+
+    state.inFlight.remove(0, match + 1);
+    return state.inFlight.isEmpty() && !state.held;
+}
+
+void VfoGovernor::clear() {
+    for (State &state : m_vfo)
+        state = State();
+}
+
+void VfoGovernor::markSent(State &state, quint64 freq, qint64 nowMs) {
+    expire(state, nowMs);
+    state.inFlight.append(Sent{freq, nowMs});
+    state.lastSendMs = nowMs;
+    state.sentBefore = true;
+}
+
+void VfoGovernor::expire(State &state, qint64 nowMs) {
+    const qint64 timeout = qMax<qint64>(qint64(m_rttMs) * ECHO_TIMEOUT_RTTS, ECHO_TIMEOUT_MIN_MS);
+    int stale = 0;
+    while (stale < state.inFlight.size() && nowMs - state.inFlight[stale].timeMs > timeout)
+        ++stale;
+    state.inFlight.remove(0, stale);
+}
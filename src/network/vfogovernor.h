@@ -0,0 +1,74 @@
+#ifndef VFOGOVERNOR_H
+#define VFOGOVERNOR_H
+
+#include <QPair>
+#include <QVector>
+
+/**
+ * @brief Rate limiter and echo filter for VFO frequency commands (FA/FB)
+ *
+ * Tuning sources (KPOD, mouse wheel, panadapter drags) produce a new frequency per event. The GUI
+ * applies each one to RadioState at once; the governor decides which ones go to the radio: at most
+ * MAX_SENDS_PER_RTT per round trip per VFO, spaced evenly, and a value that arrives too early is held
+ * and replaced by later ones, so the radio always ends up on the latest frequency.
+ *
+ * Every value sent is remembered until the radio reports it back. When a report matches one of
+ * them, the older ones are dropped and the round trip is sampled. The report is stale - and must not
+ * overwrite the optimistic local value - when a newer value has already been sent or is held. A
+ * report of a value the governor never sent is a change made at the radio: it always applies and
+ * drops anything still held.
+ *
+ * Times are milliseconds from any monotonic clock, passed in by the caller.
+ */
+class VfoGovernor {
+public:
+    enum Vfo { VfoA = 0, VfoB = 1 };
+
+    static constexpr int MAX_SENDS_PER_RTT = 2;
+    static constexpr int DEFAULT_RTT_MS = 100; // Until the first echo is measured
+    static constexpr int MIN_RTT_MS = 10;
+    static constexpr int MAX_RTT_MS = 1000;
+
+    // True if freq should be sent now (it is then recorded as sent); false if it is held for takeDue()
+    bool request(Vfo vfo, quint64 freq, qint64 nowMs);
+
+    // Record freq as sent now regardless of the rate limit (click-to-tune, typed entry); drops the held value
+    void sendNow(Vfo vfo, quint64 freq, qint64 nowMs);
+
+    // Held values whose send window has opened, recorded as sent
+    QVector<QPair<Vfo, quint64>> takeDue(qint64 nowMs);
+
+    // Milliseconds until takeDue() has something to return, -1 if nothing is held
+    qint64 msUntilDue(qint64 nowMs) const;
+
+    // A frequency reported by the radio: true to apply it to RadioState, false if it is stale
+    bool acceptEcho(Vfo vfo, quint64 freq, qint64 nowMs);
+
+    // Smoothed round trip of FA/FB commands in milliseconds
+    int rttMs() const { return m_rttMs; }
+
+    // Forget held and in-flight values (on disconnect); the round-trip estimate is kept
+    void clear();
+
+private:
+    struct Sent {
+        quint64 freq;
+        qint64 timeMs;
+    };
+
+    struct State {
+        QVector<Sent> inFlight; // Oldest first
+        quint64 held = 0;       // 0 = nothing held
+        qint64 lastSendMs = 0;
+        bool sentBefore = false;
+    };
+
+    qint64 sendIntervalMs() const { return m_rttMs / MAX_SENDS_PER_RTT; }
+    void markSent(State &state, quint64 freq, qint64 nowMs);
+    void expire(State &state, qint64 nowMs);
+
+    State m_vfo[2];
+    int m_rttMs = DEFAULT_RTT_MS;
+};
+
+#endif // VFOGOVERNOR_H
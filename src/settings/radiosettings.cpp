@@ -230,6 +230,18 @@ void RadioSettings::setCatServerPort(quint16 port) {
     }
 }
 
+QString RadioSettings::catServerBindAddress() const {
+    return m_catServerBindAddress;
+}
+
+void RadioSettings::setCatServerBindAddress(const QString &address) {
+    if (m_catServerBindAddress != address) {
+        m_catServerBindAddress = address;
+        save();
+        emit catServerBindAddressChanged(address);
+    }
+}
+
 QMap<QString, MacroEntry> RadioSettings::macros() const {
     return m_macros;
 }
@@ -397,6 +409,7 @@ void RadioSettings::load() {
     // CAT Server settings (migrate from old rigctld keys if present)
     m_catServerEnabled = m_settings.value("catServer/enabled", m_settings.value("rigctld/enabled", false)).toBool();
     m_catServerPort = m_settings.value("catServer/port", m_settings.value("rigctld/port", 9299)).toUInt();
+    m_catServerBindAddress = m_settings.value("catServer/bindAddress", "127.0.0.1").toString();
 
     // HaliKey settings
     m_halikeyPortName = m_settings.value("halikey/portName", "").toString();
@@ -484,6 +497,7 @@ void RadioSettings::save() {
     // CAT Server settings
     m_settings.setValue("catServer/enabled", m_catServerEnabled);
     m_settings.setValue("catServer/port", m_catServerPort);
+    m_settings.setValue("catServer/bindAddress", m_catServerBindAddress);
 
     // HaliKey settings
     m_settings.setValue("halikey/portName", m_halikeyPortName);
@@ -97,6 +97,8 @@ public:
     void setCatServerEnabled(bool enabled);
     quint16 catServerPort() const;
     void setCatServerPort(quint16 port);
+    QString catServerBindAddress() const; // "127.0.0.1" = this computer only, "0.0.0.0" = all interfaces
+    void setCatServerBindAddress(const QString &address);
 
     // Macro settings
     QMap<QString, MacroEntry> macros() const;
@@ -135,6 +137,7 @@ signals:
     void speakerDeviceChanged(const QString &deviceId);
     void catServerEnabledChanged(bool enabled);
     void catServerPortChanged(quint16 port);
+    void catServerBindAddressChanged(const QString &address);
     void macrosChanged();
     void halikeyEnabledChanged(bool enabled);
     void halikeyPortNameChanged(const QString &portName);
@@ -161,6 +164,7 @@ private:
     // CAT Server settings
     bool m_catServerEnabled = false;
     quint16 m_catServerPort = 9299;
+    QString m_catServerBindAddress = "127.0.0.1";
 
     // HaliKey settings
     QString m_halikeyPortName;
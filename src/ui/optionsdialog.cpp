@@ -18,6 +18,7 @@
 #include <QComboBox>
 #include <QSlider>
 #include <QPushButton>
+#include <QHostAddress>
 
 // Use K4Styles::Colors::DialogBorder for dialog-specific borders
 
@@ -26,7 +27,8 @@ OptionsDialog::OptionsDialog(RadioState *radioState, AudioEngine *audioEngine, K
     : QDialog(parent), m_radioState(radioState), m_audioEngine(audioEngine), m_kpodDevice(kpodDevice),
       m_catServer(catServer), m_halikeyDevice(halikeyDevice), m_micDeviceCombo(nullptr), m_micGainSlider(nullptr),
       m_micGainValueLabel(nullptr), m_micTestBtn(nullptr), m_micMeter(nullptr), m_speakerDeviceCombo(nullptr),
-      m_catServerEnableCheckbox(nullptr), m_catServerPortEdit(nullptr), m_catServerStatusLabel(nullptr),
+      m_catServerEnableCheckbox(nullptr), m_catServerPortEdit(nullptr), m_catServerAddressEdit(nullptr),
+      m_catServerStatusLabel(nullptr),
       m_catServerClientsLabel(nullptr), m_cwKeyerDeviceTypeCombo(nullptr), m_cwKeyerDescLabel(nullptr),
       m_cwKeyerPortCombo(nullptr), m_cwKeyerRefreshBtn(nullptr), m_cwKeyerConnectBtn(nullptr),
       m_cwKeyerStatusLabel(nullptr) {
@@ -887,17 +889,19 @@ QWidget *OptionsDialog::createRigControlPage() {
                                  .arg(K4Styles::Dimensions::FontSizePopup));
     portLabel->setFixedWidth(K4Styles::Dimensions::FormLabelWidth);
 
+    const QString lineEditStyle = QString("QLineEdit { background-color: %1; color: %2; border: 1px solid %3; "
+                                          "           padding: %6px; font-size: %5px; border-radius: %7px; }"
+                                          "QLineEdit:focus { border-color: %4; }")
+                                      .arg(K4Styles::Colors::DarkBackground, K4Styles::Colors::TextWhite,
+                                           K4Styles::Colors::DialogBorder, K4Styles::Colors::AccentAmber)
+                                      .arg(K4Styles::Dimensions::FontSizePopup)
+                                      .arg(K4Styles::Dimensions::PaddingSmall)
+                                      .arg(K4Styles::Dimensions::SliderBorderRadius);
+
     m_catServerPortEdit = new QLineEdit(page);
     m_catServerPortEdit->setPlaceholderText("9299");
     m_catServerPortEdit->setFixedWidth(K4Styles::Dimensions::InputFieldWidthSmall);
-    m_catServerPortEdit->setStyleSheet(QString("QLineEdit { background-color: %1; color: %2; border: 1px solid %3; "
-                                               "           padding: %6px; font-size: %5px; border-radius: %7px; }"
-                                               "QLineEdit:focus { border-color: %4; }")
-                                           .arg(K4Styles::Colors::DarkBackground, K4Styles::Colors::TextWhite,
-                                                K4Styles::Colors::DialogBorder, K4Styles::Colors::AccentAmber)
-                                           .arg(K4Styles::Dimensions::FontSizePopup)
-                                           .arg(K4Styles::Dimensions::PaddingSmall)
-                                           .arg(K4Styles::Dimensions::SliderBorderRadius));
+    m_catServerPortEdit->setStyleSheet(lineEditStyle);
     m_catServerPortEdit->setText(QString::number(RadioSettings::instance()->catServerPort()));
 
     auto *portHint = new QLabel("(default: 9299)", page);
@@ -911,6 +915,31 @@ QWidget *OptionsDialog::createRigControlPage() {
     portLayout->addStretch();
     layout->addLayout(portLayout);
 
+    // Bind address input
+    auto *addressLayout = new QHBoxLayout();
+    auto *addressLabel = new QLabel("Address:", page);
+    addressLabel->setStyleSheet(QString("color: %1; font-size: %2px;")
+                                    .arg(K4Styles::Colors::TextGray)
+                                    .arg(K4Styles::Dimensions::FontSizePopup));
+    addressLabel->setFixedWidth(K4Styles::Dimensions::FormLabelWidth);
+
+    m_catServerAddressEdit = new QLineEdit(page);
+    m_catServerAddressEdit->setPlaceholderText("127.0.0.1");
+    m_catServerAddressEdit->setFixedWidth(K4Styles::Dimensions::InputFieldWidthMedium);
+    m_catServerAddressEdit->setStyleSheet(lineEditStyle);
+    m_catServerAddressEdit->setText(RadioSettings::instance()->catServerBindAddress());
+
+    auto *addressHint = new QLabel("(127.0.0.1: this computer only, 0.0.0.0: all networks)", page);
+    addressHint->setStyleSheet(QString("color: %1; font-size: %2px;")
+                                   .arg(K4Styles::Colors::TextGray)
+                                   .arg(K4Styles::Dimensions::FontSizeLarge));
+
+    addressLayout->addWidget(addressLabel);
+    addressLayout->addWidget(m_catServerAddressEdit);
+    addressLayout->addWidget(addressHint);
+    addressLayout->addStretch();
+    layout->addLayout(addressLayout);
+
     // Separator line
     auto *line3 = new QFrame(page);
     line3->setFrameShape(QFrame::HLine);
@@ -930,7 +959,8 @@ QWidget *OptionsDialog::createRigControlPage() {
     layout->addWidget(m_catServerEnableCheckbox);
 
     // Help text
-    auto *helpLabel = new QLabel("Configure external apps to use Elecraft K4, host 127.0.0.1, and the port above. "
+    auto *helpLabel = new QLabel("Configure external apps to use Elecraft K4, host 127.0.0.1 (or this computer's "
+                                 "address when listening on the network), and the port above. "
                                  "Commands are forwarded to the real K4.",
                                  page);
     helpLabel->setStyleSheet(QString("color: %1; font-size: %2px; font-style: italic;")
@@ -951,6 +981,16 @@ QWidget *OptionsDialog::createRigControlPage() {
         }
     });
 
+    connect(m_catServerAddressEdit, &QLineEdit::editingFinished, this, [this]() {
+        const QString address = m_catServerAddressEdit->text().trimmed();
+        if (!QHostAddress(address).isNull()) {
+            RadioSettings::instance()->setCatServerBindAddress(address);
+        } else {
+            // Reset to current value if invalid
+            m_catServerAddressEdit->setText(RadioSettings::instance()->catServerBindAddress());
+        }
+    });
+
     connect(m_catServerEnableCheckbox, &QCheckBox::toggled, this,
             [](bool checked) { RadioSettings::instance()->setCatServerEnabled(checked); });
 
@@ -970,7 +1010,8 @@ void OptionsDialog::updateCatServerStatus() {
     bool isListening = m_catServer && m_catServer->isListening();
 
     if (isListening) {
-        m_catServerStatusLabel->setText(QString("Listening on port %1").arg(m_catServer->port()));
+        m_catServerStatusLabel->setText(
+            QString("Listening on %1:%2").arg(m_catServer->address().toString()).arg(m_catServer->port()));
         m_catServerStatusLabel->setStyleSheet(QString("color: %1; font-size: %2px; font-weight: bold;")
                                                   .arg(K4Styles::Colors::StatusGreen)
                                                   .arg(K4Styles::Dimensions::FontSizePopup));
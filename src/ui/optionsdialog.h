@@ -81,6 +81,7 @@ private:
     // CAT Server page elements
     QCheckBox *m_catServerEnableCheckbox;
     QLineEdit *m_catServerPortEdit;
+    QLineEdit *m_catServerAddressEdit;
     QLabel *m_catServerStatusLabel;
     QLabel *m_catServerClientsLabel;
 
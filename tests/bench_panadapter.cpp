@@ -0,0 +1,363 @@
+// Offscreen panadapter benchmark: renders synthetic PAN packets through PanadapterRhiWidget's
+// real pipeline into an offscreen texture and reports CPU time per frame. With a backend that
+// produces pixels (--backend gl, e.g. Mesa llvmpipe in CI) the final frame of each scenario can
+// be checked for a visible carrier (--check, independent of the rasterizer) and against golden
+// images.
+//
+//   bench_panadapter [--backend null|gl] [--frames N] [--size WxH] [--bins 512,1024,...]
+//                    [--spans 10000,50000,...] [--check] [--golden DIR] [--update-golden]
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QTextStream>
+#include <rhi/qrhi.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include "dsp/panadapter_rhi.h"
+#include "dsp/rhiresourcecache.h"
+
+static constexpr qint64 CENTER_FREQ = 14100000;
+static constexpr int RAW_NOISE_FLOOR = 26; // -120 dBm in K4 bytes (dBm + 146)
+static constexpr int GOLDEN_CHANNEL_TOLERANCE = 8;
+static constexpr double GOLDEN_PIXEL_TOLERANCE = 0.005; // Fraction of pixels allowed past the channel tolerance
+static constexpr double CARRIER_CONTRAST = 1.1; // Carrier column brightness over noise column brightness
+static constexpr int CARRIER_SEARCH_PX = 3;     // Bin-to-pixel rounding slack around the carrier
+static constexpr int EXIT_SKIPPED = 77;         // ctest SKIP_RETURN_CODE: no QRhi for the backend
+
+struct Scenario {
+    int bins;
+    int spanHz;
+    QString name() const { return QStringLiteral("panadapter_%1bins_%2hz").arg(bins).arg(spanHz); }
+};
+
+struct PhaseStats {
+    QVector<qint64> samples;
+
+    void add(qint64 ns) { samples.append(ns); }
+    double meanUs() const {
+        if (samples.isEmpty())
+            return 0.0;
+        qint64 total = 0;
+        for (qint64 ns : samples)
+            total += ns;
+        return total / 1000.0 / samples.size();
+    }
+    double percentileUs(double p) {
+        if (samples.isEmpty())
+            return 0.0;
+        std::sort(samples.begin(), samples.end());
+        return samples[std::min(int(samples.size()) - 1, int(p * samples.size()))] / 1000.0;
+    }
+};
+
+// K4 tiers: the smallest sample rate (kHz) whose span covers the requested one
+static qint32 sampleRateFor(int spanHz) {
+    for (qint32 rate : {12, 24, 48, 96, 192, 384})
+        if (rate * 1000 >= spanHz)
+            return rate;
+    return 384;
+}
+
+// Deterministic packet: noise floor with a few steady carriers and one that drifts per frame
+static QByteArray makePacket(int bins, int frame, std::mt19937 &noise) {
+    std::uniform_int_distribution<int> jitter(-4, 4);
+    QByteArray packet(bins, Qt::Uninitialized);
+    for (int i = 0; i < bins; ++i)
+        packet[i] = static_cast<char>(RAW_NOISE_FLOOR + jitter(noise));
+
+    auto carrier = [&](int center, int width, int raw) {
+        for (int i = std::max(0, center - width); i < std::min(bins, center + width + 1); ++i)
+            packet[i] = static_cast<char>(std::max<int>(quint8(packet[i]), raw - 6 * std::abs(i - center)));
+    };
+    carrier(bins / 2, 2, 86);
+    carrier(bins / 3, 1, 70);
+    carrier(bins * 3 / 4, 4, 60);
+    carrier((bins / 8 + frame) % bins, 1, 76);
+    return packet;
+}
+
+class OffscreenTarget {
+public:
+    bool create(QRhi::Implementation backend, const QSize &size) {
+        if (backend == QRhi::OpenGLES2) {
+            m_surface.reset(QRhiGles2InitParams::newFallbackSurface());
+            QRhiGles2InitParams params;
+            params.fallbackSurface = m_surface.get();
+            m_rhi.reset(QRhi::create(QRhi::OpenGLES2, &params));
+        } else {
+            QRhiNullInitParams params;
+            m_rhi.reset(QRhi::create(QRhi::Null, &params));
+        }
+        if (!m_rhi)
+            return false;
+
+        m_texture.reset(
+            m_rhi->newTexture(QRhiTexture::RGBA8, size, 1,
+                              QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+        m_texture->create();
+        m_target.reset(m_rhi->newTextureRenderTarget({m_texture.get()}));
+        m_rpDesc.reset(m_target->newCompatibleRenderPassDescriptor());
+        m_target->setRenderPassDescriptor(m_rpDesc.get());
+        m_target->create();
+        return true;
+    }
+
+    QRhi *rhi() const { return m_rhi.get(); }
+    QRhiRenderTarget *target() const { return m_target.get(); }
+
+    // Record the frame's commands; returns false if the backend couldn't start a frame
+    template <typename Record> bool frame(Record record) {
+        QRhiCommandBuffer *cb = nullptr;
+        if (m_rhi->beginOffscreenFrame(&cb) != QRhi::FrameOpSuccess)
+            return false;
+        record(cb);
+        m_rhi->endOffscreenFrame();
+        return true;
+    }
+
+    // Read the target back (offscreen frames complete synchronously)
+    QImage grab() {
+        QRhiReadbackResult result;
+        frame([&](QRhiCommandBuffer *cb) {
+            QRhiResourceUpdateBatch *rub = m_rhi->nextResourceUpdateBatch();
+            rub->readBackTexture(QRhiReadbackDescription(m_texture.get()), &result);
+            cb->resourceUpdate(rub);
+        });
+        QImage image(reinterpret_cast<const uchar *>(result.data.constData()), result.pixelSize.width(),
+                     result.pixelSize.height(), QImage::Format_RGBA8888);
+        image = image.copy(); // Detach from the readback buffer
+        return m_rhi->isYUpInFramebuffer() ? image.mirrored() : image;
+    }
+
+private:
+    std::unique_ptr<QOffscreenSurface> m_surface;
+    std::unique_ptr<QRhi> m_rhi;
+    std::unique_ptr<QRhiTexture> m_texture;
+    std::unique_ptr<QRhiTextureRenderTarget> m_target;
+    std::unique_ptr<QRhiRenderPassDescriptor> m_rpDesc;
+};
+
+// Per-channel difference beyond GOLDEN_CHANNEL_TOLERANCE, as a fraction of all pixels
+static double goldenMismatch(const QImage &actual, const QImage &golden) {
+    if (actual.size() != golden.size())
+        return 1.0;
+    const QImage a = actual.convertToFormat(QImage::Format_RGBA8888);
+    const QImage g = golden.convertToFormat(QImage::Format_RGBA8888);
+    qint64 bad = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const uchar *ar = a.constScanLine(y);
+        const uchar *gr = g.constScanLine(y);
+        for (int x = 0; x < a.width(); ++x) {
+            for (int c = 0; c < 4; ++c) {
+                if (std::abs(ar[x * 4 + c] - gr[x * 4 + c]) > GOLDEN_CHANNEL_TOLERANCE) {
+                    bad++;
+                    break;
+                }
+            }
+        }
+    }
+    return double(bad) / (qint64(a.width()) * a.height());
+}
+
+// Summed gray level of one pixel column
+static qint64 columnBrightness(const QImage &image, int x) {
+    qint64 sum = 0;
+    for (int y = 0; y < image.height(); ++y)
+        sum += qGray(image.pixel(x, y));
+    return sum;
+}
+
+// Pixel column of a packet bin for the tuned center and displayed span
+static int binColumn(int bin, int bins, qint32 sampleRate, int spanHz, int width) {
+    const double offsetHz = (double(bin) / bins - 0.5) * sampleRate * 1000.0;
+    return int(std::lround(width / 2.0 + offsetHz / spanHz * width));
+}
+
+// Rasterizer-independent sanity check of a rendered frame: the steady carrier at bins / 3 (44 dB
+// over the floor, drawn in spectrum and waterfall) must light its column more than the noise at
+// bins / 4 does. Both lie inside every span, away from the other carriers and the passband.
+static bool carrierVisible(const QImage &image, const Scenario &scenario, QString *detail) {
+    const qint32 sampleRate = sampleRateFor(scenario.spanHz);
+    const int width = image.width();
+    const int carrierX = binColumn(scenario.bins / 3, scenario.bins, sampleRate, scenario.spanHz, width);
+    const int noiseX = binColumn(scenario.bins / 4, scenario.bins, sampleRate, scenario.spanHz, width);
+
+    qint64 carrier = 0;
+    for (int x = std::max(0, carrierX - CARRIER_SEARCH_PX); x <= std::min(width - 1, carrierX + CARRIER_SEARCH_PX); ++x)
+        carrier = std::max(carrier, columnBrightness(image, x));
+    qint64 noise = 0;
+    int noiseColumns = 0;
+    for (int x = std::max(0, noiseX - CARRIER_SEARCH_PX); x <= std::min(width - 1, noiseX + CARRIER_SEARCH_PX); ++x) {
+        noise += columnBrightness(image, x);
+        noiseColumns++;
+    }
+    const double noiseMean = noiseColumns > 0 ? double(noise) / noiseColumns : 0.0;
+
+    *detail = QStringLiteral("carrier column %1 at x=%2, noise columns %3 at x=%4")
+                  .arg(carrier)
+                  .arg(carrierX)
+                  .arg(noiseMean, 0, 'f', 0)
+                  .arg(noiseX);
+    return carrier > noiseMean * CARRIER_CONTRAST;
+}
+
+static QVector<int> parseList(const QString &text) {
+    QVector<int> values;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts))
+        values.append(part.trimmed().toInt());
+    return values;
+}
+
+int main(int argc, char *argv[]) {
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offscreen PanadapterRhiWidget benchmark");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"backend", "QRhi backend: null (timing only) or gl (pixels, golden images).", "backend", "null"},
+        {"frames", "Frames per scenario.", "count", "300"},
+        {"size", "Render target size.", "WxH", "1280x720"},
+        {"bins", "Bins per PAN packet, comma separated.", "list", "512,1024,2048,4096"},
+        {"spans", "Displayed spans in Hz, comma separated.", "list", "10000,50000,200000"},
+        {"check", "Check that the last frame shows a steady carrier above the noise (gl only)."},
+        {"golden", "Directory of golden images to check the last frame against.", "dir"},
+        {"update-golden", "Write the last frame of each scenario to --golden instead of checking."},
+    });
+    parser.process(app);
+
+    const bool gl = parser.value("backend") == "gl";
+    const int frames = std::max(1, parser.value("frames").toInt());
+    const QStringList sizeParts = parser.value("size").split('x');
+    const QSize size(sizeParts.value(0).toInt(), sizeParts.value(1).toInt());
+    const bool check = parser.isSet("check");
+    const QString goldenDir = parser.value("golden");
+    const bool updateGolden = parser.isSet("update-golden");
+
+    QTextStream out(stdout);
+    if (size.isEmpty()) {
+        out << "Invalid --size " << parser.value("size") << Qt::endl;
+        return 2;
+    }
+
+    QVector<Scenario> scenarios;
+    for (int bins : parseList(parser.value("bins")))
+        for (int span : parseList(parser.value("spans")))
+            if (bins > 0 && span > 0)
+                scenarios.append({bins, span});
+
+    out << QStringLiteral("%1 frames per scenario, %2x%3, %4 backend\n")
+               .arg(frames)
+               .arg(size.width())
+               .arg(size.height())
+               .arg(gl ? QStringLiteral("gl") : QStringLiteral("null"));
+    out << QStringLiteral("%1 %2 %3 %4 %5\n")
+               .arg(QStringLiteral("scenario"), -32)
+               .arg(QStringLiteral("upload us (mean/p95)"), 22)
+               .arg(QStringLiteral("overlay us (mean/p95)"), 22)
+               .arg(QStringLiteral("record us (mean/p95)"), 22)
+               .arg(QStringLiteral("frame us (mean/p95)"), 22);
+
+    int failures = 0;
+    for (const Scenario &scenario : scenarios) {
+        // A fresh widget and QRhi per scenario: every run starts from initialization
+        OffscreenTarget offscreen;
+        if (!offscreen.create(gl ? QRhi::OpenGLES2 : QRhi::Null, size)) {
+            out << "Cannot create the QRhi backend" << Qt::endl;
+            return EXIT_SKIPPED;
+        }
+
+        PanadapterRhiWidget panadapter;
+        panadapter.resize(size);
+        panadapter.setSpectrumTrace(PanadapterRhiWidget::SpectrumTrace::Average); // Peak decay follows the wall clock
+        panadapter.setSpan(scenario.spanHz);
+        panadapter.setTunedFrequency(CENTER_FREQ);
+        offscreen.frame([&](QRhiCommandBuffer *cb) { panadapter.initializeOffscreen(offscreen.rhi(), cb); });
+
+        std::mt19937 noise(1234);
+        PhaseStats upload, overlay, record, total;
+        const qint32 sampleRate = sampleRateFor(scenario.spanHz);
+        for (int frame = 0; frame < frames; ++frame) {
+            panadapter.updateSpectrum(makePacket(scenario.bins, frame, noise), CENTER_FREQ, sampleRate, -120.0f);
+
+            QElapsedTimer frameClock;
+            frameClock.start();
+            offscreen.frame([&](QRhiCommandBuffer *cb) { panadapter.renderOffscreen(cb, offscreen.target()); });
+            total.add(frameClock.nsecsElapsed());
+
+            const PanadapterRhiWidget::FrameTiming timing = panadapter.lastFrameTiming();
+            upload.add(timing.uploadNs);
+            overlay.add(timing.overlayNs);
+            record.add(timing.recordNs);
+        }
+
+        auto column = [](PhaseStats &stats) {
+            return QStringLiteral("%1/%2").arg(stats.meanUs(), 0, 'f', 1).arg(stats.percentileUs(0.95), 0, 'f', 1);
+        };
+        out << QStringLiteral("%1 %2 %3 %4 %5\n")
+                   .arg(scenario.name(), -32)
+                   .arg(column(upload), 22)
+                   .arg(column(overlay), 22)
+                   .arg(column(record), 22)
+                   .arg(column(total), 22);
+
+        // Pixel checks need real pixels; the Null backend only exercises the CPU side
+        if ((!check && goldenDir.isEmpty()) || !gl)
+            continue;
+        const QImage image = offscreen.grab();
+        if (image.isNull()) {
+            out << "  cannot read back the frame\n";
+            failures++;
+            continue;
+        }
+        if (check) {
+            QString detail;
+            if (!carrierVisible(image, scenario, &detail)) {
+                out << "  carrier check failed: " << detail << "\n";
+                failures++;
+            }
+        }
+        if (goldenDir.isEmpty())
+            continue;
+        const QString goldenPath = QDir(goldenDir).filePath(scenario.name() + ".png");
+        if (updateGolden) {
+            QDir().mkpath(goldenDir);
+            if (!image.save(goldenPath)) {
+                out << "  cannot write " << goldenPath << "\n";
+                failures++;
+            }
+            continue;
+        }
+
+        const QImage golden(goldenPath);
+        if (golden.isNull()) {
+            out << "  no golden image " << goldenPath << " (run with --update-golden)\n";
+            continue;
+        }
+        const double mismatch = goldenMismatch(image, golden);
+        if (mismatch > GOLDEN_PIXEL_TOLERANCE) {
+            const QString actualPath = QDir(goldenDir).filePath(scenario.name() + ".actual.png");
+            image.save(actualPath);
+            out << QStringLiteral("  golden mismatch: %1% of pixels differ, wrote %2\n")
+                       .arg(mismatch * 100.0, 0, 'f', 2)
+                       .arg(actualPath);
+            failures++;
+        }
+    }
+
+    // Each scenario has its own QRhi, so only the shaders are carried over between them
+    const RhiResourceCache::Stats cache = RhiResourceCache::instance()->stats();
+    out << QStringLiteral("resource cache: %1 shaders loaded, %2 GPU resources created, %3 shared\n")
+               .arg(cache.shadersLoaded)
+               .arg(cache.resourcesCreated)
+               .arg(cache.resourcesShared);
+
+    out.flush();
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+#ifndef SPECTRUMTESTDATA_H
+#define SPECTRUMTESTDATA_H
+
+#include <QVector>
+#include <random>
+
+// Raw PAN bytes of an empty band: noise at 26 +/- 4 (the K4's -120 dBm, 1 dB per step), the
+// same for a given seed. Tests add their carriers on top.
+inline QVector<quint8> noisePacket(int bins, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(22, 30);
+    QVector<quint8> packet(bins);
+    for (quint8 &bin : packet)
+        bin = static_cast<quint8>(noise(rng));
+    return packet;
+}
+
+#endif // SPECTRUMTESTDATA_H
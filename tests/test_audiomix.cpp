@@ -0,0 +1,185 @@
+#include <QTest>
+#include <QVector>
+#include <QtMath>
+#include "audio/audiomix.h"
+
+// Reference copy of the original per-sample AudioEngine::applyMixAndVolume (gain boost
+// already applied by the decoder). Kept only to check and benchmark the matrix kernel.
+static float legacyMixChannel(float mainSample, float subSample, int src, float mainVol, float subVol) {
+    switch (src) {
+    case 0:
+        return mainSample * mainVol;
+    case 1:
+        return subSample * subVol;
+    case 2:
+        return mainSample * mainVol + subSample * subVol;
+    case 3:
+        return -mainSample * mainVol;
+    }
+    return 0.0f;
+}
+
+static void legacyApply(float *samples, int sampleCount, const AudioMix::Settings &s) {
+    float balLeftGain = 1.0f, balRightGain = 1.0f;
+    if (s.balanceMode == 1) {
+        balLeftGain = qBound(0.0f, (50.0f - s.balanceOffset) / 50.0f, 1.0f);
+        balRightGain = qBound(0.0f, (50.0f + s.balanceOffset) / 50.0f, 1.0f);
+    }
+    for (int i = 0; i < sampleCount; i++) {
+        float mainSample = samples[i * 2];
+        float subSample = samples[i * 2 + 1];
+        if (s.subMuted) {
+            float v = mainSample * s.mainVolume;
+            samples[i * 2] = qBound(-1.0f, v * balLeftGain, 1.0f);
+            samples[i * 2 + 1] = qBound(-1.0f, v * balRightGain, 1.0f);
+            continue;
+        }
+        float left, right;
+        if (s.balanceMode == 0) {
+            left = legacyMixChannel(mainSample, subSample, s.mixLeft, s.mainVolume, s.subVolume);
+            right = legacyMixChannel(mainSample, subSample, s.mixRight, s.mainVolume, s.subVolume);
+        } else {
+            left = legacyMixChannel(mainSample, subSample, s.mixLeft, s.mainVolume, s.mainVolume);
+            right = legacyMixChannel(mainSample, subSample, s.mixRight, s.mainVolume, s.mainVolume);
+            left *= balLeftGain;
+            right *= balRightGain;
+        }
+        samples[i * 2] = qBound(-1.0f, left, 1.0f);
+        samples[i * 2 + 1] = qBound(-1.0f, right, 1.0f);
+    }
+}
+
+// Deterministic quiet stereo signal, like normalized K4 Opus output before the boost
+static QVector<float> makeSignal(int frames) {
+    QVector<float> samples(frames * 2);
+    for (int i = 0; i < frames; i++) {
+        samples[i * 2] = 0.02f * float(qSin(i * 0.05));
+        samples[i * 2 + 1] = 0.015f * float(qCos(i * 0.031));
+    }
+    return samples;
+}
+
+static constexpr float K4_GAIN_BOOST = 32.0f;
+
+class TestAudioMix : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Matrix kernel matches the original per-sample mix for every setting
+    // =========================================================================
+    void testMatrix_matchesLegacy_data() {
+        QTest::addColumn<bool>("subMuted");
+        QTest::addColumn<int>("balanceMode");
+        QTest::addColumn<int>("mixLeft");
+        QTest::addColumn<int>("mixRight");
+        QTest::addColumn<int>("balanceOffset");
+
+        for (bool muted : {true, false}) {
+            for (int mode : {0, 1}) {
+                for (int left = 0; left < 4; left++) {
+                    for (int right = 0; right < 4; right++) {
+                        for (int offset : {-50, -20, 0, 35}) {
+                            QTest::addRow("muted%d_mode%d_mx%d%d_bl%d", muted, mode, left, right, offset)
+                                << muted << mode << left << right << offset;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testMatrix_matchesLegacy() {
+        QFETCH(bool, subMuted);
+        QFETCH(int, balanceMode);
+        QFETCH(int, mixLeft);
+        QFETCH(int, mixRight);
+        QFETCH(int, balanceOffset);
+
+        AudioMix::Settings settings;
+        settings.mainVolume = 0.8f;
+        settings.subVolume = 0.45f;
+        settings.subMuted = subMuted;
+        settings.mixLeft = static_cast<AudioMix::Source>(mixLeft);
+        settings.mixRight = static_cast<AudioMix::Source>(mixRight);
+        settings.balanceMode = balanceMode;
+        settings.balanceOffset = balanceOffset;
+
+        // Odd frame count exercises the scalar tail after the SIMD loop
+        const int frames = 241;
+        QVector<float> input = makeSignal(frames);
+
+        QVector<float> expected = input;
+        for (float &sample : expected) {
+            sample *= K4_GAIN_BOOST;
+        }
+        legacyApply(expected.data(), frames, settings);
+
+        // Boost fused into the matrix instead of a separate pass
+        QVector<float> actual = input;
+        AudioMix::apply(actual.data(), frames, AudioMix::matrixFor(settings).scaled(K4_GAIN_BOOST));
+
+        for (int i = 0; i < actual.size(); i++) {
+            QVERIFY2(qAbs(actual[i] - expected[i]) < 1e-5f, qPrintable(QString("sample %1").arg(i)));
+        }
+    }
+
+    void testApply_clampsToFullScale() {
+        AudioMix::Matrix matrix; // Identity
+        QVector<float> samples = {2.0f, -3.0f, 0.5f, -0.25f, -1.5f, 1.5f};
+        AudioMix::apply(samples.data(), 3, matrix);
+        const QVector<float> expected = {1.0f, -1.0f, 0.5f, -0.25f, -1.0f, 1.0f};
+        QCOMPARE(samples, expected);
+    }
+
+    void testMatrixFor_subMutedIgnoresSub() {
+        AudioMix::Settings settings;
+        settings.subMuted = true;
+        settings.mainVolume = 0.5f;
+        const AudioMix::Matrix m = AudioMix::matrixFor(settings);
+        QCOMPARE(m.mainToLeft, 0.5f);
+        QCOMPARE(m.mainToRight, 0.5f);
+        QCOMPARE(m.subToLeft, 0.0f);
+        QCOMPARE(m.subToRight, 0.0f);
+    }
+
+    // =========================================================================
+    // Benchmark: one second of 20ms stereo frames at 12kHz
+    // =========================================================================
+    void benchmarkMix_data() {
+        QTest::addColumn<bool>("matrix");
+        QTest::newRow("legacy") << false;
+        QTest::newRow("matrix") << true;
+    }
+
+    void benchmarkMix() {
+        QFETCH(bool, matrix);
+        AudioMix::Settings settings;
+        settings.subMuted = false;
+        settings.balanceMode = 1;
+        settings.balanceOffset = 10;
+        settings.mixLeft = AudioMix::SourceAB;
+        const QVector<float> input = makeSignal(240);
+        QVector<float> frame = input;
+
+        // Built when a setting changes, never on the audio path
+        const AudioMix::Matrix m = AudioMix::matrixFor(settings).scaled(K4_GAIN_BOOST);
+
+        QBENCHMARK {
+            for (int packet = 0; packet < 50; packet++) {
+                std::copy(input.cbegin(), input.cend(), frame.begin());
+                if (matrix) {
+                    AudioMix::apply(frame.data(), 240, m);
+                } else {
+                    for (float &sample : frame) {
+                        sample *= K4_GAIN_BOOST;
+                    }
+                    legacyApply(frame.data(), 240, settings);
+                }
+            }
+        }
+    }
+};
+
+QTEST_MAIN(TestAudioMix)
+#include "test_audiomix.moc"
@@ -0,0 +1,97 @@
+#include <QTest>
+#include "network/catcommandqueue.h"
+
+class TestCatCommandQueue : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Merging
+    // =========================================================================
+    void testTake_keepsOrderInOnePayload() {
+        CatCommandQueue queue;
+        queue.append(u"RU;");
+        queue.append(u"RU;");
+        queue.append(u"FA00014074000;MD2;");
+        QCOMPARE(queue.size(), 4);
+        QCOMPARE(queue.take(), QString("RU;RU;FA00014074000;MD2;"));
+        QVERIFY(queue.isEmpty());
+        QCOMPARE(queue.take(), QString());
+    }
+
+    void testAppend_unterminatedTailPassesThrough() {
+        CatCommandQueue queue;
+        queue.append(u"FA00014074000;FA00014075000");
+        QCOMPARE(queue.take(), QString("FA00014074000;FA00014075000"));
+    }
+
+    // =========================================================================
+    // Collapsing
+    // =========================================================================
+    void testCollapse_repeatedWrites() {
+        CatCommandQueue queue;
+        for (int khz = 14070; khz <= 14074; ++khz)
+            queue.append(QStringLiteral("FA%1000;").arg(khz, 8, 10, QChar('0')));
+        QCOMPARE(queue.take(), QString("FA00014074000;"));
+    }
+
+    void testCollapse_acrossOtherSettings() {
+        CatCommandQueue queue;
+        queue.append(u"FA00014070000;");
+        queue.append(u"BW0240;");
+        queue.append(u"FA00014074000;");
+        QCOMPARE(queue.take(), QString("BW0240;FA00014074000;"));
+        queue.append(u"FA;BW0240;FA;");
+        QCOMPARE(queue.take(), QString("BW0240;FA;"));
+    }
+
+    void testCollapse_writeNeverCrossesQuery() {
+        // The query must report the first write, not the frequency from before the batch
+        CatCommandQueue queue;
+        queue.append(u"FA00014070000;FA;FA00014074000;");
+        QCOMPARE(queue.take(), QString("FA00014070000;FA;FA00014074000;"));
+        queue.append(u"FA;FA00014074000;FA;");
+        QCOMPARE(queue.take(), QString("FA;FA00014074000;FA;"));
+    }
+
+    void testCollapse_subReceiverIsAnotherSetting() {
+        CatCommandQueue queue;
+        queue.append(u"BW$0100;BW0200;BW$0300;#SPN50000;#SPN$20000;");
+        QCOMPARE(queue.take(), QString("BW0200;BW$0300;#SPN50000;#SPN$20000;"));
+    }
+
+    void testCollapse_stopsAtBarrier() {
+        // A swap or relative step between two writes keeps both
+        CatCommandQueue queue;
+        queue.append(u"FA00014070000;SWT11;FA00014074000;");
+        QCOMPARE(queue.take(), QString("FA00014070000;SWT11;FA00014074000;"));
+        queue.append(u"RO+0100;RU;RO+0200;");
+        QCOMPARE(queue.take(), QString("RO+0100;RU;RO+0200;"));
+    }
+
+    void testSettingKeyLength() {
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"FA00014074000;"), 2);
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"BW$0280;"), 3);
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"#REF$-110;"), 5);
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"FA;"), 2);
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"RU;"), 0);
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"ML0010;"), 0);
+        QCOMPARE(CatCommandQueue::settingKeyLength(u"FA00014074000"), 0);
+    }
+
+    // =========================================================================
+    // Benchmark: one event-loop turn of fast tuning (20 wheel steps)
+    // =========================================================================
+    void benchmarkFastTuning() {
+        CatCommandQueue queue;
+        QBENCHMARK {
+            for (int step = 0; step < 20; ++step) {
+                queue.append(QStringLiteral("FA%1;").arg(14074000 + step * 10, 11, 10, QChar('0')));
+            }
+            queue.take();
+        }
+    }
+};
+
+QTEST_MAIN(TestCatCommandQueue)
+#include "test_catcommandqueue.moc"
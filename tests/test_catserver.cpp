@@ -0,0 +1,229 @@
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTcpSocket>
+#include <QTest>
+#include <memory>
+#include "models/radiostate.h"
+#include "network/catserver.h"
+
+class TestCatServer : public QObject {
+    Q_OBJECT
+
+private:
+    // Client and server share this thread, so waits run the event loop instead of blocking on the socket
+
+    // Connected client socket, once the server has accepted it
+    static std::unique_ptr<QTcpSocket> connectClient(CatServer &server) {
+        auto socket = std::make_unique<QTcpSocket>();
+        const int expected = server.clientCount() + 1;
+        socket->connectToHost(QHostAddress::LocalHost, server.port());
+        QElapsedTimer timer;
+        timer.start();
+        while (server.clientCount() < expected && timer.elapsed() < 2000)
+            QTest::qWait(5);
+        return server.clientCount() == expected ? std::move(socket) : nullptr;
+    }
+
+    // Send commands and wait until the server has processed them: the trailing ID query is
+    // answered last, so everything before its response belongs to the commands
+    static QByteArray request(QTcpSocket *socket, const QByteArray &commands) {
+        socket->write(commands + "ID;");
+        QByteArray received;
+        QElapsedTimer timer;
+        timer.start();
+        while (!received.endsWith("ID017;") && timer.elapsed() < 2000) {
+            QTest::qWait(5);
+            received += socket->readAll();
+        }
+        received.chop(6);
+        return received;
+    }
+
+    // Whatever arrives within a short wait
+    static QByteArray drain(QTcpSocket *socket) {
+        QTest::qWait(50);
+        return socket->readAll();
+    }
+
+private slots:
+    // =========================================================================
+    // AI level
+    // =========================================================================
+    void testAutoInfo_offByDefault() {
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        auto client = connectClient(server);
+        QVERIFY(client);
+
+        QCOMPARE(request(client.get(), "AI;"), QByteArray("AI0;"));
+        state.parseCATCommand("FA00014074000;");
+        QCOMPARE(drain(client.get()), QByteArray());
+    }
+
+    void testAutoInfo_perClientLevel() {
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        auto pushed = connectClient(server);
+        auto polling = connectClient(server);
+        QVERIFY(pushed && polling);
+
+        QCOMPARE(request(pushed.get(), "AI2;AI;"), QByteArray("AI2;"));
+        state.parseCATCommand("FA00014074000;");
+        QCOMPARE(drain(pushed.get()), QByteArray("FA00014074000;"));
+        QCOMPARE(drain(polling.get()), QByteArray());
+    }
+
+    void testAutoInfo_ifForLevel1() {
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        auto client = connectClient(server);
+        QVERIFY(client);
+
+        request(client.get(), "AI1;");
+        state.parseCATCommand("FA00007074000;");
+        const QByteArray pushed = drain(client.get());
+        QVERIFY(pushed.startsWith("IF00007074000"));
+        QCOMPARE(pushed.count(';'), 1);
+
+        // Values the IF response doesn't carry aren't pushed
+        state.parseCATCommand("FB00014074000;");
+        QCOMPARE(drain(client.get()), QByteArray());
+    }
+
+    // =========================================================================
+    // Fan-out
+    // =========================================================================
+    void testAutoInfo_oncePerBatch() {
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        auto client = connectClient(server);
+        QVERIFY(client);
+        request(client.get(), "AI2;");
+
+        state.beginBatch();
+        state.parseCATCommand("FA00014070000;");
+        state.parseCATCommand("FA00014074000;");
+        state.parseCATCommand("FT1;");
+        state.endBatch();
+        QCOMPARE(drain(client.get()), QByteArray("FA00014074000;FT1;"));
+    }
+
+    void testAutoInfo_metersNeedPoll() {
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        auto client = connectClient(server);
+        QVERIFY(client);
+        request(client.get(), "AI2;");
+
+        state.parseCATCommand("SM05;");
+        QCOMPARE(drain(client.get()), QByteArray());
+
+        // SM05 is S2.5 and SM07 S3.5; the CAT server reports 3 per S-unit
+        QCOMPARE(request(client.get(), "SM;"), QByteArray("SM0006;"));
+        state.parseCATCommand("SM07;");
+        QCOMPARE(drain(client.get()), QByteArray("SM0009;"));
+    }
+
+    // =========================================================================
+    // Client I/O
+    // =========================================================================
+    void testLineBuffer_splitAndBatchedCommands() {
+        RadioState state;
+        CatServer server(&state);
+        state.parseCATCommand("FA00014074000;");
+        QVERIFY(server.start(0));
+        auto client = connectClient(server);
+        QVERIFY(client);
+
+        // A command split across reads, then several in one read
+        client->write("F");
+        QTest::qWait(20);
+        QCOMPARE(request(client.get(), "A;"), QByteArray("FA00014074000;"));
+        QCOMPARE(request(client.get(), "FA; FT;\nTQ;"), QByteArray("FA00014074000;FT0;TQ0;"));
+    }
+
+    void testStart_bindAddress() {
+        RadioState state;
+        CatServer server(&state);
+        QSignalSpy errors(&server, &CatServer::errorOccurred);
+        QVERIFY(!server.start(0, QHostAddress("192.0.2.1"))); // TEST-NET-1: not an address of this host
+        QCOMPARE(errors.count(), 1);
+        QVERIFY(!server.isListening());
+
+        QVERIFY(server.start(0, QHostAddress::LocalHost));
+        QCOMPARE(server.address(), QHostAddress(QHostAddress::LocalHost));
+        QVERIFY(server.port() != 0);
+        server.stop();
+        QVERIFY(!server.isListening());
+    }
+
+    // =========================================================================
+    // Response cache
+    // =========================================================================
+    void testResponseCache_invalidatedByChange() {
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        state.parseCATCommand("FA00014074000;");
+        QCOMPARE(server.response("FA;"), QByteArray("FA00014074000;"));
+        QCOMPARE(server.response("FA;"), QByteArray("FA00014074000;"));
+        const QByteArray ifBefore = server.response("IF;");
+
+        state.parseCATCommand("FA00007074000;");
+        QCOMPARE(server.response("FA;"), QByteArray("FA00007074000;"));
+        QVERIFY(server.response("IF;").startsWith("IF00007074000"));
+
+        // Unrelated changes keep it; RIT/XIT is part of IF
+        state.parseCATCommand("FB00014074000;");
+        QCOMPARE(server.response("FA;"), QByteArray("FA00007074000;"));
+        state.parseCATCommand("RT1;");
+        QVERIFY(server.response("IF;") != ifBefore);
+        QCOMPARE(server.response("RT;"), QByteArray("RT1;"));
+    }
+
+    void testResponseCache_untrackedStateIsFresh() {
+        // Option modules have no change signal, so OM is never cached
+        RadioState state;
+        CatServer server(&state);
+        QVERIFY(server.start(0));
+        QCOMPARE(server.response("OM;"), QByteArray("OM AP----------;"));
+        state.parseCATCommand("OM APXSHML14----;");
+        QCOMPARE(server.response("OM;"), QByteArray("OM APXSHML14----;"));
+    }
+
+    // =========================================================================
+    // Benchmark: one second of a logger polling at 20 Hz while the radio streams
+    // S-meter updates at 10 Hz and the operator tunes (5 frequency changes), on
+    // the worker directly so thread hops don't hide the server's own cost
+    // =========================================================================
+    void benchmarkPolling20Hz() {
+        CatServerWorker worker;
+        CatSnapshot snapshot;
+        snapshot.frequency = 14074000;
+        snapshot.mode = RadioState::USB;
+        worker.updateState(snapshot, 0);
+        const QByteArray polls[] = {"IF;", "FA;", "FB;", "MD;", "TQ;"};
+        QBENCHMARK {
+            for (int tick = 0; tick < 20; ++tick) {
+                if (tick % 2 == 0) {
+                    snapshot.sMeter = tick % 4 == 0 ? 2.5 : 3.5;
+                    worker.updateState(snapshot, RadioState::FieldSMeter);
+                }
+                if (tick % 4 == 0) {
+                    snapshot.frequency++;
+                    worker.updateState(snapshot, RadioState::FieldVfoA);
+                }
+                for (const QByteArray &poll : polls)
+                    worker.response(poll);
+            }
+        }
+    }
+};
+
+QTEST_MAIN(TestCatServer)
+#include "test_catserver.moc"
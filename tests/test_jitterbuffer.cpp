@@ -0,0 +1,209 @@
+#include <QTest>
+#include <QVector>
+#include "audio/jitterbuffer.h"
+
+// K4 RX audio: 20ms packets of 240 stereo frames at 12kHz
+static constexpr int PACKET_FRAMES = 240;
+static constexpr qint64 PACKET_US = 20000;
+
+// Interleaved [main, sub] ramp so every frame is distinguishable
+static QVector<float> makePacket(int firstFrame) {
+    QVector<float> samples(PACKET_FRAMES * 2);
+    for (int i = 0; i < PACKET_FRAMES; i++) {
+        samples[i * 2] = float(firstFrame + i) / 10000.0f;
+        samples[i * 2 + 1] = -float(firstFrame + i) / 10000.0f;
+    }
+    return samples;
+}
+
+static void writePackets(JitterBuffer &buffer, int count) {
+    for (int p = 0; p < count; p++) {
+        const QVector<float> packet = makePacket(p * PACKET_FRAMES);
+        buffer.write(packet.constData(), int(packet.size()));
+    }
+}
+
+class TestJitterBuffer : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Playout
+    // =========================================================================
+    void testPrebuffer_holdsUntilTarget() {
+        JitterBuffer buffer;
+        QVector<float> out(PACKET_FRAMES * 2, 1.0f);
+
+        // One packet (20ms) is below the 40ms minimum target: silence
+        writePackets(buffer, 1);
+        buffer.read(out.data(), PACKET_FRAMES);
+        for (float sample : out) {
+            QCOMPARE(sample, 0.0f);
+        }
+    }
+
+    void testPlayout_passesSamplesThroughAtTarget() {
+        JitterBuffer buffer;
+        writePackets(buffer, 2);
+
+        QVector<float> out(PACKET_FRAMES * 2);
+        buffer.read(out.data(), PACKET_FRAMES);
+
+        // Depth sits at the target, so playout runs at exactly 1.0 and is bit-exact
+        const QVector<float> expected = makePacket(0);
+        QCOMPARE(out, expected);
+        QCOMPARE(buffer.stats().playoutRate, 1.0);
+    }
+
+    void testUnderrun_fadesOutAndRaisesTarget() {
+        JitterBuffer buffer;
+        writePackets(buffer, 2);
+
+        QVector<float> out(PACKET_FRAMES * 2 * 2);
+        buffer.read(out.data(), PACKET_FRAMES);
+        buffer.read(out.data(), PACKET_FRAMES * 2);
+
+        // Past the fade, the output is silent
+        for (int i = PACKET_FRAMES + 60; i < PACKET_FRAMES * 2; i++) {
+            QCOMPARE(out[i * 2], 0.0f);
+            QCOMPARE(out[i * 2 + 1], 0.0f);
+        }
+
+        JitterBuffer::Stats stats = buffer.stats();
+        QCOMPARE(stats.underruns, quint64(1));
+
+        // Next read recomputes the target including the underrun boost
+        buffer.read(out.data(), PACKET_FRAMES);
+        QVERIFY(buffer.stats().targetMs > JitterBuffer::MIN_TARGET_MS);
+    }
+
+    void testTimeStretch_speedsUpWhenTooDeep() {
+        JitterBuffer buffer;
+        writePackets(buffer, 20); // 400ms against a 40ms target
+
+        QVector<float> out(PACKET_FRAMES * 2);
+        buffer.read(out.data(), PACKET_FRAMES);
+
+        const double rate = buffer.stats().playoutRate;
+        QVERIFY(rate > 1.0);
+        QVERIFY(rate <= 1.0 + JitterBuffer::MAX_STRETCH + 1e-6);
+    }
+
+    void testOverflow_trimsBackToTarget() {
+        JitterBuffer buffer;
+        writePackets(buffer, 60); // 1.2s, beyond MAX_LATENCY_MS
+
+        QVector<float> out(PACKET_FRAMES * 2);
+        buffer.read(out.data(), PACKET_FRAMES);
+
+        JitterBuffer::Stats stats = buffer.stats();
+        QVERIFY(stats.overflowDrops > 0);
+        QVERIFY(stats.latencyMs <= JitterBuffer::MIN_TARGET_MS);
+    }
+
+    void testFlush_dropsBacklog() {
+        JitterBuffer buffer;
+        writePackets(buffer, 4);
+        buffer.flush();
+
+        QVector<float> out(PACKET_FRAMES * 2, 1.0f);
+        buffer.read(out.data(), PACKET_FRAMES);
+        QCOMPARE(out.at(0), 0.0f);
+        QCOMPARE(buffer.stats().latencyMs, 0.0);
+    }
+
+    // =========================================================================
+    // Sequence tracking
+    // =========================================================================
+    void testSequence_inOrder() {
+        JitterBuffer buffer;
+        for (int seq = 0; seq < 10; seq++) {
+            QCOMPARE(buffer.packetArrived(quint8(seq), PACKET_FRAMES, seq * PACKET_US), 0);
+        }
+        QCOMPARE(buffer.stats().packetsReceived, quint64(10));
+        QCOMPARE(buffer.stats().packetsLost, quint64(0));
+    }
+
+    void testSequence_wrapsAt256() {
+        JitterBuffer buffer;
+        QCOMPARE(buffer.packetArrived(254, PACKET_FRAMES, 0), 0);
+        QCOMPARE(buffer.packetArrived(255, PACKET_FRAMES, PACKET_US), 0);
+        QCOMPARE(buffer.packetArrived(0, PACKET_FRAMES, 2 * PACKET_US), 0);
+        QCOMPARE(buffer.stats().packetsLost, quint64(0));
+    }
+
+    void testSequence_gapReportsLostPackets() {
+        JitterBuffer buffer;
+        buffer.packetArrived(0, PACKET_FRAMES, 0);
+        buffer.packetArrived(1, PACKET_FRAMES, PACKET_US);
+
+        // 2 and 3 never arrived
+        QCOMPARE(buffer.packetArrived(4, PACKET_FRAMES, 4 * PACKET_US), 2);
+        QCOMPARE(buffer.stats().packetsLost, quint64(2));
+    }
+
+    void testSequence_longGapCapsConcealment() {
+        JitterBuffer buffer;
+        buffer.packetArrived(10, PACKET_FRAMES, 0);
+
+        QCOMPARE(buffer.packetArrived(30, PACKET_FRAMES, 20 * PACKET_US), JitterBuffer::MAX_CONCEALED_FRAMES);
+        QCOMPARE(buffer.stats().packetsLost, quint64(19));
+    }
+
+    void testSequence_duplicateAndLateDropped() {
+        JitterBuffer buffer;
+        buffer.packetArrived(5, PACKET_FRAMES, 0);
+        buffer.packetArrived(6, PACKET_FRAMES, PACKET_US);
+
+        QCOMPARE(buffer.packetArrived(6, PACKET_FRAMES, PACKET_US), -1);
+        QCOMPARE(buffer.packetArrived(3, PACKET_FRAMES, PACKET_US), -1);
+        QCOMPARE(buffer.stats().packetsLate, quint64(2));
+    }
+
+    void testSequence_resetStartsOver() {
+        JitterBuffer buffer;
+        buffer.packetArrived(100, PACKET_FRAMES, 0);
+        buffer.resetSequence();
+
+        // A reconnect restarts the K4's counter; that is not a gap or a late packet
+        QCOMPARE(buffer.packetArrived(0, PACKET_FRAMES, PACKET_US), 0);
+        QCOMPARE(buffer.stats().packetsLost, quint64(0));
+        QCOMPARE(buffer.stats().packetsLate, quint64(0));
+    }
+
+    void testConcealedFrames_counted() {
+        JitterBuffer buffer;
+        const QVector<float> packet = makePacket(0);
+        buffer.write(packet.constData(), int(packet.size()), true);
+        buffer.write(packet.constData(), int(packet.size()));
+        QCOMPARE(buffer.stats().concealedFrames, quint64(1));
+    }
+
+    // =========================================================================
+    // Jitter estimate and adaptive target
+    // =========================================================================
+    void testJitter_steadyArrivals() {
+        JitterBuffer buffer;
+        for (int seq = 0; seq < 50; seq++) {
+            buffer.packetArrived(quint8(seq), PACKET_FRAMES, seq * PACKET_US);
+        }
+        QVERIFY(buffer.stats().jitterMs < 0.5);
+    }
+
+    void testJitter_burstyArrivalsRaiseTarget() {
+        JitterBuffer buffer;
+
+        // Packets arrive in pairs every 40ms (typical of a congested TCP link)
+        for (int seq = 0; seq < 100; seq++) {
+            buffer.packetArrived(quint8(seq), PACKET_FRAMES, (seq / 2) * 2 * PACKET_US);
+        }
+        QVERIFY(buffer.stats().jitterMs > 10.0);
+
+        QVector<float> out(PACKET_FRAMES * 2);
+        buffer.read(out.data(), PACKET_FRAMES);
+        QVERIFY(buffer.stats().targetMs > 60.0);
+    }
+};
+
+QTEST_MAIN(TestJitterBuffer)
+#include "test_jitterbuffer.moc"
@@ -0,0 +1,83 @@
+#include <QTest>
+#include <QVector>
+#include <algorithm>
+#include "dsp/noisefloor.h"
+#include "spectrumtestdata.h"
+
+// Band noise with the given share of bins carrying a 90 carrier
+static QVector<quint8> makePacket(int bins, double carrierShare, unsigned seed = 1) {
+    QVector<quint8> packet = noisePacket(bins, seed);
+    for (int i = 0; i < static_cast<int>(bins * carrierShare); ++i)
+        packet[(i * 7) % bins] = 90;
+    return packet;
+}
+
+class TestNoiseFloor : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Percentile
+    // =========================================================================
+    void testPercentile_matchesNthElement() {
+        for (int bins : {1, 3, 17, 500, 4096}) {
+            QVector<quint8> packet = makePacket(bins, 0.2, unsigned(bins));
+            for (double fraction : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+                QVector<quint8> sorted = packet;
+                const int rank = static_cast<int>(fraction * (bins - 1));
+                std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+                QCOMPARE(NoiseFloorEstimator::percentile(packet.constData(), bins, fraction), sorted[rank]);
+            }
+        }
+    }
+
+    void testPercentile_ignoresNullsAndCarriers() {
+        QVector<quint8> packet = makePacket(1000, 0.3);
+        packet[10] = 0; // Dropped bins
+        packet[11] = 0;
+        const quint8 floor = NoiseFloorEstimator::percentile(packet.constData(), int(packet.size()), 0.1);
+        QVERIFY(floor >= 22 && floor <= 26);
+    }
+
+    void testPercentile_empty() {
+        QCOMPARE(NoiseFloorEstimator::percentile(nullptr, 0, 0.1), quint8(0));
+    }
+
+    // =========================================================================
+    // Smoothing
+    // =========================================================================
+    void testUpdate_firstPacketSetsFloor() {
+        NoiseFloorEstimator estimator;
+        QVERIFY(!estimator.isValid());
+        const QVector<quint8> packet(100, 26);
+        QCOMPARE(estimator.update(packet.constData(), 100, 1.0f, -146.0f), -120.0f);
+        QVERIFY(estimator.isValid());
+    }
+
+    void testUpdate_smoothsTowardNewFloor() {
+        NoiseFloorEstimator estimator(0.1, 0.5f);
+        const QVector<quint8> quiet(100, 26);
+        const QVector<quint8> noisy(100, 36);
+        estimator.update(quiet.constData(), 100, 1.0f, -146.0f);
+        QCOMPARE(estimator.update(noisy.constData(), 100, 1.0f, -146.0f), -115.0f);
+
+        // A different scale (MiniPAN bytes) starts over
+        QCOMPARE(estimator.update(quiet.constData(), 100, 10.0f, -160.0f), 100.0f);
+
+        estimator.reset();
+        QCOMPARE(estimator.update(noisy.constData(), 100, 10.0f, -160.0f), 200.0f);
+    }
+
+    // =========================================================================
+    // Benchmark: one 4096-bin packet
+    // =========================================================================
+    void benchmarkPercentile() {
+        const QVector<quint8> packet = makePacket(4096, 0.1);
+        QBENCHMARK {
+            NoiseFloorEstimator::percentile(packet.constData(), int(packet.size()), 0.1);
+        }
+    }
+};
+
+QTEST_MAIN(TestNoiseFloor)
+#include "test_noisefloor.moc"
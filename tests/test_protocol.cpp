@@ -2,8 +2,69 @@
 #include <QSignalSpy>
 #include <QCryptographicHash>
 #include <QtEndian>
+#include <QElapsedTimer>
+#include <cstring>
 #include "network/protocol.h"
 
+// Reference copy of the original mid()-based framer, kept only to benchmark against.
+// Counts every byte it copies out of or within its receive buffer.
+class LegacyFramer {
+public:
+    int packets = 0;
+    quint64 bytesCopied = 0;
+
+    void parse(const QByteArray &data) {
+        m_buffer.append(data);
+        while (true) {
+            int startPos = m_buffer.indexOf(K4Protocol::START_MARKER);
+            if (startPos == -1) {
+                if (m_buffer.size() > 3) {
+                    m_buffer = m_buffer.right(3);
+                    bytesCopied += 3;
+                }
+                break;
+            }
+            if (startPos > 0) {
+                m_buffer = m_buffer.mid(startPos);
+                bytesCopied += m_buffer.size();
+            }
+            if (m_buffer.size() < 8) {
+                break;
+            }
+            quint32 payloadLength = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(m_buffer.constData() + 4));
+            int totalPacketSize = 4 + 4 + payloadLength + 4;
+            if (m_buffer.size() < totalPacketSize) {
+                break;
+            }
+            QByteArray endMarker = m_buffer.mid(totalPacketSize - 4, 4);
+            bytesCopied += 4;
+            if (endMarker != K4Protocol::END_MARKER) {
+                m_buffer = m_buffer.mid(4);
+                bytesCopied += m_buffer.size();
+                continue;
+            }
+            QByteArray payload = m_buffer.mid(8, payloadLength);
+            bytesCopied += payload.size();
+            m_buffer = m_buffer.mid(totalPacketSize);
+            bytesCopied += m_buffer.size();
+
+            // Same per-type extraction the old processPacket did
+            quint8 type = static_cast<quint8>(payload[0]);
+            if (type == K4Protocol::PAN) {
+                bytesCopied += payload.size() - K4Protocol::PanPacket::BINS_OFFSET;
+            } else if (type == K4Protocol::MiniPAN) {
+                bytesCopied += payload.size() - K4Protocol::MiniPanPacket::BINS_OFFSET;
+            } else if (type == K4Protocol::CAT) {
+                bytesCopied += payload.size() - 3;
+            }
+            packets++;
+        }
+    }
+
+private:
+    QByteArray m_buffer;
+};
+
 class TestProtocol : public QObject {
     Q_OBJECT
 
@@ -31,6 +92,43 @@ private:
         return p;
     }
 
+    // Helper: one second of typical dual-receiver traffic (PAN, MiniPAN, audio and CAT for
+    // both receivers), returned as a single byte stream
+    static QByteArray mixedStream(int *packetCount) {
+        QByteArray pan(K4Protocol::PanPacket::HEADER_SIZE + 1024, '\x40');
+        pan[0] = static_cast<char>(K4Protocol::PAN);
+        QByteArray miniPan(K4Protocol::MiniPanPacket::HEADER_SIZE + 256, '\x40');
+        miniPan[0] = static_cast<char>(K4Protocol::MiniPAN);
+        QByteArray audio(K4Protocol::AudioPacket::HEADER_SIZE + 120, '\x55');
+        audio[0] = static_cast<char>(K4Protocol::Audio);
+        QByteArray cat = catPayload("SM05;SMH03;");
+
+        QByteArray stream;
+        int count = 0;
+        for (int tick = 0; tick < 50; tick++) { // 20ms ticks
+            for (int rx = 0; rx < 2; rx++) {
+                pan[K4Protocol::PanPacket::RECEIVER_OFFSET] = static_cast<char>(rx);
+                miniPan[K4Protocol::MiniPanPacket::RECEIVER_OFFSET] = static_cast<char>(rx);
+                stream.append(wrapPacket(pan));
+                stream.append(wrapPacket(miniPan));
+                stream.append(wrapPacket(cat));
+                count += 3;
+            }
+            stream.append(wrapPacket(audio));
+            count++;
+        }
+        *packetCount = count;
+        return stream;
+    }
+
+    // Helper: feed a stream in TCP-segment sized chunks, as readyRead delivers it
+    template <typename Framer> static void feedChunked(Framer &framer, const QByteArray &stream) {
+        constexpr int CHUNK = 1448;
+        for (int pos = 0; pos < stream.size(); pos += CHUNK) {
+            framer.parse(stream.mid(pos, CHUNK));
+        }
+    }
+
 private slots:
     // =========================================================================
     // buildPacket
@@ -153,6 +251,19 @@ private slots:
         QCOMPARE(static_cast<quint8>(payload[2]), static_cast<quint8>(255));
     }
 
+    void testInPlaceAudioPacket_matchesBuildAudioPacket() {
+        QByteArray audio(57, '\x3C');
+
+        // Body written directly after the reserved header, as TxAudioPipeline does
+        char packet[Protocol::AUDIO_BODY_OFFSET + 57 + 4];
+        Protocol::writeAudioHeader(packet, 7, 0x02);
+        std::memcpy(packet + Protocol::AUDIO_BODY_OFFSET, audio.constData(), audio.size());
+        const int size = Protocol::finishPacket(packet, K4Protocol::AudioPacket::HEADER_SIZE + audio.size());
+
+        QCOMPARE(size, int(sizeof(packet)));
+        QCOMPARE(QByteArray(packet, size), Protocol::buildAudioPacket(audio, 7, 0x02));
+    }
+
     // =========================================================================
     // parse → catResponseReceived
     // =========================================================================
@@ -164,7 +275,7 @@ private slots:
         proto.parse(packet);
 
         QCOMPARE(spy.count(), 1);
-        QCOMPARE(spy.at(0).at(0).toString(), QString("FA00014060000;"));
+        QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("FA00014060000;"));
     }
 
     // =========================================================================
@@ -280,7 +391,7 @@ private slots:
 
         proto.parse(part2);
         QCOMPARE(spy.count(), 1);
-        QCOMPARE(spy.at(0).at(0).toString(), QString("MD3;"));
+        QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("MD3;"));
     }
 
     // =========================================================================
@@ -296,7 +407,7 @@ private slots:
         proto.parse(garbage + packet);
 
         QCOMPARE(spy.count(), 1);
-        QCOMPARE(spy.at(0).at(0).toString(), QString("RX;"));
+        QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("RX;"));
     }
 
     // =========================================================================
@@ -324,7 +435,7 @@ private slots:
 
         // Only the good packet should be received
         QCOMPARE(spy.count(), 1);
-        QCOMPARE(spy.at(0).at(0).toString(), QString("GOOD;"));
+        QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("GOOD;"));
     }
 
     // =========================================================================
@@ -344,7 +455,7 @@ private slots:
         // After overflow, protocol should still work
         proto.parse(wrapPacket(catPayload("OK;")));
         QCOMPARE(spy.count(), 1);
-        QCOMPARE(spy.at(0).at(0).toString(), QString("OK;"));
+        QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("OK;"));
     }
 
     // =========================================================================
@@ -380,9 +491,9 @@ private slots:
         proto.parse(data);
 
         QCOMPARE(spy.count(), 3);
-        QCOMPARE(spy.at(0).at(0).toString(), QString("FA00014060000;"));
-        QCOMPARE(spy.at(1).at(0).toString(), QString("MD3;"));
-        QCOMPARE(spy.at(2).at(0).toString(), QString("BW0240;"));
+        QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("FA00014060000;"));
+        QCOMPARE(spy.at(1).at(0).toByteArray(), QByteArray("MD3;"));
+        QCOMPARE(spy.at(2).at(0).toByteArray(), QByteArray("BW0240;"));
     }
 
     // =========================================================================
@@ -433,6 +544,72 @@ private slots:
         // audioDataReady requires payload.size() > HEADER_SIZE
         QCOMPARE(spy.count(), 0);
     }
+
+    // =========================================================================
+    // Framing benchmark: read-cursor framer vs original mid()-based framer
+    // =========================================================================
+    void benchmarkParse_mixedStream() {
+        int packetCount = 0;
+        const QByteArray stream = mixedStream(&packetCount);
+
+        Protocol proto;
+        int received = 0;
+        connect(&proto, &Protocol::packetReceived, this, [&received](quint8) { received++; });
+
+        QBENCHMARK {
+            feedChunked(proto, stream);
+        }
+        QVERIFY(received > 0);
+        QCOMPARE(received % packetCount, 0);
+    }
+
+    void benchmarkParse_copiesPerPacket() {
+        int packetCount = 0;
+        const QByteArray stream = mixedStream(&packetCount);
+        constexpr int ROUNDS = 20;
+
+        // Legacy framer
+        LegacyFramer legacy;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < ROUNDS; i++) {
+            feedChunked(legacy, stream);
+        }
+        const qint64 legacyNs = qMax<qint64>(1, timer.nsecsElapsed());
+        QCOMPARE(legacy.packets, packetCount * ROUNDS);
+
+        // Read-cursor framer: copies are compaction plus the payload bytes each signal owns
+        Protocol proto;
+        int packets = 0;
+        quint64 emittedBytes = 0;
+        connect(&proto, &Protocol::packetReceived, this, [&packets](quint8) { packets++; });
+        connect(&proto, &Protocol::audioDataReady, this,
+                [&emittedBytes](const QByteArray &payload) { emittedBytes += payload.size(); });
+        connect(&proto, &Protocol::spectrumDataReady, this,
+                [&emittedBytes](int, const QByteArray &bins, qint64, qint32, float) { emittedBytes += bins.size(); });
+        connect(&proto, &Protocol::miniSpectrumDataReady, this,
+                [&emittedBytes](int, const QByteArray &bins) { emittedBytes += bins.size(); });
+        connect(&proto, &Protocol::catResponseReceived, this,
+                [&emittedBytes](const QByteArray &response) { emittedBytes += response.size(); });
+
+        timer.restart();
+        for (int i = 0; i < ROUNDS; i++) {
+            feedChunked(proto, stream);
+        }
+        const qint64 cursorNs = qMax<qint64>(1, timer.nsecsElapsed());
+        QCOMPARE(packets, packetCount * ROUNDS);
+
+        // Legacy also copied each audio payload into the signal; count it the same way
+        const quint64 legacyAudioBytes = quint64(ROUNDS) * 50 * (K4Protocol::AudioPacket::HEADER_SIZE + 120);
+        const quint64 legacyCopies = legacy.bytesCopied + legacyAudioBytes;
+        const quint64 cursorCopies = proto.bytesCompacted() + emittedBytes;
+        const double total = double(packetCount) * ROUNDS;
+
+        qInfo("legacy: %.0f packets/sec, %.1f bytes copied/packet", total * 1e9 / legacyNs, legacyCopies / total);
+        qInfo("cursor: %.0f packets/sec, %.1f bytes copied/packet", total * 1e9 / cursorNs, cursorCopies / total);
+
+        QVERIFY(cursorCopies < legacyCopies);
+    }
 };
 
 QTEST_MAIN(TestProtocol)
@@ -1,7 +1,57 @@
 #include <QTest>
 #include <QSignalSpy>
+#include <QElapsedTimer>
+#include <algorithm>
 #include "models/radiostate.h"
 
+// Recorded RDY; state dump (abridged, MEDF menu definitions removed) followed by one
+// second of the steady meter/status stream, as it arrives split into commands
+static const char *RDY_DUMP =
+    "FA00014060000;FB00007040000;MD3;MD$2;BW0040;BW$0280;IS0000;IS$0000;FP2;FP$3;CW60;KS025;PC050H;"
+    "SD0C005;SD0V010;SQ000;RG-00;SQ$000;RG$-00;#SPN50000;#SPN$50000;#REF-110;#REF$-110;#SCL75;#AVG04;"
+    "#PKM0;#NB$0;#NBL$05;#MP1;#MP$0;#FPS30;#WFC3;#WFH50;#DPM2;#DSM0;#VFA1;#VFB1;#AR1;#FXT0;#FXA0;"
+    "VXC0;VXV000;VXD020;NB0;NB$0;NR0;NR$0;PA0;PA$0;RA00;RA$00;GT1;GT$1;NA0;NA$0;NM0;NM$0;AP0;AP$0;"
+    "LK0;LK$0;VT0;VT$0;AR0;AR$0;MG030;CP010;ML010;MI0;MS1;MX0;MN000;ES0;SB0;DV0;DT0;DT$0;TS0;TB0;"
+    "TB$0;TD0;TD$0;TE+00+00+00+00+00+00+00+00;RE+00+00+00+00+00+00+00+00;BS0;AN1;AT0;RT0;XT0;RO0000;"
+    "FT0;FX0;BL0;LN0;LO000;LI000;VG0030;VI000;OM APXSHML14----;ID017;ACN0;ACM0;ACS0;ACT0;RV.1.05;"
+    "SM05;SM$02;TM000000000000;PO000;SIRC1;SIFP2;SM06;SM$02;SM05;SM$03;SM07;SM$02;SM05;SM$02;SM04;"
+    "SM$02;SM05;SM$01;SM06;SM$02;SM05;SM$02;TX0;RX;ER00;";
+
+// Reference copy of the original registry lookup: a linear startsWith() scan over all
+// prefixes, longest first. Kept only to benchmark the indexed dispatcher against.
+class LegacyDispatcher {
+public:
+    LegacyDispatcher() {
+        static const char *prefixes[] = {
+            "#HWFH", "#HDPM", "#HDSM", "#NBL$", "#REF$", "#SPN$", "#NB$", "#MP$", "#REF", "#SPN", "#SCL", "#DPM",
+            "#DSM", "#FPS", "#WFC", "#WFH", "#AVG", "#PKM", "#FXT", "#FXA", "#FRZ", "#VFA", "#VFB", "#MP", "#AR",
+            "SIFP", "SIRC", "TD$", "TB$", "DT$", "MD$", "BW$", "IS$", "FP$", "RG$", "SQ$", "SM$", "NB$", "NR$", "PA$",
+            "RA$", "GT$", "NA$", "NM$", "AP$", "LK$", "VT$", "AR$", "ACN", "ACM", "ACS", "ACT", "RV.", "FA", "FB",
+            "FT", "FP", "FX", "MD", "BL", "BW", "IS", "CW", "RG", "SQ", "MG", "ML", "CP", "PC", "KS", "SM", "PO",
+            "TM", "TX", "RX", "NB", "NR", "NA", "NM", "PA", "RA", "GT", "AP", "LN", "LK", "LO", "LI", "VT", "VX",
+            "VG", "VI", "MI", "MS", "MX", "MN", "ES", "SD", "SB", "DV", "DT", "TS", "TB", "TD", "TE", "BS", "AN",
+            "AR", "AT", "RT", "XT", "RO", "RE", "ID", "OM", "ER",
+        };
+        for (const char *p : prefixes) {
+            m_prefixes.append(QString::fromLatin1(p));
+        }
+        std::stable_sort(m_prefixes.begin(), m_prefixes.end(),
+                         [](const QString &a, const QString &b) { return a.length() > b.length(); });
+    }
+
+    QString match(const QString &cmd) const {
+        for (const QString &prefix : m_prefixes) {
+            if (cmd.startsWith(prefix)) {
+                return prefix;
+            }
+        }
+        return QString();
+    }
+
+private:
+    QStringList m_prefixes;
+};
+
 class TestRadioState : public QObject {
     Q_OBJECT
 
@@ -156,13 +206,14 @@ private slots:
         RadioState state;
         QSignalSpy spy(&state, &RadioState::sMeterChanged);
 
-        // SM00 → 0/2.0 = S0
+        // SM00 → 0/2.0 = S0, same as the initial reading: no signal
         state.parseCATCommand("SM00;");
-        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.count(), 0);
         QCOMPARE(state.sMeter(), 0.0);
 
         // SM18 → 18/2.0 = S9
         state.parseCATCommand("SM18;");
+        QCOMPARE(spy.count(), 1);
         QCOMPARE(state.sMeter(), 9.0);
     }
 
@@ -802,6 +853,252 @@ private slots:
         QCOMPARE(state.sMeterB(), 5.0);
         QCOMPARE(spy.count(), 1);
     }
+
+    // =========================================================================
+    // CatView: in-place slicing and number parsing match QString behavior
+    // =========================================================================
+    void testCatView_toIntMatchesQString_data() {
+        QTest::addColumn<QByteArray>("text");
+        for (const char *text : {"0", "05", "123", "-00", "+00", "-110", "+05", "", "-", "+", "1a", "a1", "1.5",
+                                 "2147483647", "2147483648", "-2147483648", "-2147483649", "99999999999999999999"}) {
+            QTest::addRow("\"%s\"", text) << QByteArray(text);
+        }
+    }
+
+    void testCatView_toIntMatchesQString() {
+        QFETCH(QByteArray, text);
+        bool expectedOk = false;
+        const int expected = QString::fromLatin1(text).toInt(&expectedOk);
+        bool ok = false;
+        QCOMPARE(CatView(text).toInt(&ok), expected);
+        QCOMPARE(ok, expectedOk);
+    }
+
+    void testCatView_slicing() {
+        const CatView cmd("NB$051");
+        QVERIFY(cmd.mid(3) == "051");
+        QVERIFY(cmd.mid(3, 2) == "05");
+        QVERIFY(cmd.mid(5, 10) == "1");
+        QVERIFY(cmd.mid(6).isEmpty());
+        QVERIFY(cmd.mid(20).isEmpty());
+        QVERIFY(cmd.left(2) == "NB");
+        QVERIFY(cmd.right(1) == "1");
+        QVERIFY(cmd.right(10) == cmd);
+        QVERIFY(cmd.left(-1) == cmd); // QString::left()/right() return everything for n < 0 too
+        QVERIFY(cmd.right(-1) == cmd);
+        QCOMPARE(cmd.indexOf('$'), qsizetype(2));
+        QCOMPARE(cmd.indexOf('$', 3), qsizetype(-1));
+        QCOMPARE(CatView("SIFPVS:13.8,IS:0.52").indexOf("IS:"), qsizetype(12));
+        QVERIFY(CatView("  OM AP-S----  ").trimmed() == "OM AP-S----");
+        QCOMPARE(CatView("00014060000").toULongLong(), quint64(14060000));
+
+        bool ok = false;
+        QCOMPARE(CatView("13.8").toDouble(&ok), 13.8);
+        QVERIFY(ok);
+        CatView("13.8V").toDouble(&ok);
+        QVERIFY(!ok);
+    }
+
+    void testParseCATCommand_bytesAndStringAgree() {
+        RadioState fromBytes;
+        RadioState fromString;
+        const QList<QByteArray> commands = QByteArray(RDY_DUMP).split(';');
+        for (const QByteArray &cmd : commands) {
+            fromBytes.parseCATCommand(QByteArrayView(cmd));
+            fromString.parseCATCommand(QString::fromLatin1(cmd) + ";");
+        }
+        QCOMPARE(fromBytes.vfoA(), fromString.vfoA());
+        QCOMPARE(fromBytes.vfoB(), fromString.vfoB());
+        QCOMPARE(fromBytes.mode(), fromString.mode());
+        QCOMPARE(fromBytes.refLevel(), fromString.refLevel());
+        QCOMPARE(fromBytes.sMeter(), fromString.sMeter());
+        QCOMPARE(fromBytes.optionModules(), fromString.optionModules());
+        QCOMPARE(fromBytes.radioModel(), fromString.radioModel());
+    }
+
+    // =========================================================================
+    // Dispatcher: indexed lookup matches the original linear registry scan
+    // =========================================================================
+    void testDispatch_matchesLegacyScan() {
+        LegacyDispatcher legacy;
+        const QStringList commands = QString::fromLatin1(RDY_DUMP).split(';', Qt::SkipEmptyParts);
+        for (const QString &cmd : commands) {
+            QCOMPARE(QString::fromLatin1(RadioState::commandPrefix(cmd.toLatin1())), legacy.match(cmd));
+        }
+
+        // Longest prefix wins, unknown and malformed commands do not match
+        QCOMPARE(RadioState::commandPrefix("#NBL$05"), "#NBL$");
+        QCOMPARE(RadioState::commandPrefix("#NB$1"), "#NB$");
+        QCOMPARE(RadioState::commandPrefix("MD$3"), "MD$");
+        QCOMPARE(RadioState::commandPrefix("MD3"), "MD");
+        QVERIFY(RadioState::commandPrefix("ZZ1") == nullptr);
+        QVERIFY(RadioState::commandPrefix("F") == nullptr);
+        QVERIFY(RadioState::commandPrefix("fa00014060000") == nullptr);
+    }
+
+    // =========================================================================
+    // Change sets: change-only signals, batching, dirty field masks
+    // =========================================================================
+    void testRepeatedValues_emitOnce() {
+        RadioState state;
+        QSignalSpy freqSpy(&state, &RadioState::frequencyChanged);
+        QSignalSpy meterSpy(&state, &RadioState::sMeterChanged);
+
+        state.parseCATCommand("FA00014060000;");
+        state.parseCATCommand("FA00014060000;");
+        state.parseCATCommand("SM05;");
+        state.parseCATCommand("SM05;");
+
+        QCOMPARE(freqSpy.count(), 1);
+        QCOMPARE(meterSpy.count(), 1);
+    }
+
+    void testBatch_commitsOnceAtEnd() {
+        RadioState state;
+        QSignalSpy updatedSpy(&state, &RadioState::stateUpdated);
+        QSignalSpy committedSpy(&state, &RadioState::changesCommitted);
+
+        state.beginBatch();
+        QVERIFY(state.inBatch());
+        const QList<QByteArray> commands = QByteArray(RDY_DUMP).split(';');
+        for (const QByteArray &cmd : commands) {
+            state.parseCATCommand(cmd);
+        }
+        QCOMPARE(updatedSpy.count(), 0);
+        QCOMPARE(committedSpy.count(), 0);
+        state.endBatch();
+        QVERIFY(!state.inBatch());
+
+        QCOMPARE(updatedSpy.count(), 1);
+        QCOMPARE(committedSpy.count(), 1);
+        const auto changed = committedSpy.at(0).at(0).value<RadioState::Fields>();
+        QVERIFY(changed.testFlag(RadioState::FieldVfoA));
+        QVERIFY(changed.testFlag(RadioState::FieldVfoB));
+        QVERIFY(changed.testFlag(RadioState::FieldSMeter));
+        QVERIFY(!changed.testFlag(RadioState::FieldEq)); // TE/RE report the default flat EQ
+    }
+
+    void testBatch_unchangedStateCommitsNothing() {
+        RadioState state;
+        state.parseCATCommand("FA00014060000;");
+
+        QSignalSpy updatedSpy(&state, &RadioState::stateUpdated);
+        QSignalSpy committedSpy(&state, &RadioState::changesCommitted);
+        state.beginBatch();
+        state.parseCATCommand("FA00014060000;");
+        state.endBatch();
+
+        QCOMPARE(updatedSpy.count(), 1);
+        QCOMPARE(committedSpy.count(), 0);
+    }
+
+    void testBatch_nested() {
+        RadioState state;
+        QSignalSpy committedSpy(&state, &RadioState::changesCommitted);
+
+        state.beginBatch();
+        state.beginBatch();
+        state.parseCATCommand("FA00014060000;");
+        state.endBatch();
+        QCOMPARE(committedSpy.count(), 0);
+        state.parseCATCommand("FB00007040000;");
+        state.endBatch();
+
+        QCOMPARE(committedSpy.count(), 1);
+        const auto changed = committedSpy.at(0).at(0).value<RadioState::Fields>();
+        QCOMPARE(changed, RadioState::FieldVfoA | RadioState::FieldVfoB);
+    }
+
+    void testSetterOutsideBatch_commitsImmediately() {
+        RadioState state;
+        QSignalSpy updatedSpy(&state, &RadioState::stateUpdated);
+        QSignalSpy committedSpy(&state, &RadioState::changesCommitted);
+
+        state.setKeyerSpeed(25);
+
+        QCOMPARE(updatedSpy.count(), 0); // No CAT command was applied
+        QCOMPARE(committedSpy.count(), 1);
+        QCOMPARE(committedSpy.at(0).at(0).value<RadioState::Fields>(), RadioState::Fields(RadioState::FieldTxSettings));
+    }
+
+    // =========================================================================
+    // Dispatcher benchmarks: replay the recorded RDY dump
+    // =========================================================================
+    void benchmarkDispatch_lookup_data() {
+        QTest::addColumn<bool>("indexed");
+        QTest::newRow("linear") << false;
+        QTest::newRow("indexed") << true;
+    }
+
+    void benchmarkDispatch_lookup() {
+        QFETCH(bool, indexed);
+        LegacyDispatcher legacy;
+        const QStringList commands = QString::fromLatin1(RDY_DUMP).split(';', Qt::SkipEmptyParts);
+        const QList<QByteArray> byteCommands = QByteArray(RDY_DUMP).split(';');
+
+        int matched = 0;
+        QBENCHMARK {
+            matched = 0;
+            if (indexed) {
+                for (const QByteArray &cmd : byteCommands) {
+                    if (RadioState::commandPrefix(cmd) != nullptr) {
+                        matched++;
+                    }
+                }
+            } else {
+                for (const QString &cmd : commands) {
+                    if (!legacy.match(cmd).isNull()) {
+                        matched++;
+                    }
+                }
+            }
+        }
+        QCOMPARE(matched, commands.size());
+    }
+
+    // "strings" is the original path (split into a QStringList, re-append ';', parse the
+    // QString); "bytes" walks the response in place the way MainWindow::onCatResponse does
+    void benchmarkDispatch_rdyReplay_data() {
+        QTest::addColumn<bool>("bytes");
+        QTest::newRow("strings") << false;
+        QTest::newRow("bytes") << true;
+    }
+
+    void benchmarkDispatch_rdyReplay() {
+        QFETCH(bool, bytes);
+        const QByteArray response(RDY_DUMP);
+        const QString responseText = QString::fromLatin1(response);
+        const int commandCount = response.count(';');
+        RadioState state;
+
+        QElapsedTimer timer;
+        timer.start();
+        int replayed = 0;
+        QBENCHMARK {
+            if (bytes) {
+                const CatView all(response);
+                qsizetype start = 0;
+                while (start < all.length()) {
+                    qsizetype end = all.indexOf(';', start);
+                    if (end < 0)
+                        end = all.length();
+                    state.parseCATCommand(all.mid(start, end - start).view());
+                    start = end + 1;
+                }
+            } else {
+                const QStringList commands = responseText.split(';', Qt::SkipEmptyParts);
+                for (const QString &cmd : commands) {
+                    state.parseCATCommand(cmd + ";");
+                }
+            }
+            replayed += commandCount;
+        }
+        const qint64 ns = qMax<qint64>(1, timer.nsecsElapsed());
+        qInfo("RDY replay (%s): %.0f commands/sec through parseCATCommand", bytes ? "bytes" : "strings",
+              replayed * 1e9 / ns);
+        QCOMPARE(state.vfoA(), quint64(14060000));
+        QCOMPARE(state.radioModel(), QString("K4HD"));
+    }
 };
 
 QTEST_MAIN(TestRadioState)
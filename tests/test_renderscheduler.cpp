@@ -0,0 +1,168 @@
+#include <QElapsedTimer>
+#include <QTest>
+#include <QWidget>
+#include "dsp/renderscheduler.h"
+
+// Stands in for an RHI widget: reports each paint back to the scheduler like render() does
+class FrameCounter : public QWidget {
+public:
+    int frames = 0;
+    bool reportFrames = true;
+
+protected:
+    void paintEvent(QPaintEvent *) override {
+        frames++;
+        if (reportFrames)
+            RenderScheduler::instance()->frameRendered(this);
+    }
+};
+
+static RenderScheduler *scheduler() {
+    return RenderScheduler::instance();
+}
+
+class TestRenderScheduler : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init() {
+        scheduler()->setFrameRate(RenderScheduler::DEFAULT_FRAME_RATE);
+        QTest::qWait(100); // Let the previous test's clock go idle
+        scheduler()->resetStats();
+    }
+
+    // =========================================================================
+    // Pacing
+    // =========================================================================
+    void testRequests_coalesceIntoOneFrame() {
+        FrameCounter widget;
+        widget.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&widget));
+        QTest::qWait(50);
+        const int before = widget.frames;
+
+        for (int i = 0; i < 10; i++)
+            scheduler()->requestFrame(&widget);
+        QTRY_COMPARE(widget.frames, before + 1);
+        QTest::qWait(100);
+
+        QCOMPARE(widget.frames, before + 1);
+        QCOMPARE(scheduler()->stats().requestsCoalesced, quint64(9));
+        QCOMPARE(scheduler()->stats().framesRendered, quint64(1));
+    }
+
+    void testFrameRate_capsRequests() {
+        scheduler()->setFrameRate(20);
+        FrameCounter widget;
+        widget.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&widget));
+        QTest::qWait(50);
+        scheduler()->resetStats();
+
+        // Request every 5ms for half a second: ~10 frames at 20fps, not ~100
+        QElapsedTimer elapsed;
+        elapsed.start();
+        while (elapsed.elapsed() < 500) {
+            scheduler()->requestFrame(&widget);
+            QTest::qWait(5);
+        }
+        const RenderScheduler::Stats stats = scheduler()->stats();
+        QVERIFY2(stats.ticks >= 6 && stats.ticks <= 12, qPrintable(QString::number(stats.ticks)));
+        QVERIFY(stats.requestsCoalesced > 50);
+    }
+
+    void testIdle_stopsTicking() {
+        FrameCounter widget;
+        widget.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&widget));
+
+        scheduler()->requestFrame(&widget);
+        QTest::qWait(150);
+        const quint64 ticks = scheduler()->stats().ticks;
+        QTest::qWait(150);
+        QCOMPARE(scheduler()->stats().ticks, ticks);
+    }
+
+    // =========================================================================
+    // Skipped and dropped frames
+    // =========================================================================
+    void testCleanWidget_isSkipped() {
+        FrameCounter dirty;
+        FrameCounter clean;
+        dirty.show();
+        clean.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&dirty));
+        QVERIFY(QTest::qWaitForWindowExposed(&clean));
+        scheduler()->requestFrame(&clean); // Register both
+        QTest::qWait(100);
+        const int cleanFrames = clean.frames;
+        scheduler()->resetStats();
+
+        scheduler()->requestFrame(&dirty);
+        QTest::qWait(100);
+
+        QCOMPARE(clean.frames, cleanFrames);
+        QCOMPARE(scheduler()->stats().framesSkipped, quint64(1));
+        QCOMPARE(scheduler()->stats().framesRequested, quint64(1));
+    }
+
+    void testUnrenderedFrame_isDropped() {
+        FrameCounter widget;
+        widget.reportFrames = false; // Frame never completes
+        widget.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&widget));
+
+        scheduler()->requestFrame(&widget);
+        QTest::qWait(50);
+        scheduler()->requestFrame(&widget);
+        QTest::qWait(50);
+
+        const RenderScheduler::Stats stats = scheduler()->stats();
+        QCOMPARE(stats.framesRequested, quint64(1));
+        QVERIFY(stats.framesDropped >= 1);
+
+        // Completing the frame lets the deferred one through
+        scheduler()->frameRendered(&widget);
+        QTRY_COMPARE(scheduler()->stats().framesRequested, quint64(2));
+    }
+
+    void testStuckFrame_abandoned() {
+        // A visible widget whose update() never reaches render() is asked again, then left idle
+        FrameCounter widget;
+        widget.reportFrames = false;
+        widget.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&widget));
+
+        scheduler()->requestFrame(&widget);
+        QTest::qWait(50);
+        scheduler()->requestFrame(&widget);
+        QTRY_COMPARE(scheduler()->stats().framesRequested, quint64(2));
+        QCOMPARE(scheduler()->stats().framesAbandoned, quint64(1));
+
+        QTest::qWait(100);
+        const quint64 ticks = scheduler()->stats().ticks;
+        QTest::qWait(150);
+        QCOMPARE(scheduler()->stats().ticks, ticks);
+    }
+
+    void testHiddenWidget_notRepainted() {
+        FrameCounter widget;
+        scheduler()->requestFrame(&widget);
+        QTest::qWait(100);
+        QCOMPARE(widget.frames, 0);
+        QCOMPARE(scheduler()->stats().framesRequested, quint64(0));
+    }
+
+    void testDestroyedWidget_forgotten() {
+        auto *widget = new FrameCounter;
+        widget->show();
+        QVERIFY(QTest::qWaitForWindowExposed(widget));
+        scheduler()->requestFrame(widget);
+        delete widget;
+        QTest::qWait(100); // Tick must not touch the deleted widget
+        QCOMPARE(scheduler()->stats().framesRequested, quint64(0));
+    }
+};
+
+QTEST_MAIN(TestRenderScheduler)
+#include "test_renderscheduler.moc"
@@ -0,0 +1,194 @@
+#include <QTest>
+#include <QVector>
+#include <QtMath>
+#include "audio/resampler.h"
+
+static constexpr int K4_RATE = 12000;
+
+static QVector<float> makeTone(int sampleRate, double frequency, int count, float amplitude = 0.5f) {
+    QVector<float> samples(count);
+    for (int i = 0; i < count; i++)
+        samples[i] = amplitude * float(qSin(2.0 * M_PI * frequency * i / sampleRate));
+    return samples;
+}
+
+// Feed input in capture-sized chunks (10ms poll at the device rate)
+static QVector<float> resample(Resampler &resampler, const QVector<float> &input, int chunk) {
+    QVector<float> output(resampler.maxOutput(int(input.size())) + chunk);
+    int written = 0;
+    for (int i = 0; i < input.size(); i += chunk) {
+        const int count = qMin(chunk, int(input.size()) - i);
+        written += resampler.process(input.constData() + i, count, output.data() + written,
+                                     int(output.size()) - written);
+    }
+    output.resize(written);
+    return output;
+}
+
+// Gain of a tone through the resampler in dB, measured after the filter has settled
+static double toneGainDb(int inputRate, double frequency) {
+    Resampler resampler(inputRate, K4_RATE);
+    const float amplitude = 0.5f;
+    const QVector<float> output = resample(resampler, makeTone(inputRate, frequency, inputRate, amplitude),
+                                           inputRate / 100);
+
+    double sumSquares = 0.0;
+    const int start = int(output.size()) / 2;
+    for (int i = start; i < output.size(); i++)
+        sumSquares += double(output[i]) * output[i];
+    const double rms = qSqrt(sumSquares / (output.size() - start));
+    return 20.0 * std::log10(rms / (amplitude / M_SQRT2));
+}
+
+// Original AudioEngine::resample48kTo12k: average each group of four samples
+static int legacyDecimate(const float *input, int count, float *output) {
+    const int outputCount = count / 4;
+    for (int i = 0; i < outputCount; i++)
+        output[i] = (input[i * 4] + input[i * 4 + 1] + input[i * 4 + 2] + input[i * 4 + 3]) / 4.0f;
+    return outputCount;
+}
+
+class TestResampler : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Rate conversion
+    // =========================================================================
+    void testRatio_reducedByGcd() {
+        Resampler r48(48000, K4_RATE);
+        QCOMPARE(r48.interpolation(), 1);
+        QCOMPARE(r48.decimation(), 4);
+
+        Resampler r44(44100, K4_RATE);
+        QCOMPARE(r44.interpolation(), 40);
+        QCOMPARE(r44.decimation(), 147);
+        QCOMPARE(r44.tapsPerPhase() % 4, 0);
+    }
+
+    void testOutputCount_matchesRate_data() {
+        QTest::addColumn<int>("inputRate");
+        QTest::newRow("48000") << 48000;
+        QTest::newRow("44100") << 44100;
+        QTest::newRow("96000") << 96000;
+        QTest::newRow("16000") << 16000;
+        QTest::newRow("8000") << 8000;
+    }
+
+    void testOutputCount_matchesRate() {
+        QFETCH(int, inputRate);
+        Resampler resampler(inputRate, K4_RATE);
+        QVector<float> input(inputRate, 0.0f);
+
+        // One second in odd-sized chunks is exactly one second out
+        QCOMPARE(resample(resampler, input, 441).size(), K4_RATE);
+        QVERIFY(resampler.maxOutput(441) >= 441 * K4_RATE / inputRate + 1);
+    }
+
+    void testChunking_doesNotChangeOutput() {
+        const QVector<float> input = makeTone(44100, 1234.0, 44100);
+
+        Resampler whole(44100, K4_RATE);
+        const QVector<float> expected = resample(whole, input, int(input.size()));
+
+        Resampler chunked(44100, K4_RATE);
+        const QVector<float> actual = resample(chunked, input, 37);
+
+        QCOMPARE(actual.size(), expected.size());
+        for (int i = 0; i < actual.size(); i++)
+            QVERIFY2(qAbs(actual[i] - expected[i]) < 1e-6f, qPrintable(QString("sample %1").arg(i)));
+    }
+
+    void testReset_clearsHistory() {
+        Resampler resampler(48000, K4_RATE);
+        const QVector<float> tone = makeTone(48000, 1000.0, 4800);
+        resample(resampler, tone, 480);
+        resampler.reset();
+
+        const QVector<float> silence(480, 0.0f);
+        for (float sample : resample(resampler, silence, 480))
+            QCOMPARE(sample, 0.0f);
+    }
+
+    // =========================================================================
+    // Frequency response
+    // =========================================================================
+    void testPassband_flat_data() {
+        QTest::addColumn<int>("inputRate");
+        QTest::addColumn<double>("frequency");
+        for (int rate : {48000, 44100}) {
+            for (double frequency : {100.0, 300.0, 1000.0, 2500.0, 4000.0, 4700.0})
+                QTest::addRow("%d_%.0fHz", rate, frequency) << rate << frequency;
+        }
+    }
+
+    void testPassband_flat() {
+        QFETCH(int, inputRate);
+        QFETCH(double, frequency);
+        const double gain = toneGainDb(inputRate, frequency);
+        QVERIFY2(qAbs(gain) < 0.05, qPrintable(QString("%1 dB").arg(gain)));
+    }
+
+    void testStopband_rejectsAliases_data() {
+        QTest::addColumn<int>("inputRate");
+        QTest::addColumn<double>("frequency");
+        for (int rate : {48000, 44100}) {
+            // Everything above 6kHz would fold back into the 0-6kHz TX band
+            for (double frequency : {6200.0, 7000.0, 9000.0, 11000.0, 15000.0, 20000.0})
+                QTest::addRow("%d_%.0fHz", rate, frequency) << rate << frequency;
+        }
+    }
+
+    void testStopband_rejectsAliases() {
+        QFETCH(int, inputRate);
+        QFETCH(double, frequency);
+        const double gain = toneGainDb(inputRate, frequency);
+        QVERIFY2(gain < -75.0, qPrintable(QString("%1 dB").arg(gain)));
+    }
+
+    void testLegacyDecimator_aliases() {
+        // Reference point: the old 4-sample average only attenuates a 7kHz tone
+        // (aliasing to 5kHz) by a few dB
+        const QVector<float> input = makeTone(48000, 7000.0, 48000);
+        QVector<float> output(input.size() / 4);
+        legacyDecimate(input.constData(), int(input.size()), output.data());
+
+        double sumSquares = 0.0;
+        for (float sample : output)
+            sumSquares += double(sample) * sample;
+        const double gain = 20.0 * std::log10(qSqrt(sumSquares / output.size()) / (0.5 / M_SQRT2));
+        QVERIFY(gain > -20.0);
+    }
+
+    // =========================================================================
+    // Benchmark: one second of microphone capture to 12kHz, in 10ms polls
+    // =========================================================================
+    void benchmarkResample_data() {
+        QTest::addColumn<int>("inputRate");
+        QTest::addColumn<bool>("legacy");
+        QTest::newRow("legacy_48000") << 48000 << true;
+        QTest::newRow("polyphase_48000") << 48000 << false;
+        QTest::newRow("polyphase_44100") << 44100 << false;
+    }
+
+    void benchmarkResample() {
+        QFETCH(int, inputRate);
+        QFETCH(bool, legacy);
+        const QVector<float> input = makeTone(inputRate, 1000.0, inputRate);
+        const int chunk = inputRate / 100;
+        Resampler resampler(inputRate, K4_RATE);
+        QVector<float> output(resampler.maxOutput(chunk));
+
+        QBENCHMARK {
+            for (int i = 0; i + chunk <= input.size(); i += chunk) {
+                if (legacy)
+                    legacyDecimate(input.constData() + i, chunk, output.data());
+                else
+                    resampler.process(input.constData() + i, chunk, output.data(), int(output.size()));
+            }
+        }
+    }
+};
+
+QTEST_MAIN(TestResampler)
+#include "test_resampler.moc"
@@ -0,0 +1,146 @@
+#include <QTest>
+#include <memory>
+#include <rhi/qrhi.h>
+#include "dsp/rhiresourcecache.h"
+
+static QVector<quint8> grayLut() {
+    QVector<quint8> lut(256 * 4);
+    for (int i = 0; i < 256; ++i) {
+        lut[i * 4 + 0] = lut[i * 4 + 1] = lut[i * 4 + 2] = static_cast<quint8>(i);
+        lut[i * 4 + 3] = 255;
+    }
+    return lut;
+}
+
+static int lutBuilds = 0;
+static QVector<quint8> countedLut() {
+    lutBuilds++;
+    return grayLut();
+}
+
+static std::unique_ptr<QRhi> createNullRhi() {
+    QRhiNullInitParams params;
+    return std::unique_ptr<QRhi>(QRhi::create(QRhi::Null, &params));
+}
+
+// Texture render target of the given format, as the widgets' offscreen passes use
+struct Target {
+    std::unique_ptr<QRhiTexture> texture;
+    std::unique_ptr<QRhiTextureRenderTarget> rt;
+    std::unique_ptr<QRhiRenderPassDescriptor> rpDesc;
+
+    Target(QRhi *rhi, QRhiTexture::Format format) {
+        texture.reset(rhi->newTexture(format, QSize(64, 64), 1, QRhiTexture::RenderTarget));
+        texture->create();
+        rt.reset(rhi->newTextureRenderTarget({texture.get()}));
+        rpDesc.reset(rt->newCompatibleRenderPassDescriptor());
+        rt->setRenderPassDescriptor(rpDesc.get());
+        rt->create();
+    }
+};
+
+class TestRhiResourceCache : public QObject {
+    Q_OBJECT
+
+private:
+    // Overlay-style pipeline: spectrum.vert/.frag with one uniform buffer
+    static QRhiGraphicsPipeline *overlayPipeline(QRhi *rhi, QRhiRenderPassDescriptor *rpDesc,
+                                                 QRhiShaderResourceBindings *layout) {
+        RhiResourceCache *cache = RhiResourceCache::instance();
+        return cache->pipeline(rhi, QStringLiteral("test.overlay"), rpDesc, [&](QRhiGraphicsPipeline *pipeline) {
+            pipeline->setShaderStages({{QRhiShaderStage::Vertex, cache->shader(QStringLiteral("spectrum.vert"))},
+                                       {QRhiShaderStage::Fragment, cache->shader(QStringLiteral("spectrum.frag"))}});
+            QRhiVertexInputLayout inputLayout;
+            inputLayout.setBindings({{6 * sizeof(float)}});
+            inputLayout.setAttributes({{0, 0, QRhiVertexInputAttribute::Float2, 0},
+                                       {0, 1, QRhiVertexInputAttribute::Float4, 2 * sizeof(float)}});
+            pipeline->setVertexInputLayout(inputLayout);
+            pipeline->setShaderResourceBindings(layout);
+        });
+    }
+
+    static QRhiShaderResourceBindings *uniformBindings(QRhi *rhi, QRhiBuffer *ubuf) {
+        QRhiShaderResourceBindings *srb = rhi->newShaderResourceBindings();
+        srb->setBindings({QRhiShaderResourceBinding::uniformBuffer(0, QRhiShaderResourceBinding::VertexStage, ubuf)});
+        srb->create();
+        return srb;
+    }
+
+private slots:
+    // =========================================================================
+    // Process-wide
+    // =========================================================================
+    void testShader_loadedOnce() {
+        RhiResourceCache *cache = RhiResourceCache::instance();
+        const int before = cache->stats().shadersLoaded;
+        QVERIFY(cache->shader(QStringLiteral("waterfall.vert")).isValid());
+        QVERIFY(cache->shader(QStringLiteral("waterfall.vert")).isValid());
+        QCOMPARE(cache->stats().shadersLoaded, before + 1);
+        QVERIFY(!cache->shader(QStringLiteral("missing.frag")).isValid());
+    }
+
+    // =========================================================================
+    // Per QRhi
+    // =========================================================================
+    void testLut_builtOncePerRhi() {
+        std::unique_ptr<QRhi> first = createNullRhi();
+        std::unique_ptr<QRhi> second = createNullRhi();
+        QVERIFY(first && second);
+        RhiResourceCache *cache = RhiResourceCache::instance();
+        lutBuilds = 0;
+
+        QRhiResourceUpdateBatch *rub = first->nextResourceUpdateBatch();
+        QRhiTexture *lut = cache->lut(first.get(), QStringLiteral("test.gray"), countedLut, rub);
+        QCOMPARE(cache->lut(first.get(), QStringLiteral("test.gray"), countedLut, rub), lut);
+        QCOMPARE(lutBuilds, 1);
+        QCOMPARE(lut->pixelSize(), QSize(256, 1));
+        rub->release();
+
+        // Another QRhi (another window) gets its own
+        rub = second->nextResourceUpdateBatch();
+        QVERIFY(cache->lut(second.get(), QStringLiteral("test.gray"), countedLut, rub) != lut);
+        QCOMPARE(lutBuilds, 2);
+        rub->release();
+
+        QCOMPARE(cache->linearSampler(first.get()), cache->linearSampler(first.get()));
+    }
+
+    void testPipeline_sharedByPassFormat() {
+        std::unique_ptr<QRhi> rhi = createNullRhi();
+        QVERIFY(rhi);
+        std::unique_ptr<QRhiBuffer> ubuf(rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, 16));
+        ubuf->create();
+        std::unique_ptr<QRhiShaderResourceBindings> srbA(uniformBindings(rhi.get(), ubuf.get()));
+        std::unique_ptr<QRhiShaderResourceBindings> srbB(uniformBindings(rhi.get(), ubuf.get()));
+
+        // Two widgets with RGBA8 passes share one pipeline; an R8 pass needs its own
+        Target widgetA(rhi.get(), QRhiTexture::RGBA8);
+        Target widgetB(rhi.get(), QRhiTexture::RGBA8);
+        Target singleChannel(rhi.get(), QRhiTexture::R8);
+        QRhiGraphicsPipeline *pipeline = overlayPipeline(rhi.get(), widgetA.rpDesc.get(), srbA.get());
+        QVERIFY(pipeline);
+        QCOMPARE(overlayPipeline(rhi.get(), widgetB.rpDesc.get(), srbB.get()), pipeline);
+        QVERIFY(overlayPipeline(rhi.get(), singleChannel.rpDesc.get(), srbB.get()) != pipeline);
+    }
+
+    void testRelease_withRhi() {
+        RhiResourceCache *cache = RhiResourceCache::instance();
+        std::unique_ptr<QRhi> rhi = createNullRhi();
+        QRhiResourceUpdateBatch *rub = rhi->nextResourceUpdateBatch();
+        cache->lut(rhi.get(), QStringLiteral("test.gray"), grayLut, rub);
+        cache->fullscreenQuad(rhi.get(), rub);
+        rub->release();
+        rhi.reset(); // Cleanup callback deletes the LUT and quad before the QRhi goes
+
+        // A new QRhi (possibly at the same address) starts empty
+        rhi = createNullRhi();
+        rub = rhi->nextResourceUpdateBatch();
+        const int created = cache->stats().resourcesCreated;
+        cache->lut(rhi.get(), QStringLiteral("test.gray"), grayLut, rub);
+        QCOMPARE(cache->stats().resourcesCreated, created + 1);
+        rub->release();
+    }
+};
+
+QTEST_MAIN(TestRhiResourceCache)
+#include "test_rhiresourcecache.moc"
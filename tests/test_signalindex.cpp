@@ -0,0 +1,152 @@
+#include <QPair>
+#include <QTest>
+#include <QVector>
+#include "dsp/noisefloor.h"
+#include "dsp/signalindex.h"
+#include "spectrumtestdata.h"
+
+static constexpr qint64 CENTER = 14050000;
+static constexpr qint32 SPAN = 50000;
+static constexpr int BINS = 500; // 100 Hz per bin
+
+// Band noise with a few bins of carrier at each (bin, level)
+static QVector<quint8> makePacket(const QVector<QPair<int, int>> &carriers, unsigned seed = 1) {
+    QVector<quint8> packet = noisePacket(BINS, seed);
+    for (const auto &carrier : carriers) {
+        packet[carrier.first] = static_cast<quint8>(carrier.second);
+        packet[carrier.first - 1] = static_cast<quint8>(carrier.second - 6);
+        packet[carrier.first + 1] = static_cast<quint8>(carrier.second - 6);
+    }
+    return packet;
+}
+
+static qint64 binFrequency(int bin) {
+    return CENTER - SPAN / 2 + qint64(bin) * SPAN / BINS + SPAN / BINS / 2;
+}
+
+// The packet's floor as the panadapter passes it in (unsmoothed here)
+static float floorDb(const QVector<quint8> &packet) {
+    return NoiseFloorEstimator::percentile(packet.constData(), int(packet.size()),
+                                           NoiseFloorEstimator::DEFAULT_PERCENTILE) - 146.0f;
+}
+
+static void feed(SignalIndex &index, const QVector<QPair<int, int>> &carriers, int packets, unsigned seed = 1,
+                 qint64 center = CENTER) {
+    for (int p = 0; p < packets; ++p) {
+        const QVector<quint8> packet = makePacket(carriers, seed + unsigned(p));
+        index.update(packet.constData(), BINS, center, SPAN, 1.0f, -146.0f, floorDb(packet));
+    }
+}
+
+class TestSignalIndex : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Detection
+    // =========================================================================
+    void testDetect_findsCarriers() {
+        SignalIndex index;
+        feed(index, {{100, 80}, {300, 50}}, SignalIndex::MIN_HITS);
+
+        const QVector<SignalIndex::Entry> found = index.signalList();
+        QCOMPARE(found.size(), 2);
+        QCOMPARE(found[0].frequency, binFrequency(100));
+        QCOMPARE(found[1].frequency, binFrequency(300));
+        QVERIFY(found[0].snrDb > found[1].snrDb);
+        QVERIFY(found[1].snrDb > SignalIndex::DEFAULT_THRESHOLD_DB);
+        QVERIFY(found[0].widthHz >= 300 && found[0].widthHz <= 500);
+    }
+
+    void testDetect_noiseIsNotASignal() {
+        SignalIndex index;
+        feed(index, {}, 50);
+        QVERIFY(index.signalList().isEmpty());
+    }
+
+    void testDetect_interpolatesBetweenBins() {
+        // Equal neighbours on one side: the peak sits between the two bins
+        QVector<quint8> packet = makePacket({});
+        packet[200] = 80;
+        packet[201] = 80;
+        packet[199] = 60;
+        packet[202] = 60;
+        SignalIndex index;
+        for (int i = 0; i < SignalIndex::MIN_HITS; ++i)
+            index.update(packet.constData(), BINS, CENTER, SPAN, 1.0f, -146.0f, floorDb(packet));
+        const qint64 between = (binFrequency(200) + binFrequency(201)) / 2;
+        QVERIFY(qAbs(index.signalList().value(0).frequency - between) <= 10);
+    }
+
+    // =========================================================================
+    // Tracking
+    // =========================================================================
+    void testTrack_needsConfirmationAndAgesOut() {
+        SignalIndex index;
+        feed(index, {{250, 80}}, SignalIndex::MIN_HITS - 1);
+        QVERIFY(index.signalList().isEmpty());
+        feed(index, {{250, 80}}, 1);
+        QCOMPARE(index.signalList().size(), 1);
+
+        // A fade shorter than MAX_MISSES keeps it
+        feed(index, {}, SignalIndex::MAX_MISSES, 100);
+        QCOMPARE(index.signalList().size(), 1);
+        feed(index, {}, 1, 200);
+        QVERIFY(index.signalList().isEmpty());
+    }
+
+    void testTrack_followsRetune() {
+        // The same carrier at 1 kHz higher center moves 10 bins down: still one entry
+        SignalIndex index;
+        feed(index, {{250, 80}}, SignalIndex::MIN_HITS);
+        feed(index, {{240, 80}}, 1, 50, CENTER + 1000);
+        const QVector<SignalIndex::Entry> found = index.signalList();
+        QCOMPARE(found.size(), 1);
+        QCOMPARE(found[0].frequency, binFrequency(250));
+        QCOMPARE(found[0].hits, SignalIndex::MIN_HITS + 1);
+    }
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+    void testNearest_withinTolerance() {
+        SignalIndex index;
+        feed(index, {{100, 80}, {300, 80}}, SignalIndex::MIN_HITS);
+        QCOMPARE(index.nearest(binFrequency(100) + 400, 500)->frequency, binFrequency(100));
+        QVERIFY(index.nearest(binFrequency(200), 500) == nullptr);
+    }
+
+    void testNext_upAndDown() {
+        SignalIndex index;
+        feed(index, {{100, 80}, {300, 80}, {400, 80}}, SignalIndex::MIN_HITS);
+        QCOMPARE(index.next(binFrequency(200), 1)->frequency, binFrequency(300));
+        QCOMPARE(index.next(binFrequency(300), 1)->frequency, binFrequency(400));
+        QCOMPARE(index.next(binFrequency(300), -1)->frequency, binFrequency(100));
+        QVERIFY(index.next(binFrequency(400), 1) == nullptr);
+        QVERIFY(index.next(binFrequency(100), -1) == nullptr);
+    }
+
+    void testClear() {
+        SignalIndex index;
+        feed(index, {{100, 80}}, SignalIndex::MIN_HITS);
+        index.clear();
+        QVERIFY(index.signalList().isEmpty());
+    }
+
+    // =========================================================================
+    // Benchmark: one 4096-bin packet with a busy band
+    // =========================================================================
+    void benchmarkUpdate() {
+        QVector<quint8> packet = noisePacket(4096, 7);
+        for (int i = 10; i < 4090; i += 37)
+            packet[i] = 70;
+        const float floor = floorDb(packet);
+        SignalIndex index;
+        QBENCHMARK {
+            index.update(packet.constData(), int(packet.size()), CENTER, 200000, 1.0f, -146.0f, floor);
+        }
+    }
+};
+
+QTEST_MAIN(TestSignalIndex)
+#include "test_signalindex.moc"
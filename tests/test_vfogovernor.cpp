@@ -0,0 +1,115 @@
+#include <QTest>
+#include "network/vfogovernor.h"
+
+using Due = QVector<QPair<VfoGovernor::Vfo, quint64>>;
+
+class TestVfoGovernor : public QObject {
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Rate limiting
+    // =========================================================================
+    void testRequest_spacedByRoundTrip() {
+        VfoGovernor governor;
+        const qint64 interval = VfoGovernor::DEFAULT_RTT_MS / VfoGovernor::MAX_SENDS_PER_RTT;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14074010, 10));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14074020, 20));
+        QCOMPARE(governor.msUntilDue(20), interval - 20);
+
+        // Only the latest held value goes out, once its slot opens
+        QVERIFY(governor.takeDue(interval - 1).isEmpty());
+        QCOMPARE(governor.takeDue(interval), Due({{VfoGovernor::VfoA, 14074020}}));
+        QCOMPARE(governor.msUntilDue(interval), qint64(-1));
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074030, 2 * interval));
+    }
+
+    void testSendNow_dropsHeldStep() {
+        // A click after a held wheel step: the held value must never reach the radio
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14074010, 10));
+        governor.sendNow(VfoGovernor::VfoA, 21074000, 20);
+        QCOMPARE(governor.msUntilDue(20), qint64(-1));
+        QVERIFY(governor.takeDue(1000).isEmpty());
+
+        // The click's read-back applies; the older wheel send is stale
+        QVERIFY(!governor.acceptEcho(VfoGovernor::VfoA, 14074000, 30));
+        QVERIFY(governor.acceptEcho(VfoGovernor::VfoA, 21074000, 40));
+    }
+
+    void testRequest_vfosIndependent() {
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(governor.request(VfoGovernor::VfoB, 7074000, 1));
+        QVERIFY(!governor.request(VfoGovernor::VfoB, 7074010, 2));
+        QCOMPARE(governor.takeDue(100), Due({{VfoGovernor::VfoB, 7074010}}));
+    }
+
+    // =========================================================================
+    // Echo reconciliation
+    // =========================================================================
+    void testEcho_olderSendIsStale() {
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14075000, 50));
+        QVERIFY(!governor.acceptEcho(VfoGovernor::VfoA, 14074000, 60));
+        QVERIFY(governor.acceptEcho(VfoGovernor::VfoA, 14075000, 110));
+    }
+
+    void testEcho_staleWhileHeld() {
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14075000, 10));
+        QVERIFY(!governor.acceptEcho(VfoGovernor::VfoA, 14074000, 20));
+    }
+
+    void testEcho_radioChangeWins() {
+        // A frequency we never sent was tuned at the radio: it applies and cancels the held step
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14075000, 10));
+        QVERIFY(governor.acceptEcho(VfoGovernor::VfoA, 21074000, 20));
+        QCOMPARE(governor.msUntilDue(20), qint64(-1));
+        QVERIFY(governor.acceptEcho(VfoGovernor::VfoA, 14074000, 30));
+    }
+
+    void testEcho_unansweredSendExpires() {
+        // Without auto-info the K4 doesn't echo writes; an old value reported much later is the radio's
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14075000, 100));
+        QVERIFY(governor.acceptEcho(VfoGovernor::VfoA, 14074000, 5000));
+        QCOMPARE(governor.rttMs(), VfoGovernor::DEFAULT_RTT_MS);
+    }
+
+    // =========================================================================
+    // Round trip
+    // =========================================================================
+    void testRtt_learnedFromEchoes() {
+        VfoGovernor governor;
+        qint64 now = 0;
+        for (int i = 0; i < 20; ++i, now += 500) {
+            QVERIFY(governor.request(VfoGovernor::VfoA, 14074000 + i * 10, now));
+            QVERIFY(governor.acceptEcho(VfoGovernor::VfoA, 14074000 + i * 10, now + 400));
+        }
+        QVERIFY(governor.rttMs() > 300 && governor.rttMs() <= 400);
+
+        // A slow link gets fewer, later updates
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14080000, now));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14080010, now + 100));
+    }
+
+    void testClear_dropsHeldAndInFlight() {
+        VfoGovernor governor;
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14074000, 0));
+        QVERIFY(!governor.request(VfoGovernor::VfoA, 14075000, 10));
+        governor.clear();
+        QCOMPARE(governor.msUntilDue(10), qint64(-1));
+        QVERIFY(governor.request(VfoGovernor::VfoA, 14076000, 11));
+    }
+};
+
+QTEST_MAIN(TestVfoGovernor)
+#include "test_vfogovernor.moc"
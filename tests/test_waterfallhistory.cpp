@@ -0,0 +1,178 @@
+#include <QTemporaryDir>
+#include <QTest>
+#include <QVector>
+#include "dsp/waterfallhistory.h"
+
+static constexpr qint64 CENTER = 14050000;
+static constexpr qint32 SPAN = 50000;
+static constexpr int BINS = 500;
+
+// Noise floor at 10 with one 200 "signal" bin
+static QVector<quint8> makeRow(int signalBin, quint8 floor = 10) {
+    QVector<quint8> bins(BINS, floor);
+    if (signalBin >= 0)
+        bins[signalBin] = 200;
+    return bins;
+}
+
+// Rows ROW_INTERVAL_MS apart, signal bin = row index
+static void fill(WaterfallHistory &history, int rows, qint64 startMs = 1000) {
+    for (int r = 0; r < rows; r++) {
+        const QVector<quint8> bins = makeRow(r % BINS);
+        QVERIFY(history.append(startMs + r * WaterfallHistory::ROW_INTERVAL_MS, CENTER, SPAN, bins.constData(),
+                               int(bins.size())));
+    }
+}
+
+class TestWaterfallHistory : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    QString path(const char *name) const { return m_dir.filePath(name); }
+
+private slots:
+    // =========================================================================
+    // Recording
+    // =========================================================================
+    void testAppend_ringKeepsNewest() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("ring.wfh"), 100));
+        fill(history, 150);
+
+        QCOMPARE(history.rowCount(), 100);
+        QCOMPARE(history.row(0)->timestampMs, 1000 + 149 * WaterfallHistory::ROW_INTERVAL_MS);
+        QCOMPARE(history.row(99)->timestampMs, 1000 + 50 * WaterfallHistory::ROW_INTERVAL_MS);
+        QCOMPARE(history.row(0)->centerFreq, CENTER);
+        QCOMPARE(history.row(0)->spanHz, SPAN);
+        QCOMPARE(int(history.row(0)->binCount), BINS);
+        QCOMPARE(history.rowBins(0)[149], quint8(200));
+        QVERIFY(history.row(100) == nullptr);
+    }
+
+    void testAppend_mergesWithinInterval() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("merge.wfh"), 10));
+        QVector<quint8> first = makeRow(5);
+        QVector<quint8> second = makeRow(7, 30);
+        QVERIFY(history.append(0, CENTER, SPAN, first.constData(), BINS));
+        QVERIFY(!history.append(100, CENTER, SPAN, second.constData(), BINS));
+
+        // One row holding the per-bin maximum of both packets
+        QCOMPARE(history.rowCount(), 1);
+        QCOMPARE(history.rowBins(0)[5], quint8(200));
+        QCOMPARE(history.rowBins(0)[7], quint8(200));
+        QCOMPARE(history.rowBins(0)[0], quint8(30));
+
+        // A retune starts a new row even inside the interval
+        QVERIFY(history.append(150, CENTER + 1000, SPAN, first.constData(), BINS));
+        QCOMPARE(history.rowCount(), 2);
+    }
+
+    void testAppend_widePacketMaxPooled() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("wide.wfh"), 10));
+        QVector<quint8> wide(3000, 1);
+        wide[2999] = 99;
+        history.append(0, CENTER, SPAN, wide.constData(), int(wide.size()));
+
+        QCOMPARE(int(history.row(0)->binCount), WaterfallHistory::ROW_BINS);
+        QCOMPARE(history.rowBins(0)[WaterfallHistory::ROW_BINS - 1], quint8(99));
+    }
+
+    void testReopen_keepsRows() {
+        {
+            WaterfallHistory history;
+            QVERIFY(history.open(path("persist.wfh"), 100));
+            fill(history, 40);
+        }
+        WaterfallHistory history;
+        QVERIFY(history.open(path("persist.wfh"), 100));
+        QCOMPARE(history.rowCount(), 40);
+        QCOMPARE(history.rowBins(0)[39], quint8(200));
+
+        // A different layout starts fresh
+        history.close();
+        QVERIFY(history.open(path("persist.wfh"), 200));
+        QCOMPARE(history.rowCount(), 0);
+    }
+
+    void testAgeAt_findsRowByTime() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("time.wfh"), 100));
+        fill(history, 50);
+        QCOMPARE(history.ageAt(1000 + 40 * WaterfallHistory::ROW_INTERVAL_MS + 5), 9);
+        QCOMPARE(history.ageAt(1000 + 49 * WaterfallHistory::ROW_INTERVAL_MS), 0);
+        QCOMPARE(history.ageAt(0), 49);
+    }
+
+    // =========================================================================
+    // Paging
+    // =========================================================================
+    void testReadWindow_sameView() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("window.wfh"), 100));
+        fill(history, 50);
+        QVector<quint8> page(BINS * 4);
+
+        // Newest line last; startAge skips the newest rows
+        QCOMPARE(history.readWindow(page.data(), BINS, 4, 0, 1, CENTER, SPAN), 4);
+        QCOMPARE(page[3 * BINS + 49], quint8(200));
+        QCOMPARE(page[0 * BINS + 46], quint8(200));
+        history.readWindow(page.data(), BINS, 4, 10, 1, CENTER, SPAN);
+        QCOMPARE(page[3 * BINS + 39], quint8(200));
+
+        // Past the oldest row: empty lines
+        QCOMPARE(history.readWindow(page.data(), BINS, 4, 48, 1, CENTER, SPAN), 2);
+        QCOMPARE(page[0], quint8(0));
+    }
+
+    void testReadWindow_reprojectsFrequency() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("retune.wfh"), 100));
+        fill(history, 50);
+        QVector<quint8> page(BINS);
+
+        // View 10 bins (1 kHz) higher: the signal moves 10 columns left, the right edge has no data
+        history.readWindow(page.data(), BINS, 1, 0, 1, CENTER + 1000, SPAN);
+        QCOMPARE(page[39], quint8(200));
+        QCOMPARE(page[BINS - 1], quint8(0));
+
+        // Twice the span: the row covers the middle half
+        history.readWindow(page.data(), BINS, 1, 0, 1, CENTER, SPAN * 2);
+        QCOMPARE(page[BINS / 4 + 49 / 2], quint8(200));
+        QCOMPARE(page[0], quint8(0));
+        QCOMPARE(page[BINS / 2], quint8(10));
+    }
+
+    void testReadWindow_zoomMergesRows() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("zoom.wfh"), 100));
+        fill(history, 50);
+        QVector<quint8> page(BINS * 2);
+
+        history.readWindow(page.data(), BINS, 2, 0, 4, CENTER, SPAN);
+        for (int bin : {46, 47, 48, 49})
+            QCOMPARE(page[BINS + bin], quint8(200));
+        QCOMPARE(page[BINS + 45], quint8(10));
+        QCOMPARE(page[45], quint8(200));
+    }
+
+    // =========================================================================
+    // Benchmark: page a full 1024-line window at 4 rows per line
+    // =========================================================================
+    void benchmarkReadWindow() {
+        WaterfallHistory history;
+        QVERIFY(history.open(path("bench.wfh"), 8192));
+        fill(history, 8192);
+        QVector<quint8> page(WaterfallHistory::ROW_BINS * 1024);
+
+        QBENCHMARK {
+            history.readWindow(page.data(), WaterfallHistory::ROW_BINS, 1024, 1000, 4, CENTER + 500, SPAN);
+        }
+    }
+};
+
+QTEST_MAIN(TestWaterfallHistory)
+#include "test_waterfallhistory.moc"